@@ -0,0 +1,155 @@
+/**
+ * Price history backend benchmark
+ *
+ * Records `points` prices for each of `items` wishlist items, one scrape
+ * round at a time, then reads every item's last 180 days back. Runs the
+ * same workload on the price_history table and on PriceSeriesStore in a
+ * temporary directory.
+ *
+ * Usage: price-history-benchmark [items] [points]
+ */
+
+#include "infrastructure/database_manager.hpp"
+#include "infrastructure/logger.hpp"
+#include "infrastructure/price_series_store.hpp"
+#include "infrastructure/repositories/price_history_repository.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fmt/format.h>
+#include <unistd.h>
+
+using namespace bluray;
+using namespace bluray::infrastructure;
+namespace fs = std::filesystem;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+  double ingest_seconds{0.0};
+  double read_seconds{0.0};
+  size_t points_read{0};
+  uintmax_t bytes{0};
+};
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+uintmax_t directorySize(const fs::path &directory) {
+  uintmax_t total = 0;
+  for (const auto &entry : fs::recursive_directory_iterator(directory)) {
+    if (entry.is_regular_file()) {
+      total += entry.file_size();
+    }
+  }
+  return total;
+}
+
+// Mostly stable with an occasional change, like scraped prices
+domain::Money priceAt(int item, int round) {
+  return domain::Money::fromCents(1999 + (item % 7) * 100 -
+                                  (round / 25 % 4) * 150);
+}
+
+Result runSqlite(const fs::path &directory, int items, int points) {
+  auto &db = DatabaseManager::instance();
+  db.initialize((directory / "bench.db").string());
+  for (int item = 1; item <= items; ++item) {
+    db.execute(fmt::format(
+        "INSERT INTO wishlist (id, url, title, created_at, last_checked) "
+        "VALUES ({0}, 'https://example.com/{0}', 'Item {0}', "
+        "datetime('now'), datetime('now'))",
+        item));
+  }
+
+  PriceHistoryRepository repo(PriceHistoryBackend::Sqlite);
+  Result result;
+
+  auto start = Clock::now();
+  for (int round = 0; round < points; ++round) {
+    for (int item = 1; item <= items; ++item) {
+      repo.addEntry(item, priceAt(item, round), round % 10 != 0);
+    }
+  }
+  result.ingest_seconds = secondsSince(start);
+
+  start = Clock::now();
+  for (int item = 1; item <= items; ++item) {
+    result.points_read += repo.getHistory(item, 180).size();
+  }
+  result.read_seconds = secondsSince(start);
+
+  db.close();
+  result.bytes = directorySize(directory);
+  return result;
+}
+
+Result runSeries(const fs::path &directory, int items, int points) {
+  Result result;
+  const int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+  const int64_t first = now - static_cast<int64_t>(points) * 3600;
+
+  {
+    PriceSeriesStore store(directory);
+
+    auto start = Clock::now();
+    for (int round = 0; round < points; ++round) {
+      for (int item = 1; item <= items; ++item) {
+        store.append(item, {first + round * 3600, priceAt(item, round),
+                            round % 10 != 0});
+      }
+    }
+    result.ingest_seconds = secondsSince(start);
+
+    start = Clock::now();
+    const int64_t since = now - int64_t{180} * 24 * 3600;
+    for (int item = 1; item <= items; ++item) {
+      result.points_read += store.read(item, since).size();
+    }
+    result.read_seconds = secondsSince(start);
+  } // Waits for queued compactions
+
+  result.bytes = directorySize(directory);
+  return result;
+}
+
+void print(const char *name, const Result &result, int items, int points) {
+  const double written = static_cast<double>(items) * points;
+  fmt::print("{:<8} ingest {:>10.0f} points/s   read {:>12.0f} points/s "
+             "({:>8.0f} items/s)   {:>8.1f} KiB on disk\n",
+             name, written / result.ingest_seconds,
+             result.points_read / result.read_seconds,
+             items / result.read_seconds, result.bytes / 1024.0);
+}
+
+} // anonymous namespace
+
+int main(int argc, char *argv[]) {
+  const int items = argc > 1 ? std::atoi(argv[1]) : 200;
+  const int points = argc > 2 ? std::atoi(argv[2]) : 500;
+  if (items <= 0 || points <= 0) {
+    fmt::print(stderr, "Usage: {} [items] [points]\n", argv[0]);
+    return 1;
+  }
+
+  Logger::instance().setLevel(LogLevel::Warning);
+
+  const fs::path root = fs::temp_directory_path() /
+                        fmt::format("bluray-history-bench-{}", ::getpid());
+  fs::create_directories(root / "sqlite");
+  fs::create_directories(root / "series");
+
+  fmt::print("{} items x {} points\n", items, points);
+  const auto sqlite = runSqlite(root / "sqlite", items, points);
+  print("sqlite", sqlite, items, points);
+  const auto series = runSeries(root / "series", items, points);
+  print("series", series, items, points);
+
+  fs::remove_all(root);
+  return 0;
+}
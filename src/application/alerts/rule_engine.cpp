@@ -0,0 +1,712 @@
+#include "rule_engine.hpp"
+#include "../../infrastructure/logger.hpp"
+#include "../../infrastructure/repositories/price_stats_repository.hpp"
+#include "../../infrastructure/repositories/tag_repository.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <set>
+
+namespace bluray::application::alerts {
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr uint32_t kAllChanges = ~0u;
+
+std::string toLower(std::string_view text) {
+  std::string lower(text);
+  std::transform(lower.begin(), lower.end(), lower.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return lower;
+}
+
+uint32_t changeBit(domain::ChangeType type) {
+  return 1u << static_cast<uint32_t>(type);
+}
+
+std::optional<RuleField> parseField(std::string_view name) {
+  static const std::pair<std::string_view, RuleField> kFields[] = {
+      {"current_price", RuleField::CurrentPrice},
+      {"desired_max_price", RuleField::DesiredMaxPrice},
+      {"in_stock", RuleField::InStock},
+      {"is_uhd_4k", RuleField::IsUhd4k},
+      {"source", RuleField::Source},
+      {"title", RuleField::Title},
+      {"tag", RuleField::Tag},
+      {"change", RuleField::Change},
+      {"price_drop_percent", RuleField::PriceDropPercent},
+      {"is_window_low", RuleField::IsWindowLow},
+      {"is_all_time_low", RuleField::IsAllTimeLow},
+      {"below_average_percent", RuleField::BelowAveragePercent}};
+  for (const auto &[field_name, field] : kFields) {
+    if (name == field_name) {
+      return field;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<RuleOperator> parseOperator(std::string_view name) {
+  static const std::pair<std::string_view, RuleOperator> kOperators[] = {
+      {"equals", RuleOperator::Equals},
+      {"not_equals", RuleOperator::NotEquals},
+      {"less_than", RuleOperator::LessThan},
+      {"less_or_equal", RuleOperator::LessOrEqual},
+      {"greater_than", RuleOperator::GreaterThan},
+      {"greater_or_equal", RuleOperator::GreaterOrEqual},
+      {"contains", RuleOperator::Contains}};
+  for (const auto &[op_name, op] : kOperators) {
+    if (name == op_name) {
+      return op;
+    }
+  }
+  return std::nullopt;
+}
+
+enum class FieldKind { Number, Boolean, Text, Set };
+
+FieldKind kindOf(RuleField field) {
+  switch (field) {
+  case RuleField::CurrentPrice:
+  case RuleField::DesiredMaxPrice:
+  case RuleField::PriceDropPercent:
+  case RuleField::BelowAveragePercent:
+    return FieldKind::Number;
+  case RuleField::InStock:
+  case RuleField::IsUhd4k:
+  case RuleField::IsWindowLow:
+  case RuleField::IsAllTimeLow:
+    return FieldKind::Boolean;
+  case RuleField::Source:
+  case RuleField::Title:
+    return FieldKind::Text;
+  default:
+    return FieldKind::Set;
+  }
+}
+
+/**
+ * Relative cost of evaluating a field; cheaper predicates run first
+ */
+int costOf(RuleField field) {
+  switch (field) {
+  case RuleField::Title:
+  case RuleField::Source:
+  case RuleField::Tag:
+  case RuleField::IsAllTimeLow:
+  case RuleField::BelowAveragePercent:
+    return 1;
+  case RuleField::PriceDropPercent:
+  case RuleField::IsWindowLow:
+    return 2;
+  default:
+    return 0;
+  }
+}
+
+bool compareNumber(double actual, const RuleInstruction &instruction) {
+  constexpr double kEpsilon = 0.005; // Percentages and flags
+  const double expected = instruction.number;
+  switch (instruction.op) {
+  case RuleOperator::Equals:
+    return std::abs(actual - expected) < kEpsilon;
+  case RuleOperator::NotEquals:
+    return std::abs(actual - expected) >= kEpsilon;
+  case RuleOperator::LessThan:
+    return actual < expected - kEpsilon;
+  case RuleOperator::LessOrEqual:
+    return actual < expected + kEpsilon;
+  case RuleOperator::GreaterThan:
+    return actual > expected + kEpsilon;
+  case RuleOperator::GreaterOrEqual:
+    return actual > expected - kEpsilon;
+  default:
+    return false;
+  }
+}
+
+bool compareMoney(domain::Money actual, const RuleInstruction &instruction) {
+  const domain::Money expected = instruction.money;
+  switch (instruction.op) {
+  case RuleOperator::Equals:
+    return actual == expected;
+  case RuleOperator::NotEquals:
+    return actual != expected;
+  case RuleOperator::LessThan:
+    return actual < expected;
+  case RuleOperator::LessOrEqual:
+    return actual <= expected;
+  case RuleOperator::GreaterThan:
+    return actual > expected;
+  case RuleOperator::GreaterOrEqual:
+    return actual >= expected;
+  default:
+    return false;
+  }
+}
+
+bool compareText(const std::string &actual, const RuleInstruction &instruction) {
+  const std::string lower = toLower(actual);
+  switch (instruction.op) {
+  case RuleOperator::Equals:
+    return lower == instruction.text;
+  case RuleOperator::NotEquals:
+    return lower != instruction.text;
+  case RuleOperator::Contains:
+    return lower.find(instruction.text) != std::string::npos;
+  default:
+    return false;
+  }
+}
+
+bool compareSymbol(domain::Symbol actual, const RuleInstruction &instruction) {
+  switch (instruction.op) {
+  case RuleOperator::Equals:
+    return actual.folded() == instruction.symbol;
+  case RuleOperator::NotEquals:
+    return actual.folded() != instruction.symbol;
+  case RuleOperator::Contains:
+    return actual.folded().str().find(instruction.text) != std::string::npos;
+  default:
+    return false;
+  }
+}
+
+template <typename Window>
+const std::optional<Window> *
+findWindow(const std::vector<std::pair<int, std::optional<Window>>> &windows,
+           int days) {
+  for (const auto &[window_days, window] : windows) {
+    if (window_days == days) {
+      return &window;
+    }
+  }
+  return nullptr;
+}
+
+} // anonymous namespace
+
+CompiledRule RuleEngine::compile(const domain::AlertRule &rule) {
+  CompiledRule compiled;
+  compiled.id = rule.id;
+  compiled.name = rule.name;
+  compiled.channels = rule.notify_via;
+
+  json conditions;
+  try {
+    conditions = json::parse(rule.conditions);
+  } catch (const json::parse_error &e) {
+    throw RuleCompileError(fmt::format("Conditions are not valid JSON: {}",
+                                       e.what()));
+  }
+
+  if (!conditions.is_array() || conditions.empty()) {
+    throw RuleCompileError("Conditions must be a non-empty array");
+  }
+
+  std::set<int> windows;
+  for (size_t i = 0; i < conditions.size(); ++i) {
+    const auto &condition = conditions[i];
+    const auto where = [i](std::string_view message) {
+      return RuleCompileError(fmt::format("Condition {}: {}", i + 1, message));
+    };
+
+    if (!condition.is_object() || !condition.contains("field") ||
+        !condition.contains("operator") || !condition.contains("value")) {
+      throw where("expected an object with field, operator and value");
+    }
+    if (!condition["field"].is_string() || !condition["operator"].is_string()) {
+      throw where("field and operator must be strings");
+    }
+
+    const auto field_name = condition["field"].get<std::string>();
+    const auto op_name = condition["operator"].get<std::string>();
+    const auto field = parseField(field_name);
+    if (!field) {
+      throw where(fmt::format("unknown field '{}'", field_name));
+    }
+    const auto op = parseOperator(op_name);
+    if (!op) {
+      throw where(fmt::format("unknown operator '{}'", op_name));
+    }
+
+    RuleInstruction instruction{*field, *op};
+    const auto &value = condition["value"];
+
+    switch (kindOf(*field)) {
+    case FieldKind::Number:
+      if (!value.is_number()) {
+        throw where(fmt::format("'{}' expects a number", field_name));
+      }
+      if (*op == RuleOperator::Contains) {
+        throw where("'contains' only applies to text fields");
+      }
+      instruction.number = value.get<double>();
+      instruction.money = domain::Money::fromEuros(instruction.number);
+      break;
+
+    case FieldKind::Boolean:
+      if (!value.is_boolean()) {
+        throw where(fmt::format("'{}' expects true or false", field_name));
+      }
+      if (*op != RuleOperator::Equals && *op != RuleOperator::NotEquals) {
+        throw where(fmt::format("'{}' only supports equals and not_equals",
+                                field_name));
+      }
+      instruction.number = value.get<bool>() ? 1.0 : 0.0;
+      break;
+
+    case FieldKind::Text:
+      if (!value.is_string()) {
+        throw where(fmt::format("'{}' expects a string", field_name));
+      }
+      if (*op != RuleOperator::Equals && *op != RuleOperator::NotEquals &&
+          *op != RuleOperator::Contains) {
+        throw where(fmt::format(
+            "'{}' only supports equals, not_equals and contains", field_name));
+      }
+      instruction.text = toLower(value.get<std::string>());
+      if (instruction.field == RuleField::Source) {
+        instruction.symbol = instruction.text;
+      }
+      break;
+
+    case FieldKind::Set:
+      if (!value.is_string()) {
+        throw where(fmt::format("'{}' expects a string", field_name));
+      }
+      if (*op != RuleOperator::Equals && *op != RuleOperator::NotEquals) {
+        throw where(fmt::format("'{}' only supports equals and not_equals",
+                                field_name));
+      }
+      if (*field == RuleField::Change) {
+        const auto type = domain::changeTypeFromString(value.get<std::string>());
+        if (!type || *type == domain::ChangeType::AlertRuleMatched) {
+          throw where(fmt::format("unknown change type '{}'",
+                                  value.get<std::string>()));
+        }
+        instruction.number = static_cast<double>(changeBit(*type));
+      } else {
+        // Resolve the tag once; renaming a tag keeps the rule working
+        infrastructure::repositories::SqliteTagRepository tag_repo;
+        const auto tag = tag_repo.findByName(value.get<std::string>());
+        if (!tag) {
+          throw where(
+              fmt::format("unknown tag '{}'", value.get<std::string>()));
+        }
+        instruction.number = tag->id;
+        compiled.uses_tags = true;
+      }
+      break;
+    }
+
+    if (*field == RuleField::IsAllTimeLow ||
+        *field == RuleField::BelowAveragePercent) {
+      compiled.uses_price_stats = true;
+    }
+
+    if (*field == RuleField::PriceDropPercent ||
+        *field == RuleField::IsWindowLow) {
+      instruction.window_days = *field == RuleField::PriceDropPercent
+                                    ? DEFAULT_DROP_WINDOW_DAYS
+                                    : DEFAULT_LOW_WINDOW_DAYS;
+      if (condition.contains("window_days")) {
+        if (!condition["window_days"].is_number_integer()) {
+          throw where("window_days must be an integer");
+        }
+        instruction.window_days = condition["window_days"].get<int>();
+      }
+      if (instruction.window_days < 1 ||
+          instruction.window_days > MAX_WINDOW_DAYS) {
+        throw where(
+            fmt::format("window_days must be between 1 and {}", MAX_WINDOW_DAYS));
+      }
+      windows.insert(instruction.window_days);
+      if (instruction.window_days <= domain::PriceStats::WINDOW_DAYS) {
+        compiled.uses_price_stats = true;
+      }
+    }
+
+    compiled.program.push_back(std::move(instruction));
+  }
+
+  std::stable_sort(compiled.program.begin(), compiled.program.end(),
+                   [](const RuleInstruction &a, const RuleInstruction &b) {
+                     return costOf(a.field) < costOf(b.field);
+                   });
+  compiled.window_days.assign(windows.begin(), windows.end());
+
+  return compiled;
+}
+
+void RuleEngine::load(const std::vector<domain::AlertRule> &rules) {
+  std::vector<CompiledRule> compiled;
+  compiled.reserve(rules.size());
+
+  for (const auto &rule : rules) {
+    if (!rule.enabled) {
+      continue;
+    }
+    try {
+      compiled.push_back(compile(rule));
+    } catch (const RuleCompileError &e) {
+      LOG_ERROR("Skipping alert rule {} '{}': {}", rule.id, rule.name,
+                e.what());
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  rules_ = std::move(compiled);
+
+  // Keep counters of rules that survive the reload
+  std::unordered_map<int, RuleStats> stats;
+  for (const auto &rule : rules_) {
+    auto &entry = stats[rule.id];
+    if (auto it = stats_.find(rule.id); it != stats_.end()) {
+      entry = it->second;
+    }
+    entry.rule_id = rule.id;
+    entry.name = rule.name;
+    entry.instructions = rule.program.size();
+  }
+  stats_ = std::move(stats);
+}
+
+bool RuleEngine::empty() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return rules_.empty();
+}
+
+std::vector<RuleMatch>
+RuleEngine::evaluate(const std::vector<domain::ChangeEvent> &changes) {
+  std::vector<RuleMatch> matched;
+
+  std::vector<CompiledRule> rules;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rules = rules_;
+  }
+  if (rules.empty() || changes.empty()) {
+    return matched;
+  }
+
+  // Collapse the run's changes to one entry per item, keeping the newest
+  // snapshot and the union of change types
+  struct ChangedItem {
+    const domain::ChangeEvent *latest{nullptr};
+    const domain::ChangeEvent *price_change{nullptr};
+    uint32_t changes{0};
+  };
+  std::unordered_map<int, ChangedItem> by_item;
+  std::vector<int> order;
+  for (const auto &change : changes) {
+    if (!change.item || change.type == domain::ChangeType::AlertRuleMatched) {
+      continue;
+    }
+    auto [it, inserted] = by_item.try_emplace(change.item->id);
+    if (inserted) {
+      order.push_back(change.item->id);
+    }
+    auto &entry = it->second;
+    if (!entry.latest || change.detected_at >= entry.latest->detected_at) {
+      entry.latest = &change;
+    }
+    if (change.old_price) {
+      entry.price_change = &change;
+    }
+    entry.changes |= changeBit(change.type);
+  }
+
+  std::vector<const domain::WishlistItem *> items;
+  items.reserve(order.size());
+  for (int id : order) {
+    items.push_back(by_item[id].latest->item.get());
+  }
+
+  std::vector<const CompiledRule *> rule_ptrs;
+  for (const auto &rule : rules) {
+    rule_ptrs.push_back(&rule);
+  }
+
+  auto facts = collectFacts(items, rule_ptrs);
+  for (size_t i = 0; i < facts.size(); ++i) {
+    facts[i].changes = by_item[order[i]].changes;
+  }
+
+  std::vector<RuleStats> run_stats;
+  run_stats.reserve(rules.size());
+
+  for (const auto &rule : rules) {
+    RuleStats stats;
+    stats.rule_id = rule.id;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < facts.size(); ++i) {
+      stats.evaluations++;
+      if (!matches(rule, facts[i])) {
+        continue;
+      }
+      stats.matches++;
+
+      const auto &changed = by_item[order[i]];
+      domain::ChangeEvent event{
+          .type = domain::ChangeType::AlertRuleMatched,
+          .item = changed.latest->item,
+          .detected_at = changed.latest->detected_at,
+          .rule_id = rule.id,
+          .rule_name = rule.name};
+      if (changed.price_change) {
+        event.old_price = changed.price_change->old_price;
+        event.new_price = changed.price_change->new_price;
+      }
+      matched.push_back({std::move(event), rule.channels});
+    }
+    stats.last_run_time = std::chrono::steady_clock::now() - start;
+    run_stats.push_back(std::move(stats));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto &run : run_stats) {
+    auto it = stats_.find(run.rule_id);
+    if (it == stats_.end()) {
+      continue; // Rule was reloaded away meanwhile
+    }
+    it->second.runs++;
+    it->second.evaluations += run.evaluations;
+    it->second.matches += run.matches;
+    it->second.total_time += run.last_run_time;
+    it->second.last_run_time = run.last_run_time;
+  }
+
+  return matched;
+}
+
+std::vector<int>
+RuleEngine::preview(const domain::AlertRule &rule,
+                    const std::vector<domain::WishlistItem> &items) {
+  const auto compiled = compile(rule);
+
+  std::vector<const domain::WishlistItem *> item_ptrs;
+  item_ptrs.reserve(items.size());
+  for (const auto &item : items) {
+    item_ptrs.push_back(&item);
+  }
+
+  auto facts = collectFacts(item_ptrs, {&compiled});
+
+  std::vector<int> ids;
+  for (auto &item_facts : facts) {
+    item_facts.changes = kAllChanges;
+    if (matches(compiled, item_facts)) {
+      ids.push_back(item_facts.item->id);
+    }
+  }
+  return ids;
+}
+
+std::vector<RuleStats> RuleEngine::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::vector<RuleStats> stats;
+  stats.reserve(rules_.size());
+  for (const auto &rule : rules_) {
+    if (auto it = stats_.find(rule.id); it != stats_.end()) {
+      stats.push_back(it->second);
+    }
+  }
+  return stats;
+}
+
+std::vector<RuleEngine::ItemFacts>
+RuleEngine::collectFacts(const std::vector<const domain::WishlistItem *> &items,
+                         const std::vector<const CompiledRule *> &rules) {
+  std::vector<ItemFacts> facts(items.size());
+  for (size_t i = 0; i < items.size(); ++i) {
+    facts[i].item = items[i];
+  }
+
+  std::set<int> windows;
+  bool uses_tags = false;
+  bool uses_price_stats = false;
+  for (const auto *rule : rules) {
+    windows.insert(rule->window_days.begin(), rule->window_days.end());
+    uses_tags = uses_tags || rule->uses_tags;
+    uses_price_stats = uses_price_stats || rule->uses_price_stats;
+  }
+
+  std::vector<int> ids;
+  if (uses_price_stats || !windows.empty()) {
+    ids.reserve(items.size());
+    for (const auto *item : items) {
+      ids.push_back(item->id);
+    }
+  }
+
+  if (uses_tags) {
+    infrastructure::repositories::SqliteTagRepository tag_repo;
+    auto tag_ids = tag_repo.getTagIdsByItem("wishlist");
+    for (auto &item_facts : facts) {
+      if (auto it = tag_ids.find(item_facts.item->id); it != tag_ids.end()) {
+        item_facts.tag_ids = std::move(it->second);
+      }
+    }
+  }
+
+  if (uses_price_stats) {
+    infrastructure::PriceStatsRepository stats_repo;
+    auto stats = stats_repo.find(ids);
+    for (auto &item_facts : facts) {
+      if (auto it = stats.find(item_facts.item->id); it != stats.end()) {
+        item_facts.price_stats = it->second;
+      }
+    }
+  }
+
+  // Windows the running statistics cover need no history query
+  const auto now = std::chrono::system_clock::now();
+  for (int days : windows) {
+    if (days > domain::PriceStats::WINDOW_DAYS) {
+      continue;
+    }
+    for (auto &item_facts : facts) {
+      std::optional<PriceWindow> window;
+      if (item_facts.price_stats) {
+        auto low = item_facts.price_stats->previousWindowLow(days, now);
+        auto high = item_facts.price_stats->previousWindowHigh(days, now);
+        if (low && high) {
+          window = PriceWindow{*low, *high};
+        }
+      }
+      item_facts.windows.emplace_back(days, window);
+    }
+  }
+
+  // One history query per longer window, shared by all rules
+  if (!windows.empty() && *windows.rbegin() > domain::PriceStats::WINDOW_DAYS) {
+    infrastructure::PriceHistoryRepository history_repo;
+    for (int days : windows) {
+      if (days <= domain::PriceStats::WINDOW_DAYS) {
+        continue;
+      }
+      auto aggregates = history_repo.getWindowAggregates(ids, days);
+      for (auto &item_facts : facts) {
+        std::optional<PriceWindow> window;
+        if (auto it = aggregates.find(item_facts.item->id);
+            it != aggregates.end()) {
+          window = PriceWindow{it->second.min_price, it->second.max_price};
+        }
+        item_facts.windows.emplace_back(days, window);
+      }
+    }
+  }
+
+  return facts;
+}
+
+bool RuleEngine::matches(const CompiledRule &rule, const ItemFacts &facts) {
+  for (const auto &instruction : rule.program) {
+    if (!execute(instruction, facts)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RuleEngine::execute(const RuleInstruction &instruction,
+                         const ItemFacts &facts) {
+  const auto &item = *facts.item;
+
+  switch (instruction.field) {
+  case RuleField::CurrentPrice:
+    return compareMoney(item.current_price, instruction);
+
+  case RuleField::DesiredMaxPrice:
+    return compareMoney(item.desired_max_price, instruction);
+
+  case RuleField::InStock:
+    return compareNumber(item.in_stock ? 1.0 : 0.0, instruction);
+
+  case RuleField::IsUhd4k:
+    return compareNumber(item.is_uhd_4k ? 1.0 : 0.0, instruction);
+
+  case RuleField::Source:
+    return compareSymbol(item.source, instruction);
+
+  case RuleField::Title:
+    return compareText(item.title, instruction);
+
+  case RuleField::Tag: {
+    const bool has_tag =
+        std::find(facts.tag_ids.begin(), facts.tag_ids.end(),
+                  static_cast<int>(instruction.number)) != facts.tag_ids.end();
+    return (instruction.op == RuleOperator::Equals) == has_tag;
+  }
+
+  case RuleField::Change: {
+    // Previews have no change context; treat change conditions as met
+    if (facts.changes == kAllChanges) {
+      return true;
+    }
+    const bool has_change =
+        (facts.changes & static_cast<uint32_t>(instruction.number)) != 0;
+    return (instruction.op == RuleOperator::Equals) == has_change;
+  }
+
+  case RuleField::PriceDropPercent: {
+    const auto *window = findWindow(facts.windows, instruction.window_days);
+    if (!window || !*window || !(*window)->max_price.isPositive() ||
+        !item.current_price.isPositive()) {
+      return false;
+    }
+    const int64_t max_cents = (*window)->max_price.cents();
+    const double drop =
+        static_cast<double>(max_cents - item.current_price.cents()) /
+        static_cast<double>(max_cents) * 100.0;
+    return compareNumber(drop, instruction);
+  }
+
+  case RuleField::IsWindowLow: {
+    const auto *window = findWindow(facts.windows, instruction.window_days);
+    // Without earlier prices there is nothing to be lower than
+    if (!window || !*window || !item.current_price.isPositive()) {
+      return false;
+    }
+    const bool is_low = item.current_price < (*window)->min_price;
+    return compareNumber(is_low ? 1.0 : 0.0, instruction);
+  }
+
+  case RuleField::IsAllTimeLow: {
+    // The statistics include the current price; compare with the earlier
+    // ones, as is_window_low does
+    const auto previous_low =
+        facts.price_stats ? facts.price_stats->previousLow() : std::nullopt;
+    if (!previous_low || !item.current_price.isPositive()) {
+      return false;
+    }
+    const bool is_low = item.current_price < *previous_low;
+    return compareNumber(is_low ? 1.0 : 0.0, instruction);
+  }
+
+  case RuleField::BelowAveragePercent: {
+    if (!facts.price_stats || !item.current_price.isPositive()) {
+      return false;
+    }
+    const int64_t average_cents = facts.price_stats->average().cents();
+    if (average_cents <= 0) {
+      return false;
+    }
+    const double below =
+        static_cast<double>(average_cents - item.current_price.cents()) /
+        static_cast<double>(average_cents) * 100.0;
+    return compareNumber(below, instruction);
+  }
+  }
+
+  return false;
+}
+
+} // namespace bluray::application::alerts
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "../../domain/models.hpp"
+#include "../../domain/price_stats.hpp"
+#include "../../infrastructure/repositories/price_history_repository.hpp"
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bluray::application::alerts {
+
+/**
+ * Thrown when a rule's conditions cannot be compiled
+ */
+class RuleCompileError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * Field a condition tests
+ */
+enum class RuleField : uint8_t {
+    CurrentPrice,
+    DesiredMaxPrice,
+    InStock,
+    IsUhd4k,
+    Source,
+    Title,
+    Tag,               // Item carries the tag
+    Change,            // Change of that type was detected this run
+    PriceDropPercent,  // Drop from the highest price within the window
+    IsWindowLow,       // Cheaper than every price within the window
+    IsAllTimeLow,      // At the lowest price ever recorded
+    BelowAveragePercent // Discount from the moving average price
+};
+
+enum class RuleOperator : uint8_t {
+    Equals,
+    NotEquals,
+    LessThan,
+    LessOrEqual,
+    GreaterThan,
+    GreaterOrEqual,
+    Contains
+};
+
+/**
+ * One compiled condition
+ * Operands are resolved at compile time: booleans, change types and tags
+ * become numbers, strings are lower-cased for case-insensitive matching and
+ * interned for symbol fields, which then compare by id.
+ */
+struct RuleInstruction {
+    RuleField field;
+    RuleOperator op;
+    double number{0.0};
+    domain::Money money;   // Number of price fields, in exact cents
+    std::string text;
+    domain::Symbol symbol; // Lower-cased text of symbol fields (source)
+    int window_days{0};
+};
+
+/**
+ * Rule compiled into a flat list of predicates, all of which must hold
+ * Instructions are ordered cheapest first so that evaluation
+ * short-circuits before touching tags or price history.
+ */
+struct CompiledRule {
+    int id{0};
+    std::string name;
+    std::vector<std::string> channels; // Empty = all channels
+    std::vector<RuleInstruction> program;
+    std::vector<int> window_days;      // Distinct price windows used
+    bool uses_tags{false};
+    bool uses_price_stats{false};
+};
+
+/**
+ * Evaluation cost and hit counters of one rule (per process)
+ */
+struct RuleStats {
+    int rule_id{0};
+    std::string name;
+    size_t instructions{0};
+    uint64_t runs{0};         // Batches the rule was evaluated in
+    uint64_t evaluations{0};  // Items evaluated
+    uint64_t matches{0};
+    std::chrono::nanoseconds total_time{0};
+    std::chrono::nanoseconds last_run_time{0};
+};
+
+/**
+ * Notification produced by a matching rule
+ */
+struct RuleMatch {
+    domain::ChangeEvent event;         // AlertRuleMatched
+    std::vector<std::string> channels; // Empty = all channels
+};
+
+/**
+ * Custom alert rule engine
+ *
+ * Rules are user-defined JSON condition lists, e.g.
+ *   [{"field": "price_drop_percent", "window_days": 7,
+ *     "operator": "greater_or_equal", "value": 20},
+ *    {"field": "is_uhd_4k", "operator": "equals", "value": true},
+ *    {"field": "tag", "operator": "equals", "value": "Criterion"}]
+ *
+ * Rules are parsed and compiled once per load. After a scrape run, all
+ * items that changed are evaluated against every rule in one batch; tags
+ * and price facts are fetched once per batch, not per rule. Price windows
+ * of up to domain::PriceStats::WINDOW_DAYS days come from the running price
+ * statistics; only longer ones read the price history.
+ *
+ * Fields: current_price, desired_max_price, in_stock, is_uhd_4k, source,
+ * title, tag, change, price_drop_percent and is_window_low (both with an
+ * optional window_days, default 7 and 90), is_all_time_low and
+ * below_average_percent (from the item's running price statistics). The
+ * window and all-time comparisons are against the prices recorded before
+ * the current one.
+ * Operators: equals, not_equals, less_than, less_or_equal, greater_than,
+ * greater_or_equal, contains.
+ */
+class RuleEngine {
+public:
+    /**
+     * Compile a rule
+     * @throws RuleCompileError if the conditions are invalid
+     */
+    static CompiledRule compile(const domain::AlertRule& rule);
+
+    /**
+     * Replace the active rule set, compiling each enabled rule
+     * Invalid rules are logged and skipped.
+     */
+    void load(const std::vector<domain::AlertRule>& rules);
+
+    /**
+     * Whether any rule is loaded
+     */
+    [[nodiscard]] bool empty() const;
+
+    /**
+     * Evaluate all rules against the changes of a run
+     * Each changed item is evaluated once per rule, with the union of its
+     * change types available to "change" conditions.
+     *
+     * @param changes Changes detected during the run
+     * @return One match per (rule, item)
+     */
+    std::vector<RuleMatch> evaluate(const std::vector<domain::ChangeEvent>& changes);
+
+    /**
+     * Items that currently satisfy a rule ("change" conditions are ignored)
+     * @return Matching wishlist item ids
+     * @throws RuleCompileError if the conditions are invalid
+     */
+    static std::vector<int> preview(const domain::AlertRule& rule,
+                                    const std::vector<domain::WishlistItem>& items);
+
+    /**
+     * Evaluation statistics of the loaded rules
+     */
+    [[nodiscard]] std::vector<RuleStats> getStats() const;
+
+private:
+    struct PriceWindow {
+        domain::Money min_price;
+        domain::Money max_price;
+    };
+
+    /**
+     * Inputs of one item, gathered once per batch
+     */
+    struct ItemFacts {
+        const domain::WishlistItem* item{nullptr};
+        uint32_t changes{0};  // Bit per domain::ChangeType; all bits = ignore
+        std::vector<int> tag_ids;
+        // Lowest and highest price per window (days), before the current one
+        std::vector<std::pair<int, std::optional<PriceWindow>>> windows;
+        std::optional<domain::PriceStats> price_stats;
+    };
+
+    static std::vector<ItemFacts> collectFacts(
+        const std::vector<const domain::WishlistItem*>& items,
+        const std::vector<const CompiledRule*>& rules);
+
+    static bool matches(const CompiledRule& rule, const ItemFacts& facts);
+    static bool execute(const RuleInstruction& instruction, const ItemFacts& facts);
+
+    mutable std::mutex mutex_;
+    std::vector<CompiledRule> rules_;
+    std::unordered_map<int, RuleStats> stats_;
+
+    static constexpr int DEFAULT_DROP_WINDOW_DAYS = 7;
+    static constexpr int DEFAULT_LOW_WINDOW_DAYS = 90;
+    static constexpr int MAX_WINDOW_DAYS = 365;
+};
+
+} // namespace bluray::application::alerts
@@ -1,15 +1,72 @@
 #include "tmdb_enrichment_service.hpp"
+#include "../event_bus.hpp"
 #include "../../infrastructure/repositories/wishlist_repository.hpp"
 #include "../../infrastructure/repositories/collection_repository.hpp"
+#include "../../infrastructure/config_manager.hpp"
 #include "../../infrastructure/logger.hpp"
 #include <fmt/format.h>
 #include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <future>
+#include <iomanip>
 #include <regex>
-#include <thread>
 #include <cctype>
+#include <sstream>
+#include <unordered_map>
 
 namespace bluray::application::enrichment {
 
+namespace {
+
+/**
+ * Format a time point as a UTC calendar date (YYYY-MM-DD), the granularity
+ * of TMDb's changes feed
+ */
+std::string toUtcDate(std::chrono::system_clock::time_point tp) {
+    const auto time_t = std::chrono::system_clock::to_time_t(tp);
+    std::tm tm{};
+    gmtime_r(&time_t, &tm);
+
+    std::ostringstream oss;
+    oss << std::put_time(&tm, "%Y-%m-%d");
+    return oss.str();
+}
+
+/**
+ * Parse a UTC calendar date (YYYY-MM-DD)
+ * @return Midnight UTC of that day or nullopt if malformed
+ */
+std::optional<std::chrono::system_clock::time_point> fromUtcDate(
+    const std::string& date
+) {
+    std::tm tm{};
+    std::istringstream iss(date);
+    iss >> std::get_time(&tm, "%Y-%m-%d");
+    if (iss.fail()) {
+        return std::nullopt;
+    }
+    return std::chrono::system_clock::from_time_t(timegm(&tm));
+}
+
+/**
+ * Announce saved TMDb metadata on the event bus
+ */
+template <typename Item>
+void publishMetadataUpdated(const char* item_type, const Item& item) {
+    EventBus::instance().publish(std::make_shared<const domain::MetadataUpdatedEvent>(
+        domain::MetadataUpdatedEvent{
+            .item_type = item_type,
+            .item_id = item.id,
+            .tmdb_id = item.tmdb_id,
+            .tmdb_rating = item.tmdb_rating,
+            .updated_at = std::chrono::system_clock::now()
+        }
+    ));
+}
+
+} // anonymous namespace
+
 // ============================================================================
 // TmdbMatchingStrategy Implementation
 // ============================================================================
@@ -36,10 +93,10 @@ std::optional<infrastructure::TmdbMovie> TmdbMatchingStrategy::findBestMatch(
             ? movie.release_date.substr(0, 4)
             : "????";
 
-        infrastructure::Logger::instance().debug(fmt::format(
+        LOG_DEBUG(
             "TMDb match candidate: '{}' ({}) - confidence: {:.2f}",
             movie.title, year_str, confidence
-        ));
+        );
     }
 
     // Sort by confidence (highest first)
@@ -52,19 +109,19 @@ std::optional<infrastructure::TmdbMovie> TmdbMatchingStrategy::findBestMatch(
     const auto& [best_confidence, best_movie] = scored_results[0];
 
     if (best_confidence < MIN_CONFIDENCE_THRESHOLD) {
-        infrastructure::Logger::instance().warning(fmt::format(
+        LOG_WARNING(
             "Best TMDb match '{}' has low confidence: {:.2f} (threshold: {:.2f})",
             best_movie->title, best_confidence, MIN_CONFIDENCE_THRESHOLD
-        ));
+        );
         return std::nullopt;
     }
 
-    infrastructure::Logger::instance().info(fmt::format(
+    LOG_INFO(
         "Selected TMDb match: '{}' ({}) with confidence {:.2f}",
         best_movie->title,
         best_movie->release_date.length() >= 4 ? best_movie->release_date.substr(0, 4) : "????",
         best_confidence
-    ));
+    );
 
     // Create a copy and set confidence score
     infrastructure::TmdbMovie result = *best_movie;
@@ -287,10 +344,7 @@ TmdbEnrichmentService::TmdbEnrichmentService(
 EnrichmentResult TmdbEnrichmentService::enrichWishlistItem(
     domain::WishlistItem& item
 ) {
-    infrastructure::Logger::instance().info(fmt::format(
-        "Enriching wishlist item {} ('{}')",
-        item.id, item.title
-    ));
+    LOG_INFO("Enriching wishlist item {} ('{}')", item.id, item.title);
 
     EnrichmentResult result;
 
@@ -309,15 +363,12 @@ EnrichmentResult TmdbEnrichmentService::enrichWishlistItem(
         item.tmdb_rating = result.tmdb_rating;
         item.trailer_key = result.trailer_key;
 
-        infrastructure::Logger::instance().info(fmt::format(
+        LOG_INFO(
             "Successfully enriched item {} with TMDb ID {} (confidence: {:.2f})",
             item.id, result.tmdb_id, result.confidence_score
-        ));
+        );
     } else {
-        infrastructure::Logger::instance().warning(fmt::format(
-            "Failed to enrich item {}: {}",
-            item.id, result.error_message
-        ));
+        LOG_WARNING("Failed to enrich item {}: {}", item.id, result.error_message);
     }
 
     return result;
@@ -326,10 +377,7 @@ EnrichmentResult TmdbEnrichmentService::enrichWishlistItem(
 EnrichmentResult TmdbEnrichmentService::enrichCollectionItem(
     domain::CollectionItem& item
 ) {
-    infrastructure::Logger::instance().info(fmt::format(
-        "Enriching collection item {} ('{}')",
-        item.id, item.title
-    ));
+    LOG_INFO("Enriching collection item {} ('{}')", item.id, item.title);
 
     EnrichmentResult result;
 
@@ -348,15 +396,12 @@ EnrichmentResult TmdbEnrichmentService::enrichCollectionItem(
         item.tmdb_rating = result.tmdb_rating;
         item.trailer_key = result.trailer_key;
 
-        infrastructure::Logger::instance().info(fmt::format(
+        LOG_INFO(
             "Successfully enriched collection item {} with TMDb ID {} (confidence: {:.2f})",
             item.id, result.tmdb_id, result.confidence_score
-        ));
+        );
     } else {
-        infrastructure::Logger::instance().warning(fmt::format(
-            "Failed to enrich collection item {}: {}",
-            item.id, result.error_message
-        ));
+        LOG_WARNING("Failed to enrich collection item {}: {}", item.id, result.error_message);
     }
 
     return result;
@@ -365,6 +410,68 @@ EnrichmentResult TmdbEnrichmentService::enrichCollectionItem(
 BulkEnrichmentProgress TmdbEnrichmentService::enrichMultipleWishlistItems(
     const std::vector<int>& item_ids,
     std::function<void(const BulkEnrichmentProgress&)> progress_callback
+) {
+    infrastructure::repositories::SqliteWishlistRepository repository;
+
+    return runBulkEnrichment(item_ids, "wishlist", [&](int item_id) {
+        // Load item from repository
+        auto item_opt = repository.findById(item_id);
+        if (!item_opt) {
+            LOG_WARNING("Wishlist item {} not found, skipping", item_id);
+            return BulkItemOutcome::NotFound;
+        }
+
+        auto item = *item_opt;
+        if (!enrichWishlistItem(item).success) {
+            return BulkItemOutcome::Failed;
+        }
+
+        // Save enriched item back to repository
+        if (!repository.update(item)) {
+            LOG_ERROR("Failed to save enriched wishlist item {}", item_id);
+            return BulkItemOutcome::Failed;
+        }
+
+        publishMetadataUpdated("wishlist", item);
+        return BulkItemOutcome::Enriched;
+    }, progress_callback);
+}
+
+BulkEnrichmentProgress TmdbEnrichmentService::enrichMultipleCollectionItems(
+    const std::vector<int>& item_ids,
+    std::function<void(const BulkEnrichmentProgress&)> progress_callback
+) {
+    infrastructure::repositories::SqliteCollectionRepository repository;
+
+    return runBulkEnrichment(item_ids, "collection", [&](int item_id) {
+        // Load item from repository
+        auto item_opt = repository.findById(item_id);
+        if (!item_opt) {
+            LOG_WARNING("Collection item {} not found, skipping", item_id);
+            return BulkItemOutcome::NotFound;
+        }
+
+        auto item = *item_opt;
+        if (!enrichCollectionItem(item).success) {
+            return BulkItemOutcome::Failed;
+        }
+
+        // Save enriched item back to repository
+        if (!repository.update(item)) {
+            LOG_ERROR("Failed to save enriched collection item {}", item_id);
+            return BulkItemOutcome::Failed;
+        }
+
+        publishMetadataUpdated("collection", item);
+        return BulkItemOutcome::Enriched;
+    }, progress_callback);
+}
+
+BulkEnrichmentProgress TmdbEnrichmentService::runBulkEnrichment(
+    const std::vector<int>& item_ids,
+    std::string_view item_kind,
+    const std::function<BulkItemOutcome(int)>& enrich_item,
+    const std::function<void(const BulkEnrichmentProgress&)>& progress_callback
 ) {
     // Acquire operation lock to ensure single bulk operation at a time
     std::lock_guard<std::mutex> op_lock(operation_mutex_);
@@ -377,213 +484,218 @@ BulkEnrichmentProgress TmdbEnrichmentService::enrichMultipleWishlistItems(
         bulk_progress_.is_active = true;
     }
 
-    infrastructure::Logger::instance().info(fmt::format(
-        "Starting bulk enrichment of {} wishlist items",
-        item_ids.size()
-    ));
+    LOG_INFO("Starting bulk enrichment of {} {} items", item_ids.size(), item_kind);
 
-    infrastructure::repositories::SqliteWishlistRepository repository;
+    // Workers pull the next item index until the list is exhausted. Each item
+    // costs several TMDb requests; running a few items at once hides request
+    // latency while the shared rate limiter keeps the overall pace in check.
+    std::atomic<size_t> next_index{0};
 
-    for (int item_id : item_ids) {
-        {
-            std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-            bulk_progress_.current_item_id = item_id;
-        }
+    auto worker = [&]() {
+        while (true) {
+            const size_t index = next_index++;
+            if (index >= item_ids.size()) {
+                return;
+            }
 
-        // Load item from repository
-        auto item_opt = repository.findById(item_id);
-        if (!item_opt) {
-            infrastructure::Logger::instance().warning(fmt::format(
-                "Wishlist item {} not found, skipping",
-                item_id
-            ));
-            
+            const int item_id = item_ids[index];
             {
                 std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-                bulk_progress_.failed++;
-                bulk_progress_.processed++;
-            }
-            
-            if (progress_callback) {
-                std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-                progress_callback(bulk_progress_);
+                bulk_progress_.current_item_id = item_id;
             }
-            continue;
-        }
-
-        auto item = *item_opt;
 
-        // Enrich item
-        EnrichmentResult result = enrichWishlistItem(item);
+            const BulkItemOutcome outcome = enrich_item(item_id);
 
-        {
             std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-            
-            if (result.success) {
-                // Save enriched item back to repository
-                if (repository.update(item)) {
-                    bulk_progress_.successful++;
-                } else {
-                    bulk_progress_.failed++;
-                    infrastructure::Logger::instance().error(fmt::format(
-                        "Failed to save enriched wishlist item {}",
-                        item_id
-                    ));
-                }
+            if (outcome == BulkItemOutcome::Enriched) {
+                bulk_progress_.successful++;
             } else {
                 bulk_progress_.failed++;
             }
-
             bulk_progress_.processed++;
-        }
 
-        // Call progress callback
-        if (progress_callback) {
-            std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-            progress_callback(bulk_progress_);
+            // Call progress callback
+            if (progress_callback) {
+                progress_callback(bulk_progress_);
+            }
         }
+    };
 
-        // Rate limiting delay (except for last item)
-        int processed_count;
-        int total_count;
-        {
-            std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-            processed_count = bulk_progress_.processed;
-            total_count = bulk_progress_.total;
-        }
-        
-        if (processed_count < total_count) {
-            sleepForRateLimit();
-        }
-    }
+    const int concurrency = std::clamp(
+        infrastructure::ConfigManager::instance().getInt(
+            "tmdb_bulk_concurrency", DEFAULT_BULK_CONCURRENCY),
+        1, 16);
+    const size_t worker_count =
+        std::min(static_cast<size_t>(concurrency), item_ids.size());
 
-    {
-        std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-        bulk_progress_.is_active = false;
+    std::vector<std::future<void>> workers;
+    workers.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers.push_back(std::async(std::launch::async, worker));
     }
+    for (auto& f : workers) {
+        f.wait();
+    }
+
+    std::lock_guard<std::mutex> prog_lock(progress_mutex_);
+    bulk_progress_.is_active = false;
 
-    infrastructure::Logger::instance().info(fmt::format(
+    LOG_INFO(
         "Bulk enrichment complete: {}/{} successful, {} failed",
         bulk_progress_.successful, bulk_progress_.total, bulk_progress_.failed
-    ));
+    );
 
-    std::lock_guard<std::mutex> prog_lock(progress_mutex_);
     return bulk_progress_;
 }
 
-BulkEnrichmentProgress TmdbEnrichmentService::enrichMultipleCollectionItems(
-    const std::vector<int>& item_ids,
-    std::function<void(const BulkEnrichmentProgress&)> progress_callback
-) {
-    // Acquire operation lock to ensure single bulk operation at a time
+TmdbRefreshSummary TmdbEnrichmentService::refreshChangedItems() {
+    TmdbRefreshSummary summary;
+
+    if (!client_->hasApiKey()) {
+        summary.error_message = "TMDb API key not configured";
+        return summary;
+    }
+
+    // Never overlap with a bulk run touching the same rows
     std::lock_guard<std::mutex> op_lock(operation_mutex_);
 
-    {
-        // Initialize progress (brief lock)
-        std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-        bulk_progress_ = BulkEnrichmentProgress{};
-        bulk_progress_.total = static_cast<int>(item_ids.size());
-        bulk_progress_.is_active = true;
+    auto& config = infrastructure::ConfigManager::instance();
+    const auto now = std::chrono::system_clock::now();
+    const auto oldest = now - std::chrono::hours(24 * MAX_CHANGES_WINDOW_DAYS);
+
+    // Resume from the last successful refresh; the feed is per day, so the
+    // boundary day is queried again, which is harmless
+    auto start = oldest;
+    if (auto last = fromUtcDate(config.get("tmdb_last_refresh", ""))) {
+        if (*last < oldest) {
+            LOG_WARNING(
+                "Last TMDb refresh is older than {} days; earlier changes are skipped",
+                MAX_CHANGES_WINDOW_DAYS
+            );
+        }
+        start = std::max(*last, oldest);
     }
 
-    infrastructure::Logger::instance().info(fmt::format(
-        "Starting bulk enrichment of {} collection items",
-        item_ids.size()
-    ));
+    summary.start_date = toUtcDate(start);
+    summary.end_date = toUtcDate(now);
 
-    infrastructure::repositories::SqliteCollectionRepository repository;
+    // Local index: tmdb_id -> items referencing it
+    struct TrackedItems {
+        std::vector<int> wishlist_ids;
+        std::vector<int> collection_ids;
+    };
+    std::unordered_map<int, TrackedItems> index;
 
-    for (int item_id : item_ids) {
-        {
-            std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-            bulk_progress_.current_item_id = item_id;
-        }
+    infrastructure::repositories::SqliteWishlistRepository wishlist_repo;
+    infrastructure::repositories::SqliteCollectionRepository collection_repo;
 
-        // Load item from repository
-        auto item_opt = repository.findById(item_id);
-        if (!item_opt) {
-            infrastructure::Logger::instance().warning(fmt::format(
-                "Collection item {} not found, skipping",
-                item_id
-            ));
-            
-            {
-                std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-                bulk_progress_.failed++;
-                bulk_progress_.processed++;
-            }
-            
-            if (progress_callback) {
-                std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-                progress_callback(bulk_progress_);
-            }
-            continue;
+    for (const auto& item : wishlist_repo.findAll()) {
+        if (item.tmdb_id > 0) {
+            index[item.tmdb_id].wishlist_ids.push_back(item.id);
+        }
+    }
+    for (const auto& item : collection_repo.findAll()) {
+        if (item.tmdb_id > 0) {
+            index[item.tmdb_id].collection_ids.push_back(item.id);
         }
+    }
 
-        auto item = *item_opt;
+    if (index.empty()) {
+        // Nothing enriched yet; still advance so the next run starts here
+        summary.success = true;
+        config.set("tmdb_last_refresh", summary.end_date);
+        return summary;
+    }
 
-        // Enrich item
-        EnrichmentResult result = enrichCollectionItem(item);
+    auto changed = client_->getChangedMovieIds(summary.start_date, summary.end_date);
+    if (!changed) {
+        summary.error_message = "Failed to read TMDb changes feed";
+        return summary;
+    }
+    summary.changed_movies = static_cast<int>(changed->size());
 
-        {
-            std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-            
-            if (result.success) {
-                // Save enriched item back to repository
-                if (repository.update(item)) {
-                    bulk_progress_.successful++;
-                } else {
-                    bulk_progress_.failed++;
-                    infrastructure::Logger::instance().error(fmt::format(
-                        "Failed to save enriched collection item {}",
-                        item_id
-                    ));
-                }
-            } else {
-                bulk_progress_.failed++;
-            }
+    LOG_INFO(
+        "TMDb changes {}..{}: {} movies changed, {} tracked locally",
+        summary.start_date, summary.end_date, changed->size(), index.size()
+    );
 
-            bulk_progress_.processed++;
+    // The feed may list a movie more than once across pages
+    std::sort(changed->begin(), changed->end());
+    changed->erase(std::unique(changed->begin(), changed->end()), changed->end());
+
+    for (int tmdb_id : *changed) {
+        auto it = index.find(tmdb_id);
+        if (it == index.end()) {
+            continue;
         }
+        summary.matched_movies++;
 
-        // Call progress callback
-        if (progress_callback) {
-            std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-            progress_callback(bulk_progress_);
+        auto movie = client_->getMovieDetails(tmdb_id);
+        if (!movie) {
+            summary.failed++;
+            continue;
         }
+        const auto trailer_key = getBestTrailer(tmdb_id);
+
+        // Reload each row right before saving so concurrent price updates
+        // from the scraper are not overwritten
+        auto apply = [&](auto& item) {
+            item.tmdb_rating = movie->vote_average;
+            if (!movie->imdb_id.empty()) {
+                item.imdb_id = movie->imdb_id;
+            }
+            if (trailer_key) {
+                item.trailer_key = *trailer_key;
+            }
+        };
 
-        // Rate limiting delay (except for last item)
-        int processed_count;
-        int total_count;
-        {
-            std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-            processed_count = bulk_progress_.processed;
-            total_count = bulk_progress_.total;
+        for (int id : it->second.wishlist_ids) {
+            auto item = wishlist_repo.findById(id);
+            if (!item || item->tmdb_id != tmdb_id) {
+                continue;
+            }
+            apply(*item);
+            if (wishlist_repo.update(*item)) {
+                summary.refreshed_items++;
+                publishMetadataUpdated("wishlist", *item);
+            }
         }
-        
-        if (processed_count < total_count) {
-            sleepForRateLimit();
+        for (int id : it->second.collection_ids) {
+            auto item = collection_repo.findById(id);
+            if (!item || item->tmdb_id != tmdb_id) {
+                continue;
+            }
+            apply(*item);
+            if (collection_repo.update(*item)) {
+                summary.refreshed_items++;
+                publishMetadataUpdated("collection", *item);
+            }
         }
     }
 
-    {
-        std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-        bulk_progress_.is_active = false;
+    // Only advance past this range when every tracked change was applied,
+    // otherwise the next run picks the failed movies up again
+    if (summary.failed == 0) {
+        config.set("tmdb_last_refresh", summary.end_date);
     }
+    summary.success = true;
 
-    infrastructure::Logger::instance().info(fmt::format(
-        "Bulk enrichment complete: {}/{} successful, {} failed",
-        bulk_progress_.successful, bulk_progress_.total, bulk_progress_.failed
-    ));
+    LOG_INFO(
+        "TMDb refresh complete: {} movies matched, {} items updated, {} failed",
+        summary.matched_movies, summary.refreshed_items, summary.failed
+    );
 
-    std::lock_guard<std::mutex> prog_lock(progress_mutex_);
-    return bulk_progress_;
+    return summary;
 }
 
 bool TmdbEnrichmentService::isEnabled() const {
     return client_->hasApiKey();
 }
 
+void TmdbEnrichmentService::setApiKey(std::string_view api_key) {
+    client_->setApiKey(api_key);
+}
+
 BulkEnrichmentProgress TmdbEnrichmentService::getCurrentProgress() const {
     std::lock_guard<std::mutex> lock(progress_mutex_);
     return bulk_progress_;
@@ -600,10 +712,10 @@ EnrichmentResult TmdbEnrichmentService::enrichByTitle(std::string_view title) {
     // Extract year from title if present
     int year_hint = TmdbMatchingStrategy::extractYearFromTitle(title);
 
-    infrastructure::Logger::instance().debug(fmt::format(
+    LOG_DEBUG(
         "Searching TMDb for '{}' (year hint: {})",
         title, year_hint > 0 ? std::to_string(year_hint) : "none"
-    ));
+    );
 
     // Search TMDb
     auto search_result = client_->searchMovie(title, year_hint);
@@ -666,10 +778,7 @@ EnrichmentResult TmdbEnrichmentService::enrichByImdbId(std::string_view imdb_id)
         return result;
     }
 
-    infrastructure::Logger::instance().debug(fmt::format(
-        "Searching TMDb by IMDb ID '{}'",
-        imdb_id
-    ));
+    LOG_DEBUG("Searching TMDb by IMDb ID '{}'", imdb_id);
 
     // Find by IMDb ID
     auto movie = client_->findByImdbId(imdb_id);
@@ -731,11 +840,11 @@ std::optional<std::string> TmdbEnrichmentService::getBestTrailer(int tmdb_id) {
             }
 
             if (video.type == type && video.official == is_official) {
-                infrastructure::Logger::instance().debug(fmt::format(
+                LOG_DEBUG(
                     "Selected {} trailer: '{}' (key: {})",
                     video.official ? "official" : "non-official",
                     video.name, video.key
-                ));
+                );
                 return video.key;
             }
         }
@@ -744,10 +853,7 @@ std::optional<std::string> TmdbEnrichmentService::getBestTrailer(int tmdb_id) {
     // Fallback: return first YouTube video
     for (const auto& video : videos) {
         if (video.site == "YouTube" && !video.key.empty()) {
-            infrastructure::Logger::instance().debug(fmt::format(
-                "Selected fallback video: '{}' (key: {})",
-                video.name, video.key
-            ));
+            LOG_DEBUG("Selected fallback video: '{}' (key: {})", video.name, video.key);
             return video.key;
         }
     }
@@ -755,10 +861,4 @@ std::optional<std::string> TmdbEnrichmentService::getBestTrailer(int tmdb_id) {
     return std::nullopt;
 }
 
-void TmdbEnrichmentService::sleepForRateLimit() {
-    // Conservative delay: 250ms per request
-    // This allows 240 requests per minute, well under TMDb's 40 req/10 sec limit
-    std::this_thread::sleep_for(std::chrono::milliseconds(250));
-}
-
 } // namespace bluray::application::enrichment
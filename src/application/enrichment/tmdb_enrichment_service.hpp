@@ -40,6 +40,20 @@ struct BulkEnrichmentProgress {
     int current_item_id{0};
 };
 
+/**
+ * Summary of an incremental refresh driven by the TMDb changes feed
+ */
+struct TmdbRefreshSummary {
+    bool success{false};
+    std::string start_date;     // Feed range queried (YYYY-MM-DD, UTC)
+    std::string end_date;
+    int changed_movies{0};      // Movies listed in the changes feed
+    int matched_movies{0};      // ... of which we track locally
+    int refreshed_items{0};     // Wishlist/collection rows updated
+    int failed{0};              // Matched movies that could not be re-fetched
+    std::string error_message;
+};
+
 /**
  * Strategy class for matching TMDb search results to original titles
  */
@@ -121,6 +135,9 @@ private:
  *
  * Supports both single-item and bulk enrichment operations.
  * Bulk operations automatically handle rate limiting with progress callbacks.
+ *
+ * A single instance is meant to be shared process-wide (see main.cpp), so
+ * that bulk progress is observable from any request handler.
  */
 class TmdbEnrichmentService {
 public:
@@ -160,7 +177,8 @@ public:
     /**
      * Bulk enrich multiple wishlist items
      *
-     * Processes items sequentially with automatic rate limiting delays (250ms).
+     * Processes items on a small worker pool; request pacing is left to the
+     * process-wide TMDb rate limiter, so no fixed per-item delay is needed.
      * Progress callback is invoked after each item is processed.
      *
      * @param item_ids Vector of wishlist item IDs to enrich
@@ -184,12 +202,31 @@ public:
         std::function<void(const BulkEnrichmentProgress&)> progress_callback = nullptr
     );
 
+    /**
+     * Refresh ratings and trailers of already-enriched items that changed
+     * on TMDb since the last refresh
+     *
+     * Reads the /movie/changes feed from the stored tmdb_last_refresh date
+     * (at most MAX_CHANGES_WINDOW_DAYS back) up to today, intersects it with
+     * an index of the tmdb_ids we track, and re-fetches only those movies.
+     * Each changed movie is fetched once, however many items reference it.
+     *
+     * @return Refresh summary
+     */
+    TmdbRefreshSummary refreshChangedItems();
+
     /**
      * Check if TMDb enrichment is enabled
      * @return true if API key is configured
      */
     bool isEnabled() const;
 
+    /**
+     * Update the TMDb API key used by the shared client
+     * @param api_key TMDb API v3 key
+     */
+    void setApiKey(std::string_view api_key);
+
     /**
      * Get current bulk enrichment progress
      * @return BulkEnrichmentProgress struct
@@ -197,6 +234,28 @@ public:
     BulkEnrichmentProgress getCurrentProgress() const;
 
 private:
+    /**
+     * Outcome of enriching a single item during a bulk run
+     */
+    enum class BulkItemOutcome { NotFound, Enriched, Failed };
+
+    /**
+     * Shared bulk driver: runs enrich_item over item_ids on a worker pool
+     * and keeps bulk_progress_ up to date
+     *
+     * @param item_ids Item IDs to process
+     * @param item_kind Human-readable item kind for logging
+     * @param enrich_item Loads, enriches and saves one item
+     * @param progress_callback Optional callback for progress updates
+     * @return Final bulk enrichment progress
+     */
+    BulkEnrichmentProgress runBulkEnrichment(
+        const std::vector<int>& item_ids,
+        std::string_view item_kind,
+        const std::function<BulkItemOutcome(int)>& enrich_item,
+        const std::function<void(const BulkEnrichmentProgress&)>& progress_callback
+    );
+
     /**
      * Core enrichment logic by title search
      * @param title Movie title to search
@@ -220,11 +279,11 @@ private:
      */
     std::optional<std::string> getBestTrailer(int tmdb_id);
 
-    /**
-     * Sleep for rate limiting between bulk operations
-     * Conservative delay: 250ms per request (240 requests per minute)
-     */
-    void sleepForRateLimit();
+    // Default number of items enriched concurrently during bulk runs
+    static constexpr int DEFAULT_BULK_CONCURRENCY = 4;
+
+    // Longest date range TMDb accepts for the changes feed
+    static constexpr int MAX_CHANGES_WINDOW_DAYS = 14;
 
     std::unique_ptr<infrastructure::TmdbClient> client_;
     BulkEnrichmentProgress bulk_progress_;
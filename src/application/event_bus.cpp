@@ -0,0 +1,164 @@
+#include "event_bus.hpp"
+#include "../infrastructure/logger.hpp"
+#include <algorithm>
+#include <fmt/format.h>
+
+namespace bluray::application {
+
+EventBus &EventBus::instance() {
+  static EventBus instance;
+  return instance;
+}
+
+EventBus::EventBus() { worker_ = std::thread(&EventBus::run, this); }
+
+EventBus::~EventBus() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  work_cv_.notify_all();
+
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+EventBus::SubscriptionId EventBus::addSubscriber(std::type_index type,
+                                                 Handler handler) {
+  auto subscriber = std::make_shared<Subscriber>();
+  subscriber->handler = std::move(handler);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  subscriber->id = next_id_++;
+
+  auto list = std::make_shared<SubscriberList>();
+  if (auto it = subscribers_.find(type); it != subscribers_.end()) {
+    *list = *it->second;
+  }
+  list->push_back(subscriber);
+  subscribers_[type] = std::move(list);
+  metrics_.subscribers++;
+
+  return subscriber->id;
+}
+
+void EventBus::unsubscribe(SubscriptionId id) {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  bool found = false;
+  for (auto &[type, list] : subscribers_) {
+    auto it = std::find_if(list->begin(), list->end(),
+                           [id](const auto &s) { return s->id == id; });
+    if (it == list->end()) {
+      continue;
+    }
+
+    // Events already queued still reference the old list
+    (*it)->active = false;
+
+    auto updated = std::make_shared<SubscriberList>(*list);
+    updated->erase(updated->begin() + (it - list->begin()));
+    list = std::move(updated);
+    found = true;
+    break;
+  }
+
+  if (!found) {
+    return;
+  }
+  metrics_.subscribers--;
+
+  // A delivery in progress may have seen the subscriber as active; wait for
+  // it so the caller can safely destroy whatever the handler captured
+  if (std::this_thread::get_id() != worker_.get_id()) {
+    const uint64_t target = started_deliveries_;
+    delivered_cv_.wait(lock, [&] { return finished_deliveries_ >= target; });
+  }
+}
+
+void EventBus::enqueue(std::type_index type,
+                       std::shared_ptr<const void> event) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    metrics_.published++;
+
+    auto it = subscribers_.find(type);
+    if (it == subscribers_.end() || it->second->empty()) {
+      return;
+    }
+
+    if (queue_.size() >= MAX_QUEUE_SIZE) {
+      metrics_.dropped++;
+      if (!overflowing_) {
+        overflowing_ = true;
+        LOG_WARNING("Event bus queue full ({} events), dropping events",
+                    queue_.size());
+      }
+      return;
+    }
+
+    queue_.push_back({std::move(event), it->second});
+    metrics_.max_queue_depth =
+        std::max(metrics_.max_queue_depth, queue_.size());
+  }
+  work_cv_.notify_one();
+}
+
+EventBus::Metrics EventBus::getMetrics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Metrics snapshot = metrics_;
+  snapshot.queue_depth = queue_.size();
+  return snapshot;
+}
+
+void EventBus::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    work_cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+
+    // Deliver what is left before stopping
+    if (queue_.empty()) {
+      break;
+    }
+
+    Pending pending = std::move(queue_.front());
+    queue_.pop_front();
+    if (queue_.empty()) {
+      overflowing_ = false;
+    }
+    started_deliveries_++;
+    lock.unlock();
+
+    uint64_t delivered = 0;
+    uint64_t errors = 0;
+    for (const auto &subscriber : *pending.subscribers) {
+      if (!subscriber->active) {
+        continue;
+      }
+      try {
+        subscriber->handler(pending.event);
+        delivered++;
+      } catch (const std::exception &e) {
+        errors++;
+        LOG_ERROR("Event subscriber {} failed: {}", subscriber->id, e.what());
+      } catch (...) {
+        errors++;
+        LOG_ERROR("Event subscriber {} failed with unknown error",
+                  subscriber->id);
+      }
+    }
+
+    // Release the event before reporting completion
+    pending = Pending{};
+
+    lock.lock();
+    metrics_.delivered += delivered;
+    metrics_.handler_errors += errors;
+    finished_deliveries_++;
+    delivered_cv_.notify_all();
+  }
+}
+
+} // namespace bluray::application
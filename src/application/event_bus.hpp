@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace bluray::application {
+
+/**
+ * In-process domain event bus (Singleton pattern)
+ *
+ * Producers (scraper, enrichment, calendar) publish immutable events held by
+ * shared_ptr; every subscriber of that event type receives the same
+ * instance, so a publish never copies the event. Delivery happens on the
+ * bus thread in publish order, which keeps slow subscribers (WebSocket
+ * broadcast, metrics) off the producer's thread.
+ *
+ * Subscribers must not block for long: they share a single delivery thread.
+ * Durable consumers (notifiers) keep using the notification outbox.
+ */
+class EventBus {
+public:
+    using SubscriptionId = uint64_t;
+
+    /**
+     * Delivery metrics snapshot
+     */
+    struct Metrics {
+        size_t queue_depth{0};        // Published events not yet delivered
+        size_t max_queue_depth{0};
+        size_t subscribers{0};
+        uint64_t published{0};
+        uint64_t delivered{0};        // Handler invocations
+        uint64_t dropped{0};          // Events rejected because the queue was full
+        uint64_t handler_errors{0};   // Handlers that threw
+    };
+
+    static EventBus& instance();
+
+    // Prevent copying
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    /**
+     * Subscribe to events of one type
+     * @param handler Invoked on the bus thread for each published event
+     * @return Id for unsubscribe()
+     */
+    template <typename Event>
+    SubscriptionId subscribe(
+        std::function<void(const std::shared_ptr<const Event>&)> handler) {
+        return addSubscriber(
+            std::type_index(typeid(Event)),
+            [handler = std::move(handler)](const std::shared_ptr<const void>& event) {
+                handler(std::static_pointer_cast<const Event>(event));
+            });
+    }
+
+    /**
+     * Remove a subscription
+     * Once this returns the handler is not running and will not be called
+     * again (unless called from within a handler on the bus thread).
+     */
+    void unsubscribe(SubscriptionId id);
+
+    /**
+     * Publish an event to all current subscribers of its type
+     * Does not wait for delivery.
+     */
+    template <typename Event>
+    void publish(std::shared_ptr<const Event> event) {
+        if (event) {
+            enqueue(std::type_index(typeid(Event)), std::move(event));
+        }
+    }
+
+    /**
+     * Get metrics snapshot
+     */
+    [[nodiscard]] Metrics getMetrics() const;
+
+private:
+    using Handler = std::function<void(const std::shared_ptr<const void>&)>;
+
+    struct Subscriber {
+        SubscriptionId id;
+        Handler handler;
+        std::atomic<bool> active{true};
+    };
+
+    // Copy-on-write so deliveries can iterate without holding the lock
+    using SubscriberList = std::vector<std::shared_ptr<Subscriber>>;
+
+    struct Pending {
+        std::shared_ptr<const void> event;
+        std::shared_ptr<const SubscriberList> subscribers;
+    };
+
+    EventBus();
+    ~EventBus();
+
+    SubscriptionId addSubscriber(std::type_index type, Handler handler);
+    void enqueue(std::type_index type, std::shared_ptr<const void> event);
+    void run();
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;      // Signals new events / shutdown
+    std::condition_variable delivered_cv_; // Signals a finished delivery
+    std::unordered_map<std::type_index, std::shared_ptr<const SubscriberList>>
+        subscribers_;
+    std::deque<Pending> queue_;
+    SubscriptionId next_id_{1};
+    uint64_t started_deliveries_{0};
+    uint64_t finished_deliveries_{0};
+    bool overflowing_{false};
+    bool stopping_{false};
+
+    Metrics metrics_;
+
+    std::thread worker_;
+
+    // Events held before publishers start losing them
+    static constexpr size_t MAX_QUEUE_SIZE = 10000;
+};
+
+} // namespace bluray::application
@@ -0,0 +1,191 @@
+#include "duplicate_detector.hpp"
+#include "../../infrastructure/config_manager.hpp"
+#include "../../infrastructure/logger.hpp"
+#include "../../infrastructure/repositories/catalog_repository.hpp"
+#include <map>
+
+namespace bluray::application::matching {
+
+DuplicateDetector &DuplicateDetector::instance() {
+  static DuplicateDetector instance;
+  return instance;
+}
+
+double DuplicateDetector::minSimilarity() {
+  return infrastructure::ConfigManager::instance().getDouble(
+      "duplicate_min_similarity", DEFAULT_MIN_SIMILARITY);
+}
+
+DuplicateIndex DuplicateDetector::buildIndex() {
+  const auto entries = infrastructure::CatalogRepository().findAll();
+  DuplicateIndex index;
+  index.reserve(entries.size());
+  for (const auto &entry : entries) {
+    index.upsert(entry);
+  }
+  return index;
+}
+
+void DuplicateDetector::ensureBuilt() {
+  const uint64_t generation = generation_.load();
+  if (built_ && built_generation_ == generation) {
+    return;
+  }
+
+  const auto started = std::chrono::steady_clock::now();
+  index_ = buildIndex();
+  built_ = true;
+  built_generation_ = generation;
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - started);
+  LOG_DEBUG({{"items", index_.size()}, {"duration_ms", elapsed.count()}},
+            "Duplicate index built");
+}
+
+std::vector<domain::DuplicateMatch>
+DuplicateDetector::add(const domain::CatalogEntry &entry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ensureBuilt(); // May already hold the entry; find() skips it
+  auto matches = index_.find(entry, minSimilarity());
+  index_.upsert(entry);
+  ++edits_;
+
+  if (!matches.empty()) {
+    LOG_INFO({{"item_type", entry.item_type},
+              {"item_id", entry.id},
+              {"duplicates", matches.size()}},
+             "Added item '{}' is probably a duplicate", entry.title);
+  }
+  return matches;
+}
+
+std::vector<domain::DuplicateMatch>
+DuplicateDetector::check(const domain::CatalogEntry &entry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ensureBuilt();
+  return index_.find(entry, minSimilarity());
+}
+
+void DuplicateDetector::update(const domain::CatalogEntry &entry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (built_) {
+    // A stale index is rebuilt from the database, edit included
+    index_.upsert(entry);
+    ++edits_;
+  }
+}
+
+void DuplicateDetector::remove(const std::string &item_type, int id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (built_) {
+    index_.remove(item_type, id);
+    ++edits_;
+  }
+}
+
+void DuplicateDetector::invalidate() { ++generation_; }
+
+void DuplicateDetector::apply(const std::vector<domain::DataChange> &changes) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!built_) {
+      return; // Built from the database, changes included, on first use
+    }
+  }
+
+  // Latest operation per row
+  std::map<std::pair<std::string, int64_t>, std::string> rows;
+  for (const auto &change : changes) {
+    if (change.table == "wishlist" || change.table == "collection") {
+      rows[{change.table, change.row_id}] = change.operation;
+    }
+  }
+  if (rows.empty()) {
+    return;
+  }
+  if (rows.size() > MAX_APPLIED_CHANGES) {
+    invalidate();
+    return;
+  }
+
+  // Read without mutex_ so that adds are not held up
+  infrastructure::CatalogRepository repo;
+  std::vector<domain::CatalogEntry> updated;
+  std::vector<std::pair<std::string, int>> removed;
+  for (const auto &[row, operation] : rows) {
+    const auto id = static_cast<int>(row.second);
+    std::optional<domain::CatalogEntry> entry;
+    if (operation != "delete") {
+      entry = repo.find(row.first, id);
+    }
+    if (entry) {
+      updated.push_back(std::move(*entry));
+    } else {
+      removed.emplace_back(row.first, id);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto &entry : updated) {
+    index_.upsert(entry);
+  }
+  for (const auto &[item_type, id] : removed) {
+    index_.remove(item_type, id);
+  }
+  ++edits_;
+}
+
+bool DuplicateDetector::beginScan() {
+  bool idle = false;
+  return scanning_.compare_exchange_strong(idle, true);
+}
+
+DuplicateReport DuplicateDetector::scan() {
+  // Free the slot however the scan ends
+  struct ScanSlot {
+    std::atomic<bool> &scanning;
+    ~ScanSlot() { scanning = false; }
+  } slot{scanning_};
+
+  uint64_t generation;
+  uint64_t edits;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation = generation_.load();
+    edits = edits_;
+  }
+
+  // Built outside the lock so that adds are not held up by a long scan
+  const auto started = std::chrono::steady_clock::now();
+  DuplicateIndex index = buildIndex();
+
+  DuplicateReport report;
+  report.groups = index.groups(minSimilarity());
+  report.items = index.size();
+  report.generated_at = std::chrono::system_clock::now();
+  report.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - started);
+
+  LOG_INFO({{"items", report.items},
+            {"groups", report.groups.size()},
+            {"duration_ms", report.duration.count()}},
+           "Duplicate scan complete");
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Keep the fresh index unless the live one moved on meanwhile
+  if (edits_ == edits && generation_.load() == generation) {
+    index_ = std::move(index);
+    built_ = true;
+    built_generation_ = generation;
+  }
+  last_report_ = report;
+  return report;
+}
+
+std::optional<DuplicateReport> DuplicateDetector::lastReport() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return last_report_;
+}
+
+} // namespace bluray::application::matching
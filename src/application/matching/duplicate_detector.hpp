@@ -0,0 +1,127 @@
+#pragma once
+
+#include "../../domain/models.hpp"
+#include "duplicate_index.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace bluray::application::matching {
+
+/**
+ * Full-catalog duplicate scan result
+ */
+struct DuplicateReport {
+  std::vector<domain::DuplicateGroup> groups;
+  size_t items{0}; // Wishlist and collection items scanned
+  std::chrono::system_clock::time_point generated_at;
+  std::chrono::milliseconds duration{0};
+};
+
+/**
+ * Flags wishlist and collection items that are probably the same disc
+ * (Singleton pattern)
+ *
+ * Keeps a DuplicateIndex of the whole catalog in memory, built with one
+ * read on first use. The web frontend keeps it current as it adds, edits
+ * and removes items, and writes by other processes (reported by ChangeFeed)
+ * are applied row by row.
+ */
+class DuplicateDetector {
+public:
+  static DuplicateDetector &instance();
+
+  // Prevent copying
+  DuplicateDetector(const DuplicateDetector &) = delete;
+  DuplicateDetector &operator=(const DuplicateDetector &) = delete;
+
+  /**
+   * Index a newly added item
+   * @return Items it probably duplicates, most similar first
+   */
+  std::vector<domain::DuplicateMatch> add(const domain::CatalogEntry &entry);
+
+  /**
+   * Probable duplicates of an item, without indexing it
+   */
+  std::vector<domain::DuplicateMatch> check(const domain::CatalogEntry &entry);
+
+  /**
+   * Re-index an edited item
+   */
+  void update(const domain::CatalogEntry &entry);
+
+  /**
+   * Forget a deleted item
+   */
+  void remove(const std::string &item_type, int id);
+
+  /**
+   * Rebuild on the next use
+   */
+  void invalidate();
+
+  /**
+   * Follow writes by other processes: re-read the changed wishlist and
+   * collection rows, or rebuild on the next use if there are many
+   */
+  void apply(const std::vector<domain::DataChange> &changes);
+
+  /**
+   * Claim the scan slot; one full scan runs at a time
+   * @return false if a scan is already in flight
+   */
+  bool beginScan();
+
+  /**
+   * Rebuild the index from the database and group every probable
+   * duplicate; the result is kept as lastReport()
+   * Call after a successful beginScan(); releases the slot.
+   */
+  DuplicateReport scan();
+
+  /**
+   * Whether a scan is in flight
+   */
+  [[nodiscard]] bool scanning() const { return scanning_.load(); }
+
+  std::optional<DuplicateReport> lastReport();
+
+  // Trigram similarity two titles need to count as the same film
+  static constexpr double DEFAULT_MIN_SIMILARITY = 0.8;
+
+  // More changed rows than this are cheaper to pick up with a rebuild
+  static constexpr size_t MAX_APPLIED_CHANGES = 5000;
+
+private:
+  DuplicateDetector() = default;
+
+  /**
+   * Rebuild the index if stale; caller holds mutex_
+   */
+  void ensureBuilt();
+
+  static DuplicateIndex buildIndex();
+
+  static double minSimilarity();
+
+  std::mutex mutex_;
+  DuplicateIndex index_;
+  bool built_{false};
+  uint64_t built_generation_{0};
+  uint64_t edits_{0}; // Changes made to index_ in place, see scan()
+  std::optional<DuplicateReport> last_report_;
+
+  // Bumped by invalidate(); atomic so the change feed never waits on a
+  // rebuild
+  std::atomic<uint64_t> generation_{0};
+
+  // Set from beginScan() until the scan finishes
+  std::atomic<bool> scanning_{false};
+};
+
+} // namespace bluray::application::matching
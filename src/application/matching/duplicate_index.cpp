@@ -0,0 +1,314 @@
+#include "duplicate_index.hpp"
+#include "title_index.hpp"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace bluray::application::matching {
+
+namespace {
+
+uint64_t mix64(uint64_t x) {
+  // splitmix64 finalizer
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+// Multiply-shift hash family: h_i(x) = (a_i * mix64(x) + b_i) >> 32, with
+// fixed seeds so that signatures are stable between runs
+struct HashFamily {
+  std::array<uint64_t, DuplicateIndex::SIGNATURE_SIZE> multipliers;
+  std::array<uint64_t, DuplicateIndex::SIGNATURE_SIZE> increments;
+
+  HashFamily() {
+    uint64_t state = 0x6d696e68617368ULL;
+    for (size_t i = 0; i < DuplicateIndex::SIGNATURE_SIZE; ++i) {
+      multipliers[i] = mix64(state += 0x9e3779b97f4a7c15ULL) | 1;
+      increments[i] = mix64(state += 0x9e3779b97f4a7c15ULL);
+    }
+  }
+};
+
+const HashFamily &hashFamily() {
+  static const HashFamily family;
+  return family;
+}
+
+// Jaccard similarity of two sorted sets
+double jaccard(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b) {
+  if (a.empty() || b.empty()) {
+    return 0.0;
+  }
+  size_t shared = 0;
+  auto ia = a.begin();
+  auto ib = b.begin();
+  while (ia != a.end() && ib != b.end()) {
+    if (*ia < *ib) {
+      ++ia;
+    } else if (*ib < *ia) {
+      ++ib;
+    } else {
+      ++shared;
+      ++ia;
+      ++ib;
+    }
+  }
+  return static_cast<double>(shared) /
+         static_cast<double>(a.size() + b.size() - shared);
+}
+
+// Union-find root with path halving
+uint32_t findRoot(std::vector<uint32_t> &parent, uint32_t slot) {
+  while (parent[slot] != slot) {
+    parent[slot] = parent[parent[slot]];
+    slot = parent[slot];
+  }
+  return slot;
+}
+
+} // anonymous namespace
+
+DuplicateIndex::Signature
+DuplicateIndex::signature(const std::vector<uint32_t> &trigrams) {
+  const auto &family = hashFamily();
+  Signature minimums;
+  minimums.fill(std::numeric_limits<uint32_t>::max());
+  for (uint32_t trigram : trigrams) {
+    const uint64_t base = mix64(trigram);
+    for (size_t i = 0; i < SIGNATURE_SIZE; ++i) {
+      const auto hash = static_cast<uint32_t>(
+          (family.multipliers[i] * base + family.increments[i]) >> 32);
+      minimums[i] = std::min(minimums[i], hash);
+    }
+  }
+  return minimums;
+}
+
+uint64_t DuplicateIndex::itemKey(const std::string &item_type, int id) {
+  const uint64_t type_bit = item_type == "collection" ? 1ULL << 32 : 0;
+  return type_bit | static_cast<uint32_t>(id);
+}
+
+std::vector<uint64_t>
+DuplicateIndex::bandKeys(const std::vector<uint32_t> &trigrams) {
+  std::vector<uint64_t> keys;
+  if (trigrams.empty()) {
+    return keys;
+  }
+
+  const auto minimums = signature(trigrams);
+  keys.reserve(BANDS);
+  for (size_t band = 0; band < BANDS; ++band) {
+    uint64_t key = band + 1;
+    for (size_t row = 0; row < ROWS_PER_BAND; ++row) {
+      key = mix64(key + minimums[band * ROWS_PER_BAND + row]);
+    }
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+void DuplicateIndex::reserve(size_t entries) {
+  slots_.reserve(slots_.size() + entries);
+  slot_of_.reserve(slot_of_.size() + entries);
+  // Nearly every band of a title is a bucket of its own
+  buckets_.reserve(buckets_.size() + entries * BANDS);
+}
+
+void DuplicateIndex::upsert(const domain::CatalogEntry &entry) {
+  remove(entry.item_type, entry.id);
+
+  // Dead slots stay in the buckets; start over once they dominate
+  if (slots_.size() > 2 * slot_of_.size() + 64) {
+    std::vector<domain::CatalogEntry> live;
+    live.reserve(slot_of_.size());
+    for (auto &slot : slots_) {
+      if (slot.live) {
+        live.push_back(std::move(slot.entry));
+      }
+    }
+    *this = DuplicateIndex();
+    for (const auto &kept : live) {
+      upsert(kept);
+    }
+  }
+
+  const auto slot = static_cast<uint32_t>(slots_.size());
+  Slot added;
+  added.entry = entry;
+  added.trigrams = titleTrigrams(normalizeTitle(entry.title));
+  for (uint64_t key : bandKeys(added.trigrams)) {
+    buckets_[key].push_back(slot);
+  }
+  if (entry.tmdb_id > 0) {
+    by_tmdb_id_[entry.tmdb_id].push_back(slot);
+  }
+  if (!entry.ean.empty()) {
+    by_ean_[entry.ean].push_back(slot);
+  }
+  slots_.push_back(std::move(added));
+  slot_of_[itemKey(entry.item_type, entry.id)] = slot;
+}
+
+bool DuplicateIndex::remove(const std::string &item_type, int id) {
+  auto it = slot_of_.find(itemKey(item_type, id));
+  if (it == slot_of_.end()) {
+    return false;
+  }
+  slots_[it->second].live = false;
+  slot_of_.erase(it);
+  return true;
+}
+
+std::unordered_map<uint32_t, DuplicateIndex::Candidate>
+DuplicateIndex::candidates(const domain::CatalogEntry &entry,
+                           const std::vector<uint32_t> &trigrams,
+                           double min_similarity, uint32_t first_slot) const {
+  std::unordered_map<uint32_t, Candidate> found;
+  const uint64_t own_key = itemKey(entry.item_type, entry.id);
+  auto isOther = [&](uint32_t slot) {
+    const auto &other = slots_[slot];
+    return slot >= first_slot && other.live &&
+           itemKey(other.entry.item_type, other.entry.id) != own_key;
+  };
+
+  // A shared EAN is the same disc, whatever the titles say
+  if (!entry.ean.empty()) {
+    if (auto it = by_ean_.find(entry.ean); it != by_ean_.end()) {
+      for (uint32_t slot : it->second) {
+        if (isOther(slot)) {
+          found[slot].same_ean = true;
+        }
+      }
+    }
+  }
+
+  // The same film in another format is an upgrade, not a duplicate
+  auto sameFormat = [&](uint32_t slot) {
+    return slots_[slot].entry.is_uhd_4k == entry.is_uhd_4k;
+  };
+
+  if (entry.tmdb_id > 0) {
+    if (auto it = by_tmdb_id_.find(entry.tmdb_id); it != by_tmdb_id_.end()) {
+      for (uint32_t slot : it->second) {
+        if (isOther(slot) && sameFormat(slot)) {
+          found[slot].same_tmdb_id = true;
+        }
+      }
+    }
+  }
+
+  // Similar titles share a band; verify each such slot once
+  std::vector<uint32_t> banded;
+  for (uint64_t key : bandKeys(trigrams)) {
+    if (auto it = buckets_.find(key); it != buckets_.end()) {
+      banded.insert(banded.end(), it->second.begin(), it->second.end());
+    }
+  }
+  std::sort(banded.begin(), banded.end());
+  banded.erase(std::unique(banded.begin(), banded.end()), banded.end());
+  for (uint32_t slot : banded) {
+    if (!isOther(slot) || !sameFormat(slot)) {
+      continue;
+    }
+    const double similarity = jaccard(trigrams, slots_[slot].trigrams);
+    if (similarity >= min_similarity) {
+      found[slot].similarity = similarity;
+    }
+  }
+
+  // Title similarity of the EAN and TMDb matches, for display
+  for (auto &[slot, candidate] : found) {
+    if (candidate.similarity == 0.0) {
+      candidate.similarity = jaccard(trigrams, slots_[slot].trigrams);
+    }
+  }
+  return found;
+}
+
+std::vector<domain::DuplicateMatch>
+DuplicateIndex::find(const domain::CatalogEntry &entry,
+                     double min_similarity) const {
+  const auto trigrams = titleTrigrams(normalizeTitle(entry.title));
+
+  std::vector<domain::DuplicateMatch> matches;
+  for (const auto &[slot, candidate] :
+       candidates(entry, trigrams, min_similarity)) {
+    domain::DuplicateMatch match;
+    match.entry = slots_[slot].entry;
+    match.similarity = candidate.similarity;
+    match.same_tmdb_id = candidate.same_tmdb_id;
+    match.same_ean = candidate.same_ean;
+    matches.push_back(std::move(match));
+  }
+
+  std::sort(matches.begin(), matches.end(),
+            [](const domain::DuplicateMatch &a,
+               const domain::DuplicateMatch &b) {
+              if (a.similarity != b.similarity) {
+                return a.similarity > b.similarity;
+              }
+              if (a.entry.item_type != b.entry.item_type) {
+                return a.entry.item_type > b.entry.item_type; // Wishlist first
+              }
+              return a.entry.id < b.entry.id;
+            });
+  return matches;
+}
+
+std::vector<domain::DuplicateGroup>
+DuplicateIndex::groups(double min_similarity) const {
+  const auto slot_count = static_cast<uint32_t>(slots_.size());
+  std::vector<uint32_t> parent(slot_count);
+  std::iota(parent.begin(), parent.end(), 0);
+  std::vector<uint8_t> has_tmdb_pair(slot_count, 0);
+  std::vector<uint8_t> has_ean_pair(slot_count, 0);
+
+  // Each pair would be found from both ends; look only at later slots
+  for (uint32_t slot = 0; slot < slot_count; ++slot) {
+    const auto &current = slots_[slot];
+    if (!current.live) {
+      continue;
+    }
+    for (const auto &[other, candidate] : candidates(
+             current.entry, current.trigrams, min_similarity, slot + 1)) {
+      const uint32_t root = findRoot(parent, slot);
+      const uint32_t other_root = findRoot(parent, other);
+      parent[other_root] = root;
+      has_tmdb_pair[root] |= has_tmdb_pair[other_root] | candidate.same_tmdb_id;
+      has_ean_pair[root] |= has_ean_pair[other_root] | candidate.same_ean;
+    }
+  }
+
+  std::unordered_map<uint32_t, domain::DuplicateGroup> by_root;
+  for (uint32_t slot = 0; slot < slot_count; ++slot) {
+    if (slots_[slot].live && findRoot(parent, slot) != slot) {
+      by_root[findRoot(parent, slot)].entries.push_back(slots_[slot].entry);
+    }
+  }
+
+  std::vector<domain::DuplicateGroup> result;
+  result.reserve(by_root.size());
+  for (auto &[root, group] : by_root) {
+    group.entries.insert(group.entries.begin(), slots_[root].entry);
+    group.same_tmdb_id = has_tmdb_pair[root] != 0;
+    group.same_ean = has_ean_pair[root] != 0;
+    result.push_back(std::move(group));
+  }
+
+  std::sort(result.begin(), result.end(),
+            [](const domain::DuplicateGroup &a,
+               const domain::DuplicateGroup &b) {
+              if (a.entries.size() != b.entries.size()) {
+                return a.entries.size() > b.entries.size();
+              }
+              return a.entries.front().title < b.entries.front().title;
+            });
+  return result;
+}
+
+} // namespace bluray::application::matching
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../../domain/models.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bluray::application::matching {
+
+/**
+ * MinHash locality-sensitive hashing index over catalog titles, plus exact
+ * lookups by TMDb id and EAN
+ *
+ * Each title's trigram set is summarised by SIGNATURE_SIZE min-hashes, cut
+ * into BANDS bands of ROWS_PER_BAND. Titles sharing any whole band land in
+ * the same bucket and become candidates, which are then verified with the
+ * exact trigram similarity. A lookup therefore costs a fixed number of hash
+ * probes plus the (small) buckets it hits, independent of catalog size.
+ * Pairs at 0.7 similarity share a band with 99% probability, pairs below
+ * 0.3 rarely do.
+ */
+class DuplicateIndex {
+public:
+  static constexpr size_t BANDS = 16;
+  static constexpr size_t ROWS_PER_BAND = 4;
+  static constexpr size_t SIGNATURE_SIZE = BANDS * ROWS_PER_BAND;
+
+  using Signature = std::array<uint32_t, SIGNATURE_SIZE>;
+
+  /**
+   * Make room for `entries` more entries before a bulk load
+   */
+  void reserve(size_t entries);
+
+  /**
+   * Add an entry, replacing an earlier one with the same type and id
+   */
+  void upsert(const domain::CatalogEntry &entry);
+
+  /**
+   * Forget an entry
+   * @return false if it was not indexed
+   */
+  bool remove(const std::string &item_type, int id);
+
+  /**
+   * Indexed entries that are probably the same disc as `entry` (the entry
+   * itself excluded), most similar first
+   *
+   * Entries match on a shared EAN, or on the same format (4K or not) plus
+   * a shared TMDb id or a title at least `min_similarity` similar.
+   */
+  [[nodiscard]] std::vector<domain::DuplicateMatch>
+  find(const domain::CatalogEntry &entry, double min_similarity) const;
+
+  /**
+   * Every group of indexed entries linked by a probable duplicate pair
+   * (transitively), largest group first
+   */
+  [[nodiscard]] std::vector<domain::DuplicateGroup>
+  groups(double min_similarity) const;
+
+  [[nodiscard]] size_t size() const { return slot_of_.size(); }
+
+  /**
+   * MinHash signature of a sorted trigram set (see titleTrigrams)
+   */
+  static Signature signature(const std::vector<uint32_t> &trigrams);
+
+private:
+  struct Slot {
+    domain::CatalogEntry entry;
+    std::vector<uint32_t> trigrams;
+    bool live{true};
+  };
+
+  // Candidate slot with the reasons found so far
+  struct Candidate {
+    double similarity{0.0};
+    bool same_tmdb_id{false};
+    bool same_ean{false};
+  };
+
+  static uint64_t itemKey(const std::string &item_type, int id);
+  static std::vector<uint64_t> bandKeys(const std::vector<uint32_t> &trigrams);
+
+  // Verified probable duplicates of a title among slots from `first_slot`
+  // on, by slot
+  std::unordered_map<uint32_t, Candidate>
+  candidates(const domain::CatalogEntry &entry,
+             const std::vector<uint32_t> &trigrams, double min_similarity,
+             uint32_t first_slot = 0) const;
+
+  std::vector<Slot> slots_; // Removed entries stay as dead slots
+  std::unordered_map<uint64_t, uint32_t> slot_of_; // itemKey -> live slot
+  std::unordered_map<uint64_t, std::vector<uint32_t>> buckets_;
+  std::unordered_map<int, std::vector<uint32_t>> by_tmdb_id_;
+  std::unordered_map<std::string, std::vector<uint32_t>> by_ean_;
+};
+
+} // namespace bluray::application::matching
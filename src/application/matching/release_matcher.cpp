@@ -0,0 +1,64 @@
+#include "release_matcher.hpp"
+#include "../../infrastructure/config_manager.hpp"
+#include "../../infrastructure/logger.hpp"
+#include "title_index.hpp"
+#include <chrono>
+
+namespace bluray::application::matching {
+
+using infrastructure::MatchableTitle;
+
+int ReleaseMatcher::refresh() {
+  const auto started = std::chrono::steady_clock::now();
+  const double min_similarity =
+      infrastructure::ConfigManager::instance().getDouble(
+          "release_match_min_similarity", DEFAULT_MIN_SIMILARITY);
+
+  infrastructure::ReleaseMatchRepository repo;
+  const auto releases = repo.findTitles("release_calendar");
+  const auto wishlist = repo.findTitles("wishlist");
+  const auto collection = repo.findTitles("collection");
+
+  const auto matches = match(releases, wishlist, collection, min_similarity);
+  repo.replaceAll(matches);
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - started);
+  LOG_INFO({{"releases", releases.size()},
+            {"items", wishlist.size() + collection.size()},
+            {"matches", matches.size()},
+            {"duration_ms", elapsed.count()}},
+           "Matched releases to wishlist and collection titles");
+  return static_cast<int>(matches.size());
+}
+
+std::vector<domain::ReleaseMatch>
+ReleaseMatcher::match(const std::vector<MatchableTitle> &releases,
+                      const std::vector<MatchableTitle> &wishlist,
+                      const std::vector<MatchableTitle> &collection,
+                      double min_similarity) {
+  const std::pair<const char *, const std::vector<MatchableTitle> *>
+      item_sets[] = {{"wishlist", &wishlist}, {"collection", &collection}};
+
+  std::vector<domain::ReleaseMatch> matches;
+  for (const auto &[item_type, items] : item_sets) {
+    TitleTrigramIndex index;
+    for (const auto &item : *items) {
+      index.add(item.id, item.title);
+    }
+
+    for (const auto &release : releases) {
+      for (const auto &found : index.find(release.title, min_similarity)) {
+        domain::ReleaseMatch match;
+        match.release_id = release.id;
+        match.item_type = item_type;
+        match.item_id = found.id;
+        match.score = found.similarity;
+        matches.push_back(std::move(match));
+      }
+    }
+  }
+  return matches;
+}
+
+} // namespace bluray::application::matching
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../../domain/models.hpp"
+#include "../../infrastructure/repositories/release_match_repository.hpp"
+#include <vector>
+
+namespace bluray::application::matching {
+
+/**
+ * Links upcoming releases to wishlist and collection items with similar
+ * titles, so users see when a film they follow gets a new (4K) release
+ */
+class ReleaseMatcher {
+public:
+  /**
+   * Recompute the release_matches table from the current calendar
+   * Run after every calendar refresh.
+   *
+   * @return Number of matches
+   */
+  int refresh();
+
+  /**
+   * Matches between the given titles (no database access)
+   */
+  static std::vector<domain::ReleaseMatch>
+  match(const std::vector<infrastructure::MatchableTitle> &releases,
+        const std::vector<infrastructure::MatchableTitle> &wishlist,
+        const std::vector<infrastructure::MatchableTitle> &collection,
+        double min_similarity);
+
+  // Trigram similarity a title pair needs to count as the same film
+  static constexpr double DEFAULT_MIN_SIMILARITY = 0.6;
+};
+
+} // namespace bluray::application::matching
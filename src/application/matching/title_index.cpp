@@ -0,0 +1,139 @@
+#include "title_index.hpp"
+#include <algorithm>
+#include <cctype>
+#include <set>
+
+namespace bluray::application::matching {
+
+namespace {
+
+// Words describing the disc rather than the film
+const std::set<std::string, std::less<>> kNoiseWords = {
+    "a",         "an",         "the",       "blu",      "ray",
+    "bluray",    "4k",         "uhd",       "ultra",    "hd",
+    "dvd",       "3d",         "steelbook", "edition",  "limited",
+    "special",   "collector",  "collectors", "remastered", "import",
+    "disc",      "discs",      "mediabook", "digibook", "boxset"};
+
+} // anonymous namespace
+
+std::string normalizeTitle(std::string_view title) {
+  std::string normalized;
+  normalized.reserve(title.size());
+
+  // Every word too, for titles that consist of noise words only
+  std::string all_words;
+  std::string word;
+  int bracket_depth = 0;
+  auto append = [](std::string &text, const std::string &next) {
+    if (!text.empty()) {
+      text += ' ';
+    }
+    text += next;
+  };
+  auto flushWord = [&] {
+    if (!word.empty()) {
+      append(all_words, word);
+      if (kNoiseWords.count(word) == 0) {
+        append(normalized, word);
+      }
+    }
+    word.clear();
+  };
+
+  for (char c : title) {
+    const auto uc = static_cast<unsigned char>(c);
+    if (c == '(' || c == '[') {
+      flushWord();
+      ++bracket_depth;
+    } else if (c == ')' || c == ']') {
+      flushWord();
+      bracket_depth = std::max(0, bracket_depth - 1);
+    } else if (bracket_depth > 0) {
+      continue;
+    } else if (std::isalnum(uc)) {
+      word += static_cast<char>(std::tolower(uc));
+    } else if (uc >= 0x80) {
+      word += c; // Part of a UTF-8 letter such as "é"
+    } else if (c == '\'') {
+      continue; // "Schindler's" -> "schindlers"
+    } else {
+      flushWord();
+    }
+  }
+  flushWord();
+  return normalized.empty() ? all_words : normalized;
+}
+
+std::vector<uint32_t> titleTrigrams(std::string_view normalized) {
+  std::vector<uint32_t> trigrams;
+  if (normalized.empty()) {
+    return trigrams;
+  }
+
+  const std::string padded = " " + std::string(normalized) + " ";
+  trigrams.reserve(padded.size() - 2);
+  for (size_t i = 0; i + 3 <= padded.size(); ++i) {
+    trigrams.push_back(static_cast<uint32_t>(
+        static_cast<unsigned char>(padded[i]) << 16 |
+        static_cast<unsigned char>(padded[i + 1]) << 8 |
+        static_cast<unsigned char>(padded[i + 2])));
+  }
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()),
+                 trigrams.end());
+  return trigrams;
+}
+
+void TitleTrigramIndex::add(int id, std::string_view title) {
+  const auto trigrams = titleTrigrams(normalizeTitle(title));
+  if (trigrams.empty()) {
+    return;
+  }
+
+  const auto slot = static_cast<uint32_t>(ids_.size());
+  ids_.push_back(id);
+  trigram_counts_.push_back(static_cast<uint32_t>(trigrams.size()));
+  for (uint32_t trigram : trigrams) {
+    postings_[trigram].push_back(slot);
+  }
+}
+
+std::vector<TitleTrigramIndex::Match>
+TitleTrigramIndex::find(std::string_view title, double min_similarity) const {
+  std::vector<Match> matches;
+  const auto trigrams = titleTrigrams(normalizeTitle(title));
+  if (trigrams.empty()) {
+    return matches;
+  }
+
+  // Shared trigram count per candidate slot
+  std::unordered_map<uint32_t, uint32_t> shared;
+  for (uint32_t trigram : trigrams) {
+    auto it = postings_.find(trigram);
+    if (it == postings_.end()) {
+      continue;
+    }
+    for (uint32_t slot : it->second) {
+      ++shared[slot];
+    }
+  }
+
+  const double query_count = static_cast<double>(trigrams.size());
+  for (const auto &[slot, count] : shared) {
+    const double similarity =
+        count / (query_count + trigram_counts_[slot] - count);
+    if (similarity >= min_similarity) {
+      matches.push_back({ids_[slot], similarity});
+    }
+  }
+
+  std::sort(matches.begin(), matches.end(),
+            [](const Match &a, const Match &b) {
+              return a.similarity != b.similarity ? a.similarity > b.similarity
+                                                  : a.id < b.id;
+            });
+  return matches;
+}
+
+} // namespace bluray::application::matching
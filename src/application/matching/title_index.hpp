@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace bluray::application::matching {
+
+/**
+ * Title reduced to the film's name: lower-case words, without bracketed
+ * text, articles or format and edition words ("The Thing (1982) 4K Ultra HD
+ * Blu-ray Steelbook" -> "thing"). A title made of such words only keeps
+ * them all.
+ */
+std::string normalizeTitle(std::string_view title);
+
+/**
+ * Distinct character trigrams of a normalized title, padded with a space
+ * on both ends so that short titles still have a few ("thing" -> " th",
+ * "thi", "hin", "ing", "ng "), sorted
+ */
+std::vector<uint32_t> titleTrigrams(std::string_view normalized);
+
+/**
+ * Inverted trigram index over titles
+ *
+ * A query only visits the posting lists of its own trigrams, so matching
+ * every release against every item costs about the total number of shared
+ * trigrams instead of comparing each pair of titles.
+ */
+class TitleTrigramIndex {
+public:
+  struct Match {
+    int id;
+    double similarity; // Jaccard similarity of the trigram sets
+  };
+
+  /**
+   * Index a title under a caller-chosen id
+   */
+  void add(int id, std::string_view title);
+
+  /**
+   * Indexed titles at least `min_similarity` similar, best first
+   */
+  [[nodiscard]] std::vector<Match> find(std::string_view title,
+                                        double min_similarity) const;
+
+  [[nodiscard]] size_t size() const { return ids_.size(); }
+
+private:
+  // Per indexed title (slot): caller's id and number of trigrams
+  std::vector<int> ids_;
+  std::vector<uint32_t> trigram_counts_;
+  std::unordered_map<uint32_t, std::vector<uint32_t>> postings_; // Slots
+};
+
+} // namespace bluray::application::matching
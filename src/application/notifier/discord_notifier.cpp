@@ -2,7 +2,9 @@
 #include "../../infrastructure/logger.hpp"
 #include <fmt/chrono.h>
 #include <fmt/format.h>
+#include <algorithm>
 #include <nlohmann/json.hpp>
+#include <thread>
 
 namespace bluray::application::notifier {
 
@@ -13,59 +15,151 @@ DiscordNotifier::DiscordNotifier() {
   webhook_url_ = config.get("discord_webhook_url", "");
 }
 
-void DiscordNotifier::notify(const domain::ChangeEvent &event) {
+bool DiscordNotifier::notify(const domain::ChangeEvent &event) {
+  return notifyBatch({event}) == 1;
+}
+
+size_t DiscordNotifier::notifyBatch(
+    const std::vector<domain::ChangeEvent> &events) {
   if (!isConfigured()) {
-    infrastructure::Logger::instance().warning(
-        "Discord notifier not configured");
-    return;
+    LOG_WARNING("Discord notifier not configured");
+    return 0;
   }
 
-  // Build Discord webhook payload
-  json payload = {{"content", buildMessage(event)},
-                  {"embeds", json::array({json::parse(buildEmbed(event))})}};
+  for (size_t start = 0; start < events.size();
+       start += MAX_EMBEDS_PER_MESSAGE) {
+    const size_t end = std::min(start + MAX_EMBEDS_PER_MESSAGE, events.size());
+    const size_t count = end - start;
+
+    // Build Discord webhook payload
+    json embeds = json::array();
+    for (size_t i = start; i < end; ++i) {
+      embeds.push_back(buildEmbed(events[i]));
+    }
+
+    json payload = {{"content", count == 1
+                                    ? buildMessage(events[start])
+                                    : fmt::format("🔔 **{} wishlist updates**",
+                                                  count)},
+                    {"embeds", std::move(embeds)}};
+
+    if (sendPayload(payload)) {
+      LOG_INFO("Discord notification sent: {}",
+               count == 1
+                   ? events[start].describe()
+                   : fmt::format("{} events in one message", count));
+    } else {
+      LOG_ERROR("Failed to send Discord notification for {} event(s)", count);
+      return start;
+    }
+  }
 
-  // Send webhook
-  auto response = client_.post(webhook_url_, payload.dump());
+  return events.size();
+}
 
-  if (response.success) {
-    infrastructure::Logger::instance().info(
-        fmt::format("Discord notification sent: {}", event.describe()));
-  } else {
-    infrastructure::Logger::instance().error(
-        fmt::format("Failed to send Discord notification: {} (status: {})",
-                    event.describe(), response.status_code));
+bool DiscordNotifier::sendPayload(const json &payload) {
+  const std::string body = payload.dump();
+
+  for (int attempt = 0;; ++attempt) {
+    // Wait out an exhausted bucket rather than provoking a 429
+    if (bucket_remaining_ <= 0) {
+      const auto now = std::chrono::steady_clock::now();
+      if (now < bucket_reset_at_) {
+        std::this_thread::sleep_for(bucket_reset_at_ - now);
+      }
+      bucket_remaining_ = 1;
+    }
+
+    auto response = client_.post(webhook_url_, body);
+    updateRateLimit(response);
+
+    if (response.status_code == 429 && attempt < MAX_RATE_LIMIT_RETRIES) {
+      // Retry-After header (seconds), or retry_after in the JSON body
+      double retry_after = 1.0;
+      if (auto value = response.header("Retry-After")) {
+        try {
+          retry_after = std::stod(*value);
+        } catch (const std::exception &) {
+          // Keep default
+        }
+      } else {
+        auto parsed = json::parse(response.body, nullptr, false);
+        if (parsed.is_object() && parsed.contains("retry_after") &&
+            parsed["retry_after"].is_number()) {
+          retry_after = parsed["retry_after"].get<double>();
+        }
+      }
+
+      LOG_WARNING("Discord rate limit exceeded (429), retrying in {:.1f}s",
+                  retry_after);
+      bucket_remaining_ = 0;
+      bucket_reset_at_ =
+          std::chrono::steady_clock::now() +
+          std::chrono::milliseconds(
+              static_cast<int64_t>(std::max(retry_after, 0.0) * 1000));
+      continue;
+    }
+
+    if (!response.success) {
+      LOG_ERROR("Discord webhook request failed (status: {})",
+                response.status_code);
+    }
+    return response.success;
+  }
+}
+
+void DiscordNotifier::updateRateLimit(
+    const infrastructure::HttpResponse &response) {
+  const auto remaining = response.header("X-RateLimit-Remaining");
+  const auto reset_after = response.header("X-RateLimit-Reset-After");
+  if (!remaining || !reset_after) {
+    return;
+  }
+
+  try {
+    bucket_remaining_ = std::stoi(*remaining);
+    bucket_reset_at_ =
+        std::chrono::steady_clock::now() +
+        std::chrono::milliseconds(
+            static_cast<int64_t>(std::stod(*reset_after) * 1000));
+  } catch (const std::exception &) {
+    // Malformed headers; keep previous state
   }
 }
 
 bool DiscordNotifier::isConfigured() const { return !webhook_url_.empty(); }
 
+std::string DiscordNotifier::channel() const { return "discord"; }
+
 std::string
 DiscordNotifier::buildMessage(const domain::ChangeEvent &event) const {
   switch (event.type) {
   case domain::ChangeType::PriceDroppedBelowThreshold:
-    return fmt::format("🎉 **Price Alert!** - {}", event.item.title);
+    return fmt::format("🎉 **Price Alert!** - {}", event.item->title);
 
   case domain::ChangeType::BackInStock:
-    return fmt::format("📦 **Back in Stock!** - {}", event.item.title);
+    return fmt::format("📦 **Back in Stock!** - {}", event.item->title);
 
   case domain::ChangeType::PriceChanged:
-    return fmt::format("💰 Price Update - {}", event.item.title);
+    return fmt::format("💰 Price Update - {}", event.item->title);
 
   case domain::ChangeType::OutOfStock:
-    return fmt::format("⚠️ Out of Stock - {}", event.item.title);
+    return fmt::format("⚠️ Out of Stock - {}", event.item->title);
+
+  case domain::ChangeType::AlertRuleMatched:
+    return fmt::format("🔔 **{}** - {}", event.rule_name, event.item->title);
 
   default:
-    return fmt::format("ℹ️ Update - {}", event.item.title);
+    return fmt::format("ℹ️ Update - {}", event.item->title);
   }
 }
 
-std::string
-DiscordNotifier::buildEmbed(const domain::ChangeEvent &event) const {
-  json embed = {{"title", event.item.title},
-                {"url", event.item.url},
+json DiscordNotifier::buildEmbed(const domain::ChangeEvent &event) const {
+  json embed = {{"title", event.item->title},
+                {"url", event.item->url},
                 {"color", 0x00ff00}, // Green
                 {"timestamp", fmt::format("{:%Y-%m-%dT%H:%M:%S}",
-                                          std::chrono::system_clock::now())},
+                                          event.detected_at)},
                 {"fields", json::array()}};
 
   // Set color based on event type
@@ -79,6 +173,9 @@ DiscordNotifier::buildEmbed(const domain::ChangeEvent &event) const {
   case domain::ChangeType::OutOfStock:
     embed["color"] = 0xff0000; // Red
     break;
+  case domain::ChangeType::AlertRuleMatched:
+    embed["color"] = 0x9b59b6; // Purple
+    break;
   default:
     embed["color"] = 0xffaa00; // Orange
     break;
@@ -91,31 +188,37 @@ DiscordNotifier::buildEmbed(const domain::ChangeEvent &event) const {
   if (event.new_price) {
     embed["fields"].push_back(
         {{"name", "Current Price"},
-         {"value", fmt::format("€{:.2f}", *event.new_price)},
+         {"value", fmt::format("€{}", *event.new_price)},
          {"inline", true}});
   }
 
-  if (event.item.desired_max_price > 0) {
+  if (event.item->desired_max_price.isPositive()) {
     embed["fields"].push_back(
         {{"name", "Your Max Price"},
-         {"value", fmt::format("€{:.2f}", event.item.desired_max_price)},
+         {"value", fmt::format("€{}", event.item->desired_max_price)},
          {"inline", true}});
   }
 
-  if (event.item.is_uhd_4k) {
+  if (event.item->is_uhd_4k) {
     embed["fields"].push_back(
         {{"name", "Format"}, {"value", "🎬 UHD 4K"}, {"inline", true}});
   }
 
   embed["fields"].push_back(
-      {{"name", "Source"}, {"value", event.item.source}, {"inline", true}});
+      {{"name", "Source"}, {"value", event.item->source.str()}, {"inline", true}});
 
   // Add thumbnail if available
-  if (!event.item.image_url.empty()) {
-    embed["thumbnail"] = {{"url", event.item.image_url}};
+  if (!event.item->image_url.empty()) {
+    embed["thumbnail"] = {{"url", event.item->image_url}};
+  }
+
+  // Webhooks cannot deduplicate, so show the key to make redeliveries
+  // recognisable
+  if (!event.idempotency_key.empty()) {
+    embed["footer"] = {{"text", fmt::format("ref {}", event.idempotency_key)}};
   }
 
-  return embed.dump();
+  return embed;
 }
 
 } // namespace bluray::application::notifier
@@ -3,25 +3,56 @@
 #include "notifier.hpp"
 #include "../../infrastructure/network_client.hpp"
 #include "../../infrastructure/config_manager.hpp"
+#include <chrono>
+#include <nlohmann/json.hpp>
 
 namespace bluray::application::notifier {
 
 /**
  * Discord webhook notifier
+ *
+ * Batches are sent as messages of up to MAX_EMBEDS_PER_MESSAGE embeds. The
+ * webhook's bucket limit is tracked from the X-RateLimit-* response headers,
+ * so a wave of events waits for the bucket to reset instead of running into
+ * 429s; a 429 is still retried after the advertised delay.
+ *
+ * Only called from the notification dispatcher thread.
  */
 class DiscordNotifier : public INotifier {
 public:
     DiscordNotifier();
 
-    void notify(const domain::ChangeEvent& event) override;
+    std::string channel() const override;
+    bool notify(const domain::ChangeEvent& event) override;
+    size_t notifyBatch(const std::vector<domain::ChangeEvent>& events) override;
     bool isConfigured() const override;
 
+    // Discord limit on embeds per webhook message
+    static constexpr size_t MAX_EMBEDS_PER_MESSAGE = 10;
+
 private:
     std::string buildMessage(const domain::ChangeEvent& event) const;
-    std::string buildEmbed(const domain::ChangeEvent& event) const;
+    nlohmann::json buildEmbed(const domain::ChangeEvent& event) const;
+
+    /**
+     * Post one webhook message, honouring the bucket rate limit
+     * @return true if Discord accepted the message
+     */
+    bool sendPayload(const nlohmann::json& payload);
+
+    /**
+     * Update bucket state from X-RateLimit-* headers
+     */
+    void updateRateLimit(const infrastructure::HttpResponse& response);
 
     infrastructure::NetworkClient client_;
     std::string webhook_url_;
+
+    // Webhook bucket state from the last response
+    int bucket_remaining_{1};
+    std::chrono::steady_clock::time_point bucket_reset_at_{};
+
+    static constexpr int MAX_RATE_LIMIT_RETRIES = 3;
 };
 
 } // namespace bluray::application::notifier
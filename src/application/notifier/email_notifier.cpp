@@ -2,6 +2,7 @@
 #include "../../infrastructure/logger.hpp"
 #include <cstring>
 #include <fmt/format.h>
+#include <functional>
 #include <sstream>
 
 namespace bluray::application::notifier {
@@ -15,26 +16,87 @@ EmailNotifier::EmailNotifier() {
   config_.smtp_pass = config_mgr.get("smtp_pass", "");
   config_.from_address = config_mgr.get("smtp_from", "");
   config_.to_address = config_mgr.get("smtp_to", "");
+  config_.digest_mode = config_mgr.getBool("email_digest_mode", false);
 }
 
-EmailNotifier::~EmailNotifier() = default;
+EmailNotifier::~EmailNotifier() {
+  if (recipients_) {
+    curl_slist_free_all(recipients_);
+  }
+  if (curl_) {
+    curl_easy_cleanup(curl_);
+  }
+}
+
+std::string EmailNotifier::channel() const { return "email"; }
+
+bool EmailNotifier::deliversPerRun() const { return config_.digest_mode; }
 
-void EmailNotifier::notify(const domain::ChangeEvent &event) {
+bool EmailNotifier::notify(const domain::ChangeEvent &event) {
   if (!isConfigured()) {
-    infrastructure::Logger::instance().warning("Email notifier not configured");
-    return;
+    LOG_WARNING("Email notifier not configured");
+    return false;
   }
 
   const std::string subject = buildSubject(event);
   const std::string body = buildEmailBody(event);
 
-  if (sendEmail(subject, body)) {
-    infrastructure::Logger::instance().info(
-        fmt::format("Email notification sent: {}", event.describe()));
-  } else {
-    infrastructure::Logger::instance().error(
-        fmt::format("Failed to send email notification: {}", event.describe()));
+  if (sendEmail(subject, body, messageId({event}))) {
+    LOG_INFO("Email notification sent: {}", event.describe());
+    return true;
   }
+
+  LOG_ERROR("Failed to send email notification: {}", event.describe());
+  return false;
+}
+
+size_t
+EmailNotifier::notifyBatch(const std::vector<domain::ChangeEvent> &events) {
+  if (!config_.digest_mode) {
+    return INotifier::notifyBatch(events);
+  }
+
+  if (!isConfigured()) {
+    LOG_WARNING("Email notifier not configured");
+    return 0;
+  }
+
+  if (events.empty()) {
+    return 0;
+  }
+
+  // The dispatcher hands over a whole run at once; send it as one digest
+  if (sendEmail(buildDigestSubject(events), buildDigestBody(events),
+                messageId(events))) {
+    LOG_INFO("Email digest sent with {} notification(s)", events.size());
+    return events.size();
+  }
+
+  LOG_ERROR("Failed to send email digest with {} notification(s)",
+            events.size());
+  return 0;
+}
+
+std::string EmailNotifier::messageId(
+    const std::vector<domain::ChangeEvent> &events) const {
+  // Derived from the idempotency keys, so a redelivered message carries the
+  // same Message-ID and mail systems can drop the duplicate
+  std::string keys;
+  for (const auto &event : events) {
+    keys += event.idempotency_key;
+    keys += ';';
+  }
+
+  const std::string domain_part =
+      config_.from_address.find('@') != std::string::npos
+          ? config_.from_address.substr(config_.from_address.find('@') + 1)
+          : "bluray-tracker.local";
+
+  if (events.size() == 1 && !events.front().idempotency_key.empty()) {
+    return fmt::format("<{}@{}>", events.front().idempotency_key, domain_part);
+  }
+  return fmt::format("<digest-{:016x}@{}>", std::hash<std::string>{}(keys),
+                     domain_part);
 }
 
 bool EmailNotifier::isConfigured() const {
@@ -46,20 +108,24 @@ std::string
 EmailNotifier::buildSubject(const domain::ChangeEvent &event) const {
   switch (event.type) {
   case domain::ChangeType::PriceDroppedBelowThreshold:
-    return fmt::format("Price Alert: {} - €{:.2f}", event.item.title,
-                       event.new_price.value_or(0.0));
+    return fmt::format("Price Alert: {} - €{}", event.item->title,
+                       event.new_price.value_or(domain::Money{}));
 
   case domain::ChangeType::BackInStock:
-    return fmt::format("Back in Stock: {}", event.item.title);
+    return fmt::format("Back in Stock: {}", event.item->title);
 
   case domain::ChangeType::PriceChanged:
-    return fmt::format("Price Update: {}", event.item.title);
+    return fmt::format("Price Update: {}", event.item->title);
 
   case domain::ChangeType::OutOfStock:
-    return fmt::format("Out of Stock: {}", event.item.title);
+    return fmt::format("Out of Stock: {}", event.item->title);
+
+  case domain::ChangeType::AlertRuleMatched:
+    return fmt::format("Alert '{}': {} - €{}", event.rule_name,
+                       event.item->title, event.item->current_price);
 
   default:
-    return fmt::format("Blu-ray Tracker Update: {}", event.item.title);
+    return fmt::format("Blu-ray Tracker Update: {}", event.item->title);
   }
 }
 
@@ -72,45 +138,131 @@ EmailNotifier::buildEmailBody(const domain::ChangeEvent &event) const {
 
   oss << event.describe() << "\n\n";
 
+  appendEventDetails(oss, event);
+
+  oss << "\n--\n";
+  oss << "Blu-ray Tracker\n";
+
+  return oss.str();
+}
+
+std::string EmailNotifier::buildDigestSubject(
+    const std::vector<domain::ChangeEvent> &events) const {
+  int price_alerts = 0;
+  int back_in_stock = 0;
+  int rule_alerts = 0;
+  for (const auto &event : events) {
+    if (event.type == domain::ChangeType::PriceDroppedBelowThreshold) {
+      price_alerts++;
+    } else if (event.type == domain::ChangeType::BackInStock) {
+      back_in_stock++;
+    } else if (event.type == domain::ChangeType::AlertRuleMatched) {
+      rule_alerts++;
+    }
+  }
+
+  std::string subject = fmt::format(
+      "Blu-ray Tracker Digest: {} price alert(s), {} back in stock",
+      price_alerts, back_in_stock);
+  if (rule_alerts > 0) {
+    subject += fmt::format(", {} rule alert(s)", rule_alerts);
+  }
+  return subject;
+}
+
+std::string EmailNotifier::buildDigestBody(
+    const std::vector<domain::ChangeEvent> &events) const {
+  std::ostringstream oss;
+
+  oss << "Blu-ray Tracker Digest\n";
+  oss << "======================\n\n";
+
+  oss << fmt::format("{} update(s) from the latest scrape run:\n\n",
+                     events.size());
+  for (const auto &event : events) {
+    oss << "  * " << event.describe() << "\n";
+  }
+
+  for (const auto &event : events) {
+    oss << "\n" << event.item->title << "\n";
+    oss << std::string(event.item->title.size(), '-') << "\n";
+    appendEventDetails(oss, event);
+  }
+
+  oss << "\n--\n";
+  oss << "Blu-ray Tracker\n";
+
+  return oss.str();
+}
+
+void EmailNotifier::appendEventDetails(std::ostringstream &oss,
+                                       const domain::ChangeEvent &event) const {
   oss << "Product Details:\n";
   oss << "---------------\n";
-  oss << "Title: " << event.item.title << "\n";
-  oss << "URL: " << event.item.url << "\n";
-  oss << "Source: " << event.item.source << "\n";
+  oss << "Title: " << event.item->title << "\n";
+  oss << "URL: " << event.item->url << "\n";
+  oss << "Source: " << event.item->source.str() << "\n";
 
   if (event.new_price) {
-    oss << "Current Price: €" << fmt::format("{:.2f}", *event.new_price)
-        << "\n";
+    oss << "Current Price: €" << event.new_price->toString() << "\n";
   }
 
   if (event.old_price && event.old_price != event.new_price) {
-    oss << "Previous Price: €" << fmt::format("{:.2f}", *event.old_price)
-        << "\n";
+    oss << "Previous Price: €" << event.old_price->toString() << "\n";
   }
 
-  if (event.item.desired_max_price > 0) {
-    oss << "Your Max Price: €"
-        << fmt::format("{:.2f}", event.item.desired_max_price) << "\n";
+  if (event.item->desired_max_price.isPositive()) {
+    oss << "Your Max Price: €" << event.item->desired_max_price.toString()
+        << "\n";
   }
 
-  if (event.item.is_uhd_4k) {
+  if (event.item->is_uhd_4k) {
     oss << "Format: UHD 4K\n";
   }
 
-  oss << "Stock Status: " << (event.item.in_stock ? "In Stock" : "Out of Stock")
+  oss << "Stock Status: " << (event.item->in_stock ? "In Stock" : "Out of Stock")
       << "\n";
-
-  oss << "\n--\n";
-  oss << "Blu-ray Tracker\n";
-
-  return oss.str();
 }
 
 bool EmailNotifier::sendEmail(const std::string &subject,
-                              const std::string &body) {
-  CURL *curl = curl_easy_init();
-  if (!curl) {
-    return false;
+                              const std::string &body,
+                              const std::string &message_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // The handle persists, so libcurl keeps the authenticated SMTP connection
+  // open and reuses it for the next message
+  if (!curl_) {
+    curl_ = curl_easy_init();
+    if (!curl_) {
+      return false;
+    }
+
+    // Set URL (smtp://server:port)
+    const std::string url =
+        fmt::format("smtp://{}:{}", config_.smtp_server, config_.smtp_port);
+    curl_easy_setopt(curl_, CURLOPT_URL, url.c_str());
+
+    // TLS settings
+    curl_easy_setopt(curl_, CURLOPT_USE_SSL, CURLUSESSL_ALL);
+    curl_easy_setopt(curl_, CURLOPT_SSL_VERIFYPEER, 1L);
+    curl_easy_setopt(curl_, CURLOPT_SSL_VERIFYHOST, 2L);
+
+    // Authentication
+    curl_easy_setopt(curl_, CURLOPT_USERNAME, config_.smtp_user.c_str());
+    curl_easy_setopt(curl_, CURLOPT_PASSWORD, config_.smtp_pass.c_str());
+
+    // Email addresses
+    curl_easy_setopt(curl_, CURLOPT_MAIL_FROM, config_.from_address.c_str());
+
+    recipients_ = curl_slist_append(recipients_, config_.to_address.c_str());
+    curl_easy_setopt(curl_, CURLOPT_MAIL_RCPT, recipients_);
+
+    // Payload
+    curl_easy_setopt(curl_, CURLOPT_READFUNCTION, payloadSource);
+    curl_easy_setopt(curl_, CURLOPT_UPLOAD, 1L);
+
+    // Timeout
+    curl_easy_setopt(curl_, CURLOPT_TIMEOUT, 30L);
   }
 
   // Build email payload
@@ -118,6 +270,9 @@ bool EmailNotifier::sendEmail(const std::string &subject,
   payload_stream << "To: " << config_.to_address << "\r\n";
   payload_stream << "From: " << config_.from_address << "\r\n";
   payload_stream << "Subject: " << subject << "\r\n";
+  if (!message_id.empty()) {
+    payload_stream << "Message-ID: " << message_id << "\r\n";
+  }
   payload_stream << "Content-Type: text/plain; charset=UTF-8\r\n";
   payload_stream << "\r\n";
   payload_stream << body;
@@ -125,45 +280,16 @@ bool EmailNotifier::sendEmail(const std::string &subject,
   EmailPayload payload;
   payload.data = payload_stream.str();
 
-  // Set URL (smtp://server:port)
-  const std::string url =
-      fmt::format("smtp://{}:{}", config_.smtp_server, config_.smtp_port);
-  curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-
-  // TLS settings
-  curl_easy_setopt(curl, CURLOPT_USE_SSL, CURLUSESSL_ALL);
-  curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-  curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
-
-  // Authentication
-  curl_easy_setopt(curl, CURLOPT_USERNAME, config_.smtp_user.c_str());
-  curl_easy_setopt(curl, CURLOPT_PASSWORD, config_.smtp_pass.c_str());
-
-  // Email addresses
-  curl_easy_setopt(curl, CURLOPT_MAIL_FROM, config_.from_address.c_str());
-
-  struct curl_slist *recipients = nullptr;
-  recipients = curl_slist_append(recipients, config_.to_address.c_str());
-  curl_easy_setopt(curl, CURLOPT_MAIL_RCPT, recipients);
-
-  // Payload
-  curl_easy_setopt(curl, CURLOPT_READFUNCTION, payloadSource);
-  curl_easy_setopt(curl, CURLOPT_READDATA, &payload);
-  curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
-
-  // Timeout
-  curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
+  curl_easy_setopt(curl_, CURLOPT_READDATA, &payload);
 
   // Perform
-  const CURLcode res = curl_easy_perform(curl);
+  const CURLcode res = curl_easy_perform(curl_);
 
-  // Cleanup
-  curl_slist_free_all(recipients);
-  curl_easy_cleanup(curl);
+  // Don't leave a dangling pointer on the persistent handle
+  curl_easy_setopt(curl_, CURLOPT_READDATA, nullptr);
 
   if (res != CURLE_OK) {
-    infrastructure::Logger::instance().error(
-        fmt::format("SMTP failed: {}", curl_easy_strerror(res)));
+    LOG_ERROR("SMTP failed: {}", curl_easy_strerror(res));
     return false;
   }
 
@@ -3,19 +3,35 @@
 #include "notifier.hpp"
 #include "../../infrastructure/config_manager.hpp"
 #include <curl/curl.h>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace bluray::application::notifier {
 
 /**
  * Email notifier via SMTP
+ *
+ * Keeps one curl handle for its lifetime, so consecutive messages reuse the
+ * authenticated STARTTLS session instead of reconnecting per email.
+ *
+ * With email_digest_mode enabled, the events of a scrape run are delivered
+ * as a single digest email once the run completes. Message-IDs are derived
+ * from the events' idempotency keys, so redeliveries can be deduplicated.
  */
 class EmailNotifier : public INotifier {
 public:
     EmailNotifier();
     ~EmailNotifier();
 
-    void notify(const domain::ChangeEvent& event) override;
+    // Prevent copying (owns the curl handle)
+    EmailNotifier(const EmailNotifier&) = delete;
+    EmailNotifier& operator=(const EmailNotifier&) = delete;
+
+    std::string channel() const override;
+    bool notify(const domain::ChangeEvent& event) override;
+    size_t notifyBatch(const std::vector<domain::ChangeEvent>& events) override;
+    bool deliversPerRun() const override;
     bool isConfigured() const override;
 
 private:
@@ -26,6 +42,7 @@ private:
         std::string smtp_pass;
         std::string from_address;
         std::string to_address;
+        bool digest_mode{false};
     };
 
     struct EmailPayload {
@@ -37,9 +54,19 @@ private:
 
     std::string buildEmailBody(const domain::ChangeEvent& event) const;
     std::string buildSubject(const domain::ChangeEvent& event) const;
-    bool sendEmail(const std::string& subject, const std::string& body);
+    std::string buildDigestBody(const std::vector<domain::ChangeEvent>& events) const;
+    std::string buildDigestSubject(const std::vector<domain::ChangeEvent>& events) const;
+    void appendEventDetails(std::ostringstream& oss, const domain::ChangeEvent& event) const;
+    std::string messageId(const std::vector<domain::ChangeEvent>& events) const;
+
+    bool sendEmail(const std::string& subject, const std::string& body,
+                   const std::string& message_id);
 
     EmailConfig config_;
+
+    std::mutex mutex_;                        // Guards curl_
+    CURL* curl_{nullptr};                     // Persistent SMTP session
+    struct curl_slist* recipients_{nullptr};
 };
 
 } // namespace bluray::application::notifier
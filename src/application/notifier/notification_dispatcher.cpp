@@ -0,0 +1,238 @@
+#include "notification_dispatcher.hpp"
+#include "../../infrastructure/config_manager.hpp"
+#include "../../infrastructure/logger.hpp"
+#include "../../infrastructure/repositories/notification_outbox_repository.hpp"
+#include <algorithm>
+#include <fmt/format.h>
+
+namespace bluray::application::notifier {
+
+namespace {
+constexpr int kDefaultBatchWindowMs = 2000;
+constexpr int kDefaultMaxAttempts = 8;
+} // anonymous namespace
+
+NotificationDispatcher::NotificationDispatcher(
+    std::optional<std::chrono::milliseconds> batch_window)
+    : batch_window_(batch_window
+                        ? *batch_window
+                        : std::chrono::milliseconds(std::max(
+                              0, infrastructure::ConfigManager::instance().getInt(
+                                     "notification_batch_window_ms",
+                                     kDefaultBatchWindowMs)))),
+      max_attempts_(std::max(
+          1, infrastructure::ConfigManager::instance().getInt(
+                 "notification_max_attempts", kDefaultMaxAttempts))) {
+  worker_ = std::thread(&NotificationDispatcher::run, this);
+}
+
+NotificationDispatcher::~NotificationDispatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_cv_.notify_all();
+
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void NotificationDispatcher::addNotifier(std::shared_ptr<INotifier> notifier) {
+  if (!notifier) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    notifiers_.push_back(std::move(notifier));
+    // Rows left over from earlier processes may be waiting for this channel
+    wake_pending_ = true;
+  }
+  wake_cv_.notify_one();
+}
+
+std::vector<std::string> NotificationDispatcher::channels() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::vector<std::string> names;
+  names.reserve(notifiers_.size());
+  for (const auto &notifier : notifiers_) {
+    names.push_back(notifier->channel());
+  }
+  return names;
+}
+
+void NotificationDispatcher::notifyEnqueued(size_t count) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    metrics_.enqueued += count;
+    wake_pending_ = true;
+  }
+  wake_cv_.notify_one();
+}
+
+void NotificationDispatcher::markRunCompleted() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    run_completed_ = true;
+  }
+  wake_cv_.notify_one();
+}
+
+void NotificationDispatcher::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  // A pass already in progress may have missed rows committed just now
+  const uint64_t target = completed_passes_ + (delivering_ ? 2 : 1);
+  flush_requested_ = true;
+  wake_cv_.notify_one();
+
+  idle_cv_.wait(lock, [&] { return completed_passes_ >= target; });
+}
+
+NotificationDispatcher::Metrics NotificationDispatcher::getMetrics() const {
+  Metrics snapshot;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    snapshot = metrics_;
+  }
+
+  infrastructure::NotificationOutboxRepository outbox;
+  snapshot.queue_depth = static_cast<size_t>(outbox.countPending());
+  return snapshot;
+}
+
+void NotificationDispatcher::run() {
+  // Keep the outbox from growing without bound
+  infrastructure::NotificationOutboxRepository().pruneFinished();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    // Wake on new rows, run completion, flush or shutdown; otherwise poll
+    // periodically for rows whose retry time has come
+    wake_cv_.wait_for(lock, POLL_INTERVAL, [this] {
+      return stopping_ || wake_pending_ || run_completed_ || flush_requested_;
+    });
+
+    // Give the rest of a wave time to arrive, unless someone is waiting or
+    // the run has already ended
+    if (wake_pending_) {
+      wake_cv_.wait_for(lock, batch_window_, [this] {
+        return stopping_ || run_completed_ || flush_requested_;
+      });
+    }
+
+    const bool include_per_run = run_completed_ || stopping_;
+    const bool stop = stopping_;
+    wake_pending_ = false;
+    run_completed_ = false;
+    flush_requested_ = false;
+    delivering_ = true;
+
+    lock.unlock();
+    try {
+      deliverDue(include_per_run);
+    } catch (const std::exception &e) {
+      LOG_ERROR("Notification delivery pass failed: {}", e.what());
+    }
+    lock.lock();
+
+    delivering_ = false;
+    completed_passes_++;
+    idle_cv_.notify_all();
+
+    if (stop) {
+      break;
+    }
+  }
+}
+
+void NotificationDispatcher::deliverDue(bool include_per_run) {
+  std::vector<std::shared_ptr<INotifier>> notifiers;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    notifiers = notifiers_;
+  }
+
+  infrastructure::NotificationOutboxRepository outbox;
+
+  for (const auto &notifier : notifiers) {
+    const bool per_run = notifier->deliversPerRun();
+    if (per_run && !include_per_run) {
+      continue;
+    }
+
+    const std::string channel = notifier->channel();
+    const int limit = per_run ? MAX_RUN_BATCH_SIZE : MAX_BATCH_SIZE;
+
+    while (true) {
+      auto entries = outbox.claimDue(channel, limit, CLAIM_LEASE);
+      if (entries.empty()) {
+        break;
+      }
+
+      std::vector<domain::ChangeEvent> events;
+      events.reserve(entries.size());
+      for (const auto &entry : entries) {
+        events.push_back(entry.event);
+      }
+
+      size_t delivered = 0;
+      uint64_t errors = 0;
+      std::string error = "notifier reported failure";
+      try {
+        delivered = std::min(notifier->notifyBatch(events), entries.size());
+      } catch (const std::exception &e) {
+        errors++;
+        error = e.what();
+        LOG_ERROR("Notifier '{}' failed for batch of {} event(s): {}", channel,
+                  events.size(), e.what());
+      }
+
+      const auto now = std::chrono::system_clock::now();
+      uint64_t retries = 0;
+      uint64_t given_up = 0;
+
+      for (size_t i = 0; i < entries.size(); ++i) {
+        if (i < delivered) {
+          outbox.markDelivered(entries[i].id);
+        } else if (outbox.markFailed(entries[i].id, error, max_attempts_)) {
+          retries++;
+        } else {
+          given_up++;
+          LOG_ERROR("Giving up on {} notification after {} attempts: {}",
+                    channel, max_attempts_, entries[i].event.describe());
+        }
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        metrics_.batches++;
+        metrics_.notifier_errors += errors;
+        metrics_.retries += retries;
+        metrics_.given_up += given_up;
+        for (size_t i = 0; i < delivered; ++i) {
+          const auto latency =
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                  now - entries[i].event.detected_at);
+          metrics_.dispatched++;
+          metrics_.last_latency = latency;
+          metrics_.max_latency = std::max(metrics_.max_latency, latency);
+          total_latency_ += latency;
+        }
+        if (metrics_.dispatched > 0) {
+          metrics_.avg_latency = total_latency_ / metrics_.dispatched;
+        }
+      }
+
+      // The channel is failing; leave the rest to the backoff schedule
+      if (delivered < entries.size()) {
+        break;
+      }
+    }
+  }
+}
+
+} // namespace bluray::application::notifier
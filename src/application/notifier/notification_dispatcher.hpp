@@ -0,0 +1,140 @@
+#pragma once
+
+#include "notifier.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bluray::application::notifier {
+
+/**
+ * Asynchronous notification dispatcher (outbox delivery worker)
+ *
+ * Change events are written to the notification_outbox table in the same
+ * transaction as the wishlist update that produced them (see Scheduler).
+ * This dispatcher's thread claims due rows per channel, hands them to the
+ * matching notifier and records the outcome: delivered rows are marked
+ * done, failed rows are retried with exponential backoff. Scrape workers
+ * never wait on Discord or SMTP, and an outage or crash no longer loses
+ * notifications - rows left behind are picked up by the next worker.
+ *
+ * After a wake-up, the dispatcher waits for the batch window so that a wave
+ * of price drops is delivered as a few aggregated messages. Channels that
+ * deliver per run (email digests) are only drained once the run completes.
+ *
+ * A final delivery pass runs before the dispatcher is destroyed, so
+ * one-shot modes (--scrape) still deliver everything they detected.
+ */
+class NotificationDispatcher {
+public:
+    /**
+     * Dispatch metrics snapshot (counters are per process)
+     */
+    struct Metrics {
+        size_t queue_depth{0};        // Outbox rows still pending
+        uint64_t enqueued{0};         // Outbox rows written by this process
+        uint64_t dispatched{0};       // Rows delivered
+        uint64_t retries{0};          // Failed attempts scheduled for retry
+        uint64_t given_up{0};         // Rows that ran out of attempts
+        uint64_t notifier_errors{0};  // Notifier calls that threw
+        uint64_t batches{0};
+        // Time from detection until delivery (incl. batching and retries)
+        std::chrono::milliseconds last_latency{0};
+        std::chrono::milliseconds avg_latency{0};
+        std::chrono::milliseconds max_latency{0};
+    };
+
+    /**
+     * Constructor - starts the dispatcher thread
+     * @param batch_window How long to collect events before delivering
+     *                     (nullopt = notification_batch_window_ms from
+     *                     config, default 2000)
+     */
+    explicit NotificationDispatcher(
+        std::optional<std::chrono::milliseconds> batch_window = std::nullopt);
+
+    /**
+     * Destructor - runs a final delivery pass, then stops the thread
+     */
+    ~NotificationDispatcher();
+
+    // Prevent copying
+    NotificationDispatcher(const NotificationDispatcher&) = delete;
+    NotificationDispatcher& operator=(const NotificationDispatcher&) = delete;
+
+    /**
+     * Add notifier to receive dispatched events
+     */
+    void addNotifier(std::shared_ptr<INotifier> notifier);
+
+    /**
+     * Channel names of all registered notifiers (one outbox row each)
+     */
+    [[nodiscard]] std::vector<std::string> channels() const;
+
+    /**
+     * Signal that outbox rows were committed; wakes the worker
+     * @param count Number of rows written
+     */
+    void notifyEnqueued(size_t count);
+
+    /**
+     * Mark the end of a scrape run
+     * Per-run channels are drained on the next delivery pass. Does not wait.
+     */
+    void markRunCompleted();
+
+    /**
+     * Block until a delivery pass started after this call has finished
+     */
+    void flush();
+
+    /**
+     * Get metrics snapshot
+     */
+    [[nodiscard]] Metrics getMetrics() const;
+
+private:
+    void run();
+
+    /**
+     * Deliver all due outbox rows
+     * @param include_per_run Also drain channels that deliver per run
+     */
+    void deliverDue(bool include_per_run);
+
+    const std::chrono::milliseconds batch_window_;
+    const int max_attempts_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_cv_;  // Signals work / shutdown
+    std::condition_variable idle_cv_;  // Signals a completed pass
+    std::vector<std::shared_ptr<INotifier>> notifiers_;
+    bool wake_pending_{false};
+    bool run_completed_{false};
+    bool flush_requested_{false};
+    bool delivering_{false};
+    bool stopping_{false};
+    uint64_t completed_passes_{0};
+
+    Metrics metrics_;
+    std::chrono::milliseconds total_latency_{0};
+
+    std::thread worker_;
+
+    // Retry poll interval when nothing wakes the worker
+    static constexpr std::chrono::seconds POLL_INTERVAL{15};
+    // How long claimed rows are reserved for this worker
+    static constexpr std::chrono::seconds CLAIM_LEASE{300};
+    // Rows handed to a notifier at once (per-run channels get a whole run)
+    static constexpr int MAX_BATCH_SIZE = 100;
+    static constexpr int MAX_RUN_BATCH_SIZE = 1000;
+};
+
+} // namespace bluray::application::notifier
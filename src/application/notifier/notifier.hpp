@@ -1,31 +1,55 @@
 #pragma once
 
 #include "../../domain/models.hpp"
-#include "../../domain/change_detector.hpp"
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace bluray::application::notifier {
 
 /**
  * Abstract notifier interface (Strategy pattern)
  */
-class INotifier : public domain::IChangeObserver {
+class INotifier {
 public:
     virtual ~INotifier() = default;
 
+    /**
+     * Stable channel name, used to key outbox rows (e.g. "discord")
+     */
+    virtual std::string channel() const = 0;
+
     /**
      * Send notification about change event
+     * @return true if the channel accepted the notification
      */
-    virtual void notify(const domain::ChangeEvent& event) = 0;
+    virtual bool notify(const domain::ChangeEvent& event) = 0;
 
     /**
-     * IChangeObserver implementation
+     * Send notifications for several change events at once
+     * Channels that can aggregate messages override this; the default sends
+     * each event individually.
+     *
+     * @return Number of leading events that were delivered; delivery stops
+     *         at the first failure so the rest can be retried
      */
-    void onChangeDetected(const domain::ChangeEvent& event) override {
-        notify(event);
+    virtual size_t notifyBatch(const std::vector<domain::ChangeEvent>& events) {
+        size_t delivered = 0;
+        for (const auto& event : events) {
+            if (!notify(event)) {
+                break;
+            }
+            delivered++;
+        }
+        return delivered;
     }
 
+    /**
+     * Whether events should be held back until the scrape run completes
+     * and then delivered in a single batch (e.g. email digests)
+     */
+    virtual bool deliversPerRun() const { return false; }
+
     /**
      * Check if notifier is configured and ready
      */
@@ -1,8 +1,16 @@
 #include "scheduler.hpp"
+#include "../infrastructure/change_feed.hpp"
 #include "../infrastructure/config_manager.hpp"
+#include "../infrastructure/database_manager.hpp"
 #include "../infrastructure/logger.hpp"
+#include "../infrastructure/repositories/alert_rule_repository.hpp"
+#include "../infrastructure/repositories/notification_outbox_repository.hpp"
 #include "../infrastructure/repositories/price_history_repository.hpp"
+#include "../infrastructure/repositories/price_stats_repository.hpp"
+#include "../infrastructure/repositories/product_repository.hpp"
 #include "../infrastructure/repositories/release_calendar_repository.hpp"
+#include "event_bus.hpp"
+#include "matching/release_matcher.hpp"
 #include "scraper/bluray_com_scraper.hpp"
 #include "scraper/scraper.hpp"
 #include <algorithm>
@@ -19,22 +27,49 @@ using namespace repositories;
 Scheduler::Scheduler() {
   // Load configuration
   auto &config = infrastructure::ConfigManager::instance();
-  delay_seconds_ = config.getInt("scrape_delay_seconds", 8);
+  applyScrapeSettings(*config.snapshot());
+
+  // Re-tune between requests of a running scrape when settings change
+  config_subscription_ = config.subscribe(
+      {"scrape_delay_seconds", "scrape_concurrency"},
+      [this](const ConfigSnapshot &snapshot) {
+        applyScrapeSettings(snapshot);
+        LOG_INFO("Scrape settings changed (delay: {}s, concurrency: {})",
+                 delay_seconds_.load(), concurrency_.load());
+      });
 
   const std::string cache_dir = config.get("cache_directory", "./cache");
   image_cache_ = std::make_unique<ImageCache>(cache_dir);
 
-  Logger::instance().info(
-      fmt::format("Scheduler initialized (delay: {}s)", delay_seconds_));
+  // Notifiers run on the dispatcher thread, never on scrape workers; events
+  // reach it through the notification outbox (see updateWishlistItem)
+  notification_dispatcher_ = std::make_shared<notifier::NotificationDispatcher>();
+
+  LOG_INFO("Scheduler initialized (delay: {}s, concurrency: {})",
+           delay_seconds_.load(), concurrency_.load());
+}
+
+Scheduler::~Scheduler() {
+  ConfigManager::instance().unsubscribe(config_subscription_);
+}
+
+void Scheduler::applyScrapeSettings(const ConfigSnapshot &snapshot) {
+  delay_seconds_ = std::max(0, snapshot.getInt("scrape_delay_seconds", 8));
+  concurrency_ = std::clamp(snapshot.getInt("scrape_concurrency", 4), 1, 16);
 }
 
 void Scheduler::addNotifier(std::shared_ptr<notifier::INotifier> notifier) {
   if (notifier && notifier->isConfigured()) {
-    change_detector_.addObserver(notifier);
-    Logger::instance().info("Notifier added to scheduler");
+    notification_dispatcher_->addNotifier(notifier);
+    LOG_INFO("Notifier added to scheduler");
   }
 }
 
+notifier::NotificationDispatcher::Metrics
+Scheduler::getNotificationMetrics() const {
+  return notification_dispatcher_->getMetrics();
+}
+
 Scheduler::ScrapeProgress Scheduler::getScrapeProgress() const {
   return {scrape_processed_.load(), scrape_total_.load(), is_running_.load()};
 }
@@ -43,41 +78,51 @@ int Scheduler::getScrapeDelay() const { return delay_seconds_; }
 
 int Scheduler::runOnce() {
   if (is_running_.exchange(true)) {
-    Logger::instance().warning("Scrape already in progress");
+    LOG_WARNING("Scrape already in progress");
     return 0;
   }
 
-  Logger::instance().info("Starting scrape run");
+  LOG_INFO("Starting scrape run");
+  const auto run_started = std::chrono::steady_clock::now();
 
   SqliteWishlistRepository repo;
   auto wishlist_items = repo.findAll();
 
   if (wishlist_items.empty()) {
-    Logger::instance().info("No items in wishlist to scrape");
+    LOG_INFO("No items in wishlist to scrape");
     is_running_ = false;
     return 0;
   }
 
-  Logger::instance().info(
-      fmt::format("Scraping {} wishlist items", wishlist_items.size()));
+  LOG_INFO("Scraping {} wishlist items", wishlist_items.size());
 
   scrape_total_ = static_cast<int>(wishlist_items.size());
   scrape_processed_ = 0;
 
+  // Compile the current alert rules once for this run
+  rule_engine_.load(SqliteAlertRuleRepository().findEnabled());
+  {
+    std::lock_guard<std::mutex> lock(run_changes_mutex_);
+    run_changes_.clear();
+  }
+
   // Counters for this run
   std::atomic<int> processed_count{0};
   std::atomic<int> success_count{0};
   std::atomic<int> error_count{0};
 
-  // Concurrency limit
-  const int kConcurrency = 4;
   std::vector<std::future<void>> futures;
 
   auto process_item = [&](domain::WishlistItem item) {
-    Logger::instance().debug(fmt::format("Scraping: {}", item.url));
+    LOG_DEBUG("Scraping: {}", item.url);
+    const auto started = std::chrono::steady_clock::now();
 
     // Scrape product
     auto result = scrapeProduct(item.url);
+    const auto duration_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - started)
+            .count();
 
     if (result.success) {
       // Cache image if available
@@ -89,12 +134,21 @@ int Scheduler::runOnce() {
         }
       }
 
+      LOG_INFO({{"source", result.product.source.str()},
+                {"item_id", item.id},
+                {"duration_ms", duration_ms},
+                {"price_cents", result.product.price.cents()},
+                {"in_stock", result.product.in_stock}},
+               "Scraped {}", item.title);
+
       // Update wishlist item
       updateWishlistItem(repo, item, result.product);
       success_count++;
     } else {
-      Logger::instance().warning(fmt::format("Failed to scrape {}: {}",
-                                             item.url, result.error_message));
+      LOG_WARNING({{"source", item.source.str()},
+                   {"item_id", item.id},
+                   {"duration_ms", duration_ms}},
+                  "Failed to scrape {}: {}", item.url, result.error_message);
       error_count++;
     }
     processed_count++;
@@ -111,12 +165,12 @@ int Scheduler::runOnce() {
                                  }),
                   futures.end());
 
-    if (futures.size() >= kConcurrency) {
+    // Concurrency limit (may have been lowered while running)
+    const auto concurrency = static_cast<size_t>(concurrency_.load());
+    while (futures.size() >= concurrency) {
       // Wait for the oldest one to finish to keep pool size stable
-      if (!futures.empty()) {
-        futures.front().wait();
-        futures.erase(futures.begin());
-      }
+      futures.front().wait();
+      futures.erase(futures.begin());
     }
     futures.push_back(
         std::async(std::launch::async, process_item, wishlist_items[i]));
@@ -124,14 +178,14 @@ int Scheduler::runOnce() {
     // Rate limiting: Throttle the launch rate
     // Start with configured delay divided by concurrency to spread requests out
     // But ensure at least some delay between requests if delay_seconds > 0
-    if (delay_seconds_ > 0) {
-      int throttle_ms = (delay_seconds_ * 1000) / kConcurrency;
+    const int delay_seconds = delay_seconds_.load();
+    if (delay_seconds > 0) {
+      int throttle_ms = (delay_seconds * 1000) / static_cast<int>(concurrency);
       // Clamp to reasonable minimum if user has configured a delay
       if (throttle_ms < 1000)
         throttle_ms = 1000;
 
-      Logger::instance().debug(
-          fmt::format("Throttling request for {}ms", throttle_ms));
+      LOG_DEBUG("Throttling request for {}ms", throttle_ms);
       std::this_thread::sleep_for(std::chrono::milliseconds(throttle_ms));
     }
   }
@@ -141,22 +195,99 @@ int Scheduler::runOnce() {
     f.wait();
   }
 
+  evaluateAlertRules();
+
+  // Let per-run notifiers (email digest) send what this run collected
+  notification_dispatcher_->markRunCompleted();
+
+  // Cron scrapes write change_log rows with no feed of their own to prune
+  // them
+  try {
+    ChangeFeed::prune();
+  } catch (const std::exception &e) {
+    LOG_WARNING("Failed to prune change log: {}", e.what());
+  }
+
   is_running_ = false;
 
-  Logger::instance().info(fmt::format(
-      "Scrape run completed: {} processed, {} succeeded, {} failed",
-      processed_count.load(), success_count.load(), error_count.load()));
+  const auto run_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now() - run_started)
+                          .count();
+  LOG_INFO({{"processed", processed_count.load()},
+            {"succeeded", success_count.load()},
+            {"failed", error_count.load()},
+            {"duration_ms", run_ms}},
+           "Scrape run completed: {} processed, {} succeeded, {} failed",
+           processed_count.load(), success_count.load(), error_count.load());
 
   return processed_count.load();
 }
 
+std::vector<alerts::RuleStats> Scheduler::getAlertRuleStats() const {
+  return rule_engine_.getStats();
+}
+
+void Scheduler::evaluateAlertRules() {
+  std::vector<domain::ChangeEvent> changes;
+  {
+    std::lock_guard<std::mutex> lock(run_changes_mutex_);
+    changes.swap(run_changes_);
+  }
+  if (changes.empty() || rule_engine_.empty()) {
+    return;
+  }
+
+  const auto matches = rule_engine_.evaluate(changes);
+  if (matches.empty()) {
+    return;
+  }
+
+  const auto channels = notification_dispatcher_->channels();
+  int queued = 0;
+  {
+    auto &db = DatabaseManager::instance();
+    auto lock = db.lock();
+
+    try {
+      WriteTransaction transaction(db);
+      NotificationOutboxRepository outbox;
+
+      for (const auto &match : matches) {
+        LOG_INFO("Alert rule matched: {}", match.event.describe());
+
+        // Rules may restrict delivery to some of the configured channels
+        std::vector<std::string> targets;
+        for (const auto &channel : channels) {
+          if (match.channels.empty() ||
+              std::find(match.channels.begin(), match.channels.end(),
+                        channel) != match.channels.end()) {
+            targets.push_back(channel);
+          }
+        }
+        if (!targets.empty()) {
+          queued += outbox.enqueue(match.event, targets);
+        }
+      }
+
+      transaction.commit();
+    } catch (const std::exception &e) {
+      LOG_ERROR("Failed to queue alert rule notifications: {}", e.what());
+      return;
+    }
+  }
+
+  if (queued > 0) {
+    notification_dispatcher_->notifyEnqueued(static_cast<size_t>(queued));
+  }
+}
+
 int Scheduler::scrapeReleaseCalendar() {
   auto &config = ConfigManager::instance();
 
   // Check if calendar scraping is enabled
   const bool enabled = config.getInt("bluray_calendar_enabled", 1) != 0;
   if (!enabled) {
-    Logger::instance().info("Release calendar scraping is disabled");
+    LOG_INFO("Release calendar scraping is disabled");
     return 0;
   }
 
@@ -164,9 +295,8 @@ int Scheduler::scrapeReleaseCalendar() {
       "bluray_calendar_url", "https://www.blu-ray.com/movies/releasedates.php");
   const int days_ahead = config.getInt("bluray_calendar_days_ahead", 90);
 
-  Logger::instance().info(
-      fmt::format("Scraping release calendar from: {} ({} days ahead)",
-                  calendar_url, days_ahead));
+  LOG_INFO("Scraping release calendar from: {} ({} days ahead)", calendar_url,
+           days_ahead);
 
   // Create scraper and fetch calendar
   scraper::BluRayComScraper scraper;
@@ -175,17 +305,16 @@ int Scheduler::scrapeReleaseCalendar() {
   try {
     releases = scraper.scrapeReleaseCalendar(calendar_url);
   } catch (const std::exception &e) {
-    Logger::instance().error(
-        fmt::format("Failed to scrape release calendar: {}", e.what()));
+    LOG_ERROR("Failed to scrape release calendar: {}", e.what());
     return 0;
   }
 
   if (releases.empty()) {
-    Logger::instance().warning("No releases found in calendar");
+    LOG_WARNING("No releases found in calendar");
     return 0;
   }
 
-  Logger::instance().info(fmt::format("Found {} releases", releases.size()));
+  LOG_INFO("Found {} releases", releases.size());
 
   // Filter releases by date range (only keep upcoming releases within
   // configured days)
@@ -207,9 +336,8 @@ int Scheduler::scrapeReleaseCalendar() {
     }
   }
 
-  Logger::instance().info(
-      fmt::format("Filtered to {} upcoming releases (within {} days)",
-                  filtered_releases.size(), days_ahead));
+  LOG_INFO("Filtered to {} upcoming releases (within {} days)",
+           filtered_releases.size(), days_ahead);
 
   // Update database
   SqliteReleaseCalendarRepository repo;
@@ -251,9 +379,17 @@ int Scheduler::scrapeReleaseCalendar() {
     }
   }
 
-  Logger::instance().info(
-      fmt::format("Calendar update complete: {} added, {} updated", added_count,
-                  updated_count));
+  LOG_INFO("Calendar update complete: {} added, {} updated", added_count,
+           updated_count);
+
+  matching::ReleaseMatcher().refresh();
+
+  EventBus::instance().publish(std::make_shared<const domain::CalendarUpdatedEvent>(
+      domain::CalendarUpdatedEvent{
+          .releases_found = static_cast<int>(filtered_releases.size()),
+          .added = added_count,
+          .updated = updated_count,
+          .updated_at = std::chrono::system_clock::now()}));
 
   return static_cast<int>(filtered_releases.size());
 }
@@ -292,12 +428,11 @@ void Scheduler::updateWishlistItem(SqliteWishlistRepository &repo,
   if (!old_item.title_locked && !product.title.empty()) {
     updated_item.title = product.title;
   }
-  if (product.price > 0.01) {
+  if (product.price.isPositive()) {
     updated_item.current_price = product.price;
-  } else if (product.in_stock && product.price < 0.01) {
+  } else if (product.in_stock) {
     // If in stock but price is 0, likely a scraper parsing error. Log it.
-    Logger::instance().warning(
-        fmt::format("Scraped 0 price for in-stock item: {}", product.title));
+    LOG_WARNING("Scraped 0 price for in-stock item: {}", product.title);
   }
   updated_item.in_stock = product.in_stock;
   updated_item.is_uhd_4k = product.is_uhd_4k;
@@ -324,27 +459,87 @@ void Scheduler::updateWishlistItem(SqliteWishlistRepository &repo,
 
   // Detect changes before updating
   auto changes = change_detector_.detectChanges(old_item, updated_item);
+  const auto channels = notification_dispatcher_->channels();
+
+  // Update in database, recording price history and queuing notifications
+  // in the same transaction: an event is stored if and only if the change is
+  // The series backend writes files, so it is appended to only once the
+  // transaction committed and the database lock is released
+  const auto history_backend =
+      infrastructure::PriceHistoryRepository::configuredBackend();
+  infrastructure::PriceHistoryRepository history_repo(history_backend);
+  int queued = 0;
+  {
+    auto &db = DatabaseManager::instance();
+    auto lock = db.lock();
+
+    try {
+      WriteTransaction transaction(db);
+
+      if (!repo.update(updated_item)) {
+        LOG_ERROR("Failed to update wishlist item: {}", updated_item.url);
+        return;
+      }
 
-  // Update in database
-  if (!repo.update(updated_item)) {
-    Logger::instance().error(
-        fmt::format("Failed to update wishlist item: {}", updated_item.url));
-    return;
+      // Link offers of the same disc; the best price follows via triggers
+      infrastructure::ProductRepository product_repo;
+      product_repo.link(updated_item.id, product);
+
+      // Record price history
+      if (history_backend == infrastructure::PriceHistoryBackend::Sqlite) {
+        history_repo.addEntry(updated_item.id, updated_item.current_price,
+                              updated_item.in_stock);
+      }
+      infrastructure::PriceStatsRepository stats_repo;
+      stats_repo.record(updated_item.id, updated_item.current_price,
+                        std::chrono::system_clock::now());
+
+      if (!channels.empty()) {
+        NotificationOutboxRepository outbox;
+        for (const auto &change : changes) {
+          if (domain::ChangeDetector::shouldNotify(change)) {
+            queued += outbox.enqueue(change, channels);
+          }
+        }
+      }
+
+      transaction.commit();
+    } catch (const std::exception &e) {
+      LOG_ERROR("Failed to update wishlist item {}: {}", updated_item.url,
+                e.what());
+      return;
+    }
   }
 
-  // Record price history
-  infrastructure::PriceHistoryRepository history_repo;
-  history_repo.addEntry(updated_item.id, updated_item.current_price,
-                        updated_item.in_stock);
+  if (history_backend == infrastructure::PriceHistoryBackend::Series) {
+    history_repo.addEntry(updated_item.id, updated_item.current_price,
+                          updated_item.in_stock);
+  }
+
+  if (queued > 0) {
+    notification_dispatcher_->notifyEnqueued(static_cast<size_t>(queued));
+  }
 
   // Log changes
   if (!changes.empty()) {
-    Logger::instance().info(fmt::format("Detected {} change(s) for: {}",
-                                        changes.size(), updated_item.title));
+    LOG_INFO("Detected {} change(s) for: {}", changes.size(),
+             updated_item.title);
     for (const auto &change : changes) {
-      Logger::instance().info(fmt::format("  - {}", change.describe()));
+      LOG_INFO("  - {}", change.describe());
     }
   }
+
+  // Keep the run's changes for batch rule evaluation
+  if (!changes.empty()) {
+    std::lock_guard<std::mutex> lock(run_changes_mutex_);
+    run_changes_.insert(run_changes_.end(), changes.begin(), changes.end());
+  }
+
+  // Publish committed changes; subscribers share the event and item snapshot
+  auto &bus = EventBus::instance();
+  for (auto &change : changes) {
+    bus.publish(std::make_shared<const domain::ChangeEvent>(std::move(change)));
+  }
 }
 
 } // namespace bluray::application
@@ -2,11 +2,16 @@
 
 #include "../domain/change_detector.hpp"
 #include "../domain/models.hpp"
+#include "../infrastructure/config_manager.hpp"
 #include "../infrastructure/image_cache.hpp"
 #include "../infrastructure/repositories/wishlist_repository.hpp"
+#include "alerts/rule_engine.hpp"
+#include "notifier/notification_dispatcher.hpp"
 #include "notifier/notifier.hpp"
 #include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace bluray::application {
 
@@ -16,6 +21,7 @@ namespace bluray::application {
 class Scheduler {
 public:
   Scheduler();
+  ~Scheduler();
 
   /**
    * Run scraping once for all wishlist items
@@ -31,11 +37,22 @@ public:
 
   /**
    * Add notifier to receive change notifications
+   * Notifiers are invoked asynchronously by the notification dispatcher
    */
   void addNotifier(std::shared_ptr<notifier::INotifier> notifier);
 
   /**
-   * Get scrape delay in seconds from config
+   * Get notification queue depth and dispatch latency metrics
+   */
+  notifier::NotificationDispatcher::Metrics getNotificationMetrics() const;
+
+  /**
+   * Get evaluation cost and match counts of the loaded alert rules
+   */
+  std::vector<alerts::RuleStats> getAlertRuleStats() const;
+
+  /**
+   * Get scrape delay in seconds from config (follows live changes)
    */
   int getScrapeDelay() const;
 
@@ -57,7 +74,14 @@ private:
     std::string error_message;
   };
 
-  int delay_seconds_{8};
+  /**
+   * Read scrape delay and concurrency from a config snapshot
+   */
+  void applyScrapeSettings(const infrastructure::ConfigSnapshot &snapshot);
+
+  std::atomic<int> delay_seconds_{8};
+  std::atomic<int> concurrency_{4};
+  infrastructure::ConfigManager::SubscriptionId config_subscription_{0};
   std::atomic<bool> is_running_{false};
   std::atomic<int> scrape_total_{0};
   std::atomic<int> scrape_processed_{0};
@@ -67,7 +91,20 @@ private:
       infrastructure::repositories::SqliteWishlistRepository &repo,
       const domain::WishlistItem &old_item, const domain::Product &product);
 
+  /**
+   * Evaluate alert rules against the changes of the finished run and queue
+   * a notification per match
+   */
+  void evaluateAlertRules();
+
   domain::ChangeDetector change_detector_;
+  alerts::RuleEngine rule_engine_;
+
+  // Changes detected during the current run (for alert rules)
+  std::mutex run_changes_mutex_;
+  std::vector<domain::ChangeEvent> run_changes_;
+
+  std::shared_ptr<notifier::NotificationDispatcher> notification_dispatcher_;
   std::unique_ptr<infrastructure::ImageCache> image_cache_;
 };
 
@@ -1,5 +1,6 @@
 #include "amazon_nl_scraper.hpp"
 #include "../../infrastructure/logger.hpp"
+#include "product_identifiers.hpp"
 #include <algorithm>
 #include <cctype>
 #include <cstring>
@@ -15,23 +16,25 @@ bool AmazonNlScraper::canHandle(std::string_view url) const {
 std::optional<domain::Product> AmazonNlScraper::scrape(std::string_view url) {
   using namespace infrastructure;
 
-  Logger::instance().info(fmt::format("Scraping Amazon.nl: {}", url));
+  LOG_INFO("Scraping Amazon.nl: {}", url);
 
   // Fetch HTML
   auto response = client_.get(url);
   if (!response.success) {
-    Logger::instance().error(
-        fmt::format("Failed to fetch Amazon.nl page: {} (status: {})", url,
-                    response.status_code));
+    LOG_ERROR("Failed to fetch Amazon.nl page: {} (status: {})", url,
+              response.status_code);
     return std::nullopt;
   }
 
   // Parse HTML
   auto scraped_data = parseHtml(response.body);
   if (!scraped_data) {
-    Logger::instance().error("Failed to parse Amazon.nl HTML");
+    LOG_ERROR("Failed to parse Amazon.nl HTML");
     return std::nullopt;
   }
+  if (scraped_data->asin.empty()) {
+    scraped_data->asin = asinFromUrl(url).value_or("");
+  }
 
   // Build Product
   domain::Product product{.url = std::string(url),
@@ -41,11 +44,17 @@ std::optional<domain::Product> AmazonNlScraper::scrape(std::string_view url) {
                           .is_uhd_4k = scraped_data->is_uhd_4k,
                           .image_url = scraped_data->image_url,
                           .last_updated = std::chrono::system_clock::now(),
-                          .source = std::string(getSource())};
-
-  Logger::instance().info(fmt::format(
-      "Successfully scraped: {} (€{:.2f}, stock: {}, UHD: {})", product.title,
-      product.price, product.in_stock, product.is_uhd_4k));
+                          .source = std::string(getSource()),
+                          .ean = scraped_data->ean,
+                          .asin = scraped_data->asin};
+
+  LOG_DEBUG({{"source", product.source.str()},
+             {"price_cents", product.price.cents()},
+             {"in_stock", product.in_stock},
+             {"is_uhd_4k", product.is_uhd_4k},
+             {"ean", product.ean},
+             {"asin", product.asin}},
+            "Successfully scraped: {}", product.title);
 
   return product;
 }
@@ -83,6 +92,9 @@ AmazonNlScraper::parseHtml(const std::string &html) {
     data.image_url = *image_url;
   }
 
+  // Extract EAN and ASIN (identify the disc across retailers)
+  extractIdentifiers(output->root, html, data);
+
   gumbo_destroy_output(&kGumboDefaultOptions, output);
   return data;
 }
@@ -115,7 +127,7 @@ std::optional<std::string> AmazonNlScraper::extractTitle(GumboNode *root) {
   return std::nullopt;
 }
 
-std::optional<double> AmazonNlScraper::extractPrice(GumboNode *root) {
+std::optional<domain::Money> AmazonNlScraper::extractPrice(GumboNode *root) {
   // Try multiple price selectors
   const char *price_classes[] = {"a-price-whole", "a-offscreen", "a-price"};
 
@@ -134,12 +146,8 @@ std::optional<double> AmazonNlScraper::extractPrice(GumboNode *root) {
             std::regex price_regex(R"((\d+)[,.](\d+))");
             std::smatch match;
             if (std::regex_search(price_text, match, price_regex)) {
-              try {
-                double euros = std::stod(match[1].str());
-                double cents = std::stod(match[2].str()) / 100.0;
-                return euros + cents;
-              } catch (...) {
-                continue;
+              if (auto price = domain::Money::parse(match.str())) {
+                return price;
               }
             }
           }
@@ -224,6 +232,22 @@ std::optional<std::string> AmazonNlScraper::extractImageUrl(GumboNode *root) {
   return std::nullopt;
 }
 
+void AmazonNlScraper::extractIdentifiers(GumboNode *root,
+                                         const std::string &html,
+                                         ScrapedData &data) {
+  // Hidden form field of the buy box
+  if (auto *node = findElementById(root, "ASIN")) {
+    GumboAttribute *value_attr =
+        gumbo_get_attribute(&node->v.element.attributes, "value");
+    if (value_attr && value_attr->value) {
+      data.asin = normalizeAsin(value_attr->value).value_or("");
+    }
+  }
+
+  // "EAN : 5051892239659" in the product details
+  data.ean = gtinFromText(html).value_or("");
+}
+
 GumboNode *AmazonNlScraper::findElementById(GumboNode *node, const char *id) {
   if (node->type != GUMBO_NODE_ELEMENT) {
     return nullptr;
@@ -21,8 +21,7 @@ std::vector<domain::ReleaseCalendarItem>
 BluRayComScraper::scrapeReleaseCalendar(std::string_view url) {
   using namespace infrastructure;
 
-  Logger::instance().info(
-      fmt::format("Scraping blu-ray.com release calendar: {}", url));
+  LOG_INFO("Scraping blu-ray.com release calendar: {}", url);
 
   // Use NetworkClient with proper headers
   NetworkClient client;
@@ -30,18 +29,16 @@ BluRayComScraper::scrapeReleaseCalendar(std::string_view url) {
   // Fetch HTML with custom user agent to avoid 403 errors
   auto response = client.get(url);
   if (!response.success) {
-    Logger::instance().error(fmt::format(
-        "Failed to fetch blu-ray.com release calendar: {} (status: {})", url,
-        response.status_code));
+    LOG_ERROR("Failed to fetch blu-ray.com release calendar: {} (status: {})",
+              url, response.status_code);
     return {};
   }
 
   // Parse HTML
   auto items = parseReleaseCalendarPage(response.body);
 
-  Logger::instance().info(fmt::format(
-      "Successfully scraped {} release calendar items from blu-ray.com",
-      items.size()));
+  LOG_INFO("Successfully scraped {} release calendar items from blu-ray.com",
+           items.size());
 
   return items;
 }
@@ -52,8 +49,7 @@ BluRayComScraper::parseReleaseCalendarPage(const std::string &html) {
 
   GumboOutput *output = gumbo_parse(html.c_str());
   if (!output) {
-    infrastructure::Logger::instance().error(
-        "Failed to parse blu-ray.com HTML");
+    LOG_ERROR("Failed to parse blu-ray.com HTML");
     return items;
   }
 
@@ -66,8 +62,7 @@ BluRayComScraper::parseReleaseCalendarPage(const std::string &html) {
     parseDivReleases(output->root, items);
   }
 
-  infrastructure::Logger::instance().info(
-      fmt::format("Parsed {} release calendar items from HTML", items.size()));
+  LOG_INFO("Parsed {} release calendar items from HTML", items.size());
 
   gumbo_destroy_output(&kGumboDefaultOptions, output);
   return items;
@@ -294,11 +289,19 @@ std::optional<domain::ReleaseCalendarItem> BluRayComScraper::parseReleaseItem(
   try {
     item.title = title;
     item.release_date = parseReleaseDate(release_date_str);
-    item.format = format;
+    item.is_uhd_4k = isUHD4K(format);
+    // The format cell is free text; keep one of the known formats so only
+    // those are interned
+    if (item.is_uhd_4k) {
+      item.format = "UHD 4K";
+    } else if (format.find("3D") != std::string::npos) {
+      item.format = "3D Blu-ray";
+    } else {
+      item.format = "Blu-ray";
+    }
     item.studio = studio;
     item.image_url = image_url;
     item.product_url = product_url;
-    item.is_uhd_4k = isUHD4K(format);
     item.price = parsePrice(price_str);
 
     // Determine if it's a preorder based on release date
@@ -310,8 +313,7 @@ std::optional<domain::ReleaseCalendarItem> BluRayComScraper::parseReleaseItem(
 
     return item;
   } catch (const std::exception &e) {
-    infrastructure::Logger::instance().error(
-        fmt::format("Failed to parse release item: {}", e.what()));
+    LOG_ERROR("Failed to parse release item: {}", e.what());
     return std::nullopt;
   }
 }
@@ -327,27 +329,8 @@ bool BluRayComScraper::isUHD4K(std::string_view format) const {
          format_lower.find("ultra hd") != std::string::npos;
 }
 
-double BluRayComScraper::parsePrice(std::string_view price_str) const {
-  if (price_str.empty()) {
-    return 0.0;
-  }
-
-  // Remove currency symbols and whitespace
-  std::string cleaned;
-  for (char c : price_str) {
-    if (std::isdigit(c) || c == '.' || c == ',') {
-      cleaned += c;
-    }
-  }
-
-  // Replace comma with period for decimal parsing
-  std::replace(cleaned.begin(), cleaned.end(), ',', '.');
-
-  try {
-    return std::stod(cleaned);
-  } catch (...) {
-    return 0.0;
-  }
+domain::Money BluRayComScraper::parsePrice(std::string_view price_str) const {
+  return domain::Money::parse(price_str).value_or(domain::Money{});
 }
 
 std::chrono::system_clock::time_point
@@ -379,8 +362,7 @@ BluRayComScraper::parseReleaseDate(std::string_view date_str) const {
   }
 
   // If parsing fails, return current time
-  infrastructure::Logger::instance().warning(fmt::format(
-      "Failed to parse release date: {}, using current time", date_str));
+  LOG_WARNING("Failed to parse release date: {}, using current time", date_str);
   return std::chrono::system_clock::now();
 }
 
@@ -94,9 +94,9 @@ private:
     bool isUHD4K(std::string_view format) const;
 
     /**
-     * Parse price from string (e.g., "$19.99" -> 19.99)
+     * Parse price from string (e.g., "$19.99" -> 19.99, 0 if none)
      */
-    double parsePrice(std::string_view price_str) const;
+    domain::Money parsePrice(std::string_view price_str) const;
 
     /**
      * Parse release date from string
@@ -1,5 +1,6 @@
 #include "bol_com_scraper.hpp"
 #include "../../infrastructure/logger.hpp"
+#include "product_identifiers.hpp"
 #include <algorithm>
 #include <cctype>
 #include <cstring>
@@ -15,21 +16,20 @@ bool BolComScraper::canHandle(std::string_view url) const {
 std::optional<domain::Product> BolComScraper::scrape(std::string_view url) {
   using namespace infrastructure;
 
-  Logger::instance().info(fmt::format("Scraping Bol.com: {}", url));
+  LOG_INFO("Scraping Bol.com: {}", url);
 
   // Fetch HTML
   auto response = client_.get(url);
   if (!response.success) {
-    Logger::instance().error(
-        fmt::format("Failed to fetch Bol.com page: {} (status: {})", url,
-                    response.status_code));
+    LOG_ERROR("Failed to fetch Bol.com page: {} (status: {})", url,
+              response.status_code);
     return std::nullopt;
   }
 
   // Parse HTML
   auto scraped_data = parseHtml(response.body, std::string(url));
   if (!scraped_data) {
-    Logger::instance().error("Failed to parse Bol.com HTML");
+    LOG_ERROR("Failed to parse Bol.com HTML");
     return std::nullopt;
   }
 
@@ -41,11 +41,17 @@ std::optional<domain::Product> BolComScraper::scrape(std::string_view url) {
                           .is_uhd_4k = scraped_data->is_uhd_4k,
                           .image_url = scraped_data->image_url,
                           .last_updated = std::chrono::system_clock::now(),
-                          .source = std::string(getSource())};
-
-  Logger::instance().info(fmt::format(
-      "Successfully scraped: {} (€{:.2f}, stock: {}, UHD: {})", product.title,
-      product.price, product.in_stock, product.is_uhd_4k));
+                          .source = std::string(getSource()),
+                          .ean = scraped_data->ean,
+                          .asin = scraped_data->asin};
+
+  LOG_DEBUG({{"source", product.source.str()},
+             {"price_cents", product.price.cents()},
+             {"in_stock", product.in_stock},
+             {"is_uhd_4k", product.is_uhd_4k},
+             {"ean", product.ean},
+             {"asin", product.asin}},
+            "Successfully scraped: {}", product.title);
 
   return product;
 }
@@ -59,6 +65,9 @@ BolComScraper::parseHtml(const std::string &html, const std::string &url) {
 
   // Try JSON-LD first (most reliable)
   if (auto json_data = parseJsonLd(output->root, url)) {
+    if (json_data->ean.empty()) {
+      json_data->ean = gtinFromText(html).value_or("");
+    }
     gumbo_destroy_output(&kGumboDefaultOptions, output);
     return json_data;
   }
@@ -89,6 +98,9 @@ BolComScraper::parseHtml(const std::string &html, const std::string &url) {
     data.image_url = *image_url;
   }
 
+  // Extract EAN from the specifications table
+  data.ean = gtinFromText(html).value_or("");
+
   gumbo_destroy_output(&kGumboDefaultOptions, output);
   return data;
 }
@@ -126,8 +138,7 @@ BolComScraper::parseJsonLd(GumboNode *root, const std::string &url) {
       // Fallback to simplistic slash logic if regex fails (though unlikely for
       // valid bol/p/ urls) Kept for backward compat with non-standard URLs
     } else {
-      infrastructure::Logger::instance().debug(
-          fmt::format("Bol.com Target ID: {}", target_id));
+      LOG_DEBUG("Bol.com Target ID: {}", target_id);
     }
 
     // Helper to check if item matches our URL
@@ -157,14 +168,12 @@ BolComScraper::parseJsonLd(GumboNode *root, const std::string &url) {
         if (matchesUrl(variant)) {
           item = &variant;
           found_variant = true;
-          infrastructure::Logger::instance().debug(
-              "Found matching variant in JSON-LD");
+          LOG_DEBUG("Found matching variant in JSON-LD");
           break;
         }
       }
       if (!found_variant && !target_id.empty()) {
-        infrastructure::Logger::instance().warning(
-            fmt::format("No variant matched Target ID: {}", target_id));
+        LOG_WARNING("No variant matched Target ID: {}", target_id);
       }
     }
 
@@ -192,6 +201,13 @@ BolComScraper::parseJsonLd(GumboNode *root, const std::string &url) {
       }
     }
 
+    // EAN of the variant, else of the main object
+    if (auto gtin = gtinFromJsonLd(*item)) {
+      data.ean = *gtin;
+    } else if (auto gtin = gtinFromJsonLd(j)) {
+      data.ean = *gtin;
+    }
+
     // UHD Check
     std::string lower_title = data.title;
     std::transform(lower_title.begin(), lower_title.end(), lower_title.begin(),
@@ -215,9 +231,8 @@ BolComScraper::parseJsonLd(GumboNode *root, const std::string &url) {
       if (offer) {
         if (offer->contains("price")) {
           std::string price_str = (*offer)["price"].get<std::string>();
-          try {
-            data.price = std::stod(price_str);
-          } catch (...) {
+          if (auto price = domain::Money::parse(price_str)) {
+            data.price = *price;
           }
         }
         if (offer->contains("availability")) {
@@ -228,15 +243,13 @@ BolComScraper::parseJsonLd(GumboNode *root, const std::string &url) {
     }
 
     if (!data.title.empty()) {
-      infrastructure::Logger::instance().info(
-          fmt::format("Parsed JSON-LD: Title='{}', Price={:.2f}, Stock={}",
-                      data.title, data.price, data.in_stock));
+      LOG_INFO("Parsed JSON-LD: Title='{}', Price={}, Stock={}", data.title,
+               data.price, data.in_stock);
       return data;
     }
 
   } catch (const std::exception &e) {
-    infrastructure::Logger::instance().warning(
-        fmt::format("JSON-LD parsing failed: {}", e.what()));
+    LOG_WARNING("JSON-LD parsing failed: {}", e.what());
   }
 
   return std::nullopt;
@@ -321,7 +334,7 @@ std::optional<std::string> BolComScraper::extractTitle(GumboNode *root) {
   return std::nullopt;
 }
 
-std::optional<double> BolComScraper::extractPrice(GumboNode *root) {
+std::optional<domain::Money> BolComScraper::extractPrice(GumboNode *root) {
   // Try multiple price selectors
   const char *price_classes[] = {"promo-price", "price", "product-price",
                                  "buy-block-price"};
@@ -352,12 +365,8 @@ std::optional<double> BolComScraper::extractPrice(GumboNode *root) {
         std::regex price_regex(R"((\d+)[,.](\d+))");
         std::smatch match;
         if (std::regex_search(price_text, match, price_regex)) {
-          try {
-            double euros = std::stod(match[1].str());
-            double cents = std::stod(match[2].str()) / 100.0;
-            return euros + cents;
-          } catch (...) {
-            continue;
+          if (auto price = domain::Money::parse(match.str())) {
+            return price;
           }
         }
       }
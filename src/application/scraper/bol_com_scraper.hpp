@@ -19,10 +19,12 @@ public:
 private:
   struct ScrapedData {
     std::string title;
-    double price{0.0};
+    domain::Money price;
     bool in_stock{false};
     bool is_uhd_4k{false};
     std::string image_url;
+    std::string ean;
+    std::string asin;
   };
 
   std::optional<ScrapedData> parseJsonLd(GumboNode *root,
@@ -32,7 +34,7 @@ private:
 
   // Helper methods for parsing specific elements
   std::optional<std::string> extractTitle(GumboNode *root);
-  std::optional<double> extractPrice(GumboNode *root);
+  std::optional<domain::Money> extractPrice(GumboNode *root);
   bool extractStockStatus(GumboNode *root);
   bool extractUhdStatus(GumboNode *root, const std::string &title);
   std::optional<std::string> extractImageUrl(GumboNode *root);
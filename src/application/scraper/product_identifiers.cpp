@@ -0,0 +1,159 @@
+#include "product_identifiers.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace bluray::application::scraper {
+
+namespace {
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+bool hasValidCheckDigit(const std::string &digits) {
+  // Weights 3 and 1 alternate from the digit left of the check digit
+  int sum = 0;
+  int weight = 3;
+  for (size_t i = digits.size() - 1; i-- > 0;) {
+    sum += (digits[i] - '0') * weight;
+    weight = weight == 3 ? 1 : 3;
+  }
+  return (10 - sum % 10) % 10 == digits.back() - '0';
+}
+
+std::optional<std::string> jsonString(const nlohmann::json &value) {
+  if (value.is_string()) {
+    return value.get<std::string>();
+  }
+  if (value.is_number_unsigned()) {
+    return std::to_string(value.get<uint64_t>());
+  }
+  return std::nullopt;
+}
+
+} // namespace
+
+std::optional<std::string> normalizeGtin(std::string_view code) {
+  std::string digits;
+  for (char c : code) {
+    if (isDigit(c)) {
+      digits += c;
+    } else if (c != ' ' && c != '-') {
+      return std::nullopt;
+    }
+  }
+
+  if (digits.size() != 8 && digits.size() != 12 && digits.size() != 13 &&
+      digits.size() != 14) {
+    return std::nullopt;
+  }
+  if (!hasValidCheckDigit(digits)) {
+    return std::nullopt;
+  }
+  // All zeros passes the check digit test but is a placeholder
+  if (digits.find_first_not_of('0') == std::string::npos) {
+    return std::nullopt;
+  }
+
+  if (digits.size() == 12) {
+    digits.insert(digits.begin(), '0'); // UPC-A
+  } else if (digits.size() == 14 && digits.front() == '0') {
+    digits.erase(digits.begin()); // GTIN-14 without packaging indicator
+  }
+  return digits;
+}
+
+std::optional<std::string> normalizeAsin(std::string_view code) {
+  if (code.size() != 10) {
+    return std::nullopt;
+  }
+  std::string asin;
+  for (char c : code) {
+    if (!std::isalnum(static_cast<unsigned char>(c))) {
+      return std::nullopt;
+    }
+    asin += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+  }
+  return asin;
+}
+
+std::optional<std::string> asinFromUrl(std::string_view url) {
+  for (std::string_view marker : {"/dp/", "/gp/product/", "/gp/aw/d/"}) {
+    const auto pos = url.find(marker);
+    if (pos == std::string_view::npos) {
+      continue;
+    }
+    auto rest = url.substr(pos + marker.size());
+    rest = rest.substr(0, rest.find_first_of("/?#"));
+    if (auto asin = normalizeAsin(rest)) {
+      return asin;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<std::string> gtinFromJsonLd(const nlohmann::json &object) {
+  if (!object.is_object()) {
+    return std::nullopt;
+  }
+
+  for (const char *key :
+       {"gtin13", "gtin", "gtin12", "gtin14", "gtin8", "ean", "isbn"}) {
+    if (auto it = object.find(key); it != object.end()) {
+      if (auto value = jsonString(*it)) {
+        if (auto gtin = normalizeGtin(*value)) {
+          return gtin;
+        }
+      }
+    }
+  }
+
+  if (auto it = object.find("offers"); it != object.end()) {
+    if (it->is_array()) {
+      for (const auto &offer : *it) {
+        if (auto gtin = gtinFromJsonLd(offer)) {
+          return gtin;
+        }
+      }
+    } else if (auto gtin = gtinFromJsonLd(*it)) {
+      return gtin;
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::optional<std::string> gtinFromText(std::string_view text) {
+  // Markup between label and value ("EAN</dt><dd class=...>") is skipped
+  constexpr size_t kMaxGap = 80;
+
+  for (std::string_view label : {"EAN", "GTIN", "gtin13"}) {
+    for (size_t pos = text.find(label); pos != std::string_view::npos;
+         pos = text.find(label, pos + 1)) {
+      // "EAN" inside a longer word ("OCEAN") is not a label
+      if (pos > 0 && std::isalpha(static_cast<unsigned char>(text[pos - 1]))) {
+        continue;
+      }
+
+      // First valid digit run after the label ("GTIN-13: ..." skips "13")
+      const size_t end = std::min(text.size(), pos + label.size() + kMaxGap);
+      size_t start = pos + label.size();
+      while (start < end) {
+        if (!isDigit(text[start])) {
+          ++start;
+          continue;
+        }
+        size_t stop = start;
+        while (stop < text.size() && isDigit(text[stop])) {
+          ++stop;
+        }
+        if (auto gtin = normalizeGtin(text.substr(start, stop - start))) {
+          return gtin;
+        }
+        start = stop;
+      }
+    }
+  }
+
+  return std::nullopt;
+}
+
+} // namespace bluray::application::scraper
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace bluray::application::scraper {
+
+/**
+ * Normalize an EAN/GTIN/UPC code
+ * Accepts 8, 12, 13 or 14 digits (spaces and dashes ignored) with a valid
+ * check digit. UPC-A and GTIN-14 with a zero indicator become EAN-13, so
+ * the same disc yields the same code on every retailer.
+ *
+ * @return Normalized code, or nullopt if the input is not a valid GTIN
+ */
+std::optional<std::string> normalizeGtin(std::string_view code);
+
+/**
+ * Normalize an ASIN (10 upper-case letters or digits)
+ */
+std::optional<std::string> normalizeAsin(std::string_view code);
+
+/**
+ * ASIN from an Amazon product URL (/dp/<ASIN>, /gp/product/<ASIN>)
+ */
+std::optional<std::string> asinFromUrl(std::string_view url);
+
+/**
+ * GTIN from a JSON-LD Product/Offer object (gtin13, gtin, gtin12, gtin14,
+ * gtin8, ean and isbn properties, then its offers)
+ */
+std::optional<std::string> gtinFromJsonLd(const nlohmann::json &object);
+
+/**
+ * GTIN from page text: an "EAN" or "GTIN" label followed by the code, as in
+ * product detail tables, or an itemprop="gtin13" attribute
+ */
+std::optional<std::string> gtinFromText(std::string_view text);
+
+} // namespace bluray::application::scraper
@@ -3,41 +3,27 @@
 #include "models.hpp"
 #include <vector>
 #include <memory>
-#include <functional>
 
 namespace bluray::domain {
 
 /**
- * Observer interface for change notifications
- */
-class IChangeObserver {
-public:
-    virtual ~IChangeObserver() = default;
-    virtual void onChangeDetected(const ChangeEvent& event) = 0;
-};
-
-/**
- * Subject class that detects changes and notifies observers (Observer pattern)
+ * Detects changes between two states of a wishlist item
+ * Notifications for the changes are queued in the outbox by the caller.
  */
 class ChangeDetector {
 public:
     /**
-     * Register an observer to receive change notifications
-     */
-    void addObserver(std::shared_ptr<IChangeObserver> observer) {
-        observers_.push_back(std::move(observer));
-    }
-
-    /**
-     * Remove all observers
+     * Whether an event warrants a user notification
+     * Minor price changes and out-of-stock events are only tracked.
      */
-    void clearObservers() {
-        observers_.clear();
+    [[nodiscard]] static bool shouldNotify(const ChangeEvent& event) {
+        return event.type == ChangeType::PriceDroppedBelowThreshold ||
+               event.type == ChangeType::BackInStock ||
+               event.type == ChangeType::AlertRuleMatched;
     }
 
     /**
      * Detect changes between old and new wishlist item state
-     * Returns detected changes and notifies all observers
      */
     [[nodiscard]] std::vector<ChangeEvent> detectChanges(
         const WishlistItem& old_item,
@@ -46,7 +32,19 @@ public:
         std::vector<ChangeEvent> changes;
         const auto now = std::chrono::system_clock::now();
 
-        // Check if price dropped below threshold
+        // One immutable snapshot, shared by the event and all its consumers
+        std::shared_ptr<const WishlistItem> snapshot;
+        auto itemSnapshot = [&] {
+            if (!snapshot) {
+                snapshot = std::make_shared<const WishlistItem>(new_item);
+            }
+            return snapshot;
+        };
+
+        // Price and stock are independent dimensions: a single scrape can
+        // report e.g. both a price drop and a restock
+
+        // Price: dropped below threshold, otherwise any change (informational)
         if (new_item.notify_on_price_drop &&
             new_item.in_stock &&
             new_item.current_price <= new_item.desired_max_price &&
@@ -54,67 +52,51 @@ public:
 
             ChangeEvent event{
                 .type = ChangeType::PriceDroppedBelowThreshold,
-                .item = new_item,
+                .item = itemSnapshot(),
                 .old_price = old_item.current_price,
                 .new_price = new_item.current_price,
                 .detected_at = now
             };
-            changes.push_back(event);
-            notifyObservers(event);
+            changes.push_back(std::move(event));
         }
-        // Check if back in stock
-        else if (new_item.notify_on_stock &&
-                 !old_item.in_stock &&
-                 new_item.in_stock) {
-
+        else if (old_item.current_price != new_item.current_price) {
             ChangeEvent event{
-                .type = ChangeType::BackInStock,
-                .item = new_item,
-                .old_stock_status = old_item.in_stock,
-                .new_stock_status = new_item.in_stock,
+                .type = ChangeType::PriceChanged,
+                .item = itemSnapshot(),
+                .old_price = old_item.current_price,
+                .new_price = new_item.current_price,
                 .detected_at = now
             };
-            changes.push_back(event);
-            notifyObservers(event);
+            changes.push_back(std::move(event));
         }
-        // Check if price changed (informational, always track)
-        else if (std::abs(old_item.current_price - new_item.current_price) > 0.01) {
+
+        // Stock: back in stock, or out of stock
+        if (new_item.notify_on_stock &&
+            !old_item.in_stock &&
+            new_item.in_stock) {
+
             ChangeEvent event{
-                .type = ChangeType::PriceChanged,
-                .item = new_item,
-                .old_price = old_item.current_price,
-                .new_price = new_item.current_price,
+                .type = ChangeType::BackInStock,
+                .item = itemSnapshot(),
+                .old_stock_status = old_item.in_stock,
+                .new_stock_status = new_item.in_stock,
                 .detected_at = now
             };
-            changes.push_back(event);
-            // Note: We don't notify observers for minor price changes
+            changes.push_back(std::move(event));
         }
-        // Check if out of stock
         else if (old_item.in_stock && !new_item.in_stock) {
             ChangeEvent event{
                 .type = ChangeType::OutOfStock,
-                .item = new_item,
+                .item = itemSnapshot(),
                 .old_stock_status = old_item.in_stock,
                 .new_stock_status = new_item.in_stock,
                 .detected_at = now
             };
-            changes.push_back(event);
-            // Note: We don't notify for out of stock events
+            changes.push_back(std::move(event));
         }
 
         return changes;
     }
-
-private:
-    void notifyObservers(const ChangeEvent& event) {
-        for (auto& observer : observers_) {
-            if (observer) {
-                observer->onChangeDetected(event);
-            }
-        }
-    }
-
-    std::vector<std::shared_ptr<IChangeObserver>> observers_;
 };
 
 } // namespace bluray::domain
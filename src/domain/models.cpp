@@ -3,24 +3,61 @@
 
 namespace bluray::domain {
 
+const char *toString(ChangeType type) {
+  switch (type) {
+  case ChangeType::PriceDroppedBelowThreshold:
+    return "price_dropped_below_threshold";
+  case ChangeType::BackInStock:
+    return "back_in_stock";
+  case ChangeType::PriceChanged:
+    return "price_changed";
+  case ChangeType::OutOfStock:
+    return "out_of_stock";
+  case ChangeType::AlertRuleMatched:
+    return "alert_rule_matched";
+  default:
+    return "unknown";
+  }
+}
+
+std::optional<ChangeType> changeTypeFromString(std::string_view name) {
+  for (auto type :
+       {ChangeType::PriceDroppedBelowThreshold, ChangeType::BackInStock,
+        ChangeType::PriceChanged, ChangeType::OutOfStock,
+        ChangeType::AlertRuleMatched}) {
+    if (name == toString(type)) {
+      return type;
+    }
+  }
+  return std::nullopt;
+}
+
 std::string ChangeEvent::describe() const {
+  if (!item) {
+    return "Unknown change";
+  }
+
   switch (type) {
   case ChangeType::PriceDroppedBelowThreshold:
-    return fmt::format("Price dropped below threshold for '{}': €{:.2f} → "
-                       "€{:.2f} (threshold: €{:.2f})",
-                       item.title, old_price.value_or(0.0),
-                       new_price.value_or(0.0), item.desired_max_price);
+    return fmt::format("Price dropped below threshold for '{}': €{} → "
+                       "€{} (threshold: €{})",
+                       item->title, old_price.value_or(Money{}),
+                       new_price.value_or(Money{}), item->desired_max_price);
 
   case ChangeType::BackInStock:
-    return fmt::format("'{}' is back in stock! Current price: €{:.2f}",
-                       item.title, item.current_price);
+    return fmt::format("'{}' is back in stock! Current price: €{}",
+                       item->title, item->current_price);
 
   case ChangeType::PriceChanged:
-    return fmt::format("Price changed for '{}': €{:.2f} → €{:.2f}", item.title,
-                       old_price.value_or(0.0), new_price.value_or(0.0));
+    return fmt::format("Price changed for '{}': €{} → €{}", item->title,
+                       old_price.value_or(Money{}), new_price.value_or(Money{}));
 
   case ChangeType::OutOfStock:
-    return fmt::format("'{}' is now out of stock", item.title);
+    return fmt::format("'{}' is now out of stock", item->title);
+
+  case ChangeType::AlertRuleMatched:
+    return fmt::format("Alert rule '{}' matched '{}' at €{}", rule_name,
+                       item->title, item->current_price);
 
   default:
     return "Unknown change";
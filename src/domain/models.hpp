@@ -1,8 +1,13 @@
 #pragma once
 
+#include "money.hpp"
+#include "symbol.hpp"
 #include <chrono>
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace bluray::domain {
@@ -13,7 +18,7 @@ namespace bluray::domain {
 struct Product {
   std::string url;
   std::string title;
-  double price{0.0};
+  Money price;
   bool in_stock{false};
   bool is_uhd_4k{false};
   std::string image_url;
@@ -21,7 +26,11 @@ struct Product {
   std::chrono::system_clock::time_point last_updated;
 
   // Source website (amazon.nl or bol.com)
-  std::string source;
+  Symbol source;
+
+  // Retailer-independent identifiers, empty if the page has none
+  std::string ean;  // EAN-13 (or EAN-8), check digit verified
+  std::string asin; // Amazon Standard Identification Number
 };
 
 /**
@@ -31,13 +40,13 @@ struct WishlistItem {
   int id{0};
   std::string url;
   std::string title;
-  double current_price{0.0};
-  double desired_max_price{0.0};
+  Money current_price;
+  Money desired_max_price;
   bool in_stock{false};
   bool is_uhd_4k{false};
   std::string image_url;
   std::string local_image_path;
-  std::string source;
+  Symbol source;
   std::chrono::system_clock::time_point created_at;
   std::chrono::system_clock::time_point last_checked;
 
@@ -55,12 +64,37 @@ struct WishlistItem {
   std::string trailer_key; // YouTube video key
 
   // Edition & bonus features
-  std::string edition_type;      // "Standard", "Steelbook", "Collector's", etc.
+  Symbol edition_type;           // "Standard", "Steelbook", "Collector's", etc.
   bool has_slipcover{false};
   bool has_digital_copy{false};
   std::string bonus_features;    // JSON array of bonus features
 };
 
+/**
+ * One retailer's offer for a product (a wishlist item)
+ */
+struct ProductOffer {
+  int wishlist_id{0};
+  std::string url;
+  Symbol source;
+  Money price;
+  bool in_stock{false};
+};
+
+/**
+ * Disc identified across retailers by EAN and/or ASIN
+ * Wishlist items scraped with a matching identifier are offers for it.
+ */
+struct ProductIdentity {
+  int id{0};
+  std::string ean;
+  std::string asin;
+  std::string title;
+  std::optional<ProductOffer> best_offer; // Cheapest offer in stock
+  int offer_count{0};
+  std::vector<ProductOffer> offers;       // Only filled on request
+};
+
 /**
  * Item in the user's collection
  */
@@ -68,11 +102,11 @@ struct CollectionItem {
   int id{0};
   std::string url;
   std::string title;
-  double purchase_price{0.0};
+  Money purchase_price;
   bool is_uhd_4k{false};
   std::string image_url;
   std::string local_image_path;
-  std::string source;
+  Symbol source;
   std::chrono::system_clock::time_point purchased_at;
   std::chrono::system_clock::time_point added_at;
 
@@ -86,7 +120,7 @@ struct CollectionItem {
   std::string trailer_key; // YouTube video key
 
   // Edition & bonus features
-  std::string edition_type;      // "Standard", "Steelbook", "Collector's", etc.
+  Symbol edition_type;           // "Standard", "Steelbook", "Collector's", etc.
   bool has_slipcover{false};
   bool has_digital_copy{false};
   std::string bonus_features;    // JSON array of bonus features
@@ -99,19 +133,67 @@ struct ReleaseCalendarItem {
   int id{0};
   std::string title;
   std::chrono::system_clock::time_point release_date;
-  std::string format; // "Blu-ray", "UHD 4K", "3D Blu-ray", etc.
-  std::string studio;
+  Symbol format; // "Blu-ray", "UHD 4K" or "3D Blu-ray"
+  std::string studio; // Scraped free text, so not interned
   std::string image_url;
   std::string local_image_path;
   std::string product_url;
   bool is_uhd_4k{false};
   bool is_preorder{false};
-  double price{0.0};
+  Money price;
   std::string notes;
   std::chrono::system_clock::time_point created_at;
   std::chrono::system_clock::time_point last_updated;
 };
 
+/**
+ * Upcoming release whose title matches a wishlist or collection item
+ */
+struct ReleaseMatch {
+  int release_id{0};
+  std::string item_type; // "wishlist" or "collection"
+  int item_id{0};
+  double score{0.0};     // Title similarity, 0.0 to 1.0
+
+  // Filled when loaded, for display
+  std::string release_title;
+  std::string release_date; // As stored: "YYYY-MM-DD HH:MM:SS"
+  Symbol format;
+  bool is_uhd_4k{false};
+  std::string item_title;
+};
+
+/**
+ * Wishlist or collection item, as compared by duplicate detection
+ */
+struct CatalogEntry {
+  std::string item_type; // "wishlist" or "collection"
+  int id{0};
+  std::string title;
+  bool is_uhd_4k{false};
+  int tmdb_id{0};   // 0 when not enriched
+  std::string ean;  // Of the linked product; wishlist items only
+};
+
+/**
+ * Probable duplicate of a catalog entry, and why
+ */
+struct DuplicateMatch {
+  CatalogEntry entry;
+  double similarity{0.0}; // Title similarity, 0.0 to 1.0
+  bool same_tmdb_id{false};
+  bool same_ean{false};
+};
+
+/**
+ * Catalog entries that are probably all the same disc
+ */
+struct DuplicateGroup {
+  std::vector<CatalogEntry> entries;
+  bool same_tmdb_id{false}; // Some pair in the group shares a TMDb id
+  bool same_ean{false};     // Some pair in the group shares an EAN
+};
+
 /**
  * User-defined tag for organizing items
  */
@@ -137,30 +219,105 @@ enum class ChangeType {
   PriceDroppedBelowThreshold,
   BackInStock,
   PriceChanged,
-  OutOfStock
+  OutOfStock,
+  AlertRuleMatched // A user-defined alert rule matched the item
 };
 
+/**
+ * Stable name of a change type (used in JSON and alert rules)
+ */
+[[nodiscard]] const char *toString(ChangeType type);
+
+/**
+ * Parse a change type name
+ * @return Change type or nullopt if unknown
+ */
+[[nodiscard]] std::optional<ChangeType> changeTypeFromString(std::string_view name);
+
 /**
  * Event representing a detected change
+ * The item is an immutable snapshot shared by all events of one detection,
+ * so events are cheap to copy and safe to hand to other threads.
  */
 struct ChangeEvent {
   ChangeType type;
-  WishlistItem item;
+  std::shared_ptr<const WishlistItem> item;
 
   // Additional context
-  std::optional<double> old_price;
-  std::optional<double> new_price;
+  std::optional<Money> old_price;
+  std::optional<Money> new_price;
   std::optional<bool> old_stock_status;
   std::optional<bool> new_stock_status;
 
   std::chrono::system_clock::time_point detected_at;
 
+  // Set for AlertRuleMatched events
+  int rule_id{0};
+  std::string rule_name;
+
+  // Stable key assigned when the event is queued for delivery; receivers
+  // can use it to recognise redelivered notifications
+  std::string idempotency_key;
+
   /**
    * Generate human-readable description of the change
    */
   [[nodiscard]] std::string describe() const;
 };
 
+/**
+ * User-defined alert rule
+ * Conditions are a JSON array of {"field", "operator", "value"} objects that
+ * must all hold (see application::alerts::RuleEngine for the vocabulary).
+ */
+struct AlertRule {
+  int id{0};
+  std::string name;
+  std::string conditions;             // JSON array
+  std::vector<std::string> notify_via; // Channel names; empty = all
+  bool enabled{true};
+  std::chrono::system_clock::time_point created_at;
+};
+
+/**
+ * Event published when TMDb metadata of an item was saved
+ */
+struct MetadataUpdatedEvent {
+  std::string item_type; // "wishlist" or "collection"
+  int item_id{0};
+  int tmdb_id{0};
+  double tmdb_rating{0.0};
+  std::chrono::system_clock::time_point updated_at;
+};
+
+/**
+ * Event published when a release calendar scrape was applied
+ */
+struct CalendarUpdatedEvent {
+  int releases_found{0};
+  int added{0};
+  int updated{0};
+  std::chrono::system_clock::time_point updated_at;
+};
+
+/**
+ * One row written to a tracked table (from the change_log table)
+ */
+struct DataChange {
+  int64_t id{0};         // change_log id, increasing
+  std::string table;     // "wishlist", "collection", "release_calendar", "config"
+  int64_t row_id{0};
+  std::string operation; // "insert", "update" or "delete"
+};
+
+/**
+ * Event published when another process (cron scraper, sqlite3 shell)
+ * changed tracked tables
+ */
+struct ExternalDataChangedEvent {
+  std::vector<DataChange> changes; // In commit order
+};
+
 /**
  * Pagination parameters for queries
  */
@@ -186,7 +343,7 @@ template <typename T> struct PaginatedResult {
   int total_count{0};
   int page{1};
   int page_size{20};
-  double total_value{0.0};
+  Money total_value;
 
   [[nodiscard]] int total_pages() const {
     if (page_size == 0) {
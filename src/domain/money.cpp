@@ -0,0 +1,69 @@
+#include "money.hpp"
+#include <cmath>
+
+namespace bluray::domain {
+
+Money Money::fromEuros(double euros) {
+  return fromCents(std::llround(euros * 100.0));
+}
+
+std::optional<Money> Money::parse(std::string_view text) {
+  // Digits of the first number in the text, and how many of them follow
+  // its last separator; stops at the first character that cannot be part
+  // of a price
+  int64_t digits = 0;
+  int digit_count = 0;
+  int digits_after_separator = -1;
+  bool separator_pending = false;
+
+  for (const char c : text) {
+    if (c >= '0' && c <= '9') {
+      if (separator_pending) {
+        digits_after_separator = 0;
+        separator_pending = false;
+      }
+      digits = digits * 10 + (c - '0');
+      ++digit_count;
+      if (digits_after_separator >= 0) {
+        ++digits_after_separator;
+      }
+    } else if (digit_count == 0) {
+      continue; // Currency symbol, spaces
+    } else if ((c == ',' || c == '.') && !separator_pending) {
+      separator_pending = true; // Only counts if a digit follows
+    } else {
+      break;
+    }
+
+    if (digit_count > 15) {
+      return std::nullopt; // Not a price
+    }
+  }
+
+  if (digit_count == 0) {
+    return std::nullopt;
+  }
+
+  int64_t cents = 0;
+  switch (digits_after_separator) {
+  case 1: // "12,5"
+    cents = digits * 10;
+    break;
+  case 2: // "12,34"
+    cents = digits;
+    break;
+  default: // "12", "12,-", "1.234"
+    cents = digits * 100;
+    break;
+  }
+
+  return fromCents(cents);
+}
+
+std::string Money::toString() const {
+  const int64_t magnitude = cents_ < 0 ? -cents_ : cents_;
+  return fmt::format("{}{}.{:02}", cents_ < 0 ? "-" : "", magnitude / 100,
+                     magnitude % 100);
+}
+
+} // namespace bluray::domain
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <fmt/format.h>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace bluray::domain {
+
+/**
+ * Amount of money as a whole number of cents
+ *
+ * Prices are stored, compared and summed as integers, so equal prices
+ * compare equal and totals do not drift. Conversions to and from euros as
+ * floating point only happen at the edges (JSON input, percentages).
+ */
+class Money {
+public:
+  constexpr Money() = default;
+
+  [[nodiscard]] static constexpr Money fromCents(int64_t cents) {
+    Money money;
+    money.cents_ = cents;
+    return money;
+  }
+
+  /**
+   * Amount in euros, rounded to the nearest cent
+   */
+  [[nodiscard]] static Money fromEuros(double euros);
+
+  /**
+   * Parse a price as shown on a shop page
+   * Accepts "12,34", "€ 12.34", "1.234,56", "$19.99" and "12,-". A separator
+   * followed by one or two digits is the decimal separator; other
+   * separators group thousands.
+   *
+   * @return Nothing if the text contains no digits
+   */
+  [[nodiscard]] static std::optional<Money> parse(std::string_view text);
+
+  [[nodiscard]] constexpr int64_t cents() const { return cents_; }
+  [[nodiscard]] double euros() const { return static_cast<double>(cents_) / 100.0; }
+
+  [[nodiscard]] constexpr bool isZero() const { return cents_ == 0; }
+  [[nodiscard]] constexpr bool isPositive() const { return cents_ > 0; }
+
+  /**
+   * "12.34" (no currency symbol)
+   */
+  [[nodiscard]] std::string toString() const;
+
+  constexpr Money &operator+=(Money other) {
+    cents_ += other.cents_;
+    return *this;
+  }
+  constexpr Money &operator-=(Money other) {
+    cents_ -= other.cents_;
+    return *this;
+  }
+
+  friend constexpr Money operator+(Money a, Money b) { return a += b; }
+  friend constexpr Money operator-(Money a, Money b) { return a -= b; }
+
+  friend constexpr bool operator==(Money a, Money b) { return a.cents_ == b.cents_; }
+  friend constexpr bool operator!=(Money a, Money b) { return a.cents_ != b.cents_; }
+  friend constexpr bool operator<(Money a, Money b) { return a.cents_ < b.cents_; }
+  friend constexpr bool operator<=(Money a, Money b) { return a.cents_ <= b.cents_; }
+  friend constexpr bool operator>(Money a, Money b) { return a.cents_ > b.cents_; }
+  friend constexpr bool operator>=(Money a, Money b) { return a.cents_ >= b.cents_; }
+
+private:
+  int64_t cents_{0};
+};
+
+} // namespace bluray::domain
+
+template <>
+struct fmt::formatter<bluray::domain::Money> : fmt::formatter<std::string_view> {
+  template <typename FormatContext>
+  auto format(bluray::domain::Money money, FormatContext &ctx) const {
+    return fmt::formatter<std::string_view>::format(money.toString(), ctx);
+  }
+};
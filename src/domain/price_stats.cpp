@@ -0,0 +1,143 @@
+#include "price_stats.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace bluray::domain {
+
+namespace {
+
+int64_t dayOf(std::chrono::system_clock::time_point tp) {
+  return std::chrono::duration_cast<std::chrono::hours>(tp.time_since_epoch())
+             .count() /
+         24;
+}
+
+size_t slotOf(int64_t day) {
+  return static_cast<size_t>(day % PriceStats::WINDOW_DAYS);
+}
+
+// Lowest or highest entry of a per-day ring over the last `days` days, with
+// `newest` standing in for the entry of last_day
+std::optional<Money>
+windowExtreme(const std::array<int64_t, PriceStats::WINDOW_DAYS> &ring,
+              int64_t last_day, int64_t newest, bool highest, int days,
+              std::chrono::system_clock::time_point now) {
+  days = std::clamp(days, 1, PriceStats::WINDOW_DAYS);
+  const int64_t today = dayOf(now);
+
+  // Days inside both the requested window and the ring
+  const int64_t first =
+      std::max(today - days + 1, last_day - PriceStats::WINDOW_DAYS + 1);
+  const int64_t last = std::min(today, last_day);
+
+  int64_t extreme = 0;
+  for (int64_t d = first; d <= last; ++d) {
+    const int64_t value = d == last_day ? newest : ring[slotOf(d)];
+    if (value != 0 &&
+        (extreme == 0 || (highest ? value > extreme : value < extreme))) {
+      extreme = value;
+    }
+  }
+
+  if (extreme == 0) {
+    return std::nullopt;
+  }
+  return Money::fromCents(extreme);
+}
+
+} // namespace
+
+void PriceStats::record(Money price, std::chrono::system_clock::time_point at) {
+  if (!price.isPositive()) {
+    return;
+  }
+
+  const int64_t cents = price.cents();
+  const int64_t day = dayOf(at);
+
+  if (samples == 0) {
+    previous_low = Money();
+    all_time_low = price;
+    all_time_high = price;
+    ema_cents = static_cast<double>(cents);
+    last_change_at = at;
+    last_day = day;
+    daily_low.fill(0);
+    daily_high.fill(0);
+  } else {
+    previous_low = all_time_low;
+    all_time_low = std::min(all_time_low, price);
+    all_time_high = std::max(all_time_high, price);
+    ema_cents += EMA_ALPHA * (static_cast<double>(cents) - ema_cents);
+    if (price != last_price) {
+      last_change_at = at;
+    }
+
+    // Days without samples since the last one drop out of the window
+    if (day > last_day) {
+      const int64_t gap = std::min<int64_t>(day - last_day, WINDOW_DAYS);
+      for (int64_t d = day - gap + 1; d <= day; ++d) {
+        daily_low[slotOf(d)] = 0;
+        daily_high[slotOf(d)] = 0;
+      }
+      last_day = day;
+    }
+  }
+
+  last_price = price;
+  ++samples;
+
+  // An out-of-order sample (backfill) leaves last_day as it was
+  previous_day_low = daily_low[slotOf(last_day)];
+  previous_day_high = daily_high[slotOf(last_day)];
+
+  // Older than the window (out-of-order backfill): totals only
+  if (day <= last_day - WINDOW_DAYS) {
+    return;
+  }
+  auto &low = daily_low[slotOf(day)];
+  low = low == 0 ? cents : std::min(low, cents);
+  auto &high = daily_high[slotOf(day)];
+  high = std::max(high, cents);
+}
+
+std::optional<Money>
+PriceStats::windowLow(int days, std::chrono::system_clock::time_point now) const {
+  if (samples == 0) {
+    return std::nullopt;
+  }
+  return windowExtreme(daily_low, last_day, daily_low[slotOf(last_day)],
+                       false, days, now);
+}
+
+std::optional<Money>
+PriceStats::previousWindowLow(int days,
+                              std::chrono::system_clock::time_point now) const {
+  if (samples < 2) {
+    return std::nullopt;
+  }
+  return windowExtreme(daily_low, last_day, previous_day_low, false, days,
+                       now);
+}
+
+std::optional<Money> PriceStats::previousWindowHigh(
+    int days, std::chrono::system_clock::time_point now) const {
+  if (samples < 2) {
+    return std::nullopt;
+  }
+  return windowExtreme(daily_high, last_day, previous_day_high, true, days,
+                       now);
+}
+
+std::optional<Money> PriceStats::previousLow() const {
+  if (samples < 2 || !previous_low.isPositive()) {
+    return std::nullopt;
+  }
+  return previous_low;
+}
+
+Money PriceStats::average() const {
+  return Money::fromCents(std::llround(ema_cents));
+}
+
+} // namespace bluray::domain
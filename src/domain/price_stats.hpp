@@ -0,0 +1,82 @@
+#pragma once
+
+#include "money.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace bluray::domain {
+
+/**
+ * Running price statistics of one wishlist item
+ *
+ * Updated in constant time with every recorded price, so "lowest price in
+ * 90 days" or "average price" need no price history scan. Rolling minimums
+ * and maximums come from rings of per-day extremes covering the last
+ * WINDOW_DAYS days. Zero prices are scraper misses and are not recorded.
+ *
+ * The state the newest sample replaced is kept as well, so that the newest
+ * price can be compared with the ones before it (previousLow(),
+ * previousWindowLow()).
+ */
+struct PriceStats {
+  static constexpr int WINDOW_DAYS = 90;
+
+  Money all_time_low;
+  Money all_time_high;
+  double ema_cents{0.0}; // Exponential moving average over samples
+  Money last_price;
+  std::chrono::system_clock::time_point last_change_at;
+  int64_t samples{0};
+
+  // Day (since the epoch) of the newest sample, and the lowest and highest
+  // price of each of the last WINDOW_DAYS days, indexed by
+  // day % WINDOW_DAYS (0 = no sample that day)
+  int64_t last_day{0};
+  std::array<int64_t, WINDOW_DAYS> daily_low{};
+  std::array<int64_t, WINDOW_DAYS> daily_high{};
+
+  // Before the newest sample: the all-time low (0 = none), and the lowest
+  // and highest price of last_day
+  Money previous_low;
+  int64_t previous_day_low{0};
+  int64_t previous_day_high{0};
+
+  /**
+   * Add one observed price
+   */
+  void record(Money price, std::chrono::system_clock::time_point at);
+
+  /**
+   * Lowest price seen in the last `days` days (1..WINDOW_DAYS), today
+   * included
+   */
+  [[nodiscard]] std::optional<Money>
+  windowLow(int days, std::chrono::system_clock::time_point now) const;
+
+  /**
+   * Lowest and highest price seen in the last `days` days
+   * (1..WINDOW_DAYS) before the newest sample
+   */
+  [[nodiscard]] std::optional<Money>
+  previousWindowLow(int days, std::chrono::system_clock::time_point now) const;
+  [[nodiscard]] std::optional<Money>
+  previousWindowHigh(int days,
+                     std::chrono::system_clock::time_point now) const;
+
+  /**
+   * All-time low before the newest sample
+   */
+  [[nodiscard]] std::optional<Money> previousLow() const;
+
+  /**
+   * Moving average rounded to the cent
+   */
+  [[nodiscard]] Money average() const;
+
+  // Weight of the newest sample: roughly the average of the last 10 scrapes
+  static constexpr double EMA_ALPHA = 2.0 / (10 + 1);
+};
+
+} // namespace bluray::domain
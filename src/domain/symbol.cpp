@@ -0,0 +1,111 @@
+#include "symbol.hpp"
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+#include <stdexcept>
+
+namespace bluray::domain {
+
+Symbol::Symbol(std::string_view text)
+    : id_(text.empty() ? 0 : SymbolTable::instance().intern(text)) {}
+
+SymbolTable &SymbolTable::instance() {
+  static SymbolTable instance;
+  return instance;
+}
+
+SymbolTable::SymbolTable() {
+  // Id 0: the empty string
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  add(std::string());
+}
+
+SymbolTable::~SymbolTable() {
+  for (auto &chunk : chunks_) {
+    delete[] chunk.load(std::memory_order_relaxed);
+  }
+}
+
+Symbol::Id SymbolTable::intern(std::string_view text) {
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const auto it = ids_.find(text);
+    if (it != ids_.end()) {
+      return it->second;
+    }
+  }
+
+  std::string lower(text);
+  std::transform(lower.begin(), lower.end(), lower.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+
+  // Another thread may have added it meanwhile
+  const auto it = ids_.find(text);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+
+  Symbol::Id folded = 0;
+  if (lower != text) {
+    const auto lower_it = ids_.find(lower);
+    folded = lower_it != ids_.end() ? lower_it->second : add(std::move(lower));
+  }
+
+  const auto id = add(std::string(text));
+  chunks_[id / CHUNK_SIZE].load(std::memory_order_relaxed)[id % CHUNK_SIZE]
+      .folded = folded != 0 ? folded : id;
+  return id;
+}
+
+std::optional<Symbol::Id> SymbolTable::find(std::string_view text) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  const auto it = ids_.find(text);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+const std::string &SymbolTable::text(Symbol::Id id) const {
+  return entry(id).text;
+}
+
+Symbol::Id SymbolTable::folded(Symbol::Id id) const {
+  return entry(id).folded;
+}
+
+size_t SymbolTable::size() const {
+  return size_.load(std::memory_order_acquire);
+}
+
+const SymbolTable::Entry &SymbolTable::entry(Symbol::Id id) const {
+  // A Symbol only reaches another thread through some synchronization, so
+  // the entry it names is fully written by then
+  return chunks_[id / CHUNK_SIZE].load(std::memory_order_acquire)[id % CHUNK_SIZE];
+}
+
+Symbol::Id SymbolTable::add(std::string text) {
+  const size_t id = size_.load(std::memory_order_relaxed);
+  const size_t chunk = id / CHUNK_SIZE;
+  if (chunk >= MAX_CHUNKS) {
+    throw std::length_error("Symbol table is full");
+  }
+
+  Entry *entries = chunks_[chunk].load(std::memory_order_relaxed);
+  if (!entries) {
+    entries = new Entry[CHUNK_SIZE];
+    chunks_[chunk].store(entries, std::memory_order_release);
+  }
+
+  auto &entry = entries[id % CHUNK_SIZE];
+  entry.text = std::move(text);
+  entry.folded = static_cast<Symbol::Id>(id);
+
+  ids_.emplace(entry.text, static_cast<Symbol::Id>(id));
+  size_.store(id + 1, std::memory_order_release);
+  return static_cast<Symbol::Id>(id);
+}
+
+} // namespace bluray::domain
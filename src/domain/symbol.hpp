@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace bluray::domain {
+
+/**
+ * Interned string for low-cardinality fields (source, edition, format)
+ *
+ * Interned text is kept for the life of the process, so only fields whose
+ * values come from a fixed set are Symbols; free text stays a std::string.
+ *
+ * A Symbol is the 32-bit id of an entry in the process-wide SymbolTable:
+ * items store, copy and compare it as an integer, and str() returns the
+ * shared text. Constructing a Symbol from text interns it. Id 0 is the
+ * empty string, so a default-constructed Symbol is empty.
+ */
+class Symbol {
+public:
+  using Id = uint32_t;
+
+  Symbol() = default;
+
+  // Implicit, so fields can still be assigned from text
+  Symbol(std::string_view text);
+  Symbol(const std::string &text) : Symbol(std::string_view(text)) {}
+  Symbol(const char *text) : Symbol(std::string_view(text)) {}
+
+  /**
+   * Symbol for an id previously returned by id()
+   */
+  [[nodiscard]] static Symbol fromId(Id id) {
+    Symbol symbol;
+    symbol.id_ = id;
+    return symbol;
+  }
+
+  [[nodiscard]] Id id() const { return id_; }
+  [[nodiscard]] bool empty() const { return id_ == 0; }
+
+  /**
+   * Interned text; the reference stays valid for the life of the process
+   */
+  [[nodiscard]] const std::string &str() const;
+  [[nodiscard]] const char *c_str() const { return str().c_str(); }
+
+  /**
+   * Lower-cased symbol, for case-insensitive equality by id
+   */
+  [[nodiscard]] Symbol folded() const;
+
+  friend bool operator==(Symbol a, Symbol b) { return a.id_ == b.id_; }
+  friend bool operator!=(Symbol a, Symbol b) { return a.id_ != b.id_; }
+
+  // Comparing with text does not intern it
+  friend bool operator==(Symbol a, std::string_view b) { return a.str() == b; }
+  friend bool operator!=(Symbol a, std::string_view b) { return a.str() != b; }
+  friend bool operator==(Symbol a, const std::string &b) { return a.str() == b; }
+  friend bool operator!=(Symbol a, const std::string &b) { return a.str() != b; }
+  friend bool operator==(Symbol a, const char *b) { return a.str() == b; }
+  friend bool operator!=(Symbol a, const char *b) { return a.str() != b; }
+
+private:
+  Id id_{0};
+};
+
+/**
+ * Process-wide table of interned strings (Singleton pattern)
+ *
+ * Entries are never removed, so the text of a symbol can be read without a
+ * lock: entries live in fixed-size chunks that are never moved, and only
+ * interning a new string takes the write lock.
+ */
+class SymbolTable {
+public:
+  static SymbolTable &instance();
+
+  // Prevent copying
+  SymbolTable(const SymbolTable &) = delete;
+  SymbolTable &operator=(const SymbolTable &) = delete;
+
+  /**
+   * Id of the text, adding it if new
+   * @throws std::length_error if the table is full
+   */
+  Symbol::Id intern(std::string_view text);
+
+  /**
+   * Id of the text if it has been interned
+   */
+  [[nodiscard]] std::optional<Symbol::Id> find(std::string_view text) const;
+
+  [[nodiscard]] const std::string &text(Symbol::Id id) const;
+  [[nodiscard]] Symbol::Id folded(Symbol::Id id) const;
+
+  /**
+   * Number of interned strings (including the empty string)
+   */
+  [[nodiscard]] size_t size() const;
+
+private:
+  SymbolTable();
+  ~SymbolTable();
+
+  struct Entry {
+    std::string text;
+    Symbol::Id folded{0};
+  };
+
+  [[nodiscard]] const Entry &entry(Symbol::Id id) const;
+  Symbol::Id add(std::string text); // Caller holds the write lock
+
+  static constexpr size_t CHUNK_SIZE = 256;
+  static constexpr size_t MAX_CHUNKS = 1024;
+
+  std::array<std::atomic<Entry *>, MAX_CHUNKS> chunks_{};
+  std::atomic<size_t> size_{0};
+
+  mutable std::shared_mutex mutex_;
+  std::unordered_map<std::string_view, Symbol::Id> ids_; // Views into entries
+};
+
+inline const std::string &Symbol::str() const {
+  return SymbolTable::instance().text(id_);
+}
+
+inline Symbol Symbol::folded() const {
+  return fromId(SymbolTable::instance().folded(id_));
+}
+
+} // namespace bluray::domain
+
+template <> struct std::hash<bluray::domain::Symbol> {
+  size_t operator()(bluray::domain::Symbol symbol) const noexcept {
+    return std::hash<bluray::domain::Symbol::Id>{}(symbol.id());
+  }
+};
+
+template <>
+struct fmt::formatter<bluray::domain::Symbol> : fmt::formatter<std::string_view> {
+  template <typename FormatContext>
+  auto format(bluray::domain::Symbol symbol, FormatContext &ctx) const {
+    return fmt::formatter<std::string_view>::format(symbol.str(), ctx);
+  }
+};
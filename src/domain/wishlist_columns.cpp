@@ -0,0 +1,100 @@
+#include "wishlist_columns.hpp"
+#include <algorithm>
+#include <bitset>
+
+namespace bluray::domain {
+
+size_t RowMask::count() const {
+  size_t total = 0;
+  for (const uint64_t word : words_) {
+    total += std::bitset<64>(word).count();
+  }
+  return total;
+}
+
+void RowMask::push_back(bool value) {
+  if (size_ % 64 == 0) {
+    words_.push_back(0);
+  }
+  if (value) {
+    set(size_);
+  }
+  ++size_;
+}
+
+RowMask &RowMask::operator&=(const RowMask &other) {
+  const size_t n = std::min(words_.size(), other.words_.size());
+  for (size_t i = 0; i < n; ++i) {
+    words_[i] &= other.words_[i];
+  }
+  std::fill(words_.begin() + n, words_.end(), 0);
+  return *this;
+}
+
+void WishlistColumns::append(int id, Money price, Money threshold, bool stock,
+                             bool uhd) {
+  ids.push_back(id);
+  current_price.push_back(price.cents());
+  desired_max_price.push_back(threshold.cents());
+
+  in_stock.push_back(stock);
+  is_uhd_4k.push_back(uhd);
+}
+
+namespace columns {
+
+namespace {
+
+/**
+ * Build a mask from a per-row predicate, 64 rows at a time
+ * The inner loop has a fixed trip count and no branches, so it vectorizes.
+ */
+template <typename Predicate>
+RowMask buildMask(size_t size, Predicate predicate) {
+  RowMask mask(size);
+  auto &words = mask.words();
+
+  const size_t full_words = size / 64;
+  for (size_t w = 0; w < full_words; ++w) {
+    uint64_t word = 0;
+    const size_t base = w * 64;
+    for (size_t bit = 0; bit < 64; ++bit) {
+      word |= static_cast<uint64_t>(predicate(base + bit)) << bit;
+    }
+    words[w] = word;
+  }
+
+  if (full_words < words.size()) {
+    uint64_t word = 0;
+    const size_t base = full_words * 64;
+    for (size_t bit = 0; base + bit < size; ++bit) {
+      word |= static_cast<uint64_t>(predicate(base + bit)) << bit;
+    }
+    words[full_words] = word;
+  }
+
+  return mask;
+}
+
+} // namespace
+
+RowMask belowThreshold(const WishlistColumns &columns) {
+  const int64_t *price = columns.current_price.data();
+  const int64_t *threshold = columns.desired_max_price.data();
+
+  return buildMask(columns.size(), [=](size_t row) {
+    return (price[row] > 0) & (price[row] <= threshold[row]);
+  });
+}
+
+int64_t sum(const std::vector<int64_t> &column) {
+  int64_t total = 0;
+  for (const int64_t value : column) {
+    total += value;
+  }
+  return total;
+}
+
+} // namespace columns
+
+} // namespace bluray::domain
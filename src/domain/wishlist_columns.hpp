@@ -0,0 +1,83 @@
+#pragma once
+
+#include "money.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bluray::domain {
+
+/**
+ * One bit per row of a WishlistColumns snapshot
+ */
+class RowMask {
+public:
+  RowMask() = default;
+  explicit RowMask(size_t size) : words_((size + 63) / 64, 0), size_(size) {}
+
+  [[nodiscard]] size_t size() const { return size_; }
+
+  [[nodiscard]] bool test(size_t row) const {
+    return (words_[row / 64] >> (row % 64)) & 1;
+  }
+
+  void set(size_t row) { words_[row / 64] |= uint64_t{1} << (row % 64); }
+
+  /**
+   * Append one row
+   */
+  void push_back(bool value);
+
+  /**
+   * Number of rows set
+   */
+  [[nodiscard]] size_t count() const;
+
+  RowMask &operator&=(const RowMask &other);
+
+  [[nodiscard]] std::vector<uint64_t> &words() { return words_; }
+  [[nodiscard]] const std::vector<uint64_t> &words() const { return words_; }
+
+private:
+  std::vector<uint64_t> words_; // Bits past size() are always clear
+  size_t size_{0};
+};
+
+/**
+ * Struct-of-arrays copy of the wishlist fields used by the dashboard
+ * statistics
+ *
+ * Row i of every column describes the same item. Kernels below walk one or
+ * two contiguous columns with branch-free loops the compiler vectorizes,
+ * instead of striding through full WishlistItem structs.
+ */
+struct WishlistColumns {
+  std::vector<int> ids;
+  std::vector<int64_t> current_price; // Cents
+  std::vector<int64_t> desired_max_price;
+  RowMask in_stock;
+  RowMask is_uhd_4k;
+
+  [[nodiscard]] size_t size() const { return ids.size(); }
+
+  /**
+   * Append one row
+   */
+  void append(int id, Money price, Money threshold, bool stock, bool uhd);
+};
+
+namespace columns {
+
+/**
+ * Rows with a known price at or below the desired maximum price
+ */
+[[nodiscard]] RowMask belowThreshold(const WishlistColumns &columns);
+
+/**
+ * Sum of a column over all rows
+ */
+[[nodiscard]] int64_t sum(const std::vector<int64_t> &column);
+
+} // namespace columns
+
+} // namespace bluray::domain
@@ -0,0 +1,146 @@
+#include "change_feed.hpp"
+#include "database_manager.hpp"
+#include "logger.hpp"
+
+namespace bluray::infrastructure {
+
+ChangeFeed::ChangeFeed(Handler handler, std::chrono::milliseconds poll_interval)
+    : handler_(std::move(handler)), poll_interval_(poll_interval) {}
+
+ChangeFeed::~ChangeFeed() { stop(); }
+
+void ChangeFeed::start() {
+  if (worker_.joinable()) {
+    return;
+  }
+
+  // Start from the current state; the first poll only sees later commits
+  poll();
+  last_prune_ = std::chrono::steady_clock::now();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = false;
+  }
+  worker_ = std::thread(&ChangeFeed::run, this);
+  LOG_INFO("Change feed started (poll interval: {}ms)", poll_interval_.count());
+}
+
+void ChangeFeed::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  stop_cv_.notify_all();
+
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void ChangeFeed::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (!stop_cv_.wait_for(lock, poll_interval_, [this] { return stopping_; })) {
+    lock.unlock();
+
+    try {
+      auto changes = poll();
+      if (!changes.empty()) {
+        LOG_DEBUG("Change feed: {} external changes", changes.size());
+        handler_(changes);
+      }
+
+      if (std::chrono::steady_clock::now() - last_prune_ >= PRUNE_INTERVAL) {
+        prune();
+        last_prune_ = std::chrono::steady_clock::now();
+      }
+    } catch (const std::exception &e) {
+      LOG_WARNING("Change feed poll failed: {}", e.what());
+    }
+
+    lock.lock();
+  }
+}
+
+std::vector<domain::DataChange> ChangeFeed::poll() {
+  auto &db = DatabaseManager::instance();
+  auto db_lock = db.lock();
+
+  std::vector<domain::DataChange> changes;
+
+  // One read transaction, so that data_version and change_log describe the
+  // same snapshot and no commit can slip in between the two reads
+  Transaction transaction(db);
+
+  int64_t max_id = 0;
+  {
+    auto stmt = db.prepare("SELECT COALESCE(MAX(id), 0) FROM change_log");
+    if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+      max_id = sqlite3_column_int64(stmt.get(), 0);
+    }
+  }
+
+  const int64_t version = db.dataVersion();
+  if (version != last_data_version_ && last_data_version_ != 0) {
+    auto stmt = db.prepare(
+        "SELECT id, table_name, row_id, operation FROM change_log "
+        "WHERE id > ? AND id <= ? ORDER BY id LIMIT ?");
+
+    int64_t after = last_change_id_;
+    while (after < max_id) {
+      sqlite3_bind_int64(stmt.get(), 1, after);
+      sqlite3_bind_int64(stmt.get(), 2, max_id);
+      sqlite3_bind_int(stmt.get(), 3, BATCH_SIZE);
+
+      const size_t before = changes.size();
+      while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        domain::DataChange change;
+        change.id = sqlite3_column_int64(stmt.get(), 0);
+        change.table =
+            reinterpret_cast<const char *>(sqlite3_column_text(stmt.get(), 1));
+        change.row_id = sqlite3_column_int64(stmt.get(), 2);
+        change.operation =
+            reinterpret_cast<const char *>(sqlite3_column_text(stmt.get(), 3));
+        after = change.id;
+        changes.push_back(std::move(change));
+      }
+      sqlite3_reset(stmt.get());
+
+      if (changes.size() == before) {
+        break; // Pruned meanwhile
+      }
+    }
+  }
+
+  transaction.commit();
+
+  // Own writes since the last poll are skipped along with the rest
+  last_data_version_ = version;
+  last_change_id_ = max_id;
+  return changes;
+}
+
+void ChangeFeed::prune() {
+  auto &db = DatabaseManager::instance();
+  auto db_lock = db.lock();
+
+  // Relative to the newest row rather than to what this feed has read:
+  // processes without a feed prune too
+  auto stmt = db.prepare("DELETE FROM change_log WHERE id <= "
+                         "(SELECT MAX(id) FROM change_log) - ?");
+  sqlite3_bind_int64(stmt.get(), 1, RETAINED_CHANGES);
+
+  if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+    LOG_WARNING("Failed to prune change log: {}",
+                sqlite3_errmsg(db.getHandle()));
+    return;
+  }
+
+  const int removed = sqlite3_changes(db.getHandle());
+  if (removed > 0) {
+    LOG_DEBUG("Pruned {} change log entries", removed);
+  }
+}
+
+} // namespace bluray::infrastructure
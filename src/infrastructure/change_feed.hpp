@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../domain/models.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bluray::infrastructure {
+
+/**
+ * Notices writes made to the database by other processes
+ *
+ * The cron scrapers run as separate processes on the same SQLite file.
+ * Triggers record every write to the tracked tables in change_log; this
+ * feed polls PRAGMA data_version, which only moves when another connection
+ * commits, and reads the new change_log rows only then. An idle poll is a
+ * single cheap read transaction.
+ *
+ * Rows written by this process in the same interval as an external commit
+ * are reported too; handlers must tolerate the occasional own change.
+ */
+class ChangeFeed {
+public:
+    using Handler = std::function<void(const std::vector<domain::DataChange>&)>;
+
+    /**
+     * @param handler Invoked on the feed thread with each batch of changes
+     * @param poll_interval Time between data_version checks
+     */
+    explicit ChangeFeed(Handler handler,
+                        std::chrono::milliseconds poll_interval = std::chrono::milliseconds(250));
+
+    /**
+     * Destructor - stops the polling thread
+     */
+    ~ChangeFeed();
+
+    // Prevent copying
+    ChangeFeed(const ChangeFeed&) = delete;
+    ChangeFeed& operator=(const ChangeFeed&) = delete;
+
+    /**
+     * Start polling; changes made before this call are not reported
+     */
+    void start();
+
+    /**
+     * Stop polling and wait for the thread
+     */
+    void stop();
+
+    /**
+     * Delete change_log rows beyond the retention limit
+     * Called by the feed, and by writers that run without one (cron
+     * scrapes), so that the log stays bounded either way.
+     */
+    static void prune();
+
+private:
+    void run();
+
+    /**
+     * Check for external changes
+     * @return Changes to report (empty if none)
+     */
+    std::vector<domain::DataChange> poll();
+
+    Handler handler_;
+    std::chrono::milliseconds poll_interval_;
+
+    int64_t last_data_version_{0};
+    int64_t last_change_id_{0};
+    std::chrono::steady_clock::time_point last_prune_;
+
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable stop_cv_;
+    bool stopping_{false};
+
+    // Rows read per query while catching up
+    static constexpr int BATCH_SIZE = 1000;
+    // change_log rows kept for late readers
+    static constexpr int64_t RETAINED_CHANGES = 10000;
+    static constexpr std::chrono::minutes PRUNE_INTERVAL{10};
+};
+
+} // namespace bluray::infrastructure
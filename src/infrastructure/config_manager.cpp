@@ -1,77 +1,57 @@
 #include "config_manager.hpp"
 #include "database_manager.hpp"
 #include "logger.hpp"
+#include <algorithm>
 #include <fmt/format.h>
 
 namespace bluray::infrastructure {
 
-ConfigManager &ConfigManager::instance() {
-  static ConfigManager instance;
-  return instance;
-}
-
-void ConfigManager::load() {
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  if (loaded_) {
-    return;
-  }
-
-  loadFromDatabase();
-  loaded_ = true;
-  Logger::instance().info("Configuration loaded");
-}
-
-std::optional<std::string> ConfigManager::get(std::string_view key) const {
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  const auto it = config_.find(std::string(key));
-  if (it != config_.end()) {
-    return it->second;
+std::optional<std::string_view>
+ConfigSnapshot::find(std::string_view key) const {
+  const auto it = values_.find(key);
+  if (it != values_.end()) {
+    return std::string_view(it->second.value);
   }
 
   return std::nullopt;
 }
 
-std::string ConfigManager::get(std::string_view key,
-                               std::string_view default_value) const {
-  auto value = get(key);
-  return value ? *value : std::string(default_value);
+std::string ConfigSnapshot::get(std::string_view key,
+                                std::string_view default_value) const {
+  auto value = find(key);
+  return std::string(value ? *value : default_value);
 }
 
-int ConfigManager::getInt(std::string_view key, int default_value) const {
-  auto value = get(key);
-  if (!value) {
+int ConfigSnapshot::getInt(std::string_view key, int default_value) const {
+  const auto it = values_.find(key);
+  if (it == values_.end()) {
     return default_value;
   }
 
-  try {
-    return std::stoi(*value);
-  } catch (...) {
-    Logger::instance().warning(
-        fmt::format("Failed to parse int config '{}': {}", key, *value));
+  if (!it->second.as_int) {
+    LOG_WARNING("Failed to parse int config '{}': {}", key, it->second.value);
     return default_value;
   }
+  return *it->second.as_int;
 }
 
-double ConfigManager::getDouble(std::string_view key,
-                                double default_value) const {
-  auto value = get(key);
-  if (!value) {
+double ConfigSnapshot::getDouble(std::string_view key,
+                                 double default_value) const {
+  const auto it = values_.find(key);
+  if (it == values_.end()) {
     return default_value;
   }
 
-  try {
-    return std::stod(*value);
-  } catch (...) {
-    Logger::instance().warning(
-        fmt::format("Failed to parse double config '{}': {}", key, *value));
+  if (!it->second.as_double) {
+    LOG_WARNING("Failed to parse double config '{}': {}", key,
+                it->second.value);
     return default_value;
   }
+  return *it->second.as_double;
 }
 
-bool ConfigManager::getBool(std::string_view key, bool default_value) const {
-  auto value = get(key);
+bool ConfigSnapshot::getBool(std::string_view key, bool default_value) const {
+  auto value = find(key);
   if (!value) {
     return default_value;
   }
@@ -80,28 +60,93 @@ bool ConfigManager::getBool(std::string_view key, bool default_value) const {
   return str == "1" || str == "true" || str == "yes" || str == "on";
 }
 
-void ConfigManager::set(std::string_view key, std::string_view value) {
-  std::lock_guard<std::mutex> lock(mutex_);
+bool ConfigSnapshot::has(std::string_view key) const {
+  return values_.find(key) != values_.end();
+}
+
+void ConfigSnapshot::put(const std::string &key, std::string value) {
+  Entry entry;
+  try {
+    entry.as_int = std::stoi(value);
+  } catch (...) {
+  }
+  try {
+    entry.as_double = std::stod(value);
+  } catch (...) {
+  }
+  entry.value = std::move(value);
 
-  // Update in-memory cache
-  config_[std::string(key)] = value;
+  values_[key] = std::move(entry);
+}
 
-  // Update in database
-  auto &db = DatabaseManager::instance();
-  auto db_lock = db.lock();
+ConfigManager &ConfigManager::instance() {
+  static ConfigManager instance;
+  return instance;
+}
+
+ConfigManager::ConfigManager()
+    : snapshot_(std::make_shared<const ConfigSnapshot>()) {}
+
+void ConfigManager::load() {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+
+  if (loaded_) {
+    return;
+  }
+
+  std::vector<std::string> changed;
+  publish(loadFromDatabase(), true, changed);
+  loaded_ = true;
+  LOG_INFO("Configuration loaded");
+}
+
+std::shared_ptr<const ConfigSnapshot> ConfigManager::snapshot() const {
+  return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+}
 
-  auto stmt =
-      db.prepare("INSERT OR REPLACE INTO config (key, value) VALUES (?, ?)");
+const ConfigSnapshot &ConfigManager::current() const {
+  // Readers only touch the shared pointer after a write; otherwise a read
+  // is one atomic load of the version
+  thread_local std::shared_ptr<const ConfigSnapshot> cached;
+  thread_local uint64_t cached_version = 0;
 
-  sqlite3_bind_text(stmt.get(), 1, std::string(key).c_str(), -1,
-                    SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt.get(), 2, std::string(value).c_str(), -1,
-                    SQLITE_TRANSIENT);
+  const auto version = version_.load(std::memory_order_acquire);
+  if (!cached || cached_version != version) {
+    cached = std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+    cached_version = version;
+  }
+  return *cached;
+}
 
-  if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
-    Logger::instance().error(fmt::format("Failed to set config '{}': {}", key,
-                                         sqlite3_errmsg(db.getHandle())));
+std::optional<std::string> ConfigManager::get(std::string_view key) const {
+  auto value = current().find(key);
+  if (value) {
+    return std::string(*value);
   }
+
+  return std::nullopt;
+}
+
+std::string ConfigManager::get(std::string_view key,
+                               std::string_view default_value) const {
+  return current().get(key, default_value);
+}
+
+int ConfigManager::getInt(std::string_view key, int default_value) const {
+  return current().getInt(key, default_value);
+}
+
+double ConfigManager::getDouble(std::string_view key,
+                                double default_value) const {
+  return current().getDouble(key, default_value);
+}
+
+bool ConfigManager::getBool(std::string_view key, bool default_value) const {
+  return current().getBool(key, default_value);
+}
+
+void ConfigManager::set(std::string_view key, std::string_view value) {
+  set({{std::string(key), std::string(value)}});
 }
 
 void ConfigManager::set(std::string_view key, int value) {
@@ -116,22 +161,98 @@ void ConfigManager::set(std::string_view key, bool value) {
   set(key, std::string(value ? "1" : "0"));
 }
 
+void ConfigManager::set(
+    const std::vector<std::pair<std::string, std::string>> &values) {
+  if (values.empty()) {
+    return;
+  }
+
+  std::vector<std::string> changed;
+  std::shared_ptr<const ConfigSnapshot> published;
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+
+    // Update in database
+    auto &db = DatabaseManager::instance();
+    auto db_lock = db.lock();
+
+    {
+      WriteTransaction transaction(db);
+      auto stmt = db.prepare(
+          "INSERT OR REPLACE INTO config (key, value) VALUES (?, ?)");
+
+      for (const auto &[key, value] : values) {
+        sqlite3_bind_text(stmt.get(), 1, key.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt.get(), 2, value.c_str(), -1, SQLITE_TRANSIENT);
+
+        if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+          LOG_ERROR("Failed to set config '{}': {}", key,
+                    sqlite3_errmsg(db.getHandle()));
+        }
+        sqlite3_reset(stmt.get());
+      }
+
+      transaction.commit();
+    }
+
+    // Update in-memory snapshot
+    published = publish({values.begin(), values.end()}, false, changed);
+  }
+
+  if (!changed.empty()) {
+    notify(changed, *published);
+  }
+}
+
 bool ConfigManager::has(std::string_view key) const {
-  std::lock_guard<std::mutex> lock(mutex_);
-  return config_.count(std::string(key)) > 0;
+  return current().has(key);
 }
 
 void ConfigManager::reload() {
-  std::lock_guard<std::mutex> lock(mutex_);
-  loadFromDatabase();
-  Logger::instance().info("Configuration reloaded");
+  std::vector<std::string> changed;
+  std::shared_ptr<const ConfigSnapshot> published;
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    published = publish(loadFromDatabase(), true, changed);
+  }
+  LOG_INFO("Configuration reloaded");
+
+  if (!changed.empty()) {
+    notify(changed, *published);
+  }
 }
 
-void ConfigManager::loadFromDatabase() {
+ConfigManager::SubscriptionId
+ConfigManager::subscribe(std::vector<std::string> keys, ChangeHandler handler) {
+  auto subscriber = std::make_shared<Subscriber>();
+  subscriber->keys = std::move(keys);
+  subscriber->handler = std::move(handler);
+
+  std::lock_guard<std::mutex> lock(subscribers_mutex_);
+  subscriber->id = next_subscription_id_++;
+  subscribers_.push_back(subscriber);
+  return subscriber->id;
+}
+
+void ConfigManager::unsubscribe(SubscriptionId id) {
+  {
+    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    subscribers_.erase(
+        std::remove_if(subscribers_.begin(), subscribers_.end(),
+                       [id](const auto &s) { return s->id == id; }),
+        subscribers_.end());
+  }
+
+  // Wait for a notification that may still be running the handler
+  std::lock_guard<std::recursive_mutex> lock(notify_mutex_);
+}
+
+std::map<std::string, std::string, std::less<>>
+ConfigManager::loadFromDatabase() {
   auto &db = DatabaseManager::instance();
   auto db_lock = db.lock();
 
-  config_.clear();
+  std::map<std::string, std::string, std::less<>> values;
 
   auto stmt = db.prepare("SELECT key, value FROM config");
 
@@ -142,7 +263,78 @@ void ConfigManager::loadFromDatabase() {
         reinterpret_cast<const char *>(sqlite3_column_text(stmt.get(), 1));
 
     if (key && value) {
-      config_[key] = value;
+      values[key] = value;
+    }
+  }
+
+  return values;
+}
+
+std::shared_ptr<const ConfigSnapshot> ConfigManager::publish(
+    const std::map<std::string, std::string, std::less<>> &values,
+    bool replace_all, std::vector<std::string> &changed_keys) {
+  const auto previous =
+      std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+
+  auto next = replace_all ? std::make_shared<ConfigSnapshot>()
+                          : std::make_shared<ConfigSnapshot>(*previous);
+
+  for (const auto &[key, value] : values) {
+    const auto old = previous->find(key);
+    if (!old || *old != value) {
+      changed_keys.push_back(key);
+    }
+    next->put(key, value);
+  }
+
+  if (replace_all) {
+    for (const auto &[key, entry] : previous->values_) {
+      if (values.find(key) == values.end()) {
+        changed_keys.push_back(key);
+      }
+    }
+  }
+
+  if (changed_keys.empty()) {
+    return previous;
+  }
+
+  next->version_ = previous->version_ + 1;
+  std::shared_ptr<const ConfigSnapshot> published = std::move(next);
+  std::atomic_store_explicit(&snapshot_, published, std::memory_order_release);
+
+  // Readers reload their cached snapshot once they see the new version
+  version_.store(published->version_, std::memory_order_release);
+
+  return published;
+}
+
+void ConfigManager::notify(const std::vector<std::string> &changed_keys,
+                           const ConfigSnapshot &snapshot) {
+  std::lock_guard<std::recursive_mutex> notify_lock(notify_mutex_);
+
+  std::vector<std::shared_ptr<const Subscriber>> subscribers;
+  {
+    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    subscribers = subscribers_;
+  }
+
+  for (const auto &subscriber : subscribers) {
+    const bool interested = std::any_of(
+        subscriber->keys.begin(), subscriber->keys.end(),
+        [&](const std::string &key) {
+          return std::find(changed_keys.begin(), changed_keys.end(), key) !=
+                 changed_keys.end();
+        });
+    if (!interested) {
+      continue;
+    }
+
+    try {
+      subscriber->handler(snapshot);
+    } catch (const std::exception &e) {
+      LOG_ERROR("Config change handler {} failed: {}", subscriber->id,
+                e.what());
     }
   }
 }
@@ -1,19 +1,72 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
-#include <optional>
-#include <unordered_map>
-#include <mutex>
+#include <utility>
+#include <vector>
 
 namespace bluray::infrastructure {
 
+/**
+ * Immutable view of all configuration values at one point in time
+ * Numeric values are parsed once when the snapshot is built.
+ */
+class ConfigSnapshot {
+public:
+    /**
+     * Get raw value (view into the snapshot)
+     */
+    [[nodiscard]] std::optional<std::string_view> find(std::string_view key) const;
+
+    [[nodiscard]] std::string get(std::string_view key, std::string_view default_value) const;
+    [[nodiscard]] int getInt(std::string_view key, int default_value = 0) const;
+    [[nodiscard]] double getDouble(std::string_view key, double default_value = 0.0) const;
+    [[nodiscard]] bool getBool(std::string_view key, bool default_value = false) const;
+
+    [[nodiscard]] bool has(std::string_view key) const;
+
+    /**
+     * Incremented every time a new snapshot is published
+     */
+    [[nodiscard]] uint64_t version() const { return version_; }
+
+private:
+    friend class ConfigManager;
+
+    struct Entry {
+        std::string value;
+        std::optional<int> as_int;
+        std::optional<double> as_double;
+    };
+
+    void put(const std::string& key, std::string value);
+
+    // Ordered map: heterogeneous lookup by string_view without allocating
+    std::map<std::string, Entry, std::less<>> values_;
+    uint64_t version_{0};
+};
+
 /**
  * Configuration manager that stores settings in SQLite
  * Thread-safe singleton
+ *
+ * Reads go to an immutable snapshot that writers replace wholesale, so they
+ * take no lock: each thread keeps the current snapshot and only reloads it
+ * (one atomic shared_ptr load) after a write. Components that cache
+ * settings subscribe to the keys they use and re-tune when they change.
  */
 class ConfigManager {
 public:
+    using SubscriptionId = uint64_t;
+    using ChangeHandler = std::function<void(const ConfigSnapshot&)>;
+
     /**
      * Get singleton instance
      */
@@ -24,6 +77,11 @@ public:
      */
     void load();
 
+    /**
+     * Current snapshot; stays valid (and unchanged) while held
+     */
+    [[nodiscard]] std::shared_ptr<const ConfigSnapshot> snapshot() const;
+
     /**
      * Get configuration value
      */
@@ -69,6 +127,13 @@ public:
      */
     void set(std::string_view key, bool value);
 
+    /**
+     * Set several values at once
+     * Stored in one transaction and published as one snapshot, so readers
+     * and subscribers never see half of the update.
+     */
+    void set(const std::vector<std::pair<std::string, std::string>>& values);
+
     /**
      * Check if key exists
      */
@@ -79,18 +144,77 @@ public:
      */
     void reload();
 
+    /**
+     * Subscribe to changes of some keys
+     * The handler runs on the writing thread, after the new snapshot has
+     * been published, once per update that changes any of the keys.
+     *
+     * @return Id for unsubscribe()
+     */
+    SubscriptionId subscribe(std::vector<std::string> keys, ChangeHandler handler);
+
+    /**
+     * Remove a subscription
+     * Once this returns the handler is not running and will not be called
+     * again.
+     */
+    void unsubscribe(SubscriptionId id);
+
 private:
-    ConfigManager() = default;
+    ConfigManager();
 
     // Prevent copying
     ConfigManager(const ConfigManager&) = delete;
     ConfigManager& operator=(const ConfigManager&) = delete;
 
-    void loadFromDatabase();
+    struct Subscriber {
+        SubscriptionId id;
+        std::vector<std::string> keys;
+        ChangeHandler handler;
+    };
 
-    mutable std::mutex mutex_;
-    std::unordered_map<std::string, std::string> config_;
+    /**
+     * Read all rows from the config table
+     */
+    std::map<std::string, std::string, std::less<>> loadFromDatabase();
+
+    /**
+     * Publish a new snapshot with the given values
+     * Caller holds write_mutex_.
+     *
+     * @param replace_all Values are the complete configuration (reload)
+     * @param changed_keys Receives the keys whose value changed
+     * @return Published snapshot (the current one if nothing changed)
+     */
+    std::shared_ptr<const ConfigSnapshot> publish(
+        const std::map<std::string, std::string, std::less<>>& values,
+        bool replace_all, std::vector<std::string>& changed_keys);
+
+    /**
+     * Current snapshot of the calling thread, refreshed after writes
+     */
+    const ConfigSnapshot& current() const;
+
+    /**
+     * Invoke the subscribers interested in any of the changed keys
+     */
+    void notify(const std::vector<std::string>& changed_keys,
+                const ConfigSnapshot& snapshot);
+
+    // Published snapshot; accessed with the std::atomic_* shared_ptr overloads
+    std::shared_ptr<const ConfigSnapshot> snapshot_;
+    std::atomic<uint64_t> version_{0};
+
+    std::mutex write_mutex_; // Serializes writers
     bool loaded_{false};
+
+    std::mutex subscribers_mutex_;
+    std::vector<std::shared_ptr<const Subscriber>> subscribers_;
+    SubscriptionId next_subscription_id_{1};
+
+    // Held while handlers run so unsubscribe() can wait for them; recursive
+    // because handlers may themselves change settings
+    std::recursive_mutex notify_mutex_;
 };
 
 } // namespace bluray::infrastructure
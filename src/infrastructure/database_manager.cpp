@@ -20,10 +20,17 @@ void DatabaseManager::initialize(std::string_view db_path) {
   if (result != SQLITE_OK) {
     const std::string error =
         fmt::format("Failed to open database: {}", sqlite3_errmsg(db_));
-    Logger::instance().error(error);
+    LOG_ERROR("{}", error);
     throw DatabaseException(error);
   }
 
+  // The cron scrapers and the web server share this file: wait for the
+  // other process's write lock instead of failing with SQLITE_BUSY, and use
+  // WAL so readers and the single writer do not block each other
+  sqlite3_busy_timeout(db_, BUSY_TIMEOUT_MS);
+  execute("PRAGMA journal_mode = WAL");
+  execute("PRAGMA synchronous = NORMAL");
+
   // Enable foreign keys
   execute("PRAGMA foreign_keys = ON");
 
@@ -32,7 +39,7 @@ void DatabaseManager::initialize(std::string_view db_path) {
   insertDefaultConfig();
 
   initialized_ = true;
-  Logger::instance().info(fmt::format("Database initialized: {}", db_path));
+  LOG_INFO("Database initialized: {}", db_path);
 }
 
 sqlite3 *DatabaseManager::getHandle() { return db_; }
@@ -66,8 +73,19 @@ Statement DatabaseManager::prepare(std::string_view sql) {
   return Statement(stmt);
 }
 
+int64_t DatabaseManager::dataVersion() {
+  auto stmt = prepare("PRAGMA data_version");
+  if (sqlite3_step(stmt.get()) != SQLITE_ROW) {
+    throw DatabaseException(
+        fmt::format("Failed to read data version: {}", sqlite3_errmsg(db_)));
+  }
+  return sqlite3_column_int64(stmt.get(), 0);
+}
+
 void DatabaseManager::beginTransaction() { execute("BEGIN TRANSACTION"); }
 
+void DatabaseManager::beginWriteTransaction() { execute("BEGIN IMMEDIATE"); }
+
 void DatabaseManager::commit() { execute("COMMIT"); }
 
 void DatabaseManager::rollback() { execute("ROLLBACK"); }
@@ -86,7 +104,7 @@ void DatabaseManager::close() {
   if (db_) {
     sqlite3_close(db_);
     db_ = nullptr;
-    Logger::instance().info("Database closed");
+    LOG_INFO("Database closed");
   }
 }
 
@@ -108,13 +126,13 @@ void DatabaseManager::createSchema() {
             url TEXT NOT NULL UNIQUE,
             title TEXT NOT NULL,
             title_locked INTEGER NOT NULL DEFAULT 0,
-            current_price REAL NOT NULL DEFAULT 0.0,
-            desired_max_price REAL NOT NULL,
+            current_price_cents INTEGER NOT NULL DEFAULT 0,
+            desired_max_price_cents INTEGER NOT NULL DEFAULT 0,
             in_stock INTEGER NOT NULL DEFAULT 0,
             is_uhd_4k INTEGER NOT NULL DEFAULT 0,
             image_url TEXT,
             local_image_path TEXT,
-            source TEXT NOT NULL,
+            source_id INTEGER NOT NULL DEFAULT 0,
             notify_on_price_drop INTEGER NOT NULL DEFAULT 1,
             notify_on_stock INTEGER NOT NULL DEFAULT 1,
             created_at TEXT NOT NULL,
@@ -128,11 +146,11 @@ void DatabaseManager::createSchema() {
             id INTEGER PRIMARY KEY AUTOINCREMENT,
             url TEXT NOT NULL UNIQUE,
             title TEXT NOT NULL,
-            purchase_price REAL NOT NULL DEFAULT 0.0,
+            purchase_price_cents INTEGER NOT NULL DEFAULT 0,
             is_uhd_4k INTEGER NOT NULL DEFAULT 0,
             image_url TEXT,
             local_image_path TEXT,
-            source TEXT NOT NULL,
+            source_id INTEGER NOT NULL DEFAULT 0,
             notes TEXT,
             purchased_at TEXT NOT NULL,
             added_at TEXT NOT NULL
@@ -144,7 +162,7 @@ void DatabaseManager::createSchema() {
         CREATE TABLE IF NOT EXISTS price_history (
             id INTEGER PRIMARY KEY AUTOINCREMENT,
             wishlist_id INTEGER NOT NULL,
-            price REAL NOT NULL,
+            price_cents INTEGER NOT NULL,
             in_stock INTEGER NOT NULL,
             recorded_at TEXT NOT NULL,
             FOREIGN KEY (wishlist_id) REFERENCES wishlist(id) ON DELETE CASCADE
@@ -157,14 +175,14 @@ void DatabaseManager::createSchema() {
             id INTEGER PRIMARY KEY AUTOINCREMENT,
             title TEXT NOT NULL,
             release_date TEXT NOT NULL,
-            format TEXT NOT NULL,
+            format_id INTEGER NOT NULL DEFAULT 0,
             studio TEXT,
             image_url TEXT,
             local_image_path TEXT,
             product_url TEXT,
             is_uhd_4k INTEGER NOT NULL DEFAULT 0,
             is_preorder INTEGER NOT NULL DEFAULT 0,
-            price REAL,
+            price_cents INTEGER NOT NULL DEFAULT 0,
             notes TEXT,
             created_at TEXT NOT NULL,
             last_updated TEXT NOT NULL
@@ -174,8 +192,10 @@ void DatabaseManager::createSchema() {
   // Create indices for better performance
   execute("CREATE INDEX IF NOT EXISTS idx_wishlist_url ON wishlist(url)");
   execute("CREATE INDEX IF NOT EXISTS idx_collection_url ON collection(url)");
-  execute("CREATE INDEX IF NOT EXISTS idx_price_history_wishlist ON "
-          "price_history(wishlist_id)");
+  // Per-item history in time order; replaces the wishlist_id-only index
+  execute("CREATE INDEX IF NOT EXISTS idx_price_history_wishlist_time ON "
+          "price_history(wishlist_id, recorded_at)");
+  execute("DROP INDEX IF EXISTS idx_price_history_wishlist");
   execute("CREATE INDEX IF NOT EXISTS idx_release_calendar_date ON "
           "release_calendar(release_date)");
   execute("CREATE INDEX IF NOT EXISTS idx_release_calendar_url ON "
@@ -208,6 +228,43 @@ void DatabaseManager::createSchema() {
   execute("CREATE INDEX IF NOT EXISTS idx_item_tags_tag ON "
           "item_tags(tag_id)");
 
+  // Transactional outbox for change notifications (one row per channel)
+  execute(R"(
+        CREATE TABLE IF NOT EXISTS notification_outbox (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            idempotency_key TEXT NOT NULL,
+            channel TEXT NOT NULL,
+            wishlist_id INTEGER NOT NULL,
+            payload TEXT NOT NULL,
+            status TEXT NOT NULL DEFAULT 'pending',
+            attempts INTEGER NOT NULL DEFAULT 0,
+            next_attempt_at TEXT NOT NULL,
+            lease_token TEXT,
+            locked_until TEXT,
+            last_error TEXT,
+            created_at TEXT NOT NULL,
+            delivered_at TEXT,
+            UNIQUE(idempotency_key, channel)
+        )
+    )");
+
+  execute("CREATE INDEX IF NOT EXISTS idx_notification_outbox_due ON "
+          "notification_outbox(status, channel, next_attempt_at)");
+  execute("CREATE INDEX IF NOT EXISTS idx_notification_outbox_lease ON "
+          "notification_outbox(lease_token)");
+
+  // User-defined alert rules (conditions are a JSON array)
+  execute(R"(
+        CREATE TABLE IF NOT EXISTS alert_rules (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            name TEXT NOT NULL,
+            conditions TEXT NOT NULL,
+            notify_via TEXT NOT NULL DEFAULT '',
+            enabled INTEGER NOT NULL DEFAULT 1,
+            created_at TEXT NOT NULL
+        )
+    )");
+
   // Migrations
   try {
     execute("ALTER TABLE wishlist ADD COLUMN title_locked INTEGER NOT NULL "
@@ -236,7 +293,8 @@ void DatabaseManager::createSchema() {
 
   // Edition & bonus features columns for wishlist
   try {
-    execute("ALTER TABLE wishlist ADD COLUMN edition_type TEXT DEFAULT ''");
+    execute("ALTER TABLE wishlist ADD COLUMN edition_type_id INTEGER NOT NULL "
+            "DEFAULT 0");
   } catch (...) {
   }
   try {
@@ -272,7 +330,8 @@ void DatabaseManager::createSchema() {
 
   // Edition & bonus features columns for collection
   try {
-    execute("ALTER TABLE collection ADD COLUMN edition_type TEXT DEFAULT ''");
+    execute("ALTER TABLE collection ADD COLUMN edition_type_id INTEGER NOT NULL "
+            "DEFAULT 0");
   } catch (...) {
   }
   try {
@@ -287,6 +346,287 @@ void DatabaseManager::createSchema() {
     execute("ALTER TABLE collection ADD COLUMN bonus_features TEXT DEFAULT ''");
   } catch (...) {
   }
+
+  // Dictionary for low-cardinality strings (source, edition type, format);
+  // items reference it by id, 0 is the empty string
+  execute(R"(
+        CREATE TABLE IF NOT EXISTS symbols (
+            id INTEGER PRIMARY KEY,
+            value TEXT NOT NULL UNIQUE
+        )
+    )");
+  migrateSymbolColumns();
+
+  // Prices are whole cents (domain::Money)
+  migratePriceColumns();
+  execute("CREATE INDEX IF NOT EXISTS idx_wishlist_price ON "
+          "wishlist(current_price_cents)");
+
+  // Running price statistics per item, updated with every price_history
+  // insert (see PriceStatsRepository). last_change_at is in epoch seconds,
+  // daily_low and daily_high rings of per-day minimums and maximums
+  // (little-endian 32-bit cents); the previous_* columns hold what the
+  // newest sample replaced.
+  execute(R"(
+        CREATE TABLE IF NOT EXISTS price_stats (
+            wishlist_id INTEGER PRIMARY KEY,
+            all_time_low_cents INTEGER NOT NULL,
+            all_time_high_cents INTEGER NOT NULL,
+            ema_cents REAL NOT NULL,
+            last_price_cents INTEGER NOT NULL,
+            last_change_at INTEGER NOT NULL,
+            samples INTEGER NOT NULL,
+            last_day INTEGER NOT NULL,
+            daily_low BLOB NOT NULL,
+            daily_high BLOB,
+            previous_low_cents INTEGER NOT NULL DEFAULT 0,
+            previous_day_low_cents INTEGER NOT NULL DEFAULT 0,
+            previous_day_high_cents INTEGER NOT NULL DEFAULT 0,
+            FOREIGN KEY (wishlist_id) REFERENCES wishlist(id) ON DELETE CASCADE
+        )
+    )");
+  if (!hasColumn("price_stats", "daily_high")) {
+    execute("ALTER TABLE price_stats ADD COLUMN daily_high BLOB");
+    for (const char *column : {"previous_low_cents", "previous_day_low_cents",
+                               "previous_day_high_cents"}) {
+      execute(fmt::format("ALTER TABLE price_stats ADD COLUMN {} INTEGER "
+                          "NOT NULL DEFAULT 0",
+                          column));
+    }
+  }
+
+  // Product identity across retailers: wishlist items scraped with the same
+  // EAN or ASIN point at one products row (see ProductRepository)
+  execute(R"(
+        CREATE TABLE IF NOT EXISTS products (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            ean TEXT UNIQUE,
+            asin TEXT UNIQUE,
+            title TEXT NOT NULL DEFAULT '',
+            created_at TEXT NOT NULL
+        )
+    )");
+  try {
+    execute("ALTER TABLE wishlist ADD COLUMN product_id INTEGER "
+            "REFERENCES products(id) ON DELETE SET NULL");
+  } catch (...) {
+  }
+  execute("CREATE INDEX IF NOT EXISTS idx_wishlist_product ON "
+          "wishlist(product_id, in_stock, current_price_cents)");
+
+  // Cheapest in-stock offer per product, kept current by triggers on every
+  // wishlist write so comparisons are a primary key lookup
+  execute(R"(
+        CREATE TABLE IF NOT EXISTS product_best_price (
+            product_id INTEGER PRIMARY KEY,
+            wishlist_id INTEGER,
+            price_cents INTEGER,
+            offer_count INTEGER NOT NULL,
+            FOREIGN KEY (product_id) REFERENCES products(id) ON DELETE CASCADE
+        )
+    )");
+
+  constexpr const char *kRefreshBestPrice = R"(
+            INSERT OR REPLACE INTO product_best_price
+                (product_id, wishlist_id, price_cents, offer_count)
+            SELECT {0}, best.id, best.current_price_cents,
+                   (SELECT COUNT(*) FROM wishlist WHERE product_id = {0})
+            FROM (SELECT 1) LEFT JOIN (
+                SELECT id, current_price_cents FROM wishlist
+                WHERE product_id = {0} AND in_stock = 1
+                  AND current_price_cents > 0
+                ORDER BY current_price_cents, id LIMIT 1
+            ) AS best;)";
+
+  struct BestPriceTrigger {
+    const char *name;
+    const char *event;
+    const char *product_id; // Product whose best price may have changed
+  };
+  const BestPriceTrigger best_price_triggers[] = {
+      {"insert", "AFTER INSERT ON wishlist WHEN NEW.product_id IS NOT NULL",
+       "NEW.product_id"},
+      {"update",
+       "AFTER UPDATE OF product_id, current_price_cents, in_stock ON wishlist "
+       "WHEN NEW.product_id IS NOT NULL",
+       "NEW.product_id"},
+      {"move",
+       "AFTER UPDATE OF product_id ON wishlist WHEN OLD.product_id IS NOT NULL "
+       "AND OLD.product_id IS NOT NEW.product_id",
+       "OLD.product_id"},
+      {"delete", "AFTER DELETE ON wishlist WHEN OLD.product_id IS NOT NULL",
+       "OLD.product_id"}};
+
+  for (const auto &trigger : best_price_triggers) {
+    execute(fmt::format(
+        "CREATE TRIGGER IF NOT EXISTS trg_wishlist_best_price_{} {}\n"
+        "        BEGIN{}\n        END",
+        trigger.name, trigger.event,
+        fmt::format(kRefreshBestPrice, trigger.product_id)));
+  }
+
+  // Upcoming releases whose title matches a wishlist or collection item,
+  // recomputed after every calendar refresh (see ReleaseMatcher). Items are
+  // in two tables, so their rows are removed by triggers instead of keys.
+  execute(R"(
+        CREATE TABLE IF NOT EXISTS release_matches (
+            release_id INTEGER NOT NULL,
+            item_type TEXT NOT NULL CHECK (item_type IN ('wishlist', 'collection')),
+            item_id INTEGER NOT NULL,
+            score REAL NOT NULL,
+            PRIMARY KEY (release_id, item_type, item_id),
+            FOREIGN KEY (release_id) REFERENCES release_calendar(id) ON DELETE CASCADE
+        )
+    )");
+  execute("CREATE INDEX IF NOT EXISTS idx_release_matches_item ON "
+          "release_matches(item_type, item_id)");
+  for (const char *table : {"wishlist", "collection"}) {
+    execute(fmt::format(R"(
+        CREATE TRIGGER IF NOT EXISTS trg_{0}_release_matches_delete
+        AFTER DELETE ON {0}
+        BEGIN
+            DELETE FROM release_matches
+            WHERE item_type = '{0}' AND item_id = OLD.id;
+        END
+    )",
+                        table));
+  }
+
+  // Change feed for other processes (see ChangeFeed). Filled by triggers so
+  // that every writer, including the sqlite3 shell, is covered.
+  execute(R"(
+        CREATE TABLE IF NOT EXISTS change_log (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            table_name TEXT NOT NULL,
+            row_id INTEGER NOT NULL,
+            operation TEXT NOT NULL,
+            changed_at TEXT NOT NULL DEFAULT (strftime('%Y-%m-%dT%H:%M:%SZ', 'now'))
+        )
+    )");
+
+  for (const char *table :
+       {"wishlist", "collection", "release_calendar", "config"}) {
+    execute(fmt::format(R"(
+        CREATE TRIGGER IF NOT EXISTS trg_{0}_change_insert AFTER INSERT ON {0}
+        BEGIN
+            INSERT INTO change_log (table_name, row_id, operation)
+            VALUES ('{0}', NEW.rowid, 'insert');
+        END
+    )",
+                        table));
+    execute(fmt::format(R"(
+        CREATE TRIGGER IF NOT EXISTS trg_{0}_change_update AFTER UPDATE ON {0}
+        BEGIN
+            INSERT INTO change_log (table_name, row_id, operation)
+            VALUES ('{0}', NEW.rowid, 'update');
+        END
+    )",
+                        table));
+    execute(fmt::format(R"(
+        CREATE TRIGGER IF NOT EXISTS trg_{0}_change_delete AFTER DELETE ON {0}
+        BEGIN
+            INSERT INTO change_log (table_name, row_id, operation)
+            VALUES ('{0}', OLD.rowid, 'delete');
+        END
+    )",
+                        table));
+  }
+}
+
+bool DatabaseManager::hasColumn(std::string_view table,
+                                std::string_view column) {
+  auto stmt = prepare(fmt::format("PRAGMA table_info({})", table));
+  while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+    const char *name =
+        reinterpret_cast<const char *>(sqlite3_column_text(stmt.get(), 1));
+    if (name && column == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void DatabaseManager::migrateSymbolColumns() {
+  struct SymbolColumn {
+    const char *table;
+    const char *column;
+  };
+  static constexpr SymbolColumn kColumns[] = {
+      {"wishlist", "source"},   {"wishlist", "edition_type"},
+      {"collection", "source"}, {"collection", "edition_type"},
+      {"release_calendar", "format"}};
+
+  WriteTransaction transaction(*this);
+
+  for (const auto &[table, column] : kColumns) {
+    if (!hasColumn(table, column)) {
+      continue; // Already migrated
+    }
+
+    // Replace the text column by an id into the symbols table
+    if (!hasColumn(table, fmt::format("{}_id", column))) {
+      execute(fmt::format(
+          "ALTER TABLE {} ADD COLUMN {}_id INTEGER NOT NULL DEFAULT 0", table,
+          column));
+    }
+    execute(fmt::format("INSERT OR IGNORE INTO symbols (value) "
+                        "SELECT DISTINCT {1} FROM {0} "
+                        "WHERE {1} IS NOT NULL AND {1} <> ''",
+                        table, column));
+    execute(fmt::format("UPDATE {0} SET {1}_id = COALESCE("
+                        "(SELECT id FROM symbols WHERE value = {0}.{1}), 0)",
+                        table, column));
+    execute(fmt::format("ALTER TABLE {} DROP COLUMN {}", table, column));
+
+    LOG_INFO("Migrated {}.{} to symbol ids", table, column);
+  }
+
+  // Studios are free text again: restore a column migrated to ids
+  if (hasColumn("release_calendar", "studio_id")) {
+    if (!hasColumn("release_calendar", "studio")) {
+      execute("ALTER TABLE release_calendar ADD COLUMN studio TEXT");
+    }
+    execute("UPDATE release_calendar SET studio = "
+            "(SELECT value FROM symbols WHERE id = release_calendar.studio_id)");
+    execute("ALTER TABLE release_calendar DROP COLUMN studio_id");
+    LOG_INFO("Migrated release_calendar.studio back to text");
+  }
+
+  transaction.commit();
+}
+
+void DatabaseManager::migratePriceColumns() {
+  struct PriceColumn {
+    const char *table;
+    const char *column;
+  };
+  static constexpr PriceColumn kColumns[] = {
+      {"wishlist", "current_price"},   {"wishlist", "desired_max_price"},
+      {"collection", "purchase_price"}, {"price_history", "price"},
+      {"release_calendar", "price"}};
+
+  WriteTransaction transaction(*this);
+
+  for (const auto &[table, column] : kColumns) {
+    if (!hasColumn(table, column)) {
+      continue; // Already migrated
+    }
+
+    // Replace the REAL euro column by an integer number of cents
+    if (!hasColumn(table, fmt::format("{}_cents", column))) {
+      execute(fmt::format(
+          "ALTER TABLE {} ADD COLUMN {}_cents INTEGER NOT NULL DEFAULT 0",
+          table, column));
+    }
+    execute(fmt::format("UPDATE {0} SET {1}_cents = "
+                        "CAST(ROUND(COALESCE({1}, 0) * 100) AS INTEGER)",
+                        table, column));
+    execute(fmt::format("ALTER TABLE {} DROP COLUMN {}", table, column));
+
+    LOG_INFO("Migrated {}.{} to cents", table, column);
+  }
+
+  transaction.commit();
 }
 
 void DatabaseManager::insertDefaultConfig() {
@@ -303,6 +643,7 @@ void DatabaseManager::insertDefaultConfig() {
   execute(R"(
         INSERT OR IGNORE INTO config (key, value) VALUES
         ('scrape_delay_seconds', '8'),
+        ('scrape_concurrency', '4'),
         ('discord_webhook_url', ''),
         ('smtp_server', ''),
         ('smtp_port', '587'),
@@ -319,10 +660,14 @@ void DatabaseManager::insertDefaultConfig() {
         ('bluray_calendar_days_ahead', '90'),
         ('tmdb_api_key', ''),
         ('tmdb_auto_enrich', '0'),
-        ('tmdb_enrich_on_add', '1')
+        ('tmdb_enrich_on_add', '1'),
+        ('price_history_backend', 'sqlite'),
+        ('price_series_directory', './price_series'),
+        ('release_match_min_similarity', '0.6'),
+        ('duplicate_min_similarity', '0.8')
     )");
 
-  Logger::instance().info("Default configuration inserted");
+  LOG_INFO("Default configuration inserted");
 }
 
 } // namespace bluray::infrastructure
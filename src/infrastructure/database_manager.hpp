@@ -90,10 +90,26 @@ public:
   [[nodiscard]] Statement prepare(std::string_view sql);
 
   /**
-   * Begin transaction
+   * PRAGMA data_version of this connection
+   * Changes only when another connection (process) commits, so polling it
+   * tells whether anything outside this process wrote to the database.
+   * Thread-safe: caller must hold lock
+   */
+  [[nodiscard]] int64_t dataVersion();
+
+  /**
+   * Begin a deferred transaction: the write lock is taken at the first
+   * write, which fails with SQLITE_BUSY if another connection wrote since
+   * this transaction's first read
    */
   void beginTransaction();
 
+  /**
+   * Begin a transaction that holds the write lock from the start
+   * (BEGIN IMMEDIATE), waiting up to the busy timeout for other writers
+   */
+  void beginWriteTransaction();
+
   /**
    * Commit transaction
    */
@@ -128,8 +144,26 @@ private:
   DatabaseManager &operator=(const DatabaseManager &) = delete;
 
   void createSchema();
+
+  /**
+   * Check whether a table has a column
+   */
+  bool hasColumn(std::string_view table, std::string_view column);
+
+  /**
+   * Move low-cardinality text columns of older databases to symbol ids
+   */
+  void migrateSymbolColumns();
+
+  /**
+   * Move REAL euro price columns of older databases to integer cents
+   */
+  void migratePriceColumns();
   void insertDefaultConfig();
 
+  // How long a write waits for another process's lock before SQLITE_BUSY
+  static constexpr int BUSY_TIMEOUT_MS = 5000;
+
   sqlite3 *db_{nullptr};
   std::recursive_mutex mutex_;
   bool initialized_{false};
@@ -137,12 +171,11 @@ private:
 
 /**
  * RAII transaction guard
+ * Use WriteTransaction for transactions that write.
  */
 class Transaction {
 public:
-  explicit Transaction(DatabaseManager &db) : db_(db), committed_(false) {
-    db_.beginTransaction();
-  }
+  explicit Transaction(DatabaseManager &db) : Transaction(db, false) {}
 
   ~Transaction() {
     if (!committed_) {
@@ -159,9 +192,28 @@ public:
     committed_ = true;
   }
 
+protected:
+  Transaction(DatabaseManager &db, bool write) : db_(db), committed_(false) {
+    if (write) {
+      db_.beginWriteTransaction();
+    } else {
+      db_.beginTransaction();
+    }
+  }
+
 private:
   DatabaseManager &db_;
   bool committed_;
 };
 
+/**
+ * RAII guard of a transaction that writes
+ * Takes the write lock up front, so that reads before the first write
+ * cannot leave it unable to upgrade when another process commits.
+ */
+class WriteTransaction : public Transaction {
+public:
+  explicit WriteTransaction(DatabaseManager &db) : Transaction(db, true) {}
+};
+
 } // namespace bluray::infrastructure
@@ -14,8 +14,7 @@ ImageCache::ImageCache(std::string_view cache_directory)
   // Create cache directory if it doesn't exist
   if (!std::filesystem::exists(cache_dir_)) {
     std::filesystem::create_directories(cache_dir_);
-    Logger::instance().info(
-        fmt::format("Created cache directory: {}", cache_dir_.string()));
+    LOG_INFO("Created cache directory: {}", cache_dir_.string());
   }
 }
 
@@ -37,8 +36,7 @@ std::optional<std::string> ImageCache::cacheImage(std::string_view image_url) {
   auto image_data = client.downloadFile(image_url);
 
   if (!image_data || image_data->empty()) {
-    Logger::instance().warning(
-        fmt::format("Failed to download image (empty data): {}", image_url));
+    LOG_WARNING("Failed to download image (empty data): {}", image_url);
     return std::nullopt;
   }
 
@@ -49,8 +47,7 @@ std::optional<std::string> ImageCache::cacheImage(std::string_view image_url) {
   // Save to disk
   std::ofstream file(file_path, std::ios::binary);
   if (!file.is_open()) {
-    Logger::instance().error(
-        fmt::format("Failed to open file for writing: {}", file_path.string()));
+    LOG_ERROR("Failed to open file for writing: {}", file_path.string());
     return std::nullopt;
   }
 
@@ -60,14 +57,12 @@ std::optional<std::string> ImageCache::cacheImage(std::string_view image_url) {
 
   // Verify file size
   if (std::filesystem::file_size(file_path) == 0) {
-    Logger::instance().error(fmt::format(
-        "Downloaded image is empty, deleting: {}", file_path.string()));
+    LOG_ERROR("Downloaded image is empty, deleting: {}", file_path.string());
     std::filesystem::remove(file_path);
     return std::nullopt;
   }
 
-  Logger::instance().debug(
-      fmt::format("Cached image: {} -> {}", image_url, file_path.string()));
+  LOG_DEBUG("Cached image: {} -> {}", image_url, file_path.string());
 
   return file_path.string();
 }
@@ -107,7 +102,7 @@ void ImageCache::clear() {
     }
   }
 
-  Logger::instance().info(fmt::format("Cleared {} cached images", count));
+  LOG_INFO("Cleared {} cached images", count);
 }
 
 std::string ImageCache::generateFilename(std::string_view url) const {
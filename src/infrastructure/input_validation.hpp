@@ -24,6 +24,15 @@ constexpr std::array<std::string_view, 2> VALID_SORT_ORDERS = {"asc", "desc"};
 constexpr std::array<std::string_view, 2> VALID_STOCK_FILTERS = {
     "in_stock", "out_of_stock"};
 
+// Edition types offered by the frontend ("" is a standard edition); stored
+// as interned symbols, so free text is not accepted
+constexpr std::array<std::string_view, 6> VALID_EDITION_TYPES = {
+    "", "Steelbook", "Collector's", "Ultimate", "Limited", "Director's Cut"};
+
+// Release calendar formats; interned like edition types
+constexpr std::array<std::string_view, 3> VALID_RELEASE_FORMATS = {
+    "Blu-ray", "UHD 4K", "3D Blu-ray"};
+
 /**
  * Converts a string to lowercase
  * @param str The string to convert
@@ -200,6 +209,26 @@ inline bool isValidTrailerKey(std::string_view trailer_key) {
   return true;
 }
 
+/**
+ * Validates edition type (one of VALID_EDITION_TYPES, case-sensitive)
+ * @param edition_type The edition type to validate
+ * @return true if it is a known edition type
+ */
+inline bool isValidEditionType(std::string_view edition_type) {
+  return std::find(VALID_EDITION_TYPES.begin(), VALID_EDITION_TYPES.end(),
+                   edition_type) != VALID_EDITION_TYPES.end();
+}
+
+/**
+ * Validates release format (one of VALID_RELEASE_FORMATS, case-sensitive)
+ * @param format The format to validate
+ * @return true if it is a known format
+ */
+inline bool isValidReleaseFormat(std::string_view format) {
+  return std::find(VALID_RELEASE_FORMATS.begin(), VALID_RELEASE_FORMATS.end(),
+                   format) != VALID_RELEASE_FORMATS.end();
+}
+
 /**
  * Validates tag name (non-empty, reasonable length, safe characters)
  * @param name The tag name to validate
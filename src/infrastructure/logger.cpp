@@ -1,88 +1,509 @@
 #include "logger.hpp"
-#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <ctime>
 #include <iostream>
-#include <sstream>
+#include <iterator>
 
 namespace bluray::infrastructure {
 
+namespace {
+
+void appendJsonString(std::string &out, std::string_view value) {
+  out += '"';
+  for (const char c : value) {
+    switch (c) {
+    case '"':
+      out += "\\\"";
+      break;
+    case '\\':
+      out += "\\\\";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    case '\r':
+      out += "\\r";
+      break;
+    case '\t':
+      out += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        fmt::format_to(std::back_inserter(out), "\\u{:04x}",
+                       static_cast<unsigned>(c));
+      } else {
+        out += c;
+      }
+    }
+  }
+  out += '"';
+}
+
+/**
+ * Text values are quoted only when they would otherwise be ambiguous
+ */
+void appendTextValue(std::string &out, std::string_view value) {
+  constexpr std::string_view special = " \"=\t\r\n";
+  if (value.empty() || value.find_first_of(special) != std::string_view::npos) {
+    appendJsonString(out, value);
+  } else {
+    out += value;
+  }
+}
+
+/**
+ * Encode a field for both output formats
+ */
+void encodeField(const LogField &field, std::string &text, std::string &json) {
+  text += ' ';
+  text += field.key;
+  text += '=';
+  json += ',';
+  appendJsonString(json, field.key);
+  json += ':';
+
+  switch (field.type) {
+  case LogField::Type::String:
+    appendTextValue(text, field.text);
+    appendJsonString(json, field.text);
+    break;
+  case LogField::Type::Integer:
+    fmt::format_to(std::back_inserter(text), "{}", field.integer);
+    fmt::format_to(std::back_inserter(json), "{}", field.integer);
+    break;
+  case LogField::Type::Float:
+    fmt::format_to(std::back_inserter(text), "{}", field.number);
+    if (std::isfinite(field.number)) {
+      fmt::format_to(std::back_inserter(json), "{}", field.number);
+    } else {
+      json += "null";
+    }
+    break;
+  case LogField::Type::Bool:
+    text += field.integer ? "true" : "false";
+    json += field.integer ? "true" : "false";
+    break;
+  }
+}
+
+const char *levelToJson(LogLevel level) {
+  switch (level) {
+  case LogLevel::Debug:
+    return "debug";
+  case LogLevel::Info:
+    return "info";
+  case LogLevel::Warning:
+    return "warning";
+  case LogLevel::Error:
+    return "error";
+  default:
+    return "unknown";
+  }
+}
+
+} // namespace
+
 Logger &Logger::instance() {
   static Logger instance;
   return instance;
 }
 
-void Logger::initialize(std::string_view log_file_path) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+Logger::Logger() : ring_(std::make_unique<Slot[]>(RING_CAPACITY)) {
+  static_assert((RING_CAPACITY & (RING_CAPACITY - 1)) == 0,
+                "Log ring capacity must be a power of two");
 
-  if (initialized_) {
-    return;
+  for (size_t i = 0; i < RING_CAPACITY; ++i) {
+    ring_[i].sequence.store(i, std::memory_order_relaxed);
   }
 
-  log_file_.open(std::string(log_file_path), std::ios::app);
-  if (!log_file_.is_open()) {
-    std::cerr << fmt::format("Failed to open log file: {}\n", log_file_path);
+  running_ = true;
+  writer_ = std::thread(&Logger::run, this);
+}
+
+Logger::~Logger() { close(); }
+
+void Logger::initialize(std::string_view log_file_path,
+                        LoggerOptions options) {
+  flush_interval_ms_ = options.flush_interval.count();
+  overflow_ = options.overflow;
+
+  {
+    std::lock_guard<std::mutex> lock(output_mutex_);
+
+    if (initialized_) {
+      return;
+    }
+
+    options_ = options;
+    if (!log_file_.open(log_file_path, options.rotation)) {
+      std::cerr << fmt::format("Failed to open log file: {}\n", log_file_path);
+    }
+
+    initialized_ = true;
   }
 
-  initialized_ = true;
   log_impl(LogLevel::Info, "Logger initialized");
 }
 
 void Logger::setLevel(LogLevel level) { min_level_ = level; }
 
 void Logger::debug(std::string_view message) {
-  if (LogLevel::Debug < min_level_) {
+  if (!isEnabled(LogLevel::Debug)) {
     return;
   }
   log_impl(LogLevel::Debug, message);
 }
 
 void Logger::info(std::string_view message) {
-  if (LogLevel::Info < min_level_) {
+  if (!isEnabled(LogLevel::Info)) {
     return;
   }
   log_impl(LogLevel::Info, message);
 }
 
 void Logger::warning(std::string_view message) {
-  if (LogLevel::Warning < min_level_) {
+  if (!isEnabled(LogLevel::Warning)) {
     return;
   }
   log_impl(LogLevel::Warning, message);
 }
 
 void Logger::error(std::string_view message) {
-  if (LogLevel::Error < min_level_) {
+  if (!isEnabled(LogLevel::Error)) {
     return;
   }
   log_impl(LogLevel::Error, message);
 }
 
+void Logger::flush() {
+  if (!running_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    std::cout.flush();
+    log_file_.flush();
+    return;
+  }
+
+  // Records claimed up to here must be written; later ones need not be
+  const size_t target = enqueue_pos_.load(std::memory_order_acquire);
+
+  std::unique_lock<std::mutex> lock(wake_mutex_);
+  while (flushed_pos_ < target && !stopping_) {
+    flush_requested_ = true;
+    wake_cv_.notify_one();
+    flushed_cv_.wait_for(lock, IDLE_WAIT);
+  }
+}
+
 void Logger::close() {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
-  if (log_file_.is_open()) {
+  if (!running_.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  if (initialized_) {
     log_impl(LogLevel::Info, "Logger shutting down");
-    log_file_.close();
   }
+
+  // New records go straight to the console from here on
+  running_ = false;
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stopping_ = true;
+  }
+  wake_cv_.notify_one();
+
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+
+  std::lock_guard<std::mutex> lock(output_mutex_);
+  std::cout.flush();
+  log_file_.close();
 }
 
-Logger::~Logger() { close(); }
+void Logger::log_impl(LogLevel level, std::string_view message,
+                      LogFields fields) {
+  if (!running_.load(std::memory_order_acquire)) {
+    writeSynchronously(level, message, fields);
+    return;
+  }
 
-void Logger::log_impl(LogLevel level, std::string_view message) {
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  while (!tryEnqueue(level, message, fields)) {
+    if (overflow_.load(std::memory_order_relaxed) ==
+        LogOverflowPolicy::DropNewest) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    // Ring is full: make sure the writer is draining, then retry
+    if (!running_.load(std::memory_order_acquire)) {
+      writeSynchronously(level, message, fields);
+      return;
+    }
+    wakeWriter();
+    std::this_thread::yield();
+  }
+
+  // Pairs with the fence in run(): either the writer sees this record
+  // before sleeping, or this thread sees it asleep and wakes it
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (writer_sleeping_.load(std::memory_order_relaxed)) {
+    wakeWriter();
+  }
+}
+
+bool Logger::tryEnqueue(LogLevel level, std::string_view message,
+                        LogFields fields) {
+  const auto now = std::chrono::system_clock::now();
 
-  std::string log_entry = fmt::format("[{}] [{}] {}\n", getCurrentTimestamp(),
-                                      levelToString(level), message);
+  size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  Slot *slot = nullptr;
+  while (true) {
+    slot = &ring_[pos & (RING_CAPACITY - 1)];
+    const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    const auto diff =
+        static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
 
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return false; // Full: the writer has not released this slot yet
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->level = level;
+  slot->time = now;
+  slot->message.assign(message.data(), message.size());
+  slot->fields_text.clear();
+  slot->fields_json.clear();
+  for (const auto &field : fields) {
+    encodeField(field, slot->fields_text, slot->fields_json);
+  }
+  slot->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+void Logger::wakeWriter() {
+  // Taking the mutex orders this with the writer's predicate check
+  { std::lock_guard<std::mutex> lock(wake_mutex_); }
+  wake_cv_.notify_one();
+}
+
+void Logger::run() {
+  auto last_flush = std::chrono::steady_clock::now();
+  bool unflushed = false;
+
+  const auto has_pending = [this] {
+    const Slot &slot = ring_[dequeue_pos_ & (RING_CAPACITY - 1)];
+    return slot.sequence.load(std::memory_order_acquire) == dequeue_pos_ + 1;
+  };
+
+  while (true) {
+    bool has_error = false;
+    size_t taken = 0;
+    {
+      std::lock_guard<std::mutex> lock(output_mutex_);
+      taken = drain(has_error);
+
+      if (const auto dropped = dropped_.exchange(0, std::memory_order_relaxed);
+          dropped > 0) {
+        Slot notice;
+        notice.level = LogLevel::Warning;
+        notice.time = std::chrono::system_clock::now();
+        notice.message =
+            fmt::format("Log queue full, dropped {} messages", dropped);
+        appendRecord(notice);
+      }
+
+      if (!text_buffer_.empty() || !json_buffer_.empty()) {
+        write(false);
+        unflushed = true;
+      }
+    }
+
+    bool flush_requested;
+    bool stopping;
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      flush_requested = flush_requested_;
+      stopping = stopping_;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto interval = std::chrono::milliseconds(
+        flush_interval_ms_.load(std::memory_order_relaxed));
+
+    if (unflushed && (has_error || flush_requested || stopping ||
+                      now - last_flush >= interval)) {
+      std::lock_guard<std::mutex> lock(output_mutex_);
+      write(true);
+      unflushed = false;
+      last_flush = now;
+    }
+
+    if (!unflushed) {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      flushed_pos_ = dequeue_pos_;
+      flush_requested_ = false;
+      flushed_cv_.notify_all();
+    }
+
+    // A full batch means more records are probably waiting
+    if (taken == MAX_BATCH) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    if (stopping_ && !has_pending()) {
+      break;
+    }
+
+    writer_sleeping_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Sleep until woken, or until buffered output is due for a flush
+    auto timeout = IDLE_WAIT;
+    if (unflushed) {
+      timeout = std::max(std::chrono::milliseconds(0),
+                         std::chrono::duration_cast<std::chrono::milliseconds>(
+                             interval - (now - last_flush)));
+    }
+    wake_cv_.wait_for(lock, timeout, [&] {
+      return stopping_ || flush_requested_ || has_pending();
+    });
+
+    writer_sleeping_.store(false, std::memory_order_relaxed);
+  }
+
+  std::lock_guard<std::mutex> lock(wake_mutex_);
+  flushed_pos_ = dequeue_pos_;
+  flushed_cv_.notify_all();
+}
+
+size_t Logger::drain(bool &has_error) {
+  size_t taken = 0;
+
+  while (taken < MAX_BATCH) {
+    Slot &slot = ring_[dequeue_pos_ & (RING_CAPACITY - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
+      break;
+    }
+
+    if (slot.level == LogLevel::Error) {
+      has_error = true;
+    }
+    appendRecord(slot);
+
+    // Hand the slot back to producers one lap later
+    slot.sequence.store(dequeue_pos_ + RING_CAPACITY, std::memory_order_release);
+    ++dequeue_pos_;
+    ++taken;
+  }
+
+  return taken;
+}
+
+void Logger::write(bool flush_now) {
   // Write to console
-  std::cout << log_entry;
+  if (options_.console && !text_buffer_.empty()) {
+    std::cout.write(text_buffer_.data(),
+                    static_cast<std::streamsize>(text_buffer_.size()));
+  }
+
+  // Write to file (rotating it if it has grown too large)
+  log_file_.write(options_.file_format == LogFormat::Json ? json_buffer_
+                                                          : text_buffer_);
 
-  // Write to file
-  if (log_file_.is_open()) {
-    log_file_ << log_entry;
+  text_buffer_.clear();
+  json_buffer_.clear();
+
+  if (flush_now) {
+    std::cout.flush();
     log_file_.flush();
   }
 }
 
-std::string Logger::levelToString(LogLevel level) const {
+void Logger::writeSynchronously(LogLevel level, std::string_view message,
+                                LogFields fields) {
+  Slot record;
+  record.level = level;
+  record.time = std::chrono::system_clock::now();
+  record.message = std::string(message);
+  for (const auto &field : fields) {
+    encodeField(field, record.fields_text, record.fields_json);
+  }
+
+  std::lock_guard<std::mutex> lock(output_mutex_);
+  appendRecord(record);
+  write(true);
+}
+
+void Logger::appendRecord(const Slot &slot) {
+  if (options_.console || options_.file_format == LogFormat::Text) {
+    appendText(slot);
+  }
+  if (options_.file_format == LogFormat::Json && log_file_.isOpen()) {
+    appendJson(slot);
+  }
+}
+
+void Logger::appendText(const Slot &slot) {
+  const auto since_epoch = slot.time.time_since_epoch();
+  const auto seconds =
+      std::chrono::duration_cast<std::chrono::seconds>(since_epoch).count();
+  const auto ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch)
+          .count() %
+      1000;
+
+  // localtime_r and strftime are the expensive part; do them once a second
+  if (seconds != cached_second_) {
+    const auto time_t = static_cast<std::time_t>(seconds);
+    std::tm tm{};
+    localtime_r(&time_t, &tm);
+    std::strftime(cached_timestamp_, sizeof(cached_timestamp_),
+                  "%Y-%m-%d %H:%M:%S", &tm);
+    cached_second_ = seconds;
+  }
+
+  fmt::format_to(std::back_inserter(text_buffer_), "[{}.{:03d}] [{}] {}{}\n",
+                 cached_timestamp_, static_cast<int>(ms),
+                 levelToString(slot.level), slot.message, slot.fields_text);
+}
+
+void Logger::appendJson(const Slot &slot) {
+  const auto since_epoch = slot.time.time_since_epoch();
+  const auto seconds =
+      std::chrono::duration_cast<std::chrono::seconds>(since_epoch).count();
+  const auto ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch)
+          .count() %
+      1000;
+
+  if (seconds != cached_utc_second_) {
+    const auto time_t = static_cast<std::time_t>(seconds);
+    std::tm tm{};
+    gmtime_r(&time_t, &tm);
+    std::strftime(cached_utc_timestamp_, sizeof(cached_utc_timestamp_),
+                  "%Y-%m-%dT%H:%M:%S", &tm);
+    cached_utc_second_ = seconds;
+  }
+
+  fmt::format_to(std::back_inserter(json_buffer_),
+                 "{{\"ts\":\"{}.{:03d}Z\",\"level\":\"{}\",\"msg\":",
+                 cached_utc_timestamp_, static_cast<int>(ms),
+                 levelToJson(slot.level));
+  appendJsonString(json_buffer_, slot.message);
+  json_buffer_ += slot.fields_json;
+  json_buffer_ += "}\n";
+}
+
+const char *Logger::levelToString(LogLevel level) const {
   switch (level) {
   case LogLevel::Debug:
     return "DEBUG";
@@ -97,18 +518,4 @@ std::string Logger::levelToString(LogLevel level) const {
   }
 }
 
-std::string Logger::getCurrentTimestamp() const {
-  const auto now = std::chrono::system_clock::now();
-  const auto time_t = std::chrono::system_clock::to_time_t(now);
-  const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                      now.time_since_epoch()) %
-                  1000;
-
-  std::ostringstream oss;
-  oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S") << '.'
-      << std::setfill('0') << std::setw(3) << ms.count();
-
-  return oss.str();
-}
-
 } // namespace bluray::infrastructure
@@ -1,21 +1,138 @@
 #pragma once
 
+#include "rotating_log_file.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <fmt/format.h>
-#include <fstream>
+#include <initializer_list>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <type_traits>
+
+/**
+ * Lowest level compiled into the binary (0 = Debug ... 3 = Error)
+ * Set through the BLURAY_LOG_MIN_LEVEL CMake option; log macros below it
+ * expand to nothing, so neither their arguments nor their format strings
+ * cost anything at run time.
+ */
+#ifndef BLURAY_LOG_MIN_LEVEL
+#define BLURAY_LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * Log with lazy formatting
+ * The level is checked before the arguments are evaluated or formatted, so
+ * disabled calls only cost an atomic load:
+ *   LOG_DEBUG("Scraping: {}", item.url);
+ *
+ * Structured fields go first, as a braced list of key/value pairs:
+ *   LOG_INFO({{"source", item.source}, {"duration_ms", ms}}, "Scraped {}", id);
+ */
+#define BLURAY_LOG(level, ...)                                                 \
+  do {                                                                         \
+    if constexpr (static_cast<int>(level) >= BLURAY_LOG_MIN_LEVEL) {           \
+      auto &bluray_logger = ::bluray::infrastructure::Logger::instance();      \
+      if (bluray_logger.isEnabled(level)) {                                    \
+        bluray_logger.log(level, __VA_ARGS__);                                 \
+      }                                                                        \
+    }                                                                          \
+  } while (false)
+
+#define LOG_DEBUG(...)                                                         \
+  BLURAY_LOG(::bluray::infrastructure::LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...)                                                          \
+  BLURAY_LOG(::bluray::infrastructure::LogLevel::Info, __VA_ARGS__)
+#define LOG_WARNING(...)                                                       \
+  BLURAY_LOG(::bluray::infrastructure::LogLevel::Warning, __VA_ARGS__)
+#define LOG_ERROR(...)                                                         \
+  BLURAY_LOG(::bluray::infrastructure::LogLevel::Error, __VA_ARGS__)
 
 namespace bluray::infrastructure {
 
 /**
  * Log levels
  */
-enum class LogLevel { Debug, Info, Warning, Error };
+enum class LogLevel { Debug = 0, Info = 1, Warning = 2, Error = 3 };
+
+/**
+ * What producers do when the log queue is full
+ */
+enum class LogOverflowPolicy {
+  Block,     // Wait for the writer thread (no records are lost)
+  DropNewest // Discard the record; the writer reports how many were dropped
+};
+
+/**
+ * Log file record format
+ */
+enum class LogFormat {
+  Text, // [timestamp] [LEVEL] message key=value ...
+  Json  // One JSON object per line: ts, level, msg and the record's fields
+};
+
+/**
+ * Logger tuning, set at initialization
+ */
+struct LoggerOptions {
+  // How long written records may sit in the stream buffers before they are
+  // flushed (0 = flush after every batch). Errors are always flushed at once.
+  std::chrono::milliseconds flush_interval{200};
+  LogOverflowPolicy overflow{LogOverflowPolicy::Block};
+  LogFormat file_format{LogFormat::Json};
+  bool console{true}; // Also write records (as text) to stdout
+  LogRotationOptions rotation;
+};
+
+/**
+ * Structured key/value attached to a log record
+ * Keys and string values are referenced, not copied; they only need to
+ * outlive the log call.
+ */
+struct LogField {
+  enum class Type { String, Integer, Float, Bool };
+
+  LogField(std::string_view key, std::string_view value)
+      : key(key), type(Type::String), text(value) {}
+  LogField(std::string_view key, const std::string &value)
+      : LogField(key, std::string_view(value)) {}
+  LogField(std::string_view key, const char *value)
+      : LogField(key, std::string_view(value)) {}
+  LogField(std::string_view key, bool value)
+      : key(key), type(Type::Bool), integer(value ? 1 : 0) {}
+
+  template <typename T, std::enable_if_t<std::is_integral_v<T> &&
+                                             !std::is_same_v<T, bool>,
+                                         int> = 0>
+  LogField(std::string_view key, T value)
+      : key(key), type(Type::Integer), integer(static_cast<int64_t>(value)) {}
+
+  template <typename T,
+            std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+  LogField(std::string_view key, T value)
+      : key(key), type(Type::Float), number(static_cast<double>(value)) {}
+
+  std::string_view key;
+  Type type;
+  std::string_view text;
+  int64_t integer{0};
+  double number{0.0};
+};
+
+using LogFields = std::initializer_list<LogField>;
 
 /**
- * Thread-safe logger with file and console output
- * Uses modern C++20 features: std::format, std::source_location
+ * Asynchronous logger with file and console output
+ *
+ * Callers only copy the message into a lock-free bounded MPSC ring buffer;
+ * a background thread drains it in batches, formats timestamps and writes
+ * to the console and the log file. Logging threads therefore never wait on
+ * disk or terminal I/O (including log rotation), and never contend on a
+ * mutex.
  */
 class Logger {
 public:
@@ -27,7 +144,7 @@ public:
   /**
    * Initialize logger with log file path
    */
-  void initialize(std::string_view log_file_path);
+  void initialize(std::string_view log_file_path, LoggerOptions options = {});
 
   /**
    * Set minimum log level
@@ -35,10 +152,15 @@ public:
   void setLevel(LogLevel level);
 
   /**
-   * Log methods
+   * Whether a message at this level would be written
    */
+  [[nodiscard]] bool isEnabled(LogLevel level) const {
+    return static_cast<int>(level) >= BLURAY_LOG_MIN_LEVEL &&
+           level >= min_level_.load(std::memory_order_relaxed);
+  }
+
   /**
-   * Log methods
+   * Log methods for preformatted messages (prefer the LOG_* macros)
    */
   void debug(std::string_view message);
 
@@ -53,7 +175,7 @@ public:
    */
   template <typename... Args>
   void log(LogLevel level, fmt::format_string<Args...> fmt, Args &&...args) {
-    if (level < min_level_) {
+    if (!isEnabled(level)) {
       return;
     }
 
@@ -62,27 +184,113 @@ public:
   }
 
   /**
-   * Close log file
+   * Templated log method with structured fields
+   */
+  template <typename... Args>
+  void log(LogLevel level, LogFields fields, fmt::format_string<Args...> fmt,
+           Args &&...args) {
+    if (!isEnabled(level)) {
+      return;
+    }
+
+    const auto message = fmt::format(fmt, std::forward<Args>(args)...);
+    log_impl(level, message, fields);
+  }
+
+  /**
+   * Block until everything logged before this call has been written and
+   * flushed
+   */
+  void flush();
+
+  /**
+   * Drain pending records, stop the writer thread and close the log file
+   * Later log calls are written synchronously to the console.
    */
   void close();
 
 private:
-  Logger() = default;
+  Logger();
   ~Logger();
 
   // Prevent copying
   Logger(const Logger &) = delete;
   Logger &operator=(const Logger &) = delete;
 
-  void log_impl(LogLevel level, std::string_view message);
+  /**
+   * One queued record; sequence implements the lock-free hand-over
+   * (bounded MPMC queue design by Dmitry Vyukov, used single-consumer)
+   */
+  struct Slot {
+    std::atomic<size_t> sequence{0};
+    LogLevel level{LogLevel::Info};
+    std::chrono::system_clock::time_point time;
+    std::string message; // Capacity is reused, so steady state is alloc-free
+    std::string fields_text; // " key=value ..." (empty without fields)
+    std::string fields_json; // ,"key":value ...
+  };
+
+  void log_impl(LogLevel level, std::string_view message,
+                LogFields fields = {});
+  bool tryEnqueue(LogLevel level, std::string_view message, LogFields fields);
+  void wakeWriter();
+
+  void run();
+
+  /**
+   * Move ready records into the text and JSON write buffers
+   * @return Number of records taken
+   */
+  size_t drain(bool &has_error);
+  void write(bool flush_now);
+  void writeSynchronously(LogLevel level, std::string_view message,
+                          LogFields fields);
 
-  [[nodiscard]] std::string levelToString(LogLevel level) const;
-  [[nodiscard]] std::string getCurrentTimestamp() const;
+  void appendRecord(const Slot &slot);
+  void appendText(const Slot &slot);
+  void appendJson(const Slot &slot);
+  [[nodiscard]] const char *levelToString(LogLevel level) const;
 
-  std::ofstream log_file_;
-  std::recursive_mutex mutex_;
-  LogLevel min_level_{LogLevel::Info};
+  static constexpr size_t RING_CAPACITY = 8192; // Power of two
+  static constexpr size_t MAX_BATCH = 512;
+  static constexpr std::chrono::milliseconds IDLE_WAIT{100};
+
+  std::unique_ptr<Slot[]> ring_;
+  alignas(64) std::atomic<size_t> enqueue_pos_{0};
+  alignas(64) size_t dequeue_pos_{0}; // Writer thread only
+
+  std::atomic<LogLevel> min_level_{LogLevel::Info};
+  std::atomic<LogOverflowPolicy> overflow_{LogOverflowPolicy::Block};
+  std::atomic<int64_t> flush_interval_ms_{200};
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<bool> writer_sleeping_{false};
+  std::atomic<bool> running_{false};
+
+  // Writer wake-up and flush hand-shake
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+  std::condition_variable flushed_cv_;
+  size_t flushed_pos_{0};      // Guarded by wake_mutex_
+  bool flush_requested_{false}; // Guarded by wake_mutex_
+  bool stopping_{false};        // Guarded by wake_mutex_
+
+  // Output streams and options; the file may be opened while the writer
+  // runs
+  std::mutex output_mutex_;
+  RotatingLogFile log_file_;
+  LoggerOptions options_;
   bool initialized_{false};
+
+  // Writer-thread state: batch buffers and the cached timestamps of the
+  // last formatted second ("YYYY-MM-DD HH:MM:SS" local, ISO 8601 UTC)
+  std::string text_buffer_;
+  std::string json_buffer_;
+  int64_t cached_second_{-1};
+  char cached_timestamp_[32]{};
+  int64_t cached_utc_second_{-1};
+  char cached_utc_timestamp_[32]{};
+
+  std::thread writer_;
 };
 
 } // namespace bluray::infrastructure
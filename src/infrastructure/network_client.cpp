@@ -1,9 +1,28 @@
 #include "network_client.hpp"
 #include "logger.hpp"
+#include <algorithm>
+#include <cctype>
 #include <fmt/format.h>
 
 namespace bluray::infrastructure {
 
+namespace {
+std::string toLowerAscii(std::string_view str) {
+  std::string result(str);
+  std::transform(result.begin(), result.end(), result.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return result;
+}
+} // anonymous namespace
+
+std::optional<std::string> HttpResponse::header(std::string_view name) const {
+  const auto it = headers.find(toLowerAscii(name));
+  if (it == headers.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
 NetworkClient::NetworkClient() {
   curl_ = curl_easy_init();
   if (!curl_) {
@@ -47,6 +66,8 @@ HttpResponse NetworkClient::get(std::string_view url,
   curl_easy_setopt(curl_, CURLOPT_HTTPGET, 1L);
   curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, writeCallback);
   curl_easy_setopt(curl_, CURLOPT_WRITEDATA, &response_body);
+  curl_easy_setopt(curl_, CURLOPT_HEADERFUNCTION, headerCallback);
+  curl_easy_setopt(curl_, CURLOPT_HEADERDATA, &response.headers);
 
   // Set headers
   struct curl_slist *header_list = nullptr;
@@ -60,14 +81,18 @@ HttpResponse NetworkClient::get(std::string_view url,
   // Perform request
   const CURLcode res = curl_easy_perform(curl_);
 
+  // Detach header capture so later requests on this handle don't write into
+  // this (soon out of scope) response
+  curl_easy_setopt(curl_, CURLOPT_HEADERFUNCTION, nullptr);
+  curl_easy_setopt(curl_, CURLOPT_HEADERDATA, nullptr);
+
   // Cleanup headers
   if (header_list) {
     curl_slist_free_all(header_list);
   }
 
   if (res != CURLE_OK) {
-    Logger::instance().error(fmt::format("GET request failed for {}: {}", url,
-                                         curl_easy_strerror(res)));
+    LOG_ERROR("GET request failed for {}: {}", url, curl_easy_strerror(res));
     return response;
   }
 
@@ -96,6 +121,8 @@ HttpResponse NetworkClient::post(std::string_view url,
   curl_easy_setopt(curl_, CURLOPT_POSTFIELDS, std::string(json_body).c_str());
   curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, writeCallback);
   curl_easy_setopt(curl_, CURLOPT_WRITEDATA, &response_body);
+  curl_easy_setopt(curl_, CURLOPT_HEADERFUNCTION, headerCallback);
+  curl_easy_setopt(curl_, CURLOPT_HEADERDATA, &response.headers);
 
   // Set headers
   struct curl_slist *header_list = nullptr;
@@ -121,14 +148,18 @@ HttpResponse NetworkClient::post(std::string_view url,
   // Perform request
   const CURLcode res = curl_easy_perform(curl_);
 
+  // Detach header capture so later requests on this handle don't write into
+  // this (soon out of scope) response
+  curl_easy_setopt(curl_, CURLOPT_HEADERFUNCTION, nullptr);
+  curl_easy_setopt(curl_, CURLOPT_HEADERDATA, nullptr);
+
   // Cleanup headers
   if (header_list) {
     curl_slist_free_all(header_list);
   }
 
   if (res != CURLE_OK) {
-    Logger::instance().error(fmt::format("POST request failed for {}: {}", url,
-                                         curl_easy_strerror(res)));
+    LOG_ERROR("POST request failed for {}: {}", url, curl_easy_strerror(res));
     return response;
   }
 
@@ -158,8 +189,7 @@ NetworkClient::downloadFile(std::string_view url) {
   const CURLcode res = curl_easy_perform(curl_);
 
   if (res != CURLE_OK) {
-    Logger::instance().error(fmt::format("File download failed for {}: {}", url,
-                                         curl_easy_strerror(res)));
+    LOG_ERROR("File download failed for {}: {}", url, curl_easy_strerror(res));
     return std::nullopt;
   }
 
@@ -167,8 +197,7 @@ NetworkClient::downloadFile(std::string_view url) {
   curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &status_code);
 
   if (status_code < 200 || status_code >= 300) {
-    Logger::instance().error(fmt::format(
-        "File download failed with status {}: {}", status_code, url));
+    LOG_ERROR("File download failed with status {}: {}", status_code, url);
     return std::nullopt;
   }
 
@@ -204,6 +233,36 @@ size_t NetworkClient::writeCallback(void *contents, size_t size, size_t nmemb,
   return total_size;
 }
 
+size_t NetworkClient::headerCallback(char *buffer, size_t size, size_t nitems,
+                                     void *userp) {
+  const size_t total_size = size * nitems;
+  auto *headers =
+      static_cast<std::unordered_map<std::string, std::string> *>(userp);
+  const std::string_view line(buffer, total_size);
+
+  // A new status line starts a new response (e.g. after a redirect), so only
+  // the headers of the final response are kept
+  if (line.rfind("HTTP/", 0) == 0) {
+    headers->clear();
+    return total_size;
+  }
+
+  const auto colon = line.find(':');
+  if (colon == std::string_view::npos) {
+    return total_size;
+  }
+
+  auto value = line.substr(colon + 1);
+  const auto first = value.find_first_not_of(" \t");
+  const auto last = value.find_last_not_of(" \t\r\n");
+  value = (first == std::string_view::npos)
+              ? std::string_view{}
+              : value.substr(first, last - first + 1);
+
+  (*headers)[toLowerAscii(line.substr(0, colon))] = std::string(value);
+  return total_size;
+}
+
 void NetworkClient::setupCommonOptions() {
   curl_easy_setopt(curl_, CURLOPT_USERAGENT, user_agent_.c_str());
   curl_easy_setopt(curl_, CURLOPT_TIMEOUT, timeout_);
@@ -5,6 +5,7 @@
 #include <vector>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <curl/curl.h>
 
 namespace bluray::infrastructure {
@@ -17,6 +18,14 @@ struct HttpResponse {
     std::string body;
     std::string content_type;
     bool success{false};
+
+    // Response headers of the final response, keyed by lowercase name
+    std::unordered_map<std::string, std::string> headers;
+
+    /**
+     * Get header value by (case-insensitive) name
+     */
+    [[nodiscard]] std::optional<std::string> header(std::string_view name) const;
 };
 
 /**
@@ -82,6 +91,13 @@ private:
         void* userp
     );
 
+    static size_t headerCallback(
+        char* buffer,
+        size_t size,
+        size_t nitems,
+        void* userp
+    );
+
     void setupCommonOptions();
 
     CURL* curl_{nullptr};
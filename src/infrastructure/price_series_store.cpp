@@ -0,0 +1,611 @@
+#include "price_series_store.hpp"
+#include "config_manager.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <stdexcept>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bluray::infrastructure {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr std::array<uint8_t, 4> kSegmentMagic{'B', 'R', 'P', 'S'};
+constexpr uint32_t kSegmentVersion = 1;
+constexpr size_t kSegmentHeaderSize = 32;
+constexpr size_t kLogRecordSize = 16;
+
+// First record of a log reset by compaction; read as a record time it
+// would be billions of years away
+constexpr std::array<uint8_t, 8> kLogMagic{'B', 'R', 'P', 'L',
+                                           'O', 'G', 0, 1};
+
+/**
+ * Compaction state a segment records in its header
+ */
+struct SegmentHeader {
+  uint32_t generation{0};       // Compactions of the series so far
+  uint32_t merged_log_bytes{0}; // Log bytes the last compaction merged
+};
+
+// Little-endian fixed-width integers (files are portable across hosts)
+
+void putFixed(std::vector<uint8_t> &out, uint64_t value, size_t bytes) {
+  for (size_t i = 0; i < bytes; ++i) {
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+uint64_t getFixed(const uint8_t *data, size_t bytes) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < bytes; ++i) {
+    value |= static_cast<uint64_t>(data[i]) << (8 * i);
+  }
+  return value;
+}
+
+// Varints with zigzag encoding, so small negative deltas stay small
+
+uint64_t zigzag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void putVarint(std::vector<uint8_t> &out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+bool getVarint(const uint8_t *&data, const uint8_t *end, uint64_t &value) {
+  value = 0;
+  for (int shift = 0; data < end && shift < 64; shift += 7) {
+    const uint8_t byte = *data++;
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false; // Truncated
+}
+
+/**
+ * Owned file descriptor
+ */
+class FileDescriptor {
+public:
+  explicit FileDescriptor(int fd = -1) : fd_(fd) {}
+  ~FileDescriptor() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+  FileDescriptor(const FileDescriptor &) = delete;
+  FileDescriptor &operator=(const FileDescriptor &) = delete;
+
+  [[nodiscard]] int get() const { return fd_; }
+  [[nodiscard]] bool valid() const { return fd_ >= 0; }
+
+private:
+  int fd_;
+};
+
+/**
+ * Series log flock'ed for the lifetime of the object
+ * Compaction replaces the log by rename, so a lock taken on a descriptor
+ * opened before the rename is dropped and retaken on the current file.
+ */
+class LockedLog {
+public:
+  LockedLog(const fs::path &path, int flags, int operation) {
+    for (;;) {
+      fd_ = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+      if (fd_ < 0) {
+        return;
+      }
+      while (::flock(fd_, operation) != 0) {
+        if (errno != EINTR) {
+          const int error = errno;
+          ::close(fd_);
+          throw std::runtime_error(
+              fmt::format("flock failed: {}", std::strerror(error)));
+        }
+      }
+      struct stat held {};
+      struct stat current {};
+      if (::fstat(fd_, &held) == 0 && ::stat(path.c_str(), &current) == 0 &&
+          held.st_dev == current.st_dev && held.st_ino == current.st_ino) {
+        return;
+      }
+      ::close(fd_); // Also releases the lock
+    }
+  }
+  ~LockedLog() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+  LockedLog(const LockedLog &) = delete;
+  LockedLog &operator=(const LockedLog &) = delete;
+
+  [[nodiscard]] int get() const { return fd_; }
+  [[nodiscard]] bool valid() const { return fd_ >= 0; }
+
+private:
+  int fd_ = -1;
+};
+
+/**
+ * Read-only memory mapping of a whole file (empty if missing)
+ */
+class MappedFile {
+public:
+  explicit MappedFile(const fs::path &path) {
+    FileDescriptor fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (!fd.valid()) {
+      return;
+    }
+    struct stat st {};
+    if (::fstat(fd.get(), &st) != 0 || st.st_size <= 0) {
+      return;
+    }
+    void *data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ,
+                        MAP_PRIVATE, fd.get(), 0);
+    if (data == MAP_FAILED) {
+      return;
+    }
+    data_ = static_cast<const uint8_t *>(data);
+    size_ = static_cast<size_t>(st.st_size);
+  }
+  ~MappedFile() {
+    if (data_) {
+      ::munmap(const_cast<uint8_t *>(data_), size_);
+    }
+  }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  [[nodiscard]] const uint8_t *data() const { return data_; }
+  [[nodiscard]] size_t size() const { return size_; }
+
+private:
+  const uint8_t *data_{nullptr};
+  size_t size_{0};
+};
+
+std::vector<uint8_t> encodeSegment(const std::vector<PricePoint> &points,
+                                   const SegmentHeader &header) {
+  std::vector<uint8_t> out;
+  out.reserve(kSegmentHeaderSize + points.size() * 4);
+
+  out.insert(out.end(), kSegmentMagic.begin(), kSegmentMagic.end());
+  putFixed(out, kSegmentVersion, 4);
+  putFixed(out, points.size(), 8);
+  putFixed(out, static_cast<uint64_t>(points.empty() ? 0 : points.back().time),
+           8);
+  putFixed(out, header.generation, 4);
+  putFixed(out, header.merged_log_bytes, 4);
+
+  // Stock flag rides in the low bit of the time delta
+  int64_t previous_time = 0;
+  int64_t previous_cents = 0;
+  for (const auto &point : points) {
+    putVarint(out, zigzag(point.time - previous_time) << 1 |
+                       (point.in_stock ? 1 : 0));
+    putVarint(out, zigzag(point.price.cents() - previous_cents));
+    previous_time = point.time;
+    previous_cents = point.price.cents();
+  }
+  return out;
+}
+
+/**
+ * Header of a segment, nullopt if there is no valid segment
+ */
+std::optional<SegmentHeader> segmentHeader(const MappedFile &file) {
+  if (file.size() < kSegmentHeaderSize ||
+      !std::equal(kSegmentMagic.begin(), kSegmentMagic.end(), file.data()) ||
+      getFixed(file.data() + 4, 4) != kSegmentVersion) {
+    return std::nullopt;
+  }
+
+  // Segments from before compaction generations have zeros here
+  SegmentHeader header;
+  header.generation = static_cast<uint32_t>(getFixed(file.data() + 24, 4));
+  header.merged_log_bytes =
+      static_cast<uint32_t>(getFixed(file.data() + 28, 4));
+  return header;
+}
+
+/**
+ * Decode a segment, keeping points at or after `since`
+ * @return Its header, nullopt if there is no valid segment
+ */
+std::optional<SegmentHeader> decodeSegment(const MappedFile &file,
+                                           int64_t since,
+                                           std::vector<PricePoint> &points) {
+  const auto header = segmentHeader(file);
+  if (!header) {
+    return std::nullopt;
+  }
+
+  const uint64_t count = getFixed(file.data() + 8, 8);
+
+  const uint8_t *cursor = file.data() + kSegmentHeaderSize;
+  const uint8_t *end = file.data() + file.size();
+  int64_t time = 0;
+  int64_t cents = 0;
+  for (uint64_t i = 0; i < count; ++i) {
+    uint64_t time_field = 0;
+    uint64_t price_field = 0;
+    if (!getVarint(cursor, end, time_field) ||
+        !getVarint(cursor, end, price_field)) {
+      break; // Corrupt tail; keep what decoded
+    }
+    time += unzigzag(time_field >> 1);
+    cents += unzigzag(price_field);
+    if (time >= since) {
+      points.push_back({time, domain::Money::fromCents(cents),
+                        (time_field & 1) != 0});
+    }
+  }
+  return header;
+}
+
+/**
+ * Whether a log starts with the header written when compaction reset it
+ */
+bool hasLogHeader(const MappedFile &file) {
+  return file.size() >= kLogRecordSize &&
+         std::equal(kLogMagic.begin(), kLogMagic.end(), file.data());
+}
+
+/**
+ * Generation of a log; a log that was never reset is generation 0
+ */
+uint32_t logGeneration(const MappedFile &file) {
+  return hasLogHeader(file)
+             ? static_cast<uint32_t>(getFixed(file.data() + 8, 4))
+             : 0;
+}
+
+/**
+ * Generation of the next compaction of a series
+ */
+uint32_t nextGeneration(const std::optional<SegmentHeader> &segment,
+                        const MappedFile &log) {
+  return std::max(segment ? segment->generation : 0, logGeneration(log)) + 1;
+}
+
+/**
+ * Append log records at or after `since` to the decoded segment `points`
+ * A log of an older generation than its segment was merged into it by a
+ * compaction interrupted before the log reset; the merged part is skipped.
+ * A partially written trailing record is ignored.
+ */
+void decodeLog(const MappedFile &file,
+               const std::optional<SegmentHeader> &segment, int64_t since,
+               std::vector<PricePoint> &points) {
+  size_t offset = hasLogHeader(file) ? kLogRecordSize : 0;
+  if (segment && logGeneration(file) < segment->generation) {
+    offset = std::max<size_t>(offset, segment->merged_log_bytes);
+  }
+
+  for (; offset + kLogRecordSize <= file.size(); offset += kLogRecordSize) {
+    const uint8_t *record = file.data() + offset;
+    const auto time = static_cast<int64_t>(getFixed(record, 8));
+    if (time < since) {
+      continue;
+    }
+    const auto cents =
+        static_cast<int32_t>(static_cast<uint32_t>(getFixed(record + 8, 4)));
+    const bool in_stock = (getFixed(record + 12, 4) & 1) != 0;
+    points.push_back({time, domain::Money::fromCents(cents), in_stock});
+  }
+}
+
+void sortByTime(std::vector<PricePoint> &points) {
+  // Appends from several processes may interleave within a second
+  std::stable_sort(points.begin(), points.end(),
+                   [](const PricePoint &a, const PricePoint &b) {
+                     return a.time < b.time;
+                   });
+}
+
+void writeFileAtomically(const fs::path &path,
+                         const std::vector<uint8_t> &contents) {
+  const fs::path temp_path = path.string() + ".tmp";
+  FileDescriptor fd(::open(temp_path.c_str(),
+                           O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+  if (!fd.valid()) {
+    throw std::runtime_error(fmt::format("Cannot create {}: {}",
+                                         temp_path.string(),
+                                         std::strerror(errno)));
+  }
+
+  size_t written = 0;
+  while (written < contents.size()) {
+    const ssize_t n = ::write(fd.get(), contents.data() + written,
+                              contents.size() - written);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error(fmt::format("Cannot write {}: {}",
+                                           temp_path.string(),
+                                           std::strerror(errno)));
+    }
+    written += static_cast<size_t>(n);
+  }
+  ::fdatasync(fd.get());
+
+  fs::rename(temp_path, path);
+}
+
+/**
+ * Replace a merged log with one holding only its generation header
+ * The rename leaves either the old log or the new one, never an empty log
+ * that would read as older than the segment.
+ */
+void resetLog(const fs::path &path, uint32_t generation, int series_id) {
+  std::vector<uint8_t> header(kLogMagic.begin(), kLogMagic.end());
+  putFixed(header, generation, 4);
+  putFixed(header, 0, 4); // Reserved
+
+  try {
+    writeFileAtomically(path, header);
+  } catch (const std::exception &e) {
+    // The segment already records what it merged
+    LOG_WARNING("Failed to reset price series log {}: {}", series_id, e.what());
+  }
+}
+
+std::optional<int> seriesIdOf(const fs::path &path) {
+  try {
+    size_t consumed = 0;
+    const std::string stem = path.stem().string();
+    const int id = std::stoi(stem, &consumed);
+    if (consumed == stem.size()) {
+      return id;
+    }
+  } catch (const std::exception &) {
+  }
+  return std::nullopt;
+}
+
+} // anonymous namespace
+
+PriceSeriesStore::PriceSeriesStore(fs::path directory)
+    : directory_(std::move(directory)) {
+  fs::create_directories(directory_);
+  compactor_ = std::thread(&PriceSeriesStore::compactLoop, this);
+}
+
+PriceSeriesStore::~PriceSeriesStore() {
+  {
+    std::lock_guard<std::mutex> lock(compact_mutex_);
+    compact_stopping_ = true;
+  }
+  compact_cv_.notify_all();
+  if (compactor_.joinable()) {
+    compactor_.join();
+  }
+}
+
+PriceSeriesStore &PriceSeriesStore::instance() {
+  static PriceSeriesStore instance(ConfigManager::instance().get(
+      "price_series_directory", "./price_series"));
+  return instance;
+}
+
+fs::path PriceSeriesStore::logPath(int series_id) const {
+  return directory_ / fmt::format("{}.log", series_id);
+}
+
+fs::path PriceSeriesStore::segmentPath(int series_id) const {
+  return directory_ / fmt::format("{}.seg", series_id);
+}
+
+void PriceSeriesStore::append(int series_id, const PricePoint &point) {
+  std::vector<uint8_t> record;
+  record.reserve(kLogRecordSize);
+  putFixed(record, static_cast<uint64_t>(point.time), 8);
+  const int64_t cents = std::clamp<int64_t>(point.price.cents(), INT32_MIN,
+                                            INT32_MAX);
+  putFixed(record, static_cast<uint32_t>(static_cast<int32_t>(cents)), 4);
+  putFixed(record, point.in_stock ? 1 : 0, 4);
+
+  off_t size = 0;
+  {
+    const LockedLog fd(logPath(series_id), O_WRONLY | O_APPEND | O_CREAT,
+                       LOCK_SH);
+    if (!fd.valid()) {
+      throw std::runtime_error(fmt::format("Cannot open price series {}: {}",
+                                           series_id, std::strerror(errno)));
+    }
+    if (::write(fd.get(), record.data(), record.size()) !=
+        static_cast<ssize_t>(record.size())) {
+      throw std::runtime_error(fmt::format("Cannot append to price series {}: {}",
+                                           series_id, std::strerror(errno)));
+    }
+    size = ::lseek(fd.get(), 0, SEEK_END);
+  }
+
+  if (size >= static_cast<off_t>(COMPACT_THRESHOLD * kLogRecordSize)) {
+    std::lock_guard<std::mutex> lock(compact_mutex_);
+    if (compact_queued_.insert(series_id).second) {
+      compact_queue_.push_back(series_id);
+      compact_cv_.notify_one();
+    }
+  }
+}
+
+std::vector<PricePoint> PriceSeriesStore::read(int series_id,
+                                               int64_t since) const {
+  std::vector<PricePoint> points;
+
+  // Without a log there is nothing to compact, and the segment is replaced
+  // by rename, so it can be read unlocked
+  const LockedLog log_fd(logPath(series_id), O_RDONLY, LOCK_SH);
+
+  const MappedFile segment(segmentPath(series_id));
+  const auto header = decodeSegment(segment, since, points);
+
+  if (log_fd.valid()) {
+    const MappedFile log(logPath(series_id));
+    const size_t sealed = points.size();
+    decodeLog(log, header, since, points);
+    if (points.size() > sealed) {
+      sortByTime(points);
+    }
+  }
+  return points;
+}
+
+void PriceSeriesStore::write(int series_id, std::vector<PricePoint> points) {
+  const LockedLog log_fd(logPath(series_id), O_RDWR | O_CREAT, LOCK_EX);
+  if (!log_fd.valid()) {
+    throw std::runtime_error(fmt::format("Cannot open price series {}: {}",
+                                         series_id, std::strerror(errno)));
+  }
+
+  // The whole current log is superseded
+  SegmentHeader header;
+  {
+    const MappedFile segment(segmentPath(series_id));
+    const MappedFile log(logPath(series_id));
+    header.generation = nextGeneration(segmentHeader(segment), log);
+    header.merged_log_bytes = static_cast<uint32_t>(log.size());
+  }
+
+  sortByTime(points);
+  writeFileAtomically(segmentPath(series_id), encodeSegment(points, header));
+  resetLog(logPath(series_id), header.generation, series_id);
+}
+
+void PriceSeriesStore::compact(int series_id,
+                               std::optional<int64_t> drop_before) {
+  const LockedLog log_fd(logPath(series_id), O_RDWR, LOCK_EX);
+  if (!log_fd.valid() && !drop_before) {
+    return; // Nothing appended since the last compaction
+  }
+
+  const int64_t since = drop_before.value_or(std::numeric_limits<int64_t>::min());
+  std::vector<PricePoint> points;
+  size_t sealed = 0;
+  SegmentHeader header;
+  {
+    const MappedFile segment(segmentPath(series_id));
+    const auto current = decodeSegment(segment, since, points);
+    sealed = points.size();
+    // A missing log maps as empty
+    const MappedFile log(logPath(series_id));
+    if (log_fd.valid()) {
+      decodeLog(log, current, since, points);
+    }
+    header.generation = nextGeneration(current, log);
+    header.merged_log_bytes = static_cast<uint32_t>(log.size());
+  }
+  sortByTime(points);
+
+  // The segment records what it merged before the log is reset, so that
+  // readers skip the merged records if the reset never happens
+  if (points.empty()) {
+    std::error_code ec;
+    fs::remove(segmentPath(series_id), ec);
+  } else {
+    writeFileAtomically(segmentPath(series_id), encodeSegment(points, header));
+  }
+  if (log_fd.valid()) {
+    resetLog(logPath(series_id), header.generation, series_id);
+  }
+
+  LOG_DEBUG({{"series_id", series_id},
+             {"merged", points.size() - std::min(points.size(), sealed)},
+             {"points", points.size()}},
+            "Compacted price series");
+}
+
+size_t PriceSeriesStore::compactAll(std::optional<int64_t> drop_before) {
+  std::set<int> series;
+  std::error_code ec;
+  for (const auto &entry : fs::directory_iterator(directory_, ec)) {
+    const auto extension = entry.path().extension();
+    if (extension != ".log" && extension != ".seg") {
+      continue;
+    }
+    if (auto id = seriesIdOf(entry.path())) {
+      series.insert(*id);
+    }
+  }
+
+  for (int id : series) {
+    try {
+      compact(id, drop_before);
+    } catch (const std::exception &e) {
+      LOG_ERROR("Failed to compact price series {}: {}", id, e.what());
+    }
+  }
+  return series.size();
+}
+
+void PriceSeriesStore::remove(int series_id) {
+  const LockedLog log_fd(logPath(series_id), O_RDWR, LOCK_EX);
+
+  std::error_code ec;
+  fs::remove(segmentPath(series_id), ec);
+  fs::remove(logPath(series_id), ec);
+}
+
+bool PriceSeriesStore::empty() const {
+  std::error_code ec;
+  for (const auto &entry : fs::directory_iterator(directory_, ec)) {
+    const auto extension = entry.path().extension();
+    if (extension == ".log" || extension == ".seg") {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PriceSeriesStore::compactLoop() {
+  std::unique_lock<std::mutex> lock(compact_mutex_);
+  for (;;) {
+    compact_cv_.wait(lock, [this] {
+      return compact_stopping_ || !compact_queue_.empty();
+    });
+    // Queued logs are merged even when stopping: they are full
+    if (compact_queue_.empty()) {
+      return;
+    }
+
+    const int series_id = compact_queue_.front();
+    compact_queue_.pop_front();
+    compact_queued_.erase(series_id);
+
+    lock.unlock();
+    try {
+      compact(series_id);
+    } catch (const std::exception &e) {
+      LOG_ERROR("Failed to compact price series {}: {}", series_id, e.what());
+    }
+    lock.lock();
+  }
+}
+
+} // namespace bluray::infrastructure
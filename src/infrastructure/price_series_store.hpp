@@ -0,0 +1,126 @@
+#pragma once
+
+#include "../domain/money.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace bluray::infrastructure {
+
+/**
+ * One recorded price
+ */
+struct PricePoint {
+  int64_t time{0}; // Seconds since the epoch (UTC)
+  domain::Money price;
+  bool in_stock{false};
+};
+
+/**
+ * Append-only price time-series store (alternative price history backend)
+ *
+ * Each series (wishlist item) has two files in the store directory:
+ *  - "<id>.log": fixed 16-byte records. Writers append with a single
+ *    O_APPEND write, so cron scrapers and the web server can record prices
+ *    concurrently without reading anything first.
+ *  - "<id>.seg": sealed segment. Time and price are delta-encoded as
+ *    varints, so a point whose price did not change takes about 3 bytes.
+ *
+ * Reads memory-map both files. Once a log reaches COMPACT_THRESHOLD records
+ * it is merged into a new segment on a background thread: the segment is
+ * written to a temporary file and renamed, then the log is replaced the
+ * same way by an empty one. Readers and appenders share an flock on the log
+ * that compaction takes exclusively, retaking it if the log was replaced
+ * while they waited.
+ *
+ * Compactions are numbered. The segment header records its generation and
+ * how many log bytes it merged, and the replacement log starts with a
+ * header record carrying the same generation; a log that was never replaced
+ * is generation 0. A log of an older generation than its segment was left
+ * behind by a compaction interrupted before the replace: its merged bytes
+ * are skipped, records appended after them are read.
+ */
+class PriceSeriesStore {
+public:
+  explicit PriceSeriesStore(std::filesystem::path directory);
+  ~PriceSeriesStore(); // Finishes queued compactions
+
+  // Prevent copying
+  PriceSeriesStore(const PriceSeriesStore &) = delete;
+  PriceSeriesStore &operator=(const PriceSeriesStore &) = delete;
+
+  /**
+   * Store in the configured price_series_directory (Singleton)
+   */
+  static PriceSeriesStore &instance();
+
+  /**
+   * Record a price; queues a compaction when the log is full
+   */
+  void append(int series_id, const PricePoint &point);
+
+  /**
+   * Points recorded at or after `since`, oldest first
+   */
+  [[nodiscard]] std::vector<PricePoint>
+  read(int series_id,
+       int64_t since = std::numeric_limits<int64_t>::min()) const;
+
+  /**
+   * Replace a series with the given points (bulk import)
+   */
+  void write(int series_id, std::vector<PricePoint> points);
+
+  /**
+   * Merge the series' log into its segment
+   * @param drop_before Also drop points recorded before this time
+   */
+  void compact(int series_id, std::optional<int64_t> drop_before = std::nullopt);
+
+  /**
+   * Compact every series
+   * @return Number of series compacted
+   */
+  size_t compactAll(std::optional<int64_t> drop_before = std::nullopt);
+
+  /**
+   * Delete a series
+   */
+  void remove(int series_id);
+
+  /**
+   * Whether the store holds no series at all
+   */
+  [[nodiscard]] bool empty() const;
+
+  [[nodiscard]] const std::filesystem::path &directory() const {
+    return directory_;
+  }
+
+  static constexpr size_t COMPACT_THRESHOLD = 64; // Log records
+
+private:
+  [[nodiscard]] std::filesystem::path logPath(int series_id) const;
+  [[nodiscard]] std::filesystem::path segmentPath(int series_id) const;
+
+  void compactLoop();
+
+  std::filesystem::path directory_;
+
+  // Background compaction of full logs
+  std::thread compactor_;
+  std::mutex compact_mutex_;
+  std::condition_variable compact_cv_;
+  std::deque<int> compact_queue_;
+  std::set<int> compact_queued_;
+  bool compact_stopping_{false};
+};
+
+} // namespace bluray::infrastructure
@@ -0,0 +1,181 @@
+#include "rate_limiter.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace bluray::infrastructure {
+
+namespace {
+int effectiveBurst(int max_requests, int burst) {
+  return std::clamp(burst, 1, std::max(1, max_requests));
+}
+} // anonymous namespace
+
+// With interval T and tolerance tau, any window shorter than `period` holds at
+// most (period + tau) / T permits; T = period / (max - burst + 1) and
+// tau = (burst - 1) * T bound that by max_requests.
+RateLimiter::RateLimiter(int max_requests, clock::duration period, int burst)
+    : emission_interval_(
+          period.count() /
+          std::max(1, max_requests - effectiveBurst(max_requests, burst) + 1)),
+      burst_tolerance_(emission_interval_ *
+                       (effectiveBurst(max_requests, burst) - 1)),
+      tat_(toTicks(clock::now())) {
+  if (max_requests < 1 || period <= clock::duration::zero()) {
+    throw std::invalid_argument("RateLimiter requires a positive rate");
+  }
+}
+
+RateLimiter::~RateLimiter() {
+  {
+    std::lock_guard<std::mutex> lock(waiters_mutex_);
+    stopping_ = true;
+  }
+  waiters_cv_.notify_all();
+
+  if (timer_thread_.joinable()) {
+    timer_thread_.join();
+  }
+
+  // Release anyone still waiting rather than leaving broken promises
+  for (auto &[permit_time, promise] : waiters_) {
+    promise.set_value();
+  }
+}
+
+RateLimiter::clock::time_point RateLimiter::reserve() {
+  const int64_t now = toTicks(clock::now());
+  int64_t tat = tat_.load(std::memory_order_relaxed);
+  int64_t new_tat = 0;
+
+  // GCRA: a request at `now` conforms once now >= TAT - tolerance. The
+  // permit is granted at that point and TAT advances by one interval.
+  do {
+    new_tat = std::max(tat, now) + emission_interval_;
+  } while (!tat_.compare_exchange_weak(tat, new_tat, std::memory_order_acq_rel,
+                                       std::memory_order_relaxed));
+
+  const int64_t permit = std::max(now, tat - burst_tolerance_);
+
+  permits_granted_.fetch_add(1, std::memory_order_relaxed);
+  if (permit > now) {
+    permits_delayed_.fetch_add(1, std::memory_order_relaxed);
+    total_wait_ticks_.fetch_add(permit - now, std::memory_order_relaxed);
+  }
+
+  return fromTicks(permit);
+}
+
+void RateLimiter::acquire() {
+  const auto permit_time = reserve();
+  if (permit_time > clock::now()) {
+    std::this_thread::sleep_until(permit_time);
+  }
+}
+
+bool RateLimiter::tryAcquire() {
+  const int64_t now = toTicks(clock::now());
+  int64_t tat = tat_.load(std::memory_order_relaxed);
+
+  do {
+    if (now < tat - burst_tolerance_) {
+      return false;
+    }
+  } while (!tat_.compare_exchange_weak(
+      tat, std::max(tat, now) + emission_interval_, std::memory_order_acq_rel,
+      std::memory_order_relaxed));
+
+  permits_granted_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+std::future<void> RateLimiter::acquireAsync() {
+  const auto permit_time = reserve();
+
+  std::promise<void> promise;
+  auto future = promise.get_future();
+
+  if (permit_time <= clock::now()) {
+    promise.set_value();
+    return future;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(waiters_mutex_);
+    // upper_bound insertion keeps equal permit times in arrival order
+    waiters_.emplace(permit_time, std::move(promise));
+
+    // Start timer thread lazily; purely blocking users never pay for it
+    if (!timer_thread_.joinable()) {
+      timer_thread_ = std::thread(&RateLimiter::timerLoop, this);
+    }
+  }
+  waiters_cv_.notify_one();
+
+  return future;
+}
+
+void RateLimiter::pause(clock::duration delay) {
+  // Earliest permit = TAT - tolerance, so TAT must be >= now + delay + tol
+  const int64_t target =
+      toTicks(clock::now() + delay) + burst_tolerance_;
+  int64_t tat = tat_.load(std::memory_order_relaxed);
+
+  while (tat < target &&
+         !tat_.compare_exchange_weak(tat, target, std::memory_order_acq_rel,
+                                     std::memory_order_relaxed)) {
+  }
+}
+
+RateLimiter::Stats RateLimiter::getStats() const {
+  Stats stats;
+  stats.permits_granted = permits_granted_.load(std::memory_order_relaxed);
+  stats.permits_delayed = permits_delayed_.load(std::memory_order_relaxed);
+  stats.total_wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+      clock::duration(total_wait_ticks_.load(std::memory_order_relaxed)));
+
+  const int64_t now = toTicks(clock::now());
+  const int64_t next = tat_.load(std::memory_order_relaxed) - burst_tolerance_;
+  if (next > now) {
+    stats.next_permit_in =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            clock::duration(next - now));
+  }
+
+  std::lock_guard<std::mutex> lock(waiters_mutex_);
+  stats.async_waiters = waiters_.size();
+  return stats;
+}
+
+void RateLimiter::timerLoop() {
+  std::unique_lock<std::mutex> lock(waiters_mutex_);
+
+  while (!stopping_) {
+    if (waiters_.empty()) {
+      waiters_cv_.wait(lock);
+      continue;
+    }
+
+    const auto next = waiters_.begin()->first;
+    if (clock::now() < next) {
+      waiters_cv_.wait_until(lock, next);
+      continue;
+    }
+
+    // Fulfil every waiter whose permit time has arrived, in order
+    const auto now = clock::now();
+    while (!waiters_.empty() && waiters_.begin()->first <= now) {
+      waiters_.begin()->second.set_value();
+      waiters_.erase(waiters_.begin());
+    }
+  }
+}
+
+int64_t RateLimiter::toTicks(clock::time_point tp) {
+  return tp.time_since_epoch().count();
+}
+
+RateLimiter::clock::time_point RateLimiter::fromTicks(int64_t ticks) {
+  return clock::time_point(clock::duration(ticks));
+}
+
+} // namespace bluray::infrastructure
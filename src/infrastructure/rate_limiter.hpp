@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace bluray::infrastructure {
+
+/**
+ * Lock-free rate limiter based on the generic cell rate algorithm (GCRA)
+ *
+ * Instead of counting requests in a fixed window, the limiter keeps a single
+ * "theoretical arrival time" (TAT) that every reservation advances by one
+ * emission interval with a compare-and-swap. Each caller therefore receives
+ * an exact permit time, permits are handed out in reservation order, and
+ * there is no window reset at which all waiting callers burst together.
+ *
+ * The emission interval is derived so that no sliding window of `period`
+ * ever contains more than `max_requests` permits, while still allowing up to
+ * `burst` back-to-back requests when the limiter has been idle.
+ *
+ * Usage:
+ *   RateLimiter limiter(40, std::chrono::seconds(10), 4);
+ *   limiter.acquire();                  // blocks until the permit time
+ *   auto permit = limiter.acquireAsync();
+ *   permit.wait();                      // or poll / hand off the future
+ */
+class RateLimiter {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * Statistics snapshot
+     */
+    struct Stats {
+        uint64_t permits_granted{0};
+        uint64_t permits_delayed{0};
+        std::chrono::milliseconds total_wait{0};
+        std::chrono::milliseconds next_permit_in{0};  // 0 = available now
+        size_t async_waiters{0};
+    };
+
+    /**
+     * @param max_requests Maximum permits in any sliding window of `period`
+     * @param period Length of the sliding window
+     * @param burst Permits that may be taken back-to-back after idling
+     */
+    RateLimiter(int max_requests, clock::duration period, int burst = 1);
+
+    /**
+     * Destructor - releases pending async waiters and stops the timer thread
+     */
+    ~RateLimiter();
+
+    // Prevent copying
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    /**
+     * Reserve the next permit without waiting
+     * @return Time at which the caller may proceed (<= now if immediately)
+     */
+    clock::time_point reserve();
+
+    /**
+     * Reserve a permit and block the calling thread until its permit time
+     */
+    void acquire();
+
+    /**
+     * Take a permit only if one is available right now
+     * @return true if a permit was taken
+     */
+    bool tryAcquire();
+
+    /**
+     * Reserve a permit without blocking
+     * @return Future that becomes ready at the permit time
+     */
+    std::future<void> acquireAsync();
+
+    /**
+     * Push all future permits back, e.g. after the server answered 429
+     * @param delay Minimum time before the next permit is handed out
+     */
+    void pause(clock::duration delay);
+
+    /**
+     * Get statistics snapshot
+     */
+    [[nodiscard]] Stats getStats() const;
+
+private:
+    void timerLoop();
+
+    [[nodiscard]] static int64_t toTicks(clock::time_point tp);
+    [[nodiscard]] static clock::time_point fromTicks(int64_t ticks);
+
+    const int64_t emission_interval_;  // ticks between sustained permits
+    const int64_t burst_tolerance_;    // ticks a permit may be early
+
+    std::atomic<int64_t> tat_;  // theoretical arrival time in ticks
+    std::atomic<uint64_t> permits_granted_{0};
+    std::atomic<uint64_t> permits_delayed_{0};
+    std::atomic<int64_t> total_wait_ticks_{0};
+
+    // Async waiters ordered by permit time (FIFO for equal times)
+    mutable std::mutex waiters_mutex_;
+    std::condition_variable waiters_cv_;
+    std::multimap<clock::time_point, std::promise<void>> waiters_;
+    std::thread timer_thread_;
+    bool stopping_{false};
+};
+
+} // namespace bluray::infrastructure
@@ -0,0 +1,181 @@
+#include "release_calendar_index.hpp"
+#include "logger.hpp"
+#include "repositories/release_calendar_repository.hpp"
+#include <ctime>
+#include <fmt/format.h>
+
+namespace bluray::infrastructure {
+
+namespace {
+
+struct CivilDate {
+  int year;
+  int month;
+  int day;
+};
+
+// Proleptic Gregorian calendar <-> day count (H. Hinnant's algorithms)
+
+CivilDate civilFromDays(int64_t days) {
+  days += 719468;
+  const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const int64_t day_of_era = days - era * 146097;
+  const int64_t year_of_era =
+      (day_of_era - day_of_era / 1460 + day_of_era / 36524 -
+       day_of_era / 146096) /
+      365;
+  const int64_t day_of_year =
+      day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  const int64_t month_index = (5 * day_of_year + 2) / 153; // March = 0
+  const int day =
+      static_cast<int>(day_of_year - (153 * month_index + 2) / 5 + 1);
+  const int month = static_cast<int>(month_index < 10 ? month_index + 3
+                                                      : month_index - 9);
+  const int year = static_cast<int>(year_of_era + era * 400 + (month <= 2));
+  return {year, month, day};
+}
+
+} // anonymous namespace
+
+ReleaseCalendarIndex &ReleaseCalendarIndex::instance() {
+  static ReleaseCalendarIndex instance;
+  return instance;
+}
+
+ReleaseCalendarIndex::Day ReleaseCalendarIndex::dayFromCivil(int year,
+                                                             int month,
+                                                             int day) {
+  const int64_t y = year - (month <= 2);
+  const int64_t era = (y >= 0 ? y : y - 399) / 400;
+  const int64_t year_of_era = y - era * 400;
+  const int64_t day_of_year =
+      (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const int64_t day_of_era =
+      year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return static_cast<Day>(era * 146097 + day_of_era - 719468);
+}
+
+std::optional<ReleaseCalendarIndex::Day>
+ReleaseCalendarIndex::parseDay(std::string_view date) {
+  if (date.size() != 10 || date[4] != '-' || date[7] != '-') {
+    return std::nullopt;
+  }
+  auto number = [&](size_t offset, size_t length) -> std::optional<int> {
+    int value = 0;
+    for (size_t i = offset; i < offset + length; ++i) {
+      if (date[i] < '0' || date[i] > '9') {
+        return std::nullopt;
+      }
+      value = value * 10 + (date[i] - '0');
+    }
+    return value;
+  };
+
+  const auto year = number(0, 4);
+  const auto month = number(5, 2);
+  const auto day = number(8, 2);
+  if (!year || !month || !day || *month < 1 || *month > 12 || *day < 1) {
+    return std::nullopt;
+  }
+
+  // Rejects days past the end of the month (e.g. 2025-02-30)
+  const Day result = dayFromCivil(*year, *month, *day);
+  if (civilFromDays(result).day != *day) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+std::string ReleaseCalendarIndex::formatDay(Day day) {
+  const auto date = civilFromDays(day);
+  return fmt::format("{:04}-{:02}-{:02}", date.year, date.month, date.day);
+}
+
+ReleaseCalendarIndex::Day ReleaseCalendarIndex::dayOf(
+    const std::chrono::system_clock::time_point &time) {
+  const std::time_t t = std::chrono::system_clock::to_time_t(time);
+  std::tm tm_buf{};
+  localtime_r(&t, &tm_buf);
+  return dayFromCivil(tm_buf.tm_year + 1900, tm_buf.tm_mon + 1,
+                      tm_buf.tm_mday);
+}
+
+std::chrono::system_clock::time_point
+ReleaseCalendarIndex::startOfDay(Day day) {
+  const auto date = civilFromDays(day);
+  std::tm tm_buf{};
+  tm_buf.tm_year = date.year - 1900;
+  tm_buf.tm_mon = date.month - 1;
+  tm_buf.tm_mday = date.day;
+  tm_buf.tm_isdst = -1;
+  return std::chrono::system_clock::from_time_t(std::mktime(&tm_buf));
+}
+
+void ReleaseCalendarIndex::invalidate() { ++generation_; }
+
+std::shared_ptr<const ReleaseCalendarIndex::Buckets>
+ReleaseCalendarIndex::buckets() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const uint64_t generation = generation_;
+  if (buckets_ && built_generation_ == generation) {
+    return buckets_;
+  }
+
+  const auto started = std::chrono::steady_clock::now();
+
+  // Sorted by release date, so each bucket keeps that order
+  auto items = repositories::SqliteReleaseCalendarRepository().findAll();
+  const size_t releases = items.size();
+  auto buckets = std::make_shared<Buckets>();
+  for (auto &item : items) {
+    (*buckets)[dayOf(item.release_date)].push_back(std::move(item));
+  }
+
+  buckets_ = std::move(buckets);
+  built_generation_ = generation;
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - started);
+  LOG_DEBUG("Release calendar index rebuilt: {} releases on {} days in {}ms",
+            releases, buckets_->size(), elapsed.count());
+  return buckets_;
+}
+
+std::optional<std::vector<domain::ReleaseCalendarItem>>
+ReleaseCalendarIndex::findByDayRange(Day first, Day last) {
+  std::shared_ptr<const Buckets> current;
+  try {
+    current = buckets();
+  } catch (const std::exception &e) {
+    LOG_ERROR("Failed to build release calendar index: {}", e.what());
+    return std::nullopt;
+  }
+
+  std::vector<domain::ReleaseCalendarItem> items;
+  if (first > last) {
+    return items;
+  }
+  for (auto it = current->lower_bound(first);
+       it != current->end() && it->first <= last; ++it) {
+    items.insert(items.end(), it->second.begin(), it->second.end());
+  }
+  return items;
+}
+
+std::optional<ReleaseCalendarIndex::Buckets>
+ReleaseCalendarIndex::findByMonth(int year, int month) {
+  std::shared_ptr<const Buckets> current;
+  try {
+    current = buckets();
+  } catch (const std::exception &e) {
+    LOG_ERROR("Failed to build release calendar index: {}", e.what());
+    return std::nullopt;
+  }
+
+  const Day first = dayFromCivil(year, month, 1);
+  const Day next_month = month == 12 ? dayFromCivil(year + 1, 1, 1)
+                                     : dayFromCivil(year, month + 1, 1);
+  return Buckets(current->lower_bound(first), current->lower_bound(next_month));
+}
+
+} // namespace bluray::infrastructure
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../domain/models.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bluray::infrastructure {
+
+/**
+ * In-memory release calendar bucketed by release day (Singleton pattern)
+ *
+ * The calendar is small, read often and rewritten about once a day, so
+ * range queries and month views are answered from here without touching
+ * SQLite. Writes through SqliteReleaseCalendarRepository and writes by
+ * other processes (reported by ChangeFeed) invalidate the index; the next
+ * query rebuilds it with one full read.
+ */
+class ReleaseCalendarIndex {
+public:
+  using Day = int32_t; // Days since 1970-01-01
+  using Buckets = std::map<Day, std::vector<domain::ReleaseCalendarItem>>;
+
+  static ReleaseCalendarIndex &instance();
+
+  // Prevent copying
+  ReleaseCalendarIndex(const ReleaseCalendarIndex &) = delete;
+  ReleaseCalendarIndex &operator=(const ReleaseCalendarIndex &) = delete;
+
+  /**
+   * Releases from day `first` through day `last`, by release date
+   * @return nullopt if the index could not be built (query SQLite instead)
+   */
+  std::optional<std::vector<domain::ReleaseCalendarItem>>
+  findByDayRange(Day first, Day last);
+
+  /**
+   * Releases of one month, per day (days without releases are absent)
+   * @return nullopt if the index could not be built (query SQLite instead)
+   */
+  std::optional<Buckets> findByMonth(int year, int month);
+
+  /**
+   * Rebuild on the next query
+   */
+  void invalidate();
+
+  /**
+   * Day of "YYYY-MM-DD", if it is a valid date
+   */
+  static std::optional<Day> parseDay(std::string_view date);
+
+  /**
+   * "YYYY-MM-DD" of a day
+   */
+  static std::string formatDay(Day day);
+
+  /**
+   * Calendar day (local time, as release dates are shown) of a time point
+   */
+  static Day dayOf(const std::chrono::system_clock::time_point &time);
+
+  /**
+   * Local midnight starting a day (inverse of dayOf)
+   */
+  static std::chrono::system_clock::time_point startOfDay(Day day);
+
+  static Day dayFromCivil(int year, int month, int day);
+
+private:
+  ReleaseCalendarIndex() = default;
+
+  /**
+   * Current buckets, rebuilt if stale; stay valid while held
+   */
+  std::shared_ptr<const Buckets> buckets();
+
+  std::mutex mutex_;
+  std::shared_ptr<const Buckets> buckets_;
+  uint64_t built_generation_{0};
+
+  // Bumped by invalidate(); atomic because writers call it while holding
+  // the database lock, which a rebuild takes after mutex_
+  std::atomic<uint64_t> generation_{0};
+};
+
+} // namespace bluray::infrastructure
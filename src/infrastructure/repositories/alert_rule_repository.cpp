@@ -0,0 +1,159 @@
+#include "alert_rule_repository.hpp"
+#include "../database_manager.hpp"
+#include "../logger.hpp"
+#include <fmt/format.h>
+#include <iomanip>
+#include <sstream>
+
+namespace bluray::infrastructure::repositories {
+
+int SqliteAlertRuleRepository::add(const domain::AlertRule &rule) {
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  auto stmt = db.prepare(R"(
+        INSERT INTO alert_rules (name, conditions, notify_via, enabled, created_at)
+        VALUES (?, ?, ?, ?, datetime('now'))
+    )");
+
+  const std::string notify_via = joinChannels(rule.notify_via);
+  sqlite3_bind_text(stmt.get(), 1, rule.name.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt.get(), 2, rule.conditions.c_str(), -1,
+                    SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt.get(), 3, notify_via.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int(stmt.get(), 4, rule.enabled ? 1 : 0);
+
+  if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+    LOG_ERROR("Failed to insert alert rule: {}",
+              sqlite3_errmsg(db.getHandle()));
+    return -1;
+  }
+
+  return static_cast<int>(db.lastInsertRowId());
+}
+
+bool SqliteAlertRuleRepository::update(const domain::AlertRule &rule) {
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  auto stmt = db.prepare(R"(
+        UPDATE alert_rules
+        SET name = ?, conditions = ?, notify_via = ?, enabled = ?
+        WHERE id = ?
+    )");
+
+  const std::string notify_via = joinChannels(rule.notify_via);
+  sqlite3_bind_text(stmt.get(), 1, rule.name.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt.get(), 2, rule.conditions.c_str(), -1,
+                    SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt.get(), 3, notify_via.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int(stmt.get(), 4, rule.enabled ? 1 : 0);
+  sqlite3_bind_int(stmt.get(), 5, rule.id);
+
+  return sqlite3_step(stmt.get()) == SQLITE_DONE &&
+         sqlite3_changes(db.getHandle()) > 0;
+}
+
+bool SqliteAlertRuleRepository::remove(int id) {
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  auto stmt = db.prepare("DELETE FROM alert_rules WHERE id = ?");
+  sqlite3_bind_int(stmt.get(), 1, id);
+
+  return sqlite3_step(stmt.get()) == SQLITE_DONE &&
+         sqlite3_changes(db.getHandle()) > 0;
+}
+
+std::optional<domain::AlertRule> SqliteAlertRuleRepository::findById(int id) {
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  auto stmt = db.prepare(R"(
+        SELECT id, name, conditions, notify_via, enabled, created_at
+        FROM alert_rules WHERE id = ?
+    )");
+  sqlite3_bind_int(stmt.get(), 1, id);
+
+  if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+    return fromStatement(stmt.get());
+  }
+
+  return std::nullopt;
+}
+
+std::vector<domain::AlertRule> SqliteAlertRuleRepository::findAll() {
+  return query("");
+}
+
+std::vector<domain::AlertRule> SqliteAlertRuleRepository::findEnabled() {
+  return query("WHERE enabled = 1");
+}
+
+std::vector<domain::AlertRule>
+SqliteAlertRuleRepository::query(const char *where_clause) {
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  auto stmt = db.prepare(fmt::format(R"(
+        SELECT id, name, conditions, notify_via, enabled, created_at
+        FROM alert_rules {} ORDER BY id
+    )",
+                                     where_clause));
+
+  std::vector<domain::AlertRule> rules;
+  while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+    rules.push_back(fromStatement(stmt.get()));
+  }
+
+  return rules;
+}
+
+domain::AlertRule SqliteAlertRuleRepository::fromStatement(sqlite3_stmt *stmt) {
+  domain::AlertRule rule;
+  rule.id = sqlite3_column_int(stmt, 0);
+  rule.name = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1));
+  rule.conditions = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 2));
+  if (const char *notify_via =
+          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3))) {
+    rule.notify_via = splitChannels(notify_via);
+  }
+  rule.enabled = sqlite3_column_int(stmt, 4) != 0;
+
+  if (const char *created_at =
+          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 5))) {
+    std::tm tm = {};
+    std::istringstream iss(created_at);
+    iss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    rule.created_at = std::chrono::system_clock::from_time_t(timegm(&tm));
+  }
+
+  return rule;
+}
+
+std::string SqliteAlertRuleRepository::joinChannels(
+    const std::vector<std::string> &channels) {
+  std::string joined;
+  for (const auto &channel : channels) {
+    if (!joined.empty()) {
+      joined += ',';
+    }
+    joined += channel;
+  }
+  return joined;
+}
+
+std::vector<std::string>
+SqliteAlertRuleRepository::splitChannels(const std::string &value) {
+  std::vector<std::string> channels;
+  std::istringstream iss(value);
+  std::string channel;
+  while (std::getline(iss, channel, ',')) {
+    if (!channel.empty()) {
+      channels.push_back(channel);
+    }
+  }
+  return channels;
+}
+
+} // namespace bluray::infrastructure::repositories
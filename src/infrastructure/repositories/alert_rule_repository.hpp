@@ -0,0 +1,47 @@
+#pragma once
+
+#include "../../domain/models.hpp"
+#include <optional>
+#include <sqlite3.h>
+#include <string>
+#include <vector>
+
+namespace bluray::infrastructure::repositories {
+
+/**
+ * Repository interface for alert rule operations
+ */
+class IAlertRuleRepository {
+public:
+  virtual ~IAlertRuleRepository() = default;
+
+  virtual int add(const domain::AlertRule &rule) = 0;
+  virtual bool update(const domain::AlertRule &rule) = 0;
+  virtual bool remove(int id) = 0;
+  virtual std::optional<domain::AlertRule> findById(int id) = 0;
+  virtual std::vector<domain::AlertRule> findAll() = 0;
+  virtual std::vector<domain::AlertRule> findEnabled() = 0;
+};
+
+/**
+ * SQLite implementation of alert rule repository
+ */
+class SqliteAlertRuleRepository : public IAlertRuleRepository {
+public:
+  int add(const domain::AlertRule &rule) override;
+  bool update(const domain::AlertRule &rule) override;
+  bool remove(int id) override;
+  std::optional<domain::AlertRule> findById(int id) override;
+  std::vector<domain::AlertRule> findAll() override;
+  std::vector<domain::AlertRule> findEnabled() override;
+
+private:
+  std::vector<domain::AlertRule> query(const char *where_clause);
+  static domain::AlertRule fromStatement(sqlite3_stmt *stmt);
+
+  // notify_via is stored comma-separated
+  static std::string joinChannels(const std::vector<std::string> &channels);
+  static std::vector<std::string> splitChannels(const std::string &value);
+};
+
+} // namespace bluray::infrastructure::repositories
@@ -0,0 +1,82 @@
+#include "catalog_repository.hpp"
+#include "../database_manager.hpp"
+#include "../logger.hpp"
+#include <fmt/format.h>
+
+namespace bluray::infrastructure {
+
+namespace {
+
+// Wishlist items carry the EAN of the product they are linked to
+constexpr const char *kWishlistQuery =
+    "SELECT 'wishlist', w.id, w.title, w.is_uhd_4k, COALESCE(w.tmdb_id, 0), "
+    "COALESCE(p.ean, '') FROM wishlist w "
+    "LEFT JOIN products p ON p.id = w.product_id";
+
+constexpr const char *kCollectionQuery =
+    "SELECT 'collection', id, title, is_uhd_4k, COALESCE(tmdb_id, 0), '' "
+    "FROM collection";
+
+std::string columnText(sqlite3_stmt *stmt, int column) {
+  const auto *text =
+      reinterpret_cast<const char *>(sqlite3_column_text(stmt, column));
+  return text ? text : "";
+}
+
+domain::CatalogEntry fromStatement(sqlite3_stmt *stmt) {
+  domain::CatalogEntry entry;
+  entry.item_type = columnText(stmt, 0);
+  entry.id = sqlite3_column_int(stmt, 1);
+  entry.title = columnText(stmt, 2);
+  entry.is_uhd_4k = sqlite3_column_int(stmt, 3) != 0;
+  entry.tmdb_id = sqlite3_column_int(stmt, 4);
+  entry.ean = columnText(stmt, 5);
+  return entry;
+}
+
+} // anonymous namespace
+
+std::vector<domain::CatalogEntry> CatalogRepository::findAll() {
+  std::vector<domain::CatalogEntry> entries;
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  try {
+    auto stmt = db.prepare(
+        fmt::format("{} UNION ALL {}", kWishlistQuery, kCollectionQuery));
+    while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+      entries.push_back(fromStatement(stmt.get()));
+    }
+  } catch (const std::exception &e) {
+    LOG_ERROR("Failed to load catalog: {}", e.what());
+  }
+  return entries;
+}
+
+std::optional<domain::CatalogEntry>
+CatalogRepository::find(std::string_view item_type, int id) {
+  std::string sql;
+  if (item_type == "wishlist") {
+    sql = fmt::format("{} WHERE w.id = ?", kWishlistQuery);
+  } else if (item_type == "collection") {
+    sql = fmt::format("{} WHERE id = ?", kCollectionQuery);
+  } else {
+    return std::nullopt;
+  }
+
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  try {
+    auto stmt = db.prepare(sql);
+    sqlite3_bind_int(stmt.get(), 1, id);
+    if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+      return fromStatement(stmt.get());
+    }
+  } catch (const std::exception &e) {
+    LOG_ERROR("Failed to load {} item {}: {}", item_type, id, e.what());
+  }
+  return std::nullopt;
+}
+
+} // namespace bluray::infrastructure
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "../../domain/models.hpp"
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace bluray::infrastructure {
+
+/**
+ * Wishlist and collection items in the shape duplicate detection compares
+ * (title, format, TMDb id and EAN)
+ */
+class CatalogRepository {
+public:
+  /**
+   * Every wishlist and collection item
+   */
+  std::vector<domain::CatalogEntry> findAll();
+
+  /**
+   * One item ("wishlist" or "collection")
+   */
+  std::optional<domain::CatalogEntry> find(std::string_view item_type,
+                                           int id);
+};
+
+} // namespace bluray::infrastructure
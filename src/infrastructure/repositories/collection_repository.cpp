@@ -2,21 +2,30 @@
 #include "../database_manager.hpp"
 #include "../logger.hpp"
 #include "../input_validation.hpp"
+#include "../symbol_dictionary.hpp"
 #include <fmt/format.h>
 #include <iomanip>
 #include <sstream>
 
 namespace bluray::infrastructure::repositories {
 
+// Helper constant for consistent column ordering (see fromStatement)
+static const std::string kColumnList =
+    "id, url, title, purchase_price_cents, is_uhd_4k, image_url, local_image_path, "
+    "source_id, notes, purchased_at, added_at, tmdb_id, imdb_id, tmdb_rating, "
+    "trailer_key, edition_type_id, has_slipcover, has_digital_copy, "
+    "bonus_features";
+
 int SqliteCollectionRepository::add(const domain::CollectionItem &item) {
   auto &db = DatabaseManager::instance();
   auto lock = db.lock();
+  auto &symbols = SymbolDictionary::instance();
 
   auto stmt = db.prepare(R"(
         INSERT INTO collection (
-            url, title, purchase_price, is_uhd_4k, image_url, local_image_path,
-            source, notes, purchased_at, added_at, tmdb_id, imdb_id, tmdb_rating,
-            trailer_key, edition_type, has_slipcover, has_digital_copy, bonus_features
+            url, title, purchase_price_cents, is_uhd_4k, image_url, local_image_path,
+            source_id, notes, purchased_at, added_at, tmdb_id, imdb_id, tmdb_rating,
+            trailer_key, edition_type_id, has_slipcover, has_digital_copy, bonus_features
         ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
     )");
 
@@ -25,13 +34,13 @@ int SqliteCollectionRepository::add(const domain::CollectionItem &item) {
 
   sqlite3_bind_text(stmt.get(), 1, item.url.c_str(), -1, SQLITE_TRANSIENT);
   sqlite3_bind_text(stmt.get(), 2, item.title.c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_double(stmt.get(), 3, item.purchase_price);
+  sqlite3_bind_int64(stmt.get(), 3, item.purchase_price.cents());
   sqlite3_bind_int(stmt.get(), 4, item.is_uhd_4k ? 1 : 0);
   sqlite3_bind_text(stmt.get(), 5, item.image_url.c_str(), -1,
                     SQLITE_TRANSIENT);
   sqlite3_bind_text(stmt.get(), 6, item.local_image_path.c_str(), -1,
                     SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt.get(), 7, item.source.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int64(stmt.get(), 7, symbols.toDatabaseId(item.source));
   sqlite3_bind_text(stmt.get(), 8, item.notes.c_str(), -1, SQLITE_TRANSIENT);
   sqlite3_bind_text(stmt.get(), 9, purchased_at_str.c_str(), -1,
                     SQLITE_TRANSIENT);
@@ -41,16 +50,15 @@ int SqliteCollectionRepository::add(const domain::CollectionItem &item) {
   sqlite3_bind_double(stmt.get(), 13, item.tmdb_rating);
   sqlite3_bind_text(stmt.get(), 14, item.trailer_key.c_str(), -1,
                     SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt.get(), 15, item.edition_type.c_str(), -1,
-                    SQLITE_TRANSIENT);
+  sqlite3_bind_int64(stmt.get(), 15, symbols.toDatabaseId(item.edition_type));
   sqlite3_bind_int(stmt.get(), 16, item.has_slipcover ? 1 : 0);
   sqlite3_bind_int(stmt.get(), 17, item.has_digital_copy ? 1 : 0);
   sqlite3_bind_text(stmt.get(), 18, item.bonus_features.c_str(), -1,
                     SQLITE_TRANSIENT);
 
   if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
-    Logger::instance().error(fmt::format("Failed to insert collection item: {}",
-                                         sqlite3_errmsg(db.getHandle())));
+    LOG_ERROR("Failed to insert collection item: {}",
+              sqlite3_errmsg(db.getHandle()));
     return -1;
   }
 
@@ -60,26 +68,27 @@ int SqliteCollectionRepository::add(const domain::CollectionItem &item) {
 bool SqliteCollectionRepository::update(const domain::CollectionItem &item) {
   auto &db = DatabaseManager::instance();
   auto lock = db.lock();
+  auto &symbols = SymbolDictionary::instance();
 
   auto stmt = db.prepare(R"(
         UPDATE collection SET
-            title = ?, purchase_price = ?, is_uhd_4k = ?, image_url = ?,
-            local_image_path = ?, source = ?, notes = ?, purchased_at = ?,
+            title = ?, purchase_price_cents = ?, is_uhd_4k = ?, image_url = ?,
+            local_image_path = ?, source_id = ?, notes = ?, purchased_at = ?,
             tmdb_id = ?, imdb_id = ?, tmdb_rating = ?, trailer_key = ?,
-            edition_type = ?, has_slipcover = ?, has_digital_copy = ?, bonus_features = ?
+            edition_type_id = ?, has_slipcover = ?, has_digital_copy = ?, bonus_features = ?
         WHERE id = ?
     )");
 
   const auto purchased_at_str = timePointToString(item.purchased_at);
 
   sqlite3_bind_text(stmt.get(), 1, item.title.c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_double(stmt.get(), 2, item.purchase_price);
+  sqlite3_bind_int64(stmt.get(), 2, item.purchase_price.cents());
   sqlite3_bind_int(stmt.get(), 3, item.is_uhd_4k ? 1 : 0);
   sqlite3_bind_text(stmt.get(), 4, item.image_url.c_str(), -1,
                     SQLITE_TRANSIENT);
   sqlite3_bind_text(stmt.get(), 5, item.local_image_path.c_str(), -1,
                     SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt.get(), 6, item.source.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int64(stmt.get(), 6, symbols.toDatabaseId(item.source));
   sqlite3_bind_text(stmt.get(), 7, item.notes.c_str(), -1, SQLITE_TRANSIENT);
   sqlite3_bind_text(stmt.get(), 8, purchased_at_str.c_str(), -1,
                     SQLITE_TRANSIENT);
@@ -88,8 +97,7 @@ bool SqliteCollectionRepository::update(const domain::CollectionItem &item) {
   sqlite3_bind_double(stmt.get(), 11, item.tmdb_rating);
   sqlite3_bind_text(stmt.get(), 12, item.trailer_key.c_str(), -1,
                     SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt.get(), 13, item.edition_type.c_str(), -1,
-                    SQLITE_TRANSIENT);
+  sqlite3_bind_int64(stmt.get(), 13, symbols.toDatabaseId(item.edition_type));
   sqlite3_bind_int(stmt.get(), 14, item.has_slipcover ? 1 : 0);
   sqlite3_bind_int(stmt.get(), 15, item.has_digital_copy ? 1 : 0);
   sqlite3_bind_text(stmt.get(), 16, item.bonus_features.c_str(), -1,
@@ -114,7 +122,8 @@ SqliteCollectionRepository::findById(int id) {
   auto &db = DatabaseManager::instance();
   auto lock = db.lock();
 
-  auto stmt = db.prepare("SELECT * FROM collection WHERE id = ?");
+  auto stmt = db.prepare(
+      fmt::format("SELECT {} FROM collection WHERE id = ?", kColumnList));
   sqlite3_bind_int(stmt.get(), 1, id);
 
   if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
@@ -129,7 +138,8 @@ SqliteCollectionRepository::findByUrl(std::string_view url) {
   auto &db = DatabaseManager::instance();
   auto lock = db.lock();
 
-  auto stmt = db.prepare("SELECT * FROM collection WHERE url = ?");
+  auto stmt = db.prepare(
+      fmt::format("SELECT {} FROM collection WHERE url = ?", kColumnList));
   sqlite3_bind_text(stmt.get(), 1, std::string(url).c_str(), -1,
                     SQLITE_TRANSIENT);
 
@@ -144,7 +154,8 @@ std::vector<domain::CollectionItem> SqliteCollectionRepository::findAll() {
   auto &db = DatabaseManager::instance();
   auto lock = db.lock();
 
-  auto stmt = db.prepare("SELECT * FROM collection ORDER BY added_at DESC");
+  auto stmt = db.prepare(fmt::format(
+      "SELECT {} FROM collection ORDER BY added_at DESC", kColumnList));
 
   std::vector<domain::CollectionItem> items;
   while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
@@ -164,9 +175,16 @@ SqliteCollectionRepository::findAll(const domain::PaginationParams &params) {
   result.page_size = params.page_size;
   std::vector<std::string> conditions;
   
-  // filter_source and search_query use parameterized queries (safe)
+  // filter_source and search_query use parameterized queries (safe). The
+  // source is compared by id; one that was never stored matches nothing.
+  const int64_t source_id =
+      params.filter_source.empty()
+          ? 0
+          : SymbolDictionary::instance()
+                .findDatabaseId(params.filter_source)
+                .value_or(-1);
   if (!params.filter_source.empty()) {
-    conditions.push_back("source = ?");
+    conditions.push_back("source_id = ?");
   }
   if (!params.search_query.empty()) {
     conditions.push_back("title LIKE ?");
@@ -189,8 +207,7 @@ SqliteCollectionRepository::findAll(const domain::PaginationParams &params) {
       db.prepare("SELECT COUNT(*) FROM collection " + where_clause);
   int bind_idx = 1;
   if (!params.filter_source.empty()) {
-    sqlite3_bind_text(count_stmt.get(), bind_idx++,
-                      params.filter_source.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(count_stmt.get(), bind_idx++, source_id);
   }
   if (!params.search_query.empty()) {
     std::string query = "%" + params.search_query + "%";
@@ -203,11 +220,11 @@ SqliteCollectionRepository::findAll(const domain::PaginationParams &params) {
 
   // Total Value with filters
   auto value_stmt =
-      db.prepare("SELECT SUM(purchase_price) FROM collection " + where_clause);
+      db.prepare("SELECT SUM(purchase_price_cents) FROM collection " +
+                 where_clause);
   bind_idx = 1;
   if (!params.filter_source.empty()) {
-    sqlite3_bind_text(value_stmt.get(), bind_idx++,
-                      params.filter_source.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(value_stmt.get(), bind_idx++, source_id);
   }
   if (!params.search_query.empty()) {
     std::string query = "%" + params.search_query + "%";
@@ -215,15 +232,16 @@ SqliteCollectionRepository::findAll(const domain::PaginationParams &params) {
                       SQLITE_TRANSIENT);
   }
   if (sqlite3_step(value_stmt.get()) == SQLITE_ROW) {
-    result.total_value = sqlite3_column_double(value_stmt.get(), 0);
+    result.total_value =
+        domain::Money::fromCents(sqlite3_column_int64(value_stmt.get(), 0));
   }
 
-  auto stmt = db.prepare("SELECT * FROM collection " + where_clause + " " +
-                         order_clause + " LIMIT ? OFFSET ?");
+  auto stmt = db.prepare(fmt::format("SELECT {} FROM collection {} {} "
+                                     "LIMIT ? OFFSET ?",
+                                     kColumnList, where_clause, order_clause));
   bind_idx = 1;
   if (!params.filter_source.empty()) {
-    sqlite3_bind_text(stmt.get(), bind_idx++, params.filter_source.c_str(), -1,
-                      SQLITE_TRANSIENT);
+    sqlite3_bind_int64(stmt.get(), bind_idx++, source_id);
   }
   if (!params.search_query.empty()) {
     std::string query = "%" + params.search_query + "%";
@@ -253,17 +271,17 @@ int SqliteCollectionRepository::count() {
   return 0;
 }
 
-double SqliteCollectionRepository::totalValue() {
+domain::Money SqliteCollectionRepository::totalValue() {
   auto &db = DatabaseManager::instance();
   auto lock = db.lock();
 
-  auto stmt = db.prepare("SELECT SUM(purchase_price) FROM collection");
+  auto stmt = db.prepare("SELECT SUM(purchase_price_cents) FROM collection");
 
   if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
-    return sqlite3_column_double(stmt.get(), 0);
+    return domain::Money::fromCents(sqlite3_column_int64(stmt.get(), 0));
   }
 
-  return 0.0;
+  return {};
 }
 
 domain::CollectionItem
@@ -273,7 +291,8 @@ SqliteCollectionRepository::fromStatement(sqlite3_stmt *stmt) {
   item.id = sqlite3_column_int(stmt, 0);
   item.url = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1));
   item.title = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 2));
-  item.purchase_price = sqlite3_column_double(stmt, 3);
+  item.purchase_price =
+      domain::Money::fromCents(sqlite3_column_int64(stmt, 3));
   item.is_uhd_4k = sqlite3_column_int(stmt, 4) != 0;
 
   if (const char *image_url =
@@ -285,7 +304,8 @@ SqliteCollectionRepository::fromStatement(sqlite3_stmt *stmt) {
     item.local_image_path = local_path;
   }
 
-  item.source = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 7));
+  auto &symbols = SymbolDictionary::instance();
+  item.source = symbols.fromDatabaseId(sqlite3_column_int64(stmt, 7));
 
   if (const char *notes =
           reinterpret_cast<const char *>(sqlite3_column_text(stmt, 8))) {
@@ -313,10 +333,7 @@ SqliteCollectionRepository::fromStatement(sqlite3_stmt *stmt) {
   }
 
   // Edition & bonus features fields
-  if (const char *edition_type =
-          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 15))) {
-    item.edition_type = edition_type;
-  }
+  item.edition_type = symbols.fromDatabaseId(sqlite3_column_int64(stmt, 15));
   item.has_slipcover = sqlite3_column_int(stmt, 16) != 0;
   item.has_digital_copy = sqlite3_column_int(stmt, 17) != 0;
   if (const char *bonus_features =
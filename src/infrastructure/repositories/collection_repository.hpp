@@ -25,7 +25,7 @@ public:
   virtual domain::PaginatedResult<domain::CollectionItem>
   findAll(const domain::PaginationParams &params) = 0;
   virtual int count() = 0;
-  virtual double totalValue() = 0;
+  virtual domain::Money totalValue() = 0;
 };
 
 /**
@@ -43,7 +43,7 @@ public:
   domain::PaginatedResult<domain::CollectionItem>
   findAll(const domain::PaginationParams &params) override;
   int count() override;
-  double totalValue() override;
+  domain::Money totalValue() override;
 
 private:
   static domain::CollectionItem fromStatement(sqlite3_stmt *stmt);
@@ -0,0 +1,357 @@
+#include "notification_outbox_repository.hpp"
+#include "../database_manager.hpp"
+#include "../logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <random>
+
+namespace bluray::infrastructure {
+
+using json = nlohmann::json;
+
+namespace {
+
+/**
+ * Unique token identifying one claim, so a worker only picks up the rows
+ * it leased itself
+ */
+std::string nextLeaseToken() {
+  static const auto process_tag = std::random_device{}();
+  static std::atomic<uint64_t> counter{0};
+  return fmt::format("{:08x}-{}", process_tag, ++counter);
+}
+
+int64_t toEpochMillis(std::chrono::system_clock::time_point tp) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             tp.time_since_epoch())
+      .count();
+}
+
+/**
+ * Price stored as "<key>_cents"; payloads queued by older versions hold
+ * euros under "<key>"
+ */
+std::optional<domain::Money> readMoney(const json &j, const std::string &key) {
+  const auto cents = j.find(key + "_cents");
+  if (cents != j.end()) {
+    return domain::Money::fromCents(cents->get<int64_t>());
+  }
+  const auto euros = j.find(key);
+  if (euros != j.end()) {
+    return domain::Money::fromEuros(euros->get<double>());
+  }
+  return std::nullopt;
+}
+
+} // anonymous namespace
+
+int NotificationOutboxRepository::enqueue(
+    const domain::ChangeEvent &event,
+    const std::vector<std::string> &channels) {
+  if (!event.item) {
+    return 0;
+  }
+
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  const std::string key = event.idempotency_key.empty()
+                              ? makeIdempotencyKey(event)
+                              : event.idempotency_key;
+
+  domain::ChangeEvent keyed = event;
+  keyed.idempotency_key = key;
+  const std::string payload = serializeEvent(keyed);
+
+  auto stmt = db.prepare(R"(
+        INSERT OR IGNORE INTO notification_outbox (
+            idempotency_key, channel, wishlist_id, payload, status,
+            attempts, next_attempt_at, created_at
+        ) VALUES (?, ?, ?, ?, 'pending', 0, datetime('now'), datetime('now'))
+    )");
+
+  int inserted = 0;
+  for (const auto &channel : channels) {
+    sqlite3_reset(stmt.get());
+    sqlite3_bind_text(stmt.get(), 1, key.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt.get(), 2, channel.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt.get(), 3, event.item->id);
+    sqlite3_bind_text(stmt.get(), 4, payload.c_str(), -1, SQLITE_TRANSIENT);
+
+    if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+      // Surface the failure so the surrounding transaction rolls back
+      throw DatabaseException(
+          fmt::format("Failed to enqueue notification: {}",
+                      sqlite3_errmsg(db.getHandle())));
+    }
+    inserted += sqlite3_changes(db.getHandle());
+  }
+
+  return inserted;
+}
+
+std::vector<OutboxEntry>
+NotificationOutboxRepository::claimDue(std::string_view channel, int limit,
+                                       std::chrono::seconds lease) {
+  std::vector<OutboxEntry> entries;
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  const std::string token = nextLeaseToken();
+  const std::string lease_modifier = fmt::format("+{} seconds", lease.count());
+
+  try {
+    // Single UPDATE, so concurrent workers can never claim the same row
+    auto claim = db.prepare(R"(
+        UPDATE notification_outbox
+        SET lease_token = ?, locked_until = datetime('now', ?)
+        WHERE id IN (
+            SELECT id FROM notification_outbox
+            WHERE status = 'pending' AND channel = ?
+              AND next_attempt_at <= datetime('now')
+              AND (locked_until IS NULL OR locked_until <= datetime('now'))
+            ORDER BY id
+            LIMIT ?
+        )
+    )");
+
+    sqlite3_bind_text(claim.get(), 1, token.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(claim.get(), 2, lease_modifier.c_str(), -1,
+                      SQLITE_TRANSIENT);
+    sqlite3_bind_text(claim.get(), 3, std::string(channel).c_str(), -1,
+                      SQLITE_TRANSIENT);
+    sqlite3_bind_int(claim.get(), 4, limit);
+
+    if (sqlite3_step(claim.get()) != SQLITE_DONE) {
+      LOG_ERROR("Failed to claim outbox rows: {}",
+                sqlite3_errmsg(db.getHandle()));
+      return entries;
+    }
+
+    auto stmt = db.prepare(R"(
+        SELECT id, channel, attempts, payload
+        FROM notification_outbox
+        WHERE lease_token = ?
+        ORDER BY id
+    )");
+    sqlite3_bind_text(stmt.get(), 1, token.c_str(), -1, SQLITE_TRANSIENT);
+
+    while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+      OutboxEntry entry;
+      entry.id = sqlite3_column_int64(stmt.get(), 0);
+      entry.channel =
+          reinterpret_cast<const char *>(sqlite3_column_text(stmt.get(), 1));
+      entry.attempts = sqlite3_column_int(stmt.get(), 2);
+
+      const std::string payload =
+          reinterpret_cast<const char *>(sqlite3_column_text(stmt.get(), 3));
+      try {
+        entry.event = deserializeEvent(payload);
+      } catch (const std::exception &e) {
+        // Unreadable rows can never succeed; give up on them right away
+        LOG_ERROR("Dropping malformed outbox row {}: {}", entry.id, e.what());
+        markFailed(entry.id, e.what(), 0);
+        continue;
+      }
+
+      entries.push_back(std::move(entry));
+    }
+  } catch (const std::exception &e) {
+    LOG_ERROR("Failed to claim outbox rows: {}", e.what());
+  }
+
+  return entries;
+}
+
+void NotificationOutboxRepository::markDelivered(int64_t id) {
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  try {
+    auto stmt = db.prepare(R"(
+        UPDATE notification_outbox
+        SET status = 'delivered', delivered_at = datetime('now'),
+            attempts = attempts + 1, lease_token = NULL, locked_until = NULL,
+            last_error = NULL
+        WHERE id = ?
+    )");
+    sqlite3_bind_int64(stmt.get(), 1, id);
+    sqlite3_step(stmt.get());
+  } catch (const std::exception &e) {
+    LOG_ERROR("Failed to mark outbox row {} delivered: {}", id, e.what());
+  }
+}
+
+bool NotificationOutboxRepository::markFailed(int64_t id,
+                                              std::string_view error,
+                                              int max_attempts) {
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  try {
+    auto select =
+        db.prepare("SELECT attempts FROM notification_outbox WHERE id = ?");
+    sqlite3_bind_int64(select.get(), 1, id);
+    if (sqlite3_step(select.get()) != SQLITE_ROW) {
+      return false;
+    }
+    const int attempts = sqlite3_column_int(select.get(), 0) + 1;
+    const bool retry = attempts < max_attempts;
+
+    // 30s, 1m, 2m, 4m ... capped at an hour
+    const int backoff = static_cast<int>(std::min<int64_t>(
+        static_cast<int64_t>(RETRY_BASE_SECONDS) << std::min(attempts - 1, 20),
+        RETRY_MAX_SECONDS));
+    const std::string next_modifier = fmt::format("+{} seconds", backoff);
+
+    auto stmt = db.prepare(R"(
+        UPDATE notification_outbox
+        SET status = ?, attempts = ?, last_error = ?,
+            next_attempt_at = datetime('now', ?),
+            lease_token = NULL, locked_until = NULL
+        WHERE id = ?
+    )");
+    sqlite3_bind_text(stmt.get(), 1, retry ? "pending" : "failed", -1,
+                      SQLITE_STATIC);
+    sqlite3_bind_int(stmt.get(), 2, attempts);
+    sqlite3_bind_text(stmt.get(), 3, std::string(error).c_str(), -1,
+                      SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt.get(), 4, next_modifier.c_str(), -1,
+                      SQLITE_TRANSIENT);
+    sqlite3_bind_int64(stmt.get(), 5, id);
+    sqlite3_step(stmt.get());
+
+    return retry;
+  } catch (const std::exception &e) {
+    LOG_ERROR("Failed to record outbox failure for row {}: {}", id, e.what());
+    return false;
+  }
+}
+
+int NotificationOutboxRepository::countPending() {
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  try {
+    auto stmt = db.prepare(
+        "SELECT COUNT(*) FROM notification_outbox WHERE status = 'pending'");
+    if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+      return sqlite3_column_int(stmt.get(), 0);
+    }
+  } catch (const std::exception &e) {
+    LOG_ERROR("Failed to count outbox rows: {}", e.what());
+  }
+  return 0;
+}
+
+void NotificationOutboxRepository::pruneFinished(int days_to_keep) {
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  try {
+    auto stmt = db.prepare(R"(
+        DELETE FROM notification_outbox
+        WHERE status IN ('delivered', 'failed')
+          AND created_at < datetime('now', ?)
+    )");
+    const std::string modifier = fmt::format("-{} days", days_to_keep);
+    sqlite3_bind_text(stmt.get(), 1, modifier.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_step(stmt.get());
+  } catch (const std::exception &e) {
+    LOG_ERROR("Failed to prune notification outbox: {}", e.what());
+  }
+}
+
+std::string
+NotificationOutboxRepository::makeIdempotencyKey(const domain::ChangeEvent &event) {
+  // Each rule notifies at most once per detection
+  if (event.type == domain::ChangeType::AlertRuleMatched) {
+    return fmt::format("wl{}-r{}-{}", event.item->id, event.rule_id,
+                       toEpochMillis(event.detected_at));
+  }
+  return fmt::format("wl{}-t{}-{}", event.item->id, static_cast<int>(event.type),
+                     toEpochMillis(event.detected_at));
+}
+
+std::string
+NotificationOutboxRepository::serializeEvent(const domain::ChangeEvent &event) {
+  // Snapshot of everything the notifiers render, so delivery does not depend
+  // on the wishlist row still existing or being unchanged
+  json item = {{"id", event.item->id},
+               {"url", event.item->url},
+               {"title", event.item->title},
+               {"current_price_cents", event.item->current_price.cents()},
+               {"desired_max_price_cents",
+                event.item->desired_max_price.cents()},
+               {"in_stock", event.item->in_stock},
+               {"is_uhd_4k", event.item->is_uhd_4k},
+               {"image_url", event.item->image_url},
+               {"source", event.item->source.str()}};
+
+  json payload = {{"type", static_cast<int>(event.type)},
+                  {"item", std::move(item)},
+                  {"detected_at", toEpochMillis(event.detected_at)},
+                  {"idempotency_key", event.idempotency_key}};
+
+  if (event.old_price) {
+    payload["old_price_cents"] = event.old_price->cents();
+  }
+  if (event.new_price) {
+    payload["new_price_cents"] = event.new_price->cents();
+  }
+  if (event.old_stock_status) {
+    payload["old_stock_status"] = *event.old_stock_status;
+  }
+  if (event.new_stock_status) {
+    payload["new_stock_status"] = *event.new_stock_status;
+  }
+  if (event.rule_id != 0) {
+    payload["rule_id"] = event.rule_id;
+    payload["rule_name"] = event.rule_name;
+  }
+
+  return payload.dump();
+}
+
+domain::ChangeEvent
+NotificationOutboxRepository::deserializeEvent(const std::string &payload) {
+  const json j = json::parse(payload);
+
+  domain::ChangeEvent event;
+  event.type = static_cast<domain::ChangeType>(j.at("type").get<int>());
+  event.detected_at = std::chrono::system_clock::time_point(
+      std::chrono::milliseconds(j.at("detected_at").get<int64_t>()));
+  event.idempotency_key = j.at("idempotency_key").get<std::string>();
+
+  const auto &j_item = j.at("item");
+  domain::WishlistItem item;
+  item.id = j_item.value("id", 0);
+  item.url = j_item.value("url", "");
+  item.title = j_item.value("title", "");
+  item.current_price =
+      readMoney(j_item, "current_price").value_or(domain::Money{});
+  item.desired_max_price =
+      readMoney(j_item, "desired_max_price").value_or(domain::Money{});
+  item.in_stock = j_item.value("in_stock", false);
+  item.is_uhd_4k = j_item.value("is_uhd_4k", false);
+  item.image_url = j_item.value("image_url", "");
+  item.source = j_item.value("source", "");
+  event.item = std::make_shared<const domain::WishlistItem>(std::move(item));
+
+  event.old_price = readMoney(j, "old_price");
+  event.new_price = readMoney(j, "new_price");
+  if (j.contains("old_stock_status")) {
+    event.old_stock_status = j["old_stock_status"].get<bool>();
+  }
+  if (j.contains("new_stock_status")) {
+    event.new_stock_status = j["new_stock_status"].get<bool>();
+  }
+  event.rule_id = j.value("rule_id", 0);
+  event.rule_name = j.value("rule_name", "");
+
+  return event;
+}
+
+} // namespace bluray::infrastructure
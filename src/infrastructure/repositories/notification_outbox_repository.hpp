@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../../domain/models.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bluray::infrastructure {
+
+/**
+ * Notification claimed from the outbox for delivery
+ */
+struct OutboxEntry {
+  int64_t id{0};
+  std::string channel;
+  int attempts{0};
+  domain::ChangeEvent event; // idempotency_key is populated
+};
+
+/**
+ * Transactional outbox for change notifications
+ *
+ * enqueue() is meant to run inside the same transaction as the wishlist
+ * update that produced the event, so an event is stored if and only if the
+ * change is. Rows are then claimed by a delivery worker under a lease, which
+ * keeps concurrent processes (web server and cron scrape) from delivering
+ * the same row twice, and are retried with exponential backoff until
+ * delivered or out of attempts. Delivery is at-least-once; the idempotency
+ * key travels with the notification so duplicates can be recognised.
+ */
+class NotificationOutboxRepository {
+public:
+  /**
+   * Queue an event for each channel
+   * Caller should hold the database lock and an open transaction.
+   * @return Number of rows inserted (duplicates by key are ignored)
+   */
+  int enqueue(const domain::ChangeEvent &event,
+              const std::vector<std::string> &channels);
+
+  /**
+   * Lease due rows of a channel for delivery
+   * @param channel Notifier channel name
+   * @param limit Maximum rows to claim
+   * @param lease How long other workers must leave the rows alone
+   * @return Claimed entries, oldest first
+   */
+  std::vector<OutboxEntry> claimDue(std::string_view channel, int limit,
+                                    std::chrono::seconds lease);
+
+  /**
+   * Mark a claimed row as delivered
+   */
+  void markDelivered(int64_t id);
+
+  /**
+   * Record a failed attempt and schedule the next one
+   * @param error Reason, kept for diagnostics
+   * @param max_attempts Rows reaching this many attempts are given up
+   * @return true if the row will be retried, false if it was given up
+   */
+  bool markFailed(int64_t id, std::string_view error, int max_attempts);
+
+  /**
+   * Count rows still waiting for delivery
+   */
+  int countPending();
+
+  /**
+   * Delete delivered and given-up rows older than the given age
+   */
+  void pruneFinished(int days_to_keep = 30);
+
+  /**
+   * Build the idempotency key of an event
+   * Stable for a given detection, distinct between detections.
+   */
+  static std::string makeIdempotencyKey(const domain::ChangeEvent &event);
+
+private:
+  static std::string serializeEvent(const domain::ChangeEvent &event);
+  static domain::ChangeEvent deserializeEvent(const std::string &payload);
+
+  // Retry backoff: BASE * 2^attempts, capped
+  static constexpr int RETRY_BASE_SECONDS = 30;
+  static constexpr int RETRY_MAX_SECONDS = 3600;
+};
+
+} // namespace bluray::infrastructure
@@ -1,12 +1,174 @@
 #include "price_history_repository.hpp"
 #include "../database_manager.hpp"
+#include "../config_manager.hpp"
 #include "../logger.hpp"
+#include "../price_series_store.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
 #include <fmt/format.h>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
 
 namespace bluray::infrastructure {
 
-void PriceHistoryRepository::addEntry(int wishlist_id, double price,
+namespace {
+
+int64_t nowSeconds() {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+int64_t daysAgo(int days) {
+  return nowSeconds() - static_cast<int64_t>(days) * 24 * 60 * 60;
+}
+
+// Same format as SQLite's datetime('now')
+std::string formatTime(int64_t seconds) {
+  const auto time = static_cast<std::time_t>(seconds);
+  std::tm tm_buf{};
+  gmtime_r(&time, &tm_buf);
+  char buffer[20];
+  std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm_buf);
+  return buffer;
+}
+
+int64_t parseTime(const std::string &text) {
+  std::tm tm_buf{};
+  std::istringstream iss(text);
+  iss >> std::get_time(&tm_buf, "%Y-%m-%d %H:%M:%S");
+  return iss.fail() ? 0 : static_cast<int64_t>(timegm(&tm_buf));
+}
+
+/**
+ * Largest-Triangle-Three-Buckets over the line (x, y)
+ * @return Indices of at most `threshold` points (never fewer than the first
+ *         and last), ascending
+ */
+std::vector<size_t> lttbIndices(const std::vector<double> &x,
+                                const std::vector<double> &y,
+                                size_t threshold) {
+  const size_t n = x.size();
+  std::vector<size_t> selected;
+  if (n <= threshold) {
+    selected.resize(n);
+    std::iota(selected.begin(), selected.end(), 0);
+    return selected;
+  }
+  if (threshold < 3) {
+    return {0, n - 1};
+  }
+
+  selected.reserve(threshold);
+  selected.push_back(0);
+
+  // Inner points split into threshold - 2 buckets
+  auto bucketStart = [&](size_t bucket) {
+    return std::min(n - 1, bucket * (n - 2) / (threshold - 2) + 1);
+  };
+
+  for (size_t bucket = 0; bucket < threshold - 2; ++bucket) {
+    // Third triangle corner: average of the next bucket (or the last point)
+    const size_t next_start = bucketStart(bucket + 1);
+    const size_t next_end = std::max(next_start + 1, bucketStart(bucket + 2));
+    double avg_x = 0.0;
+    double avg_y = 0.0;
+    for (size_t i = next_start; i < next_end; ++i) {
+      avg_x += x[i];
+      avg_y += y[i];
+    }
+    avg_x /= static_cast<double>(next_end - next_start);
+    avg_y /= static_cast<double>(next_end - next_start);
+
+    const size_t previous = selected.back();
+    size_t best = bucketStart(bucket);
+    double best_area = -1.0;
+    for (size_t i = bucketStart(bucket); i < next_start; ++i) {
+      const double area =
+          std::abs((x[previous] - avg_x) * (y[i] - y[previous]) -
+                   (x[previous] - x[i]) * (avg_y - y[previous]));
+      if (area > best_area) {
+        best_area = area;
+        best = i;
+      }
+    }
+    selected.push_back(best);
+  }
+
+  selected.push_back(n - 1);
+  return selected;
+}
+
+std::vector<PriceHistoryEntry>
+downsampleLttb(const std::vector<PriceHistoryEntry> &entries,
+               size_t threshold) {
+  if (entries.size() <= threshold) {
+    return entries;
+  }
+
+  std::vector<double> x(entries.size());
+  std::vector<double> y(entries.size());
+  const int64_t origin = parseTime(entries.front().recorded_at);
+  for (size_t i = 0; i < entries.size(); ++i) {
+    x[i] = static_cast<double>(parseTime(entries[i].recorded_at) - origin);
+    y[i] = static_cast<double>(entries[i].price.cents());
+  }
+
+  std::vector<PriceHistoryEntry> sampled;
+  for (size_t index : lttbIndices(x, y, threshold)) {
+    sampled.push_back(entries[index]);
+  }
+  return sampled;
+}
+
+PriceSparkline downsampleSparkline(const std::vector<int64_t> &times,
+                                   const std::vector<int64_t> &cents,
+                                   size_t threshold) {
+  std::vector<double> x(times.size());
+  std::vector<double> y(times.size());
+  for (size_t i = 0; i < times.size(); ++i) {
+    x[i] = static_cast<double>(times[i] - times.front());
+    y[i] = static_cast<double>(cents[i]);
+  }
+
+  PriceSparkline sparkline;
+  for (size_t index : lttbIndices(x, y, threshold)) {
+    sparkline.times.push_back(times[index]);
+    sparkline.cents.push_back(cents[index]);
+  }
+  return sparkline;
+}
+
+} // anonymous namespace
+
+PriceHistoryRepository::PriceHistoryRepository()
+    : backend_(configuredBackend()) {}
+
+PriceHistoryRepository::PriceHistoryRepository(PriceHistoryBackend backend)
+    : backend_(backend) {}
+
+PriceHistoryBackend PriceHistoryRepository::configuredBackend() {
+  return ConfigManager::instance().get("price_history_backend", "sqlite") ==
+                 "series"
+             ? PriceHistoryBackend::Series
+             : PriceHistoryBackend::Sqlite;
+}
+
+void PriceHistoryRepository::addEntry(int wishlist_id, domain::Money price,
                                       bool in_stock) {
+  if (backend_ == PriceHistoryBackend::Series) {
+    try {
+      PriceSeriesStore::instance().append(wishlist_id,
+                                          {nowSeconds(), price, in_stock});
+    } catch (const std::exception &e) {
+      LOG_ERROR("Failed to add price history: {}", e.what());
+    }
+    return;
+  }
+
   auto &db = DatabaseManager::instance();
 
   // Check if the last entry for this item has the same price and stock status.
@@ -27,28 +189,44 @@ void PriceHistoryRepository::addEntry(int wishlist_id, double price,
 
   try {
     auto stmt = db.prepare(
-        "INSERT INTO price_history (wishlist_id, price, in_stock, recorded_at) "
-        "VALUES (?, ?, ?, datetime('now'))");
+        "INSERT INTO price_history (wishlist_id, price_cents, in_stock, "
+        "recorded_at) VALUES (?, ?, ?, datetime('now'))");
 
     sqlite3_bind_int(stmt.get(), 1, wishlist_id);
-    sqlite3_bind_double(stmt.get(), 2, price);
+    sqlite3_bind_int64(stmt.get(), 2, price.cents());
     sqlite3_bind_int(stmt.get(), 3, in_stock ? 1 : 0);
 
     sqlite3_step(stmt.get());
   } catch (const std::exception &e) {
-    Logger::instance().error(
-        fmt::format("Failed to add price history: {}", e.what()));
+    LOG_ERROR("Failed to add price history: {}", e.what());
   }
 }
 
 std::vector<PriceHistoryEntry>
 PriceHistoryRepository::getHistory(int wishlist_id, int days) {
   std::vector<PriceHistoryEntry> history;
+
+  if (backend_ == PriceHistoryBackend::Series) {
+    try {
+      const auto points =
+          PriceSeriesStore::instance().read(wishlist_id, daysAgo(days));
+      history.reserve(points.size());
+      for (size_t i = 0; i < points.size(); ++i) {
+        history.push_back({static_cast<int>(i + 1), wishlist_id,
+                           points[i].price, points[i].in_stock,
+                           formatTime(points[i].time)});
+      }
+    } catch (const std::exception &e) {
+      LOG_ERROR("Failed to get price history: {}", e.what());
+    }
+    return history;
+  }
+
   auto &db = DatabaseManager::instance();
 
   try {
     auto stmt = db.prepare(
-        "SELECT id, wishlist_id, price, in_stock, recorded_at "
+        "SELECT id, wishlist_id, price_cents, in_stock, recorded_at "
         "FROM price_history "
         "WHERE wishlist_id = ? AND recorded_at >= datetime('now', ?) "
         "ORDER BY recorded_at ASC");
@@ -61,7 +239,8 @@ PriceHistoryRepository::getHistory(int wishlist_id, int days) {
       PriceHistoryEntry entry;
       entry.id = sqlite3_column_int(stmt.get(), 0);
       entry.wishlist_id = sqlite3_column_int(stmt.get(), 1);
-      entry.price = sqlite3_column_double(stmt.get(), 2);
+      entry.price =
+          domain::Money::fromCents(sqlite3_column_int64(stmt.get(), 2));
       entry.in_stock = sqlite3_column_int(stmt.get(), 3) != 0;
       entry.recorded_at =
           reinterpret_cast<const char *>(sqlite3_column_text(stmt.get(), 4));
@@ -69,14 +248,221 @@ PriceHistoryRepository::getHistory(int wishlist_id, int days) {
       history.push_back(entry);
     }
   } catch (const std::exception &e) {
-    Logger::instance().error(
-        fmt::format("Failed to get price history: {}", e.what()));
+    LOG_ERROR("Failed to get price history: {}", e.what());
   }
 
   return history;
 }
 
+std::vector<PriceHistoryEntry>
+PriceHistoryRepository::getDownsampledHistory(int wishlist_id, int days,
+                                              size_t max_points) {
+  return downsampleLttb(getHistory(wishlist_id, days), max_points);
+}
+
+std::unordered_map<int, PriceSparkline>
+PriceHistoryRepository::getSparklines(const std::vector<int> &wishlist_ids,
+                                      int days, size_t max_points) {
+  std::unordered_map<int, PriceSparkline> sparklines;
+
+  if (backend_ == PriceHistoryBackend::Series) {
+    auto &store = PriceSeriesStore::instance();
+    const int64_t since = daysAgo(days);
+    for (int id : wishlist_ids) {
+      try {
+        std::vector<int64_t> times;
+        std::vector<int64_t> cents;
+        for (const auto &point : store.read(id, since)) {
+          if (point.price.isPositive()) {
+            times.push_back(point.time);
+            cents.push_back(point.price.cents());
+          }
+        }
+        if (!times.empty()) {
+          sparklines[id] = downsampleSparkline(times, cents, max_points);
+        }
+      } catch (const std::exception &e) {
+        LOG_ERROR("Failed to read price sparkline: {}", e.what());
+      }
+    }
+    return sparklines;
+  }
+
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  const std::string days_param = fmt::format("-{} days", days);
+  constexpr size_t kChunkSize = 500;
+
+  for (size_t offset = 0; offset < wishlist_ids.size(); offset += kChunkSize) {
+    const size_t count = std::min(kChunkSize, wishlist_ids.size() - offset);
+
+    std::string placeholders;
+    for (size_t i = 0; i < count; ++i) {
+      placeholders += i == 0 ? "?" : ",?";
+    }
+
+    try {
+      // Walks idx_price_history_wishlist_time in (item, time) order
+      auto stmt = db.prepare(fmt::format(
+          "SELECT wishlist_id, CAST(strftime('%s', recorded_at) AS INTEGER), "
+          "price_cents FROM price_history "
+          "WHERE wishlist_id IN ({}) AND recorded_at >= datetime('now', ?) "
+          "AND price_cents > 0 ORDER BY wishlist_id, recorded_at",
+          placeholders));
+
+      int index = 1;
+      for (size_t i = 0; i < count; ++i) {
+        sqlite3_bind_int(stmt.get(), index++, wishlist_ids[offset + i]);
+      }
+      sqlite3_bind_text(stmt.get(), index, days_param.c_str(), -1,
+                        SQLITE_TRANSIENT);
+
+      int current_id = 0;
+      std::vector<int64_t> times;
+      std::vector<int64_t> cents;
+      auto flush = [&] {
+        if (!times.empty()) {
+          sparklines[current_id] =
+              downsampleSparkline(times, cents, max_points);
+          times.clear();
+          cents.clear();
+        }
+      };
+
+      while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        const int id = sqlite3_column_int(stmt.get(), 0);
+        if (id != current_id) {
+          flush();
+          current_id = id;
+        }
+        times.push_back(sqlite3_column_int64(stmt.get(), 1));
+        cents.push_back(sqlite3_column_int64(stmt.get(), 2));
+      }
+      flush();
+    } catch (const std::exception &e) {
+      LOG_ERROR("Failed to read price sparklines: {}", e.what());
+    }
+  }
+
+  return sparklines;
+}
+
+std::unordered_map<int, PriceWindowAggregate>
+PriceHistoryRepository::getWindowAggregates(const std::vector<int> &wishlist_ids,
+                                            int days) {
+  std::unordered_map<int, PriceWindowAggregate> aggregates;
+
+  if (backend_ == PriceHistoryBackend::Series) {
+    auto &store = PriceSeriesStore::instance();
+    const int64_t since = daysAgo(days);
+    for (int id : wishlist_ids) {
+      try {
+        auto points = store.read(id, since);
+        // Points are ordered: the newest one in range is the newest overall
+        if (!points.empty()) {
+          points.pop_back();
+        }
+
+        PriceWindowAggregate aggregate;
+        int64_t total = 0;
+        for (const auto &point : points) {
+          if (!point.price.isPositive()) {
+            continue; // Scraper miss
+          }
+          if (aggregate.samples == 0) {
+            aggregate.min_price = aggregate.max_price = point.price;
+          }
+          aggregate.min_price = std::min(aggregate.min_price, point.price);
+          aggregate.max_price = std::max(aggregate.max_price, point.price);
+          total += point.price.cents();
+          ++aggregate.samples;
+        }
+        if (aggregate.samples > 0) {
+          aggregate.avg_price = domain::Money::fromCents(std::llround(
+              static_cast<double>(total) / aggregate.samples));
+          aggregates[id] = aggregate;
+        }
+      } catch (const std::exception &e) {
+        LOG_ERROR("Failed to aggregate price history: {}", e.what());
+      }
+    }
+    return aggregates;
+  }
+
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  const std::string days_param = fmt::format("-{} days", days);
+
+  // Each id is bound twice; stay well below SQLite's parameter limit
+  constexpr size_t kChunkSize = 400;
+
+  for (size_t offset = 0; offset < wishlist_ids.size(); offset += kChunkSize) {
+    const size_t count = std::min(kChunkSize, wishlist_ids.size() - offset);
+
+    std::string placeholders;
+    for (size_t i = 0; i < count; ++i) {
+      placeholders += i == 0 ? "?" : ",?";
+    }
+
+    try {
+      // Zero prices are scraper misses, not real offers
+      auto stmt = db.prepare(fmt::format(R"(
+        SELECT wishlist_id, MIN(price_cents), MAX(price_cents),
+               CAST(ROUND(AVG(price_cents)) AS INTEGER), COUNT(*)
+        FROM price_history
+        WHERE wishlist_id IN ({0})
+          AND price_cents > 0
+          AND recorded_at >= datetime('now', ?)
+          AND id NOT IN (
+              SELECT MAX(id) FROM price_history
+              WHERE wishlist_id IN ({0})
+              GROUP BY wishlist_id
+          )
+        GROUP BY wishlist_id
+    )",
+                                         placeholders));
+
+      int index = 1;
+      for (size_t i = 0; i < count; ++i) {
+        sqlite3_bind_int(stmt.get(), index++, wishlist_ids[offset + i]);
+      }
+      sqlite3_bind_text(stmt.get(), index++, days_param.c_str(), -1,
+                        SQLITE_TRANSIENT);
+      for (size_t i = 0; i < count; ++i) {
+        sqlite3_bind_int(stmt.get(), index++, wishlist_ids[offset + i]);
+      }
+
+      while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        PriceWindowAggregate aggregate;
+        aggregate.min_price =
+            domain::Money::fromCents(sqlite3_column_int64(stmt.get(), 1));
+        aggregate.max_price =
+            domain::Money::fromCents(sqlite3_column_int64(stmt.get(), 2));
+        aggregate.avg_price =
+            domain::Money::fromCents(sqlite3_column_int64(stmt.get(), 3));
+        aggregate.samples = sqlite3_column_int(stmt.get(), 4);
+        aggregates[sqlite3_column_int(stmt.get(), 0)] = aggregate;
+      }
+    } catch (const std::exception &e) {
+      LOG_ERROR("Failed to aggregate price history: {}", e.what());
+    }
+  }
+
+  return aggregates;
+}
+
 void PriceHistoryRepository::pruneHistory(int days_to_keep) {
+  if (backend_ == PriceHistoryBackend::Series) {
+    try {
+      PriceSeriesStore::instance().compactAll(daysAgo(days_to_keep));
+    } catch (const std::exception &e) {
+      LOG_ERROR("Failed to prune price history: {}", e.what());
+    }
+    return;
+  }
+
   auto &db = DatabaseManager::instance();
 
   try {
@@ -88,8 +474,76 @@ void PriceHistoryRepository::pruneHistory(int days_to_keep) {
 
     sqlite3_step(stmt.get());
   } catch (const std::exception &e) {
-    Logger::instance().error(
-        fmt::format("Failed to prune price history: {}", e.what()));
+    LOG_ERROR("Failed to prune price history: {}", e.what());
+  }
+}
+
+void PriceHistoryRepository::removeHistory(int wishlist_id) {
+  if (backend_ != PriceHistoryBackend::Series) {
+    return;
+  }
+  try {
+    PriceSeriesStore::instance().remove(wishlist_id);
+  } catch (const std::exception &e) {
+    LOG_ERROR("Failed to remove price history: {}", e.what());
+  }
+}
+
+void PriceHistoryRepository::importIntoSeries() {
+  if (backend_ != PriceHistoryBackend::Series) {
+    return;
+  }
+  auto &store = PriceSeriesStore::instance();
+  if (!store.empty()) {
+    return;
+  }
+
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+  const auto started = std::chrono::steady_clock::now();
+
+  try {
+    auto stmt = db.prepare(
+        "SELECT wishlist_id, CAST(strftime('%s', recorded_at) AS INTEGER), "
+        "price_cents, in_stock FROM price_history "
+        "ORDER BY wishlist_id, recorded_at, id");
+
+    int current_id = 0;
+    std::vector<PricePoint> points;
+    size_t series = 0;
+    size_t total = 0;
+
+    auto flush = [&] {
+      if (!points.empty()) {
+        total += points.size();
+        ++series;
+        store.write(current_id, std::move(points));
+        points.clear();
+      }
+    };
+
+    while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+      const int wishlist_id = sqlite3_column_int(stmt.get(), 0);
+      if (wishlist_id != current_id) {
+        flush();
+        current_id = wishlist_id;
+      }
+      points.push_back(
+          {sqlite3_column_int64(stmt.get(), 1),
+           domain::Money::fromCents(sqlite3_column_int64(stmt.get(), 2)),
+           sqlite3_column_int(stmt.get(), 3) != 0});
+    }
+    flush();
+
+    if (series > 0) {
+      const auto elapsed =
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - started);
+      LOG_INFO("Imported {} price history entries of {} items into {} in {}ms",
+               total, series, store.directory().string(), elapsed.count());
+    }
+  } catch (const std::exception &e) {
+    LOG_ERROR("Failed to import price history: {}", e.what());
   }
 }
 
@@ -2,6 +2,7 @@
 
 #include "../../domain/models.hpp"
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 namespace bluray::infrastructure {
@@ -9,16 +10,95 @@ namespace bluray::infrastructure {
 struct PriceHistoryEntry {
   int id;
   int wishlist_id;
-  double price;
+  domain::Money price;
   bool in_stock;
   std::string recorded_at;
 };
 
+/**
+ * Price statistics of one item over a time window
+ */
+struct PriceWindowAggregate {
+  domain::Money min_price;
+  domain::Money max_price;
+  domain::Money avg_price; // Rounded to the cent
+  int samples{0};
+};
+
+/**
+ * Downsampled price line of one item, for a sparkline
+ */
+struct PriceSparkline {
+  std::vector<int64_t> times; // Seconds since the epoch (UTC), ascending
+  std::vector<int64_t> cents;
+};
+
+/**
+ * Where price history is stored
+ */
+enum class PriceHistoryBackend {
+  Sqlite, // price_history table
+  Series  // Append-only files of PriceSeriesStore
+};
+
 class PriceHistoryRepository {
 public:
-  void addEntry(int wishlist_id, double price, bool in_stock);
+  /**
+   * Repository on the configured backend (price_history_backend: "sqlite"
+   * or "series")
+   */
+  PriceHistoryRepository();
+  explicit PriceHistoryRepository(PriceHistoryBackend backend);
+
+  static PriceHistoryBackend configuredBackend();
+
+  void addEntry(int wishlist_id, domain::Money price, bool in_stock);
   std::vector<PriceHistoryEntry> getHistory(int wishlist_id, int days = 180);
+
+  /**
+   * History of the last `days`, reduced to at most `max_points` entries for
+   * charting
+   * Largest-Triangle-Three-Buckets with time as the x axis: the first and
+   * last entry are kept, plus the entry of each bucket that best preserves
+   * the line's shape, so short price drops survive.
+   * @param max_points At least 2
+   */
+  std::vector<PriceHistoryEntry>
+  getDownsampledHistory(int wishlist_id, int days, size_t max_points);
+
+  /**
+   * Downsampled lines of several items, read in one query
+   * Zero prices (scraper misses) are left out.
+   * @return Sparklines by wishlist id; items without history are absent
+   */
+  std::unordered_map<int, PriceSparkline>
+  getSparklines(const std::vector<int> &wishlist_ids, int days,
+                size_t max_points);
+
+  /**
+   * Aggregate the last `days` of history for several items in one query
+   * The most recent entry of each item (normally the scrape being evaluated)
+   * is excluded, so the result describes the prices seen before it.
+   * @return Aggregates by wishlist id; items without history are absent
+   */
+  std::unordered_map<int, PriceWindowAggregate>
+  getWindowAggregates(const std::vector<int> &wishlist_ids, int days);
+
   void pruneHistory(int days_to_keep = 365);
+
+  /**
+   * Delete an item's history (the price_history table cascades by itself)
+   */
+  void removeHistory(int wishlist_id);
+
+  /**
+   * Copy the price_history table into an empty series store
+   * Done once, when the series backend is first selected.
+   */
+  void importIntoSeries();
+
+private:
+  PriceHistoryBackend backend_;
 };
 
 } // namespace bluray::infrastructure
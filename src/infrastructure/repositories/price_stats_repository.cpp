@@ -0,0 +1,238 @@
+#include "price_stats_repository.hpp"
+#include "../database_manager.hpp"
+#include "../logger.hpp"
+#include <algorithm>
+#include <fmt/format.h>
+
+namespace bluray::infrastructure {
+
+namespace {
+
+constexpr const char *kColumnList =
+    "wishlist_id, all_time_low_cents, all_time_high_cents, ema_cents, "
+    "last_price_cents, last_change_at, samples, last_day, daily_low, "
+    "daily_high, previous_low_cents, previous_day_low_cents, "
+    "previous_day_high_cents";
+
+constexpr size_t kDailyBytes = domain::PriceStats::WINDOW_DAYS * 4;
+
+std::chrono::system_clock::time_point fromEpochSeconds(int64_t seconds) {
+  return std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
+}
+
+int64_t toEpochSeconds(std::chrono::system_clock::time_point tp) {
+  return std::chrono::duration_cast<std::chrono::seconds>(tp.time_since_epoch())
+      .count();
+}
+
+// Daily extremes are stored as little-endian 32-bit cents (up to ~21
+// million)
+std::vector<unsigned char>
+encodeDaily(const std::array<int64_t, domain::PriceStats::WINDOW_DAYS> &ring) {
+  std::vector<unsigned char> blob(kDailyBytes);
+  for (size_t i = 0; i < ring.size(); ++i) {
+    const auto value =
+        static_cast<uint32_t>(std::clamp<int64_t>(ring[i], 0, UINT32_MAX));
+    for (size_t b = 0; b < 4; ++b) {
+      blob[i * 4 + b] = static_cast<unsigned char>(value >> (8 * b));
+    }
+  }
+  return blob;
+}
+
+// @return false (and an empty ring) if the blob is missing or malformed
+bool decodeDaily(const void *data, int size,
+                 std::array<int64_t, domain::PriceStats::WINDOW_DAYS> &ring) {
+  if (!data || size != static_cast<int>(kDailyBytes)) {
+    ring.fill(0);
+    return false;
+  }
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < ring.size(); ++i) {
+    uint32_t value = 0;
+    for (size_t b = 0; b < 4; ++b) {
+      value |= static_cast<uint32_t>(bytes[i * 4 + b]) << (8 * b);
+    }
+    ring[i] = value;
+  }
+  return true;
+}
+
+std::pair<int, domain::PriceStats> fromStatement(sqlite3_stmt *stmt) {
+  domain::PriceStats stats;
+  stats.all_time_low = domain::Money::fromCents(sqlite3_column_int64(stmt, 1));
+  stats.all_time_high = domain::Money::fromCents(sqlite3_column_int64(stmt, 2));
+  stats.ema_cents = sqlite3_column_double(stmt, 3);
+  stats.last_price = domain::Money::fromCents(sqlite3_column_int64(stmt, 4));
+  stats.last_change_at = fromEpochSeconds(sqlite3_column_int64(stmt, 5));
+  stats.samples = sqlite3_column_int64(stmt, 6);
+  stats.last_day = sqlite3_column_int64(stmt, 7);
+  decodeDaily(sqlite3_column_blob(stmt, 8), sqlite3_column_bytes(stmt, 8),
+              stats.daily_low);
+  if (!decodeDaily(sqlite3_column_blob(stmt, 9), sqlite3_column_bytes(stmt, 9),
+                   stats.daily_high)) {
+    // Rows from before daily highs: each day's low stands in for its high
+    // until the window has turned over
+    stats.daily_high = stats.daily_low;
+  }
+  stats.previous_low =
+      domain::Money::fromCents(sqlite3_column_int64(stmt, 10));
+  stats.previous_day_low = sqlite3_column_int64(stmt, 11);
+  stats.previous_day_high = sqlite3_column_int64(stmt, 12);
+  return {sqlite3_column_int(stmt, 0), stats};
+}
+
+} // anonymous namespace
+
+void PriceStatsRepository::record(int wishlist_id, domain::Money price,
+                                  std::chrono::system_clock::time_point at) {
+  if (!price.isPositive()) {
+    return; // Scraper miss; nothing to record
+  }
+
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  auto stats = find(wishlist_id).value_or(domain::PriceStats{});
+  stats.record(price, at);
+  save(wishlist_id, stats);
+}
+
+std::optional<domain::PriceStats> PriceStatsRepository::find(int wishlist_id) {
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  auto stmt = db.prepare(fmt::format(
+      "SELECT {} FROM price_stats WHERE wishlist_id = ?", kColumnList));
+  sqlite3_bind_int(stmt.get(), 1, wishlist_id);
+
+  if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+    return fromStatement(stmt.get()).second;
+  }
+  return std::nullopt;
+}
+
+std::unordered_map<int, domain::PriceStats>
+PriceStatsRepository::find(const std::vector<int> &wishlist_ids) {
+  std::unordered_map<int, domain::PriceStats> result;
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  constexpr size_t kChunkSize = 500;
+
+  for (size_t offset = 0; offset < wishlist_ids.size(); offset += kChunkSize) {
+    const size_t count = std::min(kChunkSize, wishlist_ids.size() - offset);
+
+    std::string placeholders;
+    for (size_t i = 0; i < count; ++i) {
+      placeholders += i == 0 ? "?" : ",?";
+    }
+
+    try {
+      auto stmt = db.prepare(
+          fmt::format("SELECT {} FROM price_stats WHERE wishlist_id IN ({})",
+                      kColumnList, placeholders));
+      for (size_t i = 0; i < count; ++i) {
+        sqlite3_bind_int(stmt.get(), static_cast<int>(i + 1),
+                         wishlist_ids[offset + i]);
+      }
+
+      while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        result.insert(fromStatement(stmt.get()));
+      }
+    } catch (const std::exception &e) {
+      LOG_ERROR("Failed to load price stats: {}", e.what());
+    }
+  }
+
+  return result;
+}
+
+void PriceStatsRepository::backfill() {
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  {
+    auto stmt = db.prepare("SELECT EXISTS (SELECT 1 FROM price_stats), "
+                           "EXISTS (SELECT 1 FROM price_history)");
+    if (sqlite3_step(stmt.get()) != SQLITE_ROW ||
+        sqlite3_column_int(stmt.get(), 0) != 0 ||
+        sqlite3_column_int(stmt.get(), 1) == 0) {
+      return;
+    }
+  }
+
+  const auto started = std::chrono::steady_clock::now();
+  WriteTransaction transaction(db);
+
+  auto stmt = db.prepare(
+      "SELECT wishlist_id, price_cents, "
+      "CAST(strftime('%s', recorded_at) AS INTEGER) FROM price_history "
+      "WHERE wishlist_id IN (SELECT id FROM wishlist) "
+      "ORDER BY wishlist_id, recorded_at, id");
+
+  int current_id = 0;
+  domain::PriceStats stats;
+  size_t items = 0;
+
+  while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+    const int wishlist_id = sqlite3_column_int(stmt.get(), 0);
+    if (wishlist_id != current_id) {
+      if (stats.samples > 0) {
+        save(current_id, stats);
+        ++items;
+      }
+      current_id = wishlist_id;
+      stats = domain::PriceStats{};
+    }
+    stats.record(domain::Money::fromCents(sqlite3_column_int64(stmt.get(), 1)),
+                 fromEpochSeconds(sqlite3_column_int64(stmt.get(), 2)));
+  }
+  if (stats.samples > 0) {
+    save(current_id, stats);
+    ++items;
+  }
+
+  transaction.commit();
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - started);
+  LOG_INFO("Built price stats for {} items from price history in {}ms", items,
+           elapsed.count());
+}
+
+void PriceStatsRepository::save(int wishlist_id,
+                                const domain::PriceStats &stats) {
+  auto &db = DatabaseManager::instance();
+
+  auto stmt = db.prepare(fmt::format(
+      "INSERT OR REPLACE INTO price_stats ({}) "
+      "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+      kColumnList));
+
+  const auto daily_low = encodeDaily(stats.daily_low);
+  const auto daily_high = encodeDaily(stats.daily_high);
+
+  sqlite3_bind_int(stmt.get(), 1, wishlist_id);
+  sqlite3_bind_int64(stmt.get(), 2, stats.all_time_low.cents());
+  sqlite3_bind_int64(stmt.get(), 3, stats.all_time_high.cents());
+  sqlite3_bind_double(stmt.get(), 4, stats.ema_cents);
+  sqlite3_bind_int64(stmt.get(), 5, stats.last_price.cents());
+  sqlite3_bind_int64(stmt.get(), 6, toEpochSeconds(stats.last_change_at));
+  sqlite3_bind_int64(stmt.get(), 7, stats.samples);
+  sqlite3_bind_int64(stmt.get(), 8, stats.last_day);
+  sqlite3_bind_blob(stmt.get(), 9, daily_low.data(),
+                    static_cast<int>(daily_low.size()), SQLITE_TRANSIENT);
+  sqlite3_bind_blob(stmt.get(), 10, daily_high.data(),
+                    static_cast<int>(daily_high.size()), SQLITE_TRANSIENT);
+  sqlite3_bind_int64(stmt.get(), 11, stats.previous_low.cents());
+  sqlite3_bind_int64(stmt.get(), 12, stats.previous_day_low);
+  sqlite3_bind_int64(stmt.get(), 13, stats.previous_day_high);
+
+  if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+    throw DatabaseException(fmt::format("Failed to save price stats: {}",
+                                        sqlite3_errmsg(db.getHandle())));
+  }
+}
+
+} // namespace bluray::infrastructure
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../../domain/price_stats.hpp"
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace bluray::infrastructure {
+
+/**
+ * Per-item running price statistics (price_stats table)
+ * Kept next to price_history: every recorded price updates one row.
+ */
+class PriceStatsRepository {
+public:
+  /**
+   * Fold a new price into the item's statistics
+   * Call in the same transaction as the price history insert, and roll it
+   * back on failure so the statistics never miss a recorded price.
+   * @throws DatabaseException if the statistics cannot be updated
+   */
+  void record(int wishlist_id, domain::Money price,
+              std::chrono::system_clock::time_point at);
+
+  std::optional<domain::PriceStats> find(int wishlist_id);
+
+  /**
+   * Statistics of several items in one query
+   * @return Statistics by wishlist id; items without prices are absent
+   */
+  std::unordered_map<int, domain::PriceStats>
+  find(const std::vector<int> &wishlist_ids);
+
+  /**
+   * Build the statistics from price_history if none exist yet
+   * Done once, for databases that predate the price_stats table.
+   */
+  void backfill();
+
+private:
+  void save(int wishlist_id, const domain::PriceStats &stats);
+};
+
+} // namespace bluray::infrastructure
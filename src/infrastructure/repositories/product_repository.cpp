@@ -0,0 +1,237 @@
+#include "product_repository.hpp"
+#include "../database_manager.hpp"
+#include "../logger.hpp"
+#include "../symbol_dictionary.hpp"
+#include <algorithm>
+#include <fmt/format.h>
+
+namespace bluray::infrastructure {
+
+namespace {
+
+// Columns of a product joined with its best offer (b = product_best_price,
+// w = wishlist row of the best offer)
+constexpr const char *kColumnList =
+    "p.id, p.ean, p.asin, p.title, b.offer_count, b.wishlist_id, w.url, "
+    "w.source_id, b.price_cents";
+
+std::string columnText(sqlite3_stmt *stmt, int column) {
+  const auto *text =
+      reinterpret_cast<const char *>(sqlite3_column_text(stmt, column));
+  return text ? text : "";
+}
+
+void bindOptionalText(sqlite3_stmt *stmt, int index, const std::string &text) {
+  if (text.empty()) {
+    sqlite3_bind_null(stmt, index);
+  } else {
+    sqlite3_bind_text(stmt, index, text.c_str(), -1, SQLITE_TRANSIENT);
+  }
+}
+
+domain::ProductIdentity fromStatement(sqlite3_stmt *stmt) {
+  domain::ProductIdentity product;
+  product.id = sqlite3_column_int(stmt, 0);
+  product.ean = columnText(stmt, 1);
+  product.asin = columnText(stmt, 2);
+  product.title = columnText(stmt, 3);
+  product.offer_count = sqlite3_column_int(stmt, 4);
+
+  if (sqlite3_column_type(stmt, 5) != SQLITE_NULL) {
+    domain::ProductOffer offer;
+    offer.wishlist_id = sqlite3_column_int(stmt, 5);
+    offer.url = columnText(stmt, 6);
+    offer.source = SymbolDictionary::instance().fromDatabaseId(
+        sqlite3_column_int64(stmt, 7));
+    offer.price = domain::Money::fromCents(sqlite3_column_int64(stmt, 8));
+    offer.in_stock = true;
+    product.best_offer = std::move(offer);
+  }
+  return product;
+}
+
+} // anonymous namespace
+
+std::optional<int> ProductRepository::link(int wishlist_id,
+                                           const domain::Product &product) {
+  if (product.ean.empty() && product.asin.empty()) {
+    return std::nullopt;
+  }
+
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  try {
+    const auto product_id = resolve(product);
+    if (!product_id) {
+      return std::nullopt;
+    }
+
+    // Only write on a change: the update fires the change feed triggers
+    auto stmt = db.prepare("UPDATE wishlist SET product_id = ? "
+                           "WHERE id = ? AND product_id IS NOT ?");
+    sqlite3_bind_int(stmt.get(), 1, *product_id);
+    sqlite3_bind_int(stmt.get(), 2, wishlist_id);
+    sqlite3_bind_int(stmt.get(), 3, *product_id);
+    if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+      throw DatabaseException(fmt::format("Failed to link product: {}",
+                                          sqlite3_errmsg(db.getHandle())));
+    }
+    if (sqlite3_changes(db.getHandle()) > 0) {
+      LOG_DEBUG({{"wishlist_id", wishlist_id},
+                 {"product_id", *product_id},
+                 {"ean", product.ean},
+                 {"asin", product.asin}},
+                "Linked wishlist item to product");
+    }
+    return product_id;
+  } catch (const std::exception &e) {
+    LOG_ERROR("Failed to link wishlist item {} to a product: {}", wishlist_id,
+              e.what());
+    return std::nullopt;
+  }
+}
+
+std::optional<int> ProductRepository::resolve(const domain::Product &product) {
+  auto &db = DatabaseManager::instance();
+
+  // EAN first: it is printed on the disc and shared by every retailer
+  const std::pair<const char *, const std::string *> identifiers[] = {
+      {"ean", &product.ean}, {"asin", &product.asin}};
+  for (const auto &[column, value] : identifiers) {
+    if (value->empty()) {
+      continue;
+    }
+    auto stmt = db.prepare(
+        fmt::format("SELECT id FROM products WHERE {} = ?", column));
+    sqlite3_bind_text(stmt.get(), 1, value->c_str(), -1, SQLITE_TRANSIENT);
+    if (sqlite3_step(stmt.get()) != SQLITE_ROW) {
+      continue;
+    }
+    const int id = sqlite3_column_int(stmt.get(), 0);
+
+    // Learn the other identifier, unless another product already has it
+    auto fill = db.prepare(
+        "UPDATE OR IGNORE products SET ean = COALESCE(ean, ?), "
+        "asin = COALESCE(asin, ?) WHERE id = ?");
+    bindOptionalText(fill.get(), 1, product.ean);
+    bindOptionalText(fill.get(), 2, product.asin);
+    sqlite3_bind_int(fill.get(), 3, id);
+    sqlite3_step(fill.get());
+    return id;
+  }
+
+  auto stmt = db.prepare(
+      "INSERT INTO products (ean, asin, title, created_at) "
+      "VALUES (?, ?, ?, strftime('%Y-%m-%d %H:%M:%S', 'now'))");
+  bindOptionalText(stmt.get(), 1, product.ean);
+  bindOptionalText(stmt.get(), 2, product.asin);
+  sqlite3_bind_text(stmt.get(), 3, product.title.c_str(), -1, SQLITE_TRANSIENT);
+  if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+    throw DatabaseException(fmt::format("Failed to add product: {}",
+                                        sqlite3_errmsg(db.getHandle())));
+  }
+  return static_cast<int>(db.lastInsertRowId());
+}
+
+std::optional<domain::ProductIdentity>
+ProductRepository::findById(int id, bool with_offers) {
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  try {
+    auto stmt = db.prepare(fmt::format(
+        "SELECT {} FROM products p "
+        "LEFT JOIN product_best_price b ON b.product_id = p.id "
+        "LEFT JOIN wishlist w ON w.id = b.wishlist_id WHERE p.id = ?",
+        kColumnList));
+    sqlite3_bind_int(stmt.get(), 1, id);
+
+    if (sqlite3_step(stmt.get()) != SQLITE_ROW) {
+      return std::nullopt;
+    }
+    auto product = fromStatement(stmt.get());
+    if (with_offers) {
+      product.offers = findOffers(id);
+    }
+    return product;
+  } catch (const std::exception &e) {
+    LOG_ERROR("Failed to load product {}: {}", id, e.what());
+    return std::nullopt;
+  }
+}
+
+std::optional<domain::ProductIdentity>
+ProductRepository::findByWishlistId(int wishlist_id) {
+  auto products = findByWishlistIds({wishlist_id});
+  auto it = products.find(wishlist_id);
+  if (it == products.end()) {
+    return std::nullopt;
+  }
+  return std::move(it->second);
+}
+
+std::unordered_map<int, domain::ProductIdentity>
+ProductRepository::findByWishlistIds(const std::vector<int> &wishlist_ids) {
+  std::unordered_map<int, domain::ProductIdentity> products;
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  constexpr size_t kChunkSize = 500;
+
+  for (size_t offset = 0; offset < wishlist_ids.size(); offset += kChunkSize) {
+    const size_t count = std::min(kChunkSize, wishlist_ids.size() - offset);
+
+    std::string placeholders;
+    for (size_t i = 0; i < count; ++i) {
+      placeholders += i == 0 ? "?" : ",?";
+    }
+
+    try {
+      // The item's id follows the product columns
+      auto stmt = db.prepare(fmt::format(
+          "SELECT {}, i.id FROM wishlist i "
+          "JOIN products p ON p.id = i.product_id "
+          "LEFT JOIN product_best_price b ON b.product_id = p.id "
+          "LEFT JOIN wishlist w ON w.id = b.wishlist_id WHERE i.id IN ({})",
+          kColumnList, placeholders));
+      for (size_t i = 0; i < count; ++i) {
+        sqlite3_bind_int(stmt.get(), static_cast<int>(i + 1),
+                         wishlist_ids[offset + i]);
+      }
+
+      while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        products.emplace(sqlite3_column_int(stmt.get(), 9),
+                         fromStatement(stmt.get()));
+      }
+    } catch (const std::exception &e) {
+      LOG_ERROR("Failed to load products of wishlist items: {}", e.what());
+    }
+  }
+  return products;
+}
+
+std::vector<domain::ProductOffer> ProductRepository::findOffers(int product_id) {
+  auto &db = DatabaseManager::instance();
+  auto &symbols = SymbolDictionary::instance();
+
+  // Served by idx_wishlist_product; in-stock offers first, then by price
+  auto stmt = db.prepare(
+      "SELECT id, url, source_id, current_price_cents, in_stock FROM wishlist "
+      "WHERE product_id = ? ORDER BY in_stock DESC, current_price_cents, id");
+  sqlite3_bind_int(stmt.get(), 1, product_id);
+
+  std::vector<domain::ProductOffer> offers;
+  while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+    domain::ProductOffer offer;
+    offer.wishlist_id = sqlite3_column_int(stmt.get(), 0);
+    offer.url = columnText(stmt.get(), 1);
+    offer.source = symbols.fromDatabaseId(sqlite3_column_int64(stmt.get(), 2));
+    offer.price = domain::Money::fromCents(sqlite3_column_int64(stmt.get(), 3));
+    offer.in_stock = sqlite3_column_int(stmt.get(), 4) != 0;
+    offers.push_back(std::move(offer));
+  }
+  return offers;
+}
+
+} // namespace bluray::infrastructure
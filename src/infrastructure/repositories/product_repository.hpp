@@ -0,0 +1,49 @@
+#pragma once
+
+#include "../../domain/models.hpp"
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace bluray::infrastructure {
+
+/**
+ * Product identities (products table) and their best offers
+ * (product_best_price, maintained by triggers on the wishlist table)
+ */
+class ProductRepository {
+public:
+  /**
+   * Point a wishlist item at the product with the scraped EAN or ASIN,
+   * creating the product if neither is known yet
+   * Call in the same transaction as the wishlist update.
+   *
+   * @return Product id, or nullopt if the page had no identifier
+   */
+  std::optional<int> link(int wishlist_id, const domain::Product &product);
+
+  /**
+   * Product with its best offer and offer count
+   * @param with_offers Also list every offer, cheapest first
+   */
+  std::optional<domain::ProductIdentity> findById(int id,
+                                                  bool with_offers = false);
+
+  /**
+   * Product a wishlist item belongs to, with its best offer
+   */
+  std::optional<domain::ProductIdentity> findByWishlistId(int wishlist_id);
+
+  /**
+   * Products of several wishlist items in one query
+   * @return Products by wishlist id; unlinked items are absent
+   */
+  std::unordered_map<int, domain::ProductIdentity>
+  findByWishlistIds(const std::vector<int> &wishlist_ids);
+
+private:
+  std::optional<int> resolve(const domain::Product &product);
+  std::vector<domain::ProductOffer> findOffers(int product_id);
+};
+
+} // namespace bluray::infrastructure
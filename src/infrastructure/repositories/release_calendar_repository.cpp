@@ -1,21 +1,30 @@
 #include "release_calendar_repository.hpp"
 #include "../database_manager.hpp"
 #include "../logger.hpp"
+#include "../release_calendar_index.hpp"
+#include "../symbol_dictionary.hpp"
 #include <fmt/format.h>
 #include <iomanip>
 #include <sstream>
 
 namespace bluray::infrastructure::repositories {
 
+// Helper constant for consistent column ordering (see fromStatement)
+static const std::string kColumnList =
+    "id, title, release_date, format_id, studio, image_url, "
+    "local_image_path, product_url, is_uhd_4k, is_preorder, price_cents, notes, "
+    "created_at, last_updated";
+
 int SqliteReleaseCalendarRepository::add(
     const domain::ReleaseCalendarItem &item) {
   auto &db = DatabaseManager::instance();
   auto lock = db.lock();
+  auto &symbols = SymbolDictionary::instance();
 
   auto stmt = db.prepare(R"(
         INSERT INTO release_calendar (
-            title, release_date, format, studio, image_url, local_image_path,
-            product_url, is_uhd_4k, is_preorder, price, notes, created_at, last_updated
+            title, release_date, format_id, studio, image_url, local_image_path,
+            product_url, is_uhd_4k, is_preorder, price_cents, notes, created_at, last_updated
         ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
     )");
 
@@ -26,7 +35,7 @@ int SqliteReleaseCalendarRepository::add(
   sqlite3_bind_text(stmt.get(), 1, item.title.c_str(), -1, SQLITE_TRANSIENT);
   sqlite3_bind_text(stmt.get(), 2, release_date_str.c_str(), -1,
                     SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt.get(), 3, item.format.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int64(stmt.get(), 3, symbols.toDatabaseId(item.format));
   sqlite3_bind_text(stmt.get(), 4, item.studio.c_str(), -1, SQLITE_TRANSIENT);
   sqlite3_bind_text(stmt.get(), 5, item.image_url.c_str(), -1,
                     SQLITE_TRANSIENT);
@@ -36,7 +45,7 @@ int SqliteReleaseCalendarRepository::add(
                     SQLITE_TRANSIENT);
   sqlite3_bind_int(stmt.get(), 8, item.is_uhd_4k ? 1 : 0);
   sqlite3_bind_int(stmt.get(), 9, item.is_preorder ? 1 : 0);
-  sqlite3_bind_double(stmt.get(), 10, item.price);
+  sqlite3_bind_int64(stmt.get(), 10, item.price.cents());
   sqlite3_bind_text(stmt.get(), 11, item.notes.c_str(), -1, SQLITE_TRANSIENT);
   sqlite3_bind_text(stmt.get(), 12, created_at_str.c_str(), -1,
                     SQLITE_TRANSIENT);
@@ -44,12 +53,12 @@ int SqliteReleaseCalendarRepository::add(
                     SQLITE_TRANSIENT);
 
   if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
-    Logger::instance().error(
-        fmt::format("Failed to insert release calendar item: {}",
-                    sqlite3_errmsg(db.getHandle())));
+    LOG_ERROR("Failed to insert release calendar item: {}",
+              sqlite3_errmsg(db.getHandle()));
     return -1;
   }
 
+  ReleaseCalendarIndex::instance().invalidate();
   return static_cast<int>(db.lastInsertRowId());
 }
 
@@ -57,12 +66,13 @@ bool SqliteReleaseCalendarRepository::update(
     const domain::ReleaseCalendarItem &item) {
   auto &db = DatabaseManager::instance();
   auto lock = db.lock();
+  auto &symbols = SymbolDictionary::instance();
 
   auto stmt = db.prepare(R"(
         UPDATE release_calendar SET
-            title = ?, release_date = ?, format = ?, studio = ?, image_url = ?,
+            title = ?, release_date = ?, format_id = ?, studio = ?, image_url = ?,
             local_image_path = ?, product_url = ?, is_uhd_4k = ?, is_preorder = ?,
-            price = ?, notes = ?, last_updated = ?
+            price_cents = ?, notes = ?, last_updated = ?
         WHERE id = ?
     )");
 
@@ -72,7 +82,7 @@ bool SqliteReleaseCalendarRepository::update(
   sqlite3_bind_text(stmt.get(), 1, item.title.c_str(), -1, SQLITE_TRANSIENT);
   sqlite3_bind_text(stmt.get(), 2, release_date_str.c_str(), -1,
                     SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt.get(), 3, item.format.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int64(stmt.get(), 3, symbols.toDatabaseId(item.format));
   sqlite3_bind_text(stmt.get(), 4, item.studio.c_str(), -1, SQLITE_TRANSIENT);
   sqlite3_bind_text(stmt.get(), 5, item.image_url.c_str(), -1,
                     SQLITE_TRANSIENT);
@@ -82,13 +92,17 @@ bool SqliteReleaseCalendarRepository::update(
                     SQLITE_TRANSIENT);
   sqlite3_bind_int(stmt.get(), 8, item.is_uhd_4k ? 1 : 0);
   sqlite3_bind_int(stmt.get(), 9, item.is_preorder ? 1 : 0);
-  sqlite3_bind_double(stmt.get(), 10, item.price);
+  sqlite3_bind_int64(stmt.get(), 10, item.price.cents());
   sqlite3_bind_text(stmt.get(), 11, item.notes.c_str(), -1, SQLITE_TRANSIENT);
   sqlite3_bind_text(stmt.get(), 12, last_updated_str.c_str(), -1,
                     SQLITE_TRANSIENT);
   sqlite3_bind_int(stmt.get(), 13, item.id);
 
-  return sqlite3_step(stmt.get()) == SQLITE_DONE;
+  if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+    return false;
+  }
+  ReleaseCalendarIndex::instance().invalidate();
+  return true;
 }
 
 bool SqliteReleaseCalendarRepository::remove(int id) {
@@ -98,7 +112,11 @@ bool SqliteReleaseCalendarRepository::remove(int id) {
   auto stmt = db.prepare("DELETE FROM release_calendar WHERE id = ?");
   sqlite3_bind_int(stmt.get(), 1, id);
 
-  return sqlite3_step(stmt.get()) == SQLITE_DONE;
+  if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+    return false;
+  }
+  ReleaseCalendarIndex::instance().invalidate();
+  return true;
 }
 
 std::optional<domain::ReleaseCalendarItem>
@@ -106,7 +124,8 @@ SqliteReleaseCalendarRepository::findById(int id) {
   auto &db = DatabaseManager::instance();
   auto lock = db.lock();
 
-  auto stmt = db.prepare("SELECT * FROM release_calendar WHERE id = ?");
+  auto stmt = db.prepare(
+      fmt::format("SELECT {} FROM release_calendar WHERE id = ?", kColumnList));
   sqlite3_bind_int(stmt.get(), 1, id);
 
   if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
@@ -121,8 +140,8 @@ SqliteReleaseCalendarRepository::findByUrl(std::string_view url) {
   auto &db = DatabaseManager::instance();
   auto lock = db.lock();
 
-  auto stmt =
-      db.prepare("SELECT * FROM release_calendar WHERE product_url = ?");
+  auto stmt = db.prepare(fmt::format(
+      "SELECT {} FROM release_calendar WHERE product_url = ?", kColumnList));
   sqlite3_bind_text(stmt.get(), 1, std::string(url).c_str(), -1,
                     SQLITE_TRANSIENT);
 
@@ -138,8 +157,8 @@ SqliteReleaseCalendarRepository::findAll() {
   auto &db = DatabaseManager::instance();
   auto lock = db.lock();
 
-  auto stmt =
-      db.prepare("SELECT * FROM release_calendar ORDER BY release_date ASC");
+  auto stmt = db.prepare(fmt::format(
+      "SELECT {} FROM release_calendar ORDER BY release_date ASC", kColumnList));
 
   std::vector<domain::ReleaseCalendarItem> items;
   while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
@@ -160,8 +179,9 @@ SqliteReleaseCalendarRepository::findAll(
   result.page_size = params.page_size;
   result.total_count = count();
 
-  auto stmt = db.prepare("SELECT * FROM release_calendar ORDER BY release_date "
-                         "ASC LIMIT ? OFFSET ?");
+  auto stmt = db.prepare(fmt::format("SELECT {} FROM release_calendar ORDER BY "
+                                     "release_date ASC LIMIT ? OFFSET ?",
+                                     kColumnList));
   sqlite3_bind_int(stmt.get(), 1, params.limit());
   sqlite3_bind_int(stmt.get(), 2, params.offset());
 
@@ -179,8 +199,10 @@ SqliteReleaseCalendarRepository::findByDateRange(
   auto &db = DatabaseManager::instance();
   auto lock = db.lock();
 
-  auto stmt = db.prepare("SELECT * FROM release_calendar WHERE release_date >= "
-                         "? AND release_date <= ? ORDER BY release_date ASC");
+  auto stmt = db.prepare(fmt::format(
+      "SELECT {} FROM release_calendar WHERE release_date >= ? AND "
+      "release_date <= ? ORDER BY release_date ASC",
+      kColumnList));
 
   const auto start_str = timePointToString(start);
   const auto end_str = timePointToString(end);
@@ -220,6 +242,7 @@ int SqliteReleaseCalendarRepository::removeOlderThan(
   sqlite3_bind_text(stmt.get(), 1, cutoff_str.c_str(), -1, SQLITE_TRANSIENT);
 
   if (sqlite3_step(stmt.get()) == SQLITE_DONE) {
+    ReleaseCalendarIndex::instance().invalidate();
     return sqlite3_changes(db.getHandle());
   }
 
@@ -237,7 +260,8 @@ SqliteReleaseCalendarRepository::fromStatement(sqlite3_stmt *stmt) {
       reinterpret_cast<const char *>(sqlite3_column_text(stmt, 2));
   item.release_date = stringToTimePoint(release_date);
 
-  item.format = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3));
+  auto &symbols = SymbolDictionary::instance();
+  item.format = symbols.fromDatabaseId(sqlite3_column_int64(stmt, 3));
 
   if (const char *studio =
           reinterpret_cast<const char *>(sqlite3_column_text(stmt, 4))) {
@@ -258,7 +282,7 @@ SqliteReleaseCalendarRepository::fromStatement(sqlite3_stmt *stmt) {
 
   item.is_uhd_4k = sqlite3_column_int(stmt, 8) != 0;
   item.is_preorder = sqlite3_column_int(stmt, 9) != 0;
-  item.price = sqlite3_column_double(stmt, 10);
+  item.price = domain::Money::fromCents(sqlite3_column_int64(stmt, 10));
 
   if (const char *notes =
           reinterpret_cast<const char *>(sqlite3_column_text(stmt, 11))) {
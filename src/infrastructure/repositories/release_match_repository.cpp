@@ -0,0 +1,203 @@
+#include "release_match_repository.hpp"
+#include "../database_manager.hpp"
+#include "../logger.hpp"
+#include "../symbol_dictionary.hpp"
+#include <algorithm>
+#include <fmt/format.h>
+
+namespace bluray::infrastructure {
+
+namespace {
+
+std::string columnText(sqlite3_stmt *stmt, int column) {
+  const auto *text =
+      reinterpret_cast<const char *>(sqlite3_column_text(stmt, column));
+  return text ? text : "";
+}
+
+// Columns of a match joined with its release (r) and item (i)
+constexpr const char *kColumnList =
+    "m.release_id, m.item_type, m.item_id, m.score, r.title, r.release_date, "
+    "r.format_id, r.is_uhd_4k, i.title";
+
+domain::ReleaseMatch fromStatement(sqlite3_stmt *stmt) {
+  domain::ReleaseMatch match;
+  match.release_id = sqlite3_column_int(stmt, 0);
+  match.item_type = columnText(stmt, 1);
+  match.item_id = sqlite3_column_int(stmt, 2);
+  match.score = sqlite3_column_double(stmt, 3);
+  match.release_title = columnText(stmt, 4);
+  match.release_date = columnText(stmt, 5);
+  match.format =
+      SymbolDictionary::instance().fromDatabaseId(sqlite3_column_int64(stmt, 6));
+  match.is_uhd_4k = sqlite3_column_int(stmt, 7) != 0;
+  match.item_title = columnText(stmt, 8);
+  return match;
+}
+
+// Ids bound per IN list, well below SQLITE_MAX_VARIABLE_NUMBER
+constexpr size_t kChunkSize = 500;
+
+// "?<first>,?<first + 1>,..." so that a list can appear twice in a query
+std::string placeholders(size_t count, size_t first) {
+  std::string list;
+  for (size_t i = 0; i < count; ++i) {
+    list += fmt::format(i == 0 ? "?{}" : ",?{}", first + i);
+  }
+  return list;
+}
+
+} // anonymous namespace
+
+std::vector<MatchableTitle>
+ReleaseMatchRepository::findTitles(std::string_view table) {
+  std::vector<MatchableTitle> titles;
+  if (table != "release_calendar" && table != "wishlist" &&
+      table != "collection") {
+    return titles;
+  }
+
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  try {
+    auto stmt = db.prepare(fmt::format("SELECT id, title FROM {}", table));
+    while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+      titles.push_back(
+          {sqlite3_column_int(stmt.get(), 0), columnText(stmt.get(), 1)});
+    }
+  } catch (const std::exception &e) {
+    LOG_ERROR("Failed to load {} titles: {}", table, e.what());
+  }
+  return titles;
+}
+
+void ReleaseMatchRepository::replaceAll(
+    const std::vector<domain::ReleaseMatch> &matches) {
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  try {
+    WriteTransaction transaction(db);
+    db.execute("DELETE FROM release_matches");
+
+    auto stmt = db.prepare(
+        "INSERT OR REPLACE INTO release_matches "
+        "(release_id, item_type, item_id, score) VALUES (?, ?, ?, ?)");
+    for (const auto &match : matches) {
+      sqlite3_reset(stmt.get());
+      sqlite3_bind_int(stmt.get(), 1, match.release_id);
+      sqlite3_bind_text(stmt.get(), 2, match.item_type.c_str(), -1,
+                        SQLITE_TRANSIENT);
+      sqlite3_bind_int(stmt.get(), 3, match.item_id);
+      sqlite3_bind_double(stmt.get(), 4, match.score);
+      if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
+        throw DatabaseException(fmt::format("Failed to save release match: {}",
+                                            sqlite3_errmsg(db.getHandle())));
+      }
+    }
+
+    transaction.commit();
+  } catch (const std::exception &e) {
+    LOG_ERROR("Failed to replace release matches: {}", e.what());
+  }
+}
+
+std::vector<domain::ReleaseMatch>
+ReleaseMatchRepository::findByRelease(int release_id) {
+  auto matches = findByReleases({release_id});
+  auto it = matches.find(release_id);
+  return it != matches.end() ? std::move(it->second)
+                             : std::vector<domain::ReleaseMatch>{};
+}
+
+std::unordered_map<int, std::vector<domain::ReleaseMatch>>
+ReleaseMatchRepository::findByReleases(const std::vector<int> &release_ids) {
+  std::unordered_map<int, std::vector<domain::ReleaseMatch>> matches;
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  for (size_t offset = 0; offset < release_ids.size(); offset += kChunkSize) {
+    const size_t count = std::min(kChunkSize, release_ids.size() - offset);
+    const auto ids = placeholders(count, 1);
+
+    try {
+      // Each item type joins its own table
+      auto stmt = db.prepare(fmt::format(
+          "SELECT {0} FROM release_matches m "
+          "JOIN release_calendar r ON r.id = m.release_id "
+          "JOIN wishlist i ON m.item_type = 'wishlist' AND i.id = m.item_id "
+          "WHERE m.release_id IN ({1}) "
+          "UNION ALL SELECT {0} FROM release_matches m "
+          "JOIN release_calendar r ON r.id = m.release_id "
+          "JOIN collection i ON m.item_type = 'collection' "
+          "AND i.id = m.item_id "
+          "WHERE m.release_id IN ({1}) ORDER BY 1, 4 DESC",
+          kColumnList, ids));
+      for (size_t i = 0; i < count; ++i) {
+        sqlite3_bind_int(stmt.get(), static_cast<int>(i + 1),
+                         release_ids[offset + i]);
+      }
+
+      while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        auto match = fromStatement(stmt.get());
+        matches[match.release_id].push_back(std::move(match));
+      }
+    } catch (const std::exception &e) {
+      LOG_ERROR("Failed to load release matches: {}", e.what());
+    }
+  }
+  return matches;
+}
+
+std::vector<domain::ReleaseMatch>
+ReleaseMatchRepository::findByItem(std::string_view item_type, int item_id) {
+  auto matches = findByItems(item_type, {item_id});
+  auto it = matches.find(item_id);
+  return it != matches.end() ? std::move(it->second)
+                             : std::vector<domain::ReleaseMatch>{};
+}
+
+std::unordered_map<int, std::vector<domain::ReleaseMatch>>
+ReleaseMatchRepository::findByItems(std::string_view item_type,
+                                    const std::vector<int> &item_ids) {
+  std::unordered_map<int, std::vector<domain::ReleaseMatch>> matches;
+  if (item_type != "wishlist" && item_type != "collection") {
+    return matches;
+  }
+
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  for (size_t offset = 0; offset < item_ids.size(); offset += kChunkSize) {
+    const size_t count = std::min(kChunkSize, item_ids.size() - offset);
+
+    try {
+      // Served by idx_release_matches_item
+      auto stmt = db.prepare(fmt::format(
+          "SELECT {} FROM release_matches m "
+          "JOIN release_calendar r ON r.id = m.release_id "
+          "JOIN {} i ON i.id = m.item_id "
+          "WHERE m.item_type = ?1 AND m.item_id IN ({}) "
+          "ORDER BY m.item_id, r.release_date",
+          kColumnList, item_type, placeholders(count, 2)));
+      sqlite3_bind_text(stmt.get(), 1, item_type.data(),
+                        static_cast<int>(item_type.size()), SQLITE_TRANSIENT);
+      for (size_t i = 0; i < count; ++i) {
+        sqlite3_bind_int(stmt.get(), static_cast<int>(i + 2),
+                         item_ids[offset + i]);
+      }
+
+      while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+        auto match = fromStatement(stmt.get());
+        matches[match.item_id].push_back(std::move(match));
+      }
+    } catch (const std::exception &e) {
+      LOG_ERROR("Failed to load release matches of {} items: {}", item_type,
+                e.what());
+    }
+  }
+  return matches;
+}
+
+} // namespace bluray::infrastructure
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../../domain/models.hpp"
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace bluray::infrastructure {
+
+/**
+ * Title of a release, wishlist or collection row, for matching
+ */
+struct MatchableTitle {
+  int id{0};
+  std::string title;
+};
+
+/**
+ * Links between upcoming releases and wishlist or collection items
+ * (release_matches table)
+ */
+class ReleaseMatchRepository {
+public:
+  /**
+   * Ids and titles of a table ("release_calendar", "wishlist" or
+   * "collection")
+   */
+  std::vector<MatchableTitle> findTitles(std::string_view table);
+
+  /**
+   * Replace every match in one transaction
+   */
+  void replaceAll(const std::vector<domain::ReleaseMatch> &matches);
+
+  /**
+   * Items matching a release, best match first
+   */
+  std::vector<domain::ReleaseMatch> findByRelease(int release_id);
+
+  /**
+   * Items matching each of the given releases, best match first, in one
+   * query per 500 ids (releases without matches are absent)
+   */
+  std::unordered_map<int, std::vector<domain::ReleaseMatch>>
+  findByReleases(const std::vector<int> &release_ids);
+
+  /**
+   * Upcoming releases matching an item, soonest first
+   */
+  std::vector<domain::ReleaseMatch> findByItem(std::string_view item_type,
+                                               int item_id);
+
+  /**
+   * Upcoming releases matching each of the given items of one type,
+   * soonest first (items without matches are absent)
+   */
+  std::unordered_map<int, std::vector<domain::ReleaseMatch>>
+  findByItems(std::string_view item_type, const std::vector<int> &item_ids);
+};
+
+} // namespace bluray::infrastructure
@@ -17,8 +17,7 @@ int SqliteTagRepository::add(const domain::Tag &tag) {
   sqlite3_bind_text(stmt.get(), 2, tag.color.c_str(), -1, SQLITE_TRANSIENT);
 
   if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
-    Logger::instance().error(fmt::format("Failed to insert tag: {}",
-                                         sqlite3_errmsg(db.getHandle())));
+    LOG_ERROR("Failed to insert tag: {}", sqlite3_errmsg(db.getHandle()));
     return -1;
   }
 
@@ -174,6 +173,27 @@ SqliteTagRepository::getItemIdsForTag(int tag_id, const std::string &item_type)
   return item_ids;
 }
 
+std::unordered_map<int, std::vector<int>>
+SqliteTagRepository::getTagIdsByItem(const std::string &item_type) {
+  auto &db = DatabaseManager::instance();
+  auto lock = db.lock();
+
+  auto stmt = db.prepare(R"(
+        SELECT item_id, tag_id FROM item_tags
+        WHERE item_type = ?
+    )");
+
+  sqlite3_bind_text(stmt.get(), 1, item_type.c_str(), -1, SQLITE_TRANSIENT);
+
+  std::unordered_map<int, std::vector<int>> tag_ids;
+  while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+    tag_ids[sqlite3_column_int(stmt.get(), 0)].push_back(
+        sqlite3_column_int(stmt.get(), 1));
+  }
+
+  return tag_ids;
+}
+
 domain::Tag SqliteTagRepository::fromStatement(sqlite3_stmt *stmt) {
   domain::Tag tag;
   tag.id = sqlite3_column_int(stmt, 0);
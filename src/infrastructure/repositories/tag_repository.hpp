@@ -4,6 +4,7 @@
 #include <optional>
 #include <sqlite3.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace bluray::infrastructure::repositories {
@@ -31,6 +32,10 @@ public:
                                                   const std::string &item_type) = 0;
   virtual std::vector<int> getItemIdsForTag(int tag_id,
                                             const std::string &item_type) = 0;
+
+  // Tag ids of every tagged item of a type, keyed by item id
+  virtual std::unordered_map<int, std::vector<int>>
+  getTagIdsByItem(const std::string &item_type) = 0;
 };
 
 /**
@@ -53,6 +58,8 @@ public:
                                           const std::string &item_type) override;
   std::vector<int> getItemIdsForTag(int tag_id,
                                     const std::string &item_type) override;
+  std::unordered_map<int, std::vector<int>>
+  getTagIdsByItem(const std::string &item_type) override;
 
 private:
   static domain::Tag fromStatement(sqlite3_stmt *stmt);
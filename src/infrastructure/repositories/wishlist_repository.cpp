@@ -2,6 +2,7 @@
 #include "../database_manager.hpp"
 #include "../input_validation.hpp"
 #include "../logger.hpp"
+#include "../symbol_dictionary.hpp"
 #include <fmt/format.h>
 #include <iomanip>
 #include <sstream>
@@ -17,13 +18,14 @@ using validation::VALID_STOCK_FILTERS;
 int SqliteWishlistRepository::add(const domain::WishlistItem &item) {
   auto &db = DatabaseManager::instance();
   auto lock = db.lock();
+  auto &symbols = SymbolDictionary::instance();
 
   auto stmt = db.prepare(R"(
         INSERT INTO wishlist (
-            url, title, title_locked, current_price, desired_max_price, in_stock, is_uhd_4k,
-            image_url, local_image_path, source, notify_on_price_drop, notify_on_stock,
+            url, title, title_locked, current_price_cents, desired_max_price_cents, in_stock, is_uhd_4k,
+            image_url, local_image_path, source_id, notify_on_price_drop, notify_on_stock,
             created_at, last_checked, tmdb_id, imdb_id, tmdb_rating, trailer_key,
-            edition_type, has_slipcover, has_digital_copy, bonus_features
+            edition_type_id, has_slipcover, has_digital_copy, bonus_features
         ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
     )");
 
@@ -33,15 +35,15 @@ int SqliteWishlistRepository::add(const domain::WishlistItem &item) {
   sqlite3_bind_text(stmt.get(), 1, item.url.c_str(), -1, SQLITE_TRANSIENT);
   sqlite3_bind_text(stmt.get(), 2, item.title.c_str(), -1, SQLITE_TRANSIENT);
   sqlite3_bind_int(stmt.get(), 3, item.title_locked ? 1 : 0);
-  sqlite3_bind_double(stmt.get(), 4, item.current_price);
-  sqlite3_bind_double(stmt.get(), 5, item.desired_max_price);
+  sqlite3_bind_int64(stmt.get(), 4, item.current_price.cents());
+  sqlite3_bind_int64(stmt.get(), 5, item.desired_max_price.cents());
   sqlite3_bind_int(stmt.get(), 6, item.in_stock ? 1 : 0);
   sqlite3_bind_int(stmt.get(), 7, item.is_uhd_4k ? 1 : 0);
   sqlite3_bind_text(stmt.get(), 8, item.image_url.c_str(), -1,
                     SQLITE_TRANSIENT);
   sqlite3_bind_text(stmt.get(), 9, item.local_image_path.c_str(), -1,
                     SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt.get(), 10, item.source.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int64(stmt.get(), 10, symbols.toDatabaseId(item.source));
   sqlite3_bind_int(stmt.get(), 11, item.notify_on_price_drop ? 1 : 0);
   sqlite3_bind_int(stmt.get(), 12, item.notify_on_stock ? 1 : 0);
   sqlite3_bind_text(stmt.get(), 13, created_at_str.c_str(), -1,
@@ -53,16 +55,15 @@ int SqliteWishlistRepository::add(const domain::WishlistItem &item) {
   sqlite3_bind_double(stmt.get(), 17, item.tmdb_rating);
   sqlite3_bind_text(stmt.get(), 18, item.trailer_key.c_str(), -1,
                     SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt.get(), 19, item.edition_type.c_str(), -1,
-                    SQLITE_TRANSIENT);
+  sqlite3_bind_int64(stmt.get(), 19, symbols.toDatabaseId(item.edition_type));
   sqlite3_bind_int(stmt.get(), 20, item.has_slipcover ? 1 : 0);
   sqlite3_bind_int(stmt.get(), 21, item.has_digital_copy ? 1 : 0);
   sqlite3_bind_text(stmt.get(), 22, item.bonus_features.c_str(), -1,
                     SQLITE_TRANSIENT);
 
   if (sqlite3_step(stmt.get()) != SQLITE_DONE) {
-    Logger::instance().error(fmt::format("Failed to insert wishlist item: {}",
-                                         sqlite3_errmsg(db.getHandle())));
+    LOG_ERROR("Failed to insert wishlist item: {}",
+              sqlite3_errmsg(db.getHandle()));
     return -1;
   }
 
@@ -72,14 +73,15 @@ int SqliteWishlistRepository::add(const domain::WishlistItem &item) {
 bool SqliteWishlistRepository::update(const domain::WishlistItem &item) {
   auto &db = DatabaseManager::instance();
   auto lock = db.lock();
+  auto &symbols = SymbolDictionary::instance();
 
   auto stmt = db.prepare(R"(
         UPDATE wishlist SET
-            title = ?, title_locked = ?, current_price = ?, desired_max_price = ?, in_stock = ?,
-            is_uhd_4k = ?, image_url = ?, local_image_path = ?, source = ?,
+            title = ?, title_locked = ?, current_price_cents = ?, desired_max_price_cents = ?, in_stock = ?,
+            is_uhd_4k = ?, image_url = ?, local_image_path = ?, source_id = ?,
             notify_on_price_drop = ?, notify_on_stock = ?, last_checked = ?,
             tmdb_id = ?, imdb_id = ?, tmdb_rating = ?, trailer_key = ?,
-            edition_type = ?, has_slipcover = ?, has_digital_copy = ?, bonus_features = ?
+            edition_type_id = ?, has_slipcover = ?, has_digital_copy = ?, bonus_features = ?
         WHERE id = ?
     )");
 
@@ -87,15 +89,15 @@ bool SqliteWishlistRepository::update(const domain::WishlistItem &item) {
 
   sqlite3_bind_text(stmt.get(), 1, item.title.c_str(), -1, SQLITE_TRANSIENT);
   sqlite3_bind_int(stmt.get(), 2, item.title_locked ? 1 : 0);
-  sqlite3_bind_double(stmt.get(), 3, item.current_price);
-  sqlite3_bind_double(stmt.get(), 4, item.desired_max_price);
+  sqlite3_bind_int64(stmt.get(), 3, item.current_price.cents());
+  sqlite3_bind_int64(stmt.get(), 4, item.desired_max_price.cents());
   sqlite3_bind_int(stmt.get(), 5, item.in_stock ? 1 : 0);
   sqlite3_bind_int(stmt.get(), 6, item.is_uhd_4k ? 1 : 0);
   sqlite3_bind_text(stmt.get(), 7, item.image_url.c_str(), -1,
                     SQLITE_TRANSIENT);
   sqlite3_bind_text(stmt.get(), 8, item.local_image_path.c_str(), -1,
                     SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt.get(), 9, item.source.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int64(stmt.get(), 9, symbols.toDatabaseId(item.source));
   sqlite3_bind_int(stmt.get(), 10, item.notify_on_price_drop ? 1 : 0);
   sqlite3_bind_int(stmt.get(), 11, item.notify_on_stock ? 1 : 0);
   sqlite3_bind_text(stmt.get(), 12, last_checked_str.c_str(), -1,
@@ -105,8 +107,7 @@ bool SqliteWishlistRepository::update(const domain::WishlistItem &item) {
   sqlite3_bind_double(stmt.get(), 15, item.tmdb_rating);
   sqlite3_bind_text(stmt.get(), 16, item.trailer_key.c_str(), -1,
                     SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt.get(), 17, item.edition_type.c_str(), -1,
-                    SQLITE_TRANSIENT);
+  sqlite3_bind_int64(stmt.get(), 17, symbols.toDatabaseId(item.edition_type));
   sqlite3_bind_int(stmt.get(), 18, item.has_slipcover ? 1 : 0);
   sqlite3_bind_int(stmt.get(), 19, item.has_digital_copy ? 1 : 0);
   sqlite3_bind_text(stmt.get(), 20, item.bonus_features.c_str(), -1,
@@ -118,12 +119,13 @@ bool SqliteWishlistRepository::update(const domain::WishlistItem &item) {
 
 // Helper constant for consistent column ordering
 static const std::string kColumnList =
-    "id, url, title, title_locked, current_price, desired_max_price, in_stock, "
+    "id, url, title, title_locked, current_price_cents, "
+    "desired_max_price_cents, in_stock, "
     "is_uhd_4k, "
-    "image_url, local_image_path, source, notify_on_price_drop, "
+    "image_url, local_image_path, source_id, notify_on_price_drop, "
     "notify_on_stock, "
     "created_at, last_checked, tmdb_id, imdb_id, tmdb_rating, trailer_key, "
-    "edition_type, has_slipcover, has_digital_copy, bonus_features";
+    "edition_type_id, has_slipcover, has_digital_copy, bonus_features";
 
 bool SqliteWishlistRepository::remove(int id) {
   auto &db = DatabaseManager::instance();
@@ -201,9 +203,8 @@ SqliteWishlistRepository::findAll(const domain::PaginationParams &params) {
     std::string filter_stock_lower;
     if (!isValidValueNormalized(params.filter_stock, VALID_STOCK_FILTERS,
                                 filter_stock_lower)) {
-      Logger::instance().warning(
-          fmt::format("Invalid filter_stock value: {}",
-                      sanitizeForLog(params.filter_stock)));
+      LOG_WARNING("Invalid filter_stock value: {}",
+                  sanitizeForLog(params.filter_stock));
     } else {
       if (filter_stock_lower == "in_stock") {
         conditions.push_back("in_stock = 1");
@@ -215,8 +216,11 @@ SqliteWishlistRepository::findAll(const domain::PaginationParams &params) {
 
   // filter_source and search_query use parameterized queries (safe)
   if (!params.filter_source.empty()) {
-    conditions.push_back("source = ?");
-    bind_params.push_back(params.filter_source);
+    // Compare ids; a source that was never stored matches nothing
+    const auto source_id =
+        SymbolDictionary::instance().findDatabaseId(params.filter_source);
+    conditions.push_back("source_id = ?");
+    bind_params.push_back(std::to_string(source_id.value_or(-1)));
   }
 
   if (!params.search_query.empty()) {
@@ -230,9 +234,8 @@ SqliteWishlistRepository::findAll(const domain::PaginationParams &params) {
     std::string sort_by_lower;
     if (!isValidValueNormalized(params.sort_by, VALID_SORT_FIELDS,
                                 sort_by_lower)) {
-      Logger::instance().warning(
-          fmt::format("Invalid sort_by value: {}, using default",
-                      sanitizeForLog(params.sort_by)));
+      LOG_WARNING("Invalid sort_by value: {}, using default",
+                  sanitizeForLog(params.sort_by));
     } else {
       // Validate sort_order
       std::string direction = "DESC";
@@ -240,9 +243,8 @@ SqliteWishlistRepository::findAll(const domain::PaginationParams &params) {
         std::string sort_order_lower;
         if (!isValidValueNormalized(params.sort_order, VALID_SORT_ORDERS,
                                     sort_order_lower)) {
-          Logger::instance().warning(
-              fmt::format("Invalid sort_order value: {}, using DESC",
-                          sanitizeForLog(params.sort_order)));
+          LOG_WARNING("Invalid sort_order value: {}, using DESC",
+                      sanitizeForLog(params.sort_order));
         } else {
           direction = (sort_order_lower == "desc") ? "DESC" : "ASC";
         }
@@ -250,7 +252,7 @@ SqliteWishlistRepository::findAll(const domain::PaginationParams &params) {
 
       // Build ORDER BY clause with validated values
       if (sort_by_lower == "price") {
-        order_clause = "ORDER BY current_price " + direction;
+        order_clause = "ORDER BY current_price_cents " + direction;
       } else if (sort_by_lower == "title") {
         order_clause = "ORDER BY title " + direction;
       } else if (sort_by_lower == "date") {
@@ -321,8 +323,9 @@ SqliteWishlistRepository::fromStatement(sqlite3_stmt *stmt) {
   item.url = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1));
   item.title = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 2));
   item.title_locked = sqlite3_column_int(stmt, 3) != 0;
-  item.current_price = sqlite3_column_double(stmt, 4);
-  item.desired_max_price = sqlite3_column_double(stmt, 5);
+  item.current_price = domain::Money::fromCents(sqlite3_column_int64(stmt, 4));
+  item.desired_max_price =
+      domain::Money::fromCents(sqlite3_column_int64(stmt, 5));
   item.in_stock = sqlite3_column_int(stmt, 6) != 0;
   item.is_uhd_4k = sqlite3_column_int(stmt, 7) != 0;
 
@@ -335,7 +338,8 @@ SqliteWishlistRepository::fromStatement(sqlite3_stmt *stmt) {
     item.local_image_path = local_path;
   }
 
-  item.source = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 10));
+  auto &symbols = SymbolDictionary::instance();
+  item.source = symbols.fromDatabaseId(sqlite3_column_int64(stmt, 10));
   item.notify_on_price_drop = sqlite3_column_int(stmt, 11) != 0;
   item.notify_on_stock = sqlite3_column_int(stmt, 12) != 0;
 
@@ -360,10 +364,7 @@ SqliteWishlistRepository::fromStatement(sqlite3_stmt *stmt) {
   }
 
   // Edition & bonus features fields
-  if (const char *edition_type =
-          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 19))) {
-    item.edition_type = edition_type;
-  }
+  item.edition_type = symbols.fromDatabaseId(sqlite3_column_int64(stmt, 19));
   item.has_slipcover = sqlite3_column_int(stmt, 20) != 0;
   item.has_digital_copy = sqlite3_column_int(stmt, 21) != 0;
   if (const char *bonus_features =
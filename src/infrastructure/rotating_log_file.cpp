@@ -0,0 +1,215 @@
+#include "rotating_log_file.hpp"
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <fmt/format.h>
+#include <iostream>
+#include <vector>
+#include <zlib.h>
+
+namespace bluray::infrastructure {
+
+namespace fs = std::filesystem;
+
+RotatingLogFile::~RotatingLogFile() { close(); }
+
+bool RotatingLogFile::open(std::string_view path, LogRotationOptions options) {
+  close();
+
+  path_ = std::string(path);
+  options_ = options;
+
+  file_.open(path_, std::ios::app | std::ios::binary);
+  if (!file_.is_open()) {
+    return false;
+  }
+
+  std::error_code ec;
+  const auto existing = fs::file_size(path_, ec);
+  size_ = ec ? 0 : static_cast<size_t>(existing);
+
+  {
+    std::lock_guard<std::mutex> lock(compress_mutex_);
+    compress_stopping_ = false;
+  }
+  if (options_.max_file_size > 0) {
+    compressor_ = std::thread(&RotatingLogFile::compressLoop, this);
+  }
+
+  return true;
+}
+
+void RotatingLogFile::write(std::string_view data) {
+  if (!file_.is_open() || data.empty()) {
+    return;
+  }
+
+  if (options_.max_file_size > 0 && size_ > 0 &&
+      size_ + data.size() > options_.max_file_size) {
+    rotate();
+  }
+
+  file_.write(data.data(), static_cast<std::streamsize>(data.size()));
+  size_ += data.size();
+}
+
+void RotatingLogFile::flush() {
+  if (file_.is_open()) {
+    file_.flush();
+  }
+}
+
+void RotatingLogFile::close() {
+  if (file_.is_open()) {
+    file_.close();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(compress_mutex_);
+    compress_stopping_ = true;
+  }
+  compress_cv_.notify_one();
+
+  if (compressor_.joinable()) {
+    compressor_.join();
+  }
+}
+
+void RotatingLogFile::rotate() {
+  file_.close();
+
+  const auto rotated = rotatedPath();
+  std::error_code ec;
+  fs::rename(path_, rotated, ec);
+  if (ec) {
+    // Keep appending to the current file rather than losing records
+    std::cerr << fmt::format("Failed to rotate log file {}: {}\n", path_,
+                             ec.message());
+  }
+
+  file_.open(path_, std::ios::app | std::ios::binary);
+  if (!file_.is_open()) {
+    std::cerr << fmt::format("Failed to reopen log file: {}\n", path_);
+  }
+  if (ec) {
+    return;
+  }
+
+  size_ = 0;
+  {
+    std::lock_guard<std::mutex> lock(compress_mutex_);
+    compress_queue_.push_back(rotated);
+  }
+  compress_cv_.notify_one();
+}
+
+std::string RotatingLogFile::rotatedPath() const {
+  const auto now = std::time(nullptr);
+  std::tm tm{};
+  localtime_r(&now, &tm);
+  char stamp[32];
+  std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &tm);
+
+  // Several rotations within one second get a counter suffix
+  std::string candidate = fmt::format("{}.{}", path_, stamp);
+  for (int i = 1; fs::exists(candidate) || fs::exists(candidate + ".gz");
+       ++i) {
+    candidate = fmt::format("{}.{}-{}", path_, stamp, i);
+  }
+  return candidate;
+}
+
+void RotatingLogFile::compressLoop() {
+  std::unique_lock<std::mutex> lock(compress_mutex_);
+
+  while (true) {
+    compress_cv_.wait(
+        lock, [this] { return compress_stopping_ || !compress_queue_.empty(); });
+
+    // Compress what is left before stopping
+    if (compress_queue_.empty()) {
+      break;
+    }
+
+    const std::string path = std::move(compress_queue_.front());
+    compress_queue_.pop_front();
+    lock.unlock();
+
+    compress(path);
+    prune();
+
+    lock.lock();
+  }
+}
+
+void RotatingLogFile::compress(const std::string &path) const {
+  const std::string target = path + ".gz";
+  const std::string temp = target + ".tmp";
+
+  std::ifstream input(path, std::ios::binary);
+  gzFile output = gzopen(temp.c_str(), "wb6");
+  if (!input || !output) {
+    std::cerr << fmt::format("Failed to compress rotated log {}\n", path);
+    if (output) {
+      gzclose(output);
+    }
+    return;
+  }
+
+  std::vector<char> chunk(64 * 1024);
+  bool ok = true;
+  while (input) {
+    input.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    const auto read = input.gcount();
+    if (read > 0 &&
+        gzwrite(output, chunk.data(), static_cast<unsigned>(read)) != read) {
+      ok = false;
+      break;
+    }
+  }
+  ok = gzclose(output) == Z_OK && ok;
+  input.close();
+
+  std::error_code ec;
+  if (!ok) {
+    std::cerr << fmt::format("Failed to compress rotated log {}\n", path);
+    fs::remove(temp, ec);
+    return;
+  }
+
+  fs::rename(temp, target, ec);
+  if (!ec) {
+    fs::remove(path, ec);
+  }
+}
+
+void RotatingLogFile::prune() const {
+  const fs::path current(path_);
+  const auto directory =
+      current.has_parent_path() ? current.parent_path() : fs::path(".");
+  const std::string prefix = current.filename().string() + ".";
+
+  std::vector<std::pair<fs::file_time_type, fs::path>> segments;
+  std::error_code ec;
+  for (const auto &entry : fs::directory_iterator(directory, ec)) {
+    const auto name = entry.path().filename().string();
+    if (name.size() > prefix.size() + 3 &&
+        name.compare(0, prefix.size(), prefix) == 0 &&
+        name.compare(name.size() - 3, 3, ".gz") == 0) {
+      segments.emplace_back(entry.last_write_time(ec), entry.path());
+    }
+  }
+
+  if (segments.size() <= options_.max_rotated_files) {
+    return;
+  }
+
+  // Oldest first
+  std::sort(segments.begin(), segments.end());
+  const size_t excess = segments.size() - options_.max_rotated_files;
+  for (size_t i = 0; i < excess; ++i) {
+    fs::remove(segments[i].second, ec);
+  }
+}
+
+} // namespace bluray::infrastructure
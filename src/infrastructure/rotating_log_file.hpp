@@ -0,0 +1,82 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace bluray::infrastructure {
+
+/**
+ * Log file size limits
+ */
+struct LogRotationOptions {
+  size_t max_file_size{10 * 1024 * 1024}; // Rotate past this size (0 = never)
+  size_t max_rotated_files{5};            // Compressed segments kept
+};
+
+/**
+ * Append-only log file with size-based rotation
+ *
+ * When the file grows past the limit it is renamed to
+ * "<path>.<YYYYMMDD-HHMMSS>" and a fresh file is opened in its place; the
+ * rename is the only work done on the writing thread. The rotated segment
+ * is gzip-compressed and old segments are pruned on a background thread.
+ *
+ * Not thread-safe: one writer (the logger thread) owns the instance.
+ */
+class RotatingLogFile {
+public:
+  RotatingLogFile() = default;
+  ~RotatingLogFile();
+
+  // Prevent copying
+  RotatingLogFile(const RotatingLogFile &) = delete;
+  RotatingLogFile &operator=(const RotatingLogFile &) = delete;
+
+  /**
+   * Open (append to) the log file
+   * @return false if the file could not be opened
+   */
+  bool open(std::string_view path, LogRotationOptions options);
+
+  [[nodiscard]] bool isOpen() const { return file_.is_open(); }
+
+  /**
+   * Append data, rotating first if the size limit has been reached
+   */
+  void write(std::string_view data);
+
+  void flush();
+
+  /**
+   * Close the file and wait for pending compression
+   */
+  void close();
+
+private:
+  void rotate();
+  [[nodiscard]] std::string rotatedPath() const;
+
+  void compressLoop();
+  void compress(const std::string &path) const;
+  void prune() const;
+
+  std::ofstream file_;
+  std::string path_;
+  LogRotationOptions options_;
+  size_t size_{0};
+
+  // Background compression of rotated segments
+  std::thread compressor_;
+  std::mutex compress_mutex_;
+  std::condition_variable compress_cv_;
+  std::deque<std::string> compress_queue_;
+  bool compress_stopping_{false};
+};
+
+} // namespace bluray::infrastructure
@@ -0,0 +1,122 @@
+#include "symbol_dictionary.hpp"
+#include "database_manager.hpp"
+#include "logger.hpp"
+#include <fmt/format.h>
+
+namespace bluray::infrastructure {
+
+SymbolDictionary &SymbolDictionary::instance() {
+  static SymbolDictionary instance;
+  return instance;
+}
+
+int64_t SymbolDictionary::toDatabaseId(domain::Symbol symbol) {
+  if (symbol.empty()) {
+    return 0;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = database_ids_.find(symbol);
+    if (it != database_ids_.end()) {
+      return it->second;
+    }
+  }
+
+  // Database lock first, like every other caller, then the cache. Another
+  // process may have stored the value already.
+  auto &db = DatabaseManager::instance();
+  auto db_lock = db.lock();
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto insert =
+      db.prepare("INSERT OR IGNORE INTO symbols (value) VALUES (?)");
+  sqlite3_bind_text(insert.get(), 1, symbol.c_str(), -1, SQLITE_STATIC);
+  if (sqlite3_step(insert.get()) != SQLITE_DONE) {
+    throw DatabaseException(fmt::format("Failed to store symbol '{}': {}",
+                                        symbol, sqlite3_errmsg(db.getHandle())));
+  }
+
+  auto select = db.prepare("SELECT id FROM symbols WHERE value = ?");
+  sqlite3_bind_text(select.get(), 1, symbol.c_str(), -1, SQLITE_STATIC);
+  if (sqlite3_step(select.get()) != SQLITE_ROW) {
+    throw DatabaseException(fmt::format("Failed to look up symbol '{}': {}",
+                                        symbol, sqlite3_errmsg(db.getHandle())));
+  }
+
+  const int64_t id = sqlite3_column_int64(select.get(), 0);
+  remember(symbol, id);
+  return id;
+}
+
+std::optional<int64_t> SymbolDictionary::findDatabaseId(std::string_view text) {
+  if (text.empty()) {
+    return 0;
+  }
+
+  auto &db = DatabaseManager::instance();
+  auto db_lock = db.lock();
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Only texts that were interned can be cached
+  if (const auto symbol_id = domain::SymbolTable::instance().find(text)) {
+    const auto it = database_ids_.find(domain::Symbol::fromId(*symbol_id));
+    if (it != database_ids_.end()) {
+      return it->second;
+    }
+  }
+
+  auto stmt = db.prepare("SELECT id FROM symbols WHERE value = ?");
+  sqlite3_bind_text(stmt.get(), 1, text.data(), static_cast<int>(text.size()),
+                    SQLITE_STATIC);
+  if (sqlite3_step(stmt.get()) != SQLITE_ROW) {
+    return std::nullopt;
+  }
+
+  const int64_t id = sqlite3_column_int64(stmt.get(), 0);
+  remember(domain::Symbol(text), id);
+  return id;
+}
+
+domain::Symbol SymbolDictionary::fromDatabaseId(int64_t id) {
+  if (id <= 0) {
+    return {};
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto index = static_cast<size_t>(id);
+    if (index < symbols_.size() && !symbols_[index].empty()) {
+      return symbols_[index];
+    }
+  }
+
+  // Added by another process since we last looked
+  auto &db = DatabaseManager::instance();
+  auto db_lock = db.lock();
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto stmt = db.prepare("SELECT value FROM symbols WHERE id = ?");
+  sqlite3_bind_int64(stmt.get(), 1, id);
+  if (sqlite3_step(stmt.get()) != SQLITE_ROW) {
+    LOG_WARNING("Unknown symbol id {}", id);
+    return {};
+  }
+
+  const domain::Symbol symbol(
+      reinterpret_cast<const char *>(sqlite3_column_text(stmt.get(), 0)));
+  remember(symbol, id);
+  return symbol;
+}
+
+void SymbolDictionary::remember(domain::Symbol symbol, int64_t id) {
+  database_ids_[symbol] = id;
+
+  const auto index = static_cast<size_t>(id);
+  if (index >= symbols_.size()) {
+    symbols_.resize(index + 1);
+  }
+  symbols_[index] = symbol;
+}
+
+} // namespace bluray::infrastructure
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../domain/symbol.hpp"
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace bluray::infrastructure {
+
+/**
+ * Maps symbols to the ids of the symbols table (Singleton pattern)
+ *
+ * In-memory symbol ids depend on interning order and differ per process;
+ * the symbols table gives every text one id shared by all processes. Both
+ * directions are cached, so repositories convert without a query once a
+ * value has been seen.
+ */
+class SymbolDictionary {
+public:
+  static SymbolDictionary &instance();
+
+  // Prevent copying
+  SymbolDictionary(const SymbolDictionary &) = delete;
+  SymbolDictionary &operator=(const SymbolDictionary &) = delete;
+
+  /**
+   * Database id of a symbol, adding it to the symbols table if new
+   * @return 0 for the empty symbol
+   */
+  int64_t toDatabaseId(domain::Symbol symbol);
+
+  /**
+   * Database id of a text, without adding it
+   */
+  std::optional<int64_t> findDatabaseId(std::string_view text);
+
+  /**
+   * Symbol of a database id
+   * @return Empty symbol for 0 or an unknown id
+   */
+  domain::Symbol fromDatabaseId(int64_t id);
+
+private:
+  SymbolDictionary() = default;
+
+  void remember(domain::Symbol symbol, int64_t id); // Caller holds mutex_
+
+  std::mutex mutex_;
+  std::unordered_map<domain::Symbol, int64_t> database_ids_;
+  std::vector<domain::Symbol> symbols_; // Indexed by database id
+};
+
+} // namespace bluray::infrastructure
@@ -3,7 +3,6 @@
 #include "logger.hpp"
 #include <fmt/format.h>
 #include <algorithm>
-#include <thread>
 
 namespace bluray::infrastructure {
 
@@ -11,14 +10,11 @@ TmdbClient::TmdbClient() {
   // Load API key from config
   const auto& config = ConfigManager::instance();
   api_key_ = config.get("tmdb_api_key", "");
-
-  // Initialize rate limit window
-  rate_limit_state_.window_start = std::chrono::steady_clock::now();
+  base_url_ = config.get("tmdb_base_url", BASE_URL);
 }
 
 TmdbClient::TmdbClient(std::string_view api_key)
-    : api_key_(api_key) {
-  rate_limit_state_.window_start = std::chrono::steady_clock::now();
+    : api_key_(api_key), base_url_(BASE_URL) {
 }
 
 std::optional<TmdbSearchResult> TmdbClient::searchMovie(
@@ -27,7 +23,7 @@ std::optional<TmdbSearchResult> TmdbClient::searchMovie(
     int page
 ) {
   if (!hasApiKey()) {
-    Logger::instance().error("TMDb API key not configured");
+    LOG_ERROR("TMDb API key not configured");
     return std::nullopt;
   }
 
@@ -60,23 +56,19 @@ std::optional<TmdbSearchResult> TmdbClient::searchMovie(
       }
     }
 
-    Logger::instance().debug(fmt::format(
-        "TMDb search for '{}' returned {} results",
-        query, result.total_results
-    ));
+    LOG_DEBUG("TMDb search for '{}' returned {} results", query,
+              result.total_results);
 
     return result;
   } catch (const std::exception& e) {
-    Logger::instance().error(fmt::format(
-        "Failed to parse TMDb search results: {}", e.what()
-    ));
+    LOG_ERROR("Failed to parse TMDb search results: {}", e.what());
     return std::nullopt;
   }
 }
 
 std::optional<TmdbMovie> TmdbClient::getMovieDetails(int movie_id) {
   if (!hasApiKey()) {
-    Logger::instance().error("TMDb API key not configured");
+    LOG_ERROR("TMDb API key not configured");
     return std::nullopt;
   }
 
@@ -112,23 +104,19 @@ std::optional<TmdbMovie> TmdbClient::getMovieDetails(int movie_id) {
       movie.runtime = json["runtime"].get<int>();
     }
 
-    Logger::instance().debug(fmt::format(
-        "TMDb fetched details for movie ID {}: '{}'",
-        movie_id, movie.title
-    ));
+    LOG_DEBUG("TMDb fetched details for movie ID {}: '{}'", movie_id,
+              movie.title);
 
     return movie;
   } catch (const std::exception& e) {
-    Logger::instance().error(fmt::format(
-        "Failed to parse TMDb movie details: {}", e.what()
-    ));
+    LOG_ERROR("Failed to parse TMDb movie details: {}", e.what());
     return std::nullopt;
   }
 }
 
 std::vector<TmdbVideo> TmdbClient::getMovieVideos(int movie_id) {
   if (!hasApiKey()) {
-    Logger::instance().error("TMDb API key not configured");
+    LOG_ERROR("TMDb API key not configured");
     return {};
   }
 
@@ -149,23 +137,19 @@ std::vector<TmdbVideo> TmdbClient::getMovieVideos(int movie_id) {
       }
     }
 
-    Logger::instance().debug(fmt::format(
-        "TMDb fetched {} videos for movie ID {}",
-        videos.size(), movie_id
-    ));
+    LOG_DEBUG("TMDb fetched {} videos for movie ID {}", videos.size(),
+              movie_id);
 
     return videos;
   } catch (const std::exception& e) {
-    Logger::instance().error(fmt::format(
-        "Failed to parse TMDb videos: {}", e.what()
-    ));
+    LOG_ERROR("Failed to parse TMDb videos: {}", e.what());
     return {};
   }
 }
 
 std::optional<TmdbMovie> TmdbClient::findByImdbId(std::string_view imdb_id) {
   if (!hasApiKey()) {
-    Logger::instance().error("TMDb API key not configured");
+    LOG_ERROR("TMDb API key not configured");
     return std::nullopt;
   }
 
@@ -193,27 +177,72 @@ std::optional<TmdbMovie> TmdbClient::findByImdbId(std::string_view imdb_id) {
         TmdbMovie movie = parseMovie(movie_results[0]);
         movie.imdb_id = std::string(imdb_id);
 
-        Logger::instance().debug(fmt::format(
-            "TMDb found movie for IMDb ID {}: '{}'",
-            imdb_id, movie.title
-        ));
+        LOG_DEBUG("TMDb found movie for IMDb ID {}: '{}'", imdb_id,
+                  movie.title);
 
         return movie;
       }
     }
 
-    Logger::instance().warning(fmt::format(
-        "TMDb found no movie for IMDb ID {}",
-        imdb_id
-    ));
+    LOG_WARNING("TMDb found no movie for IMDb ID {}", imdb_id);
 
     return std::nullopt;
   } catch (const std::exception& e) {
-    Logger::instance().error(fmt::format(
-        "Failed to parse TMDb find results: {}", e.what()
-    ));
+    LOG_ERROR("Failed to parse TMDb find results: {}", e.what());
+    return std::nullopt;
+  }
+}
+
+std::optional<std::vector<int>> TmdbClient::getChangedMovieIds(
+    std::string_view start_date,
+    std::string_view end_date
+) {
+  if (!hasApiKey()) {
+    LOG_ERROR("TMDb API key not configured");
     return std::nullopt;
   }
+
+  std::vector<int> movie_ids;
+  int total_pages = 1;
+
+  for (int page = 1; page <= total_pages; ++page) {
+    const std::string url = buildUrl("/movie/changes", {
+        {"start_date", std::string(start_date)},
+        {"end_date", std::string(end_date)},
+        {"page", std::to_string(page)}
+    });
+
+    auto json_opt = makeRequest(url);
+    if (!json_opt) {
+      return std::nullopt;
+    }
+
+    try {
+      const auto& json = *json_opt;
+      total_pages = json.value("total_pages", 1);
+
+      if (json.contains("results") && json["results"].is_array()) {
+        for (const auto& change : json["results"]) {
+          if (change.contains("id") && change["id"].is_number_integer()) {
+            movie_ids.push_back(change["id"].get<int>());
+          }
+        }
+      }
+    } catch (const std::exception& e) {
+      LOG_ERROR("Failed to parse TMDb changes page {}: {}", page, e.what());
+      return std::nullopt;
+    }
+  }
+
+  LOG_DEBUG("TMDb changes feed {}..{} listed {} movies", start_date, end_date,
+            movie_ids.size());
+
+  return movie_ids;
+}
+
+void TmdbClient::setBaseUrl(std::string_view base_url) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  base_url_ = base_url;
 }
 
 void TmdbClient::setApiKey(std::string_view api_key) {
@@ -226,16 +255,25 @@ bool TmdbClient::hasApiKey() const {
   return !api_key_.empty();
 }
 
-RateLimitState TmdbClient::getRateLimitState() const {
-  std::lock_guard<std::mutex> lock(mutex_);
-  return rate_limit_state_;
+RateLimiter::Stats TmdbClient::getRateLimitStats() const {
+  return rateLimiter().getStats();
+}
+
+RateLimiter &TmdbClient::rateLimiter() {
+  static RateLimiter limiter(MAX_REQUESTS_PER_10_SEC, std::chrono::seconds(10),
+                             RATE_LIMIT_BURST);
+  return limiter;
 }
 
 std::string TmdbClient::buildUrl(
     std::string_view endpoint,
     const std::vector<std::pair<std::string, std::string>>& params
 ) {
-  std::string url = fmt::format("{}{}", BASE_URL, endpoint);
+  std::string url;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    url = fmt::format("{}{}", base_url_, endpoint);
+  }
 
   // URL encode helper using RFC 3986 unreserved characters
   auto url_encode = [](std::string_view str) -> std::string {
@@ -268,90 +306,64 @@ std::string TmdbClient::buildUrl(
 }
 
 std::optional<nlohmann::json> TmdbClient::makeRequest(std::string_view url) {
-  // Check rate limit before making request
-  if (!checkRateLimit()) {
-    Logger::instance().warning("TMDb rate limit exceeded, waiting...");
-
-    int wait_time = 0;
-    {
-      // Calculate time to wait until window reset
-      std::lock_guard<std::mutex> lock(mutex_);
-      auto now = std::chrono::steady_clock::now();
-      auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
-          now - rate_limit_state_.window_start
-      ).count();
-
-      wait_time = static_cast<int>(std::max(0L, 10L - elapsed));
-    }
-
-    if (wait_time > 0) {
-      std::this_thread::sleep_for(std::chrono::seconds(wait_time));
-    }
-
-    {
-      // Reset window
-      std::lock_guard<std::mutex> lock(mutex_);
-      rate_limit_state_.window_start = std::chrono::steady_clock::now();
-      rate_limit_state_.requests_made = 0;
-    }
+  std::string api_key;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    api_key = api_key_;
   }
 
   // Make HTTP request with Authorization header (Bearer token authentication)
-  std::vector<std::string> headers = {
-    fmt::format("Authorization: Bearer {}", api_key_)
+  const std::vector<std::string> headers = {
+    fmt::format("Authorization: Bearer {}", api_key)
   };
-  auto response = client_.get(url, headers);
-
-  if (!response.success) {
-    Logger::instance().error(fmt::format(
-        "TMDb API request failed: HTTP {}",
-        response.status_code
-    ));
-
-    if (response.status_code == 401) {
-      Logger::instance().error("Invalid TMDb API key");
-    } else if (response.status_code == 429) {
-      Logger::instance().error("TMDb rate limit exceeded (429)");
-    }
 
-    return std::nullopt;
-  }
+  // The client is shared between request threads, so every thread gets its
+  // own curl handle (which also keeps the TMDb connection alive per thread)
+  thread_local NetworkClient client;
+
+  for (int attempt = 0; ; ++attempt) {
+    // Wait for this request's permit from the shared limiter
+    rateLimiter().acquire();
+
+    auto response = client.get(url, headers);
+
+    if (response.status_code == 429 && attempt < MAX_RATE_LIMIT_RETRIES) {
+      // Honour Retry-After so every caller backs off, not just this one
+      int retry_after = 1;
+      if (auto value = response.header("Retry-After")) {
+        try {
+          retry_after = std::max(1, std::stoi(*value));
+        } catch (const std::exception &) {
+          // Keep default
+        }
+      }
 
-  // Increment rate limit counter
-  incrementRateLimit();
+      LOG_WARNING("TMDb rate limit exceeded (429), retrying in {}s",
+                  retry_after);
+      rateLimiter().pause(std::chrono::seconds(retry_after));
+      continue;
+    }
 
-  // Parse JSON response
-  try {
-    return nlohmann::json::parse(response.body);
-  } catch (const std::exception& e) {
-    Logger::instance().error(fmt::format(
-        "Failed to parse TMDb JSON response: {}", e.what()
-    ));
-    return std::nullopt;
-  }
-}
+    if (!response.success) {
+      LOG_ERROR("TMDb API request failed: HTTP {}", response.status_code);
 
-bool TmdbClient::checkRateLimit() {
-  std::lock_guard<std::mutex> lock(mutex_);
+      if (response.status_code == 401) {
+        LOG_ERROR("Invalid TMDb API key");
+      } else if (response.status_code == 429) {
+        LOG_ERROR("TMDb rate limit exceeded (429)");
+      }
 
-  auto now = std::chrono::steady_clock::now();
-  auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
-      now - rate_limit_state_.window_start
-  ).count();
+      return std::nullopt;
+    }
 
-  // Reset window if 10 seconds have elapsed
-  if (elapsed >= 10) {
-    rate_limit_state_.window_start = now;
-    rate_limit_state_.requests_made = 0;
+    // Parse JSON response
+    try {
+      return nlohmann::json::parse(response.body);
+    } catch (const std::exception& e) {
+      LOG_ERROR("Failed to parse TMDb JSON response: {}", e.what());
+      return std::nullopt;
+    }
   }
-
-  // Check if we can make another request
-  return rate_limit_state_.requests_made < RateLimitState::MAX_REQUESTS_PER_10_SEC;
-}
-
-void TmdbClient::incrementRateLimit() {
-  std::lock_guard<std::mutex> lock(mutex_);
-  rate_limit_state_.requests_made++;
 }
 
 TmdbMovie TmdbClient::parseMovie(const nlohmann::json& json) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "network_client.hpp"
+#include "rate_limiter.hpp"
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
@@ -45,20 +46,13 @@ struct TmdbSearchResult {
     int total_pages{1};
 };
 
-/**
- * Rate limiting state
- */
-struct RateLimitState {
-    int requests_made{0};
-    std::chrono::steady_clock::time_point window_start;
-    static constexpr int MAX_REQUESTS_PER_10_SEC = 40;  // TMDb free tier limit
-};
-
 /**
  * TMDb API client for fetching movie metadata
  *
  * Provides thread-safe access to TMDb API v3 with built-in rate limiting
- * to respect the free tier limit of 40 requests per 10 seconds.
+ * to respect the free tier limit of 40 requests per 10 seconds. The limit is
+ * enforced process-wide, across all client instances and threads, by a GCRA
+ * limiter that hands every request an exact permit time.
  *
  * Usage:
  *   TmdbClient client("your_api_key");
@@ -72,7 +66,8 @@ struct RateLimitState {
 class TmdbClient {
 public:
     /**
-     * Default constructor - loads API key from ConfigManager
+     * Default constructor - loads API key (and optional tmdb_base_url
+     * override) from ConfigManager
      */
     TmdbClient();
 
@@ -117,6 +112,27 @@ public:
      */
     std::optional<TmdbMovie> findByImdbId(std::string_view imdb_id);
 
+    /**
+     * Get IDs of movies changed on TMDb within a date range
+     * Follows every page of the /movie/changes feed. TMDb accepts ranges of
+     * at most 14 days.
+     *
+     * @param start_date First day of the range (YYYY-MM-DD, UTC)
+     * @param end_date Last day of the range (YYYY-MM-DD, UTC)
+     * @return Changed movie IDs or nullopt on error
+     */
+    std::optional<std::vector<int>> getChangedMovieIds(
+        std::string_view start_date,
+        std::string_view end_date
+    );
+
+    /**
+     * Point the client at a different API root, e.g. a local stand-in
+     * server during tests
+     * @param base_url API root without trailing slash
+     */
+    void setBaseUrl(std::string_view base_url);
+
     /**
      * Set or update API key
      * @param api_key TMDb API v3 key
@@ -130,10 +146,24 @@ public:
     bool hasApiKey() const;
 
     /**
-     * Get current rate limit status
-     * @return RateLimitState with requests made and window start time
+     * Get current (process-wide) rate limit statistics
+     * @return Permits granted/delayed, accumulated wait and next permit time
      */
-    RateLimitState getRateLimitState() const;
+    RateLimiter::Stats getRateLimitStats() const;
+
+    /**
+     * Process-wide limiter guarding all TMDb requests
+     *
+     * Asynchronous callers can await a permit via acquireAsync() instead of
+     * blocking a thread; requests issued through this client acquire their
+     * permit internally.
+     */
+    static RateLimiter& rateLimiter();
+
+    // TMDb free tier limit
+    static constexpr int MAX_REQUESTS_PER_10_SEC = 40;
+    // Requests that may be sent back-to-back after idling (one enrichment)
+    static constexpr int RATE_LIMIT_BURST = 4;
 
 private:
     /**
@@ -154,18 +184,6 @@ private:
      */
     std::optional<nlohmann::json> makeRequest(std::string_view url);
 
-    /**
-     * Check if we can make another request without exceeding rate limit
-     * Resets window if 10 seconds have elapsed
-     * @return true if request is allowed, false if rate limit exceeded
-     */
-    bool checkRateLimit();
-
-    /**
-     * Increment rate limit counter after successful request
-     */
-    void incrementRateLimit();
-
     /**
      * Parse TMDb movie JSON object into TmdbMovie struct
      * @param json JSON object from TMDb API
@@ -180,12 +198,12 @@ private:
      */
     TmdbVideo parseVideo(const nlohmann::json& json);
 
-    NetworkClient client_;
     std::string api_key_;
-    RateLimitState rate_limit_state_;
+    std::string base_url_;
     mutable std::mutex mutex_;
 
     static constexpr const char* BASE_URL = "https://api.themoviedb.org/3";
+    static constexpr int MAX_RATE_LIMIT_RETRIES = 3;
 };
 
 } // namespace bluray::infrastructure
@@ -0,0 +1,65 @@
+#include "wishlist_snapshot.hpp"
+#include "database_manager.hpp"
+#include "logger.hpp"
+
+namespace bluray::infrastructure {
+
+WishlistSnapshot &WishlistSnapshot::instance() {
+  static WishlistSnapshot instance;
+  return instance;
+}
+
+std::shared_ptr<const domain::WishlistColumns> WishlistSnapshot::columns() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  const auto now = std::chrono::steady_clock::now();
+  if (columns_ && now - built_at_ < REFRESH_INTERVAL) {
+    return columns_;
+  }
+
+  auto &db = DatabaseManager::instance();
+  auto db_lock = db.lock();
+
+  // data_version moves on commits by other connections, total_changes on
+  // writes through ours; together they tell whether anything was written
+  const int64_t version = db.dataVersion();
+  const int64_t changes = sqlite3_total_changes(db.getHandle());
+
+  if (!columns_ || version != data_version_ || changes != total_changes_) {
+    columns_ = load();
+    data_version_ = version;
+    total_changes_ = changes;
+  }
+
+  built_at_ = now;
+  return columns_;
+}
+
+std::shared_ptr<const domain::WishlistColumns> WishlistSnapshot::load() {
+  auto &db = DatabaseManager::instance();
+
+  const auto started = std::chrono::steady_clock::now();
+
+  auto columns = std::make_shared<domain::WishlistColumns>();
+
+  auto stmt = db.prepare(
+      "SELECT id, current_price_cents, desired_max_price_cents, in_stock, "
+      "is_uhd_4k FROM wishlist ORDER BY id");
+
+  while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+    columns->append(sqlite3_column_int(stmt.get(), 0),
+                    domain::Money::fromCents(sqlite3_column_int64(stmt.get(), 1)),
+                    domain::Money::fromCents(sqlite3_column_int64(stmt.get(), 2)),
+                    sqlite3_column_int(stmt.get(), 3) != 0,
+                    sqlite3_column_int(stmt.get(), 4) != 0);
+  }
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - started);
+  LOG_DEBUG("Wishlist snapshot rebuilt: {} rows in {}ms", columns->size(),
+            elapsed.count());
+
+  return columns;
+}
+
+} // namespace bluray::infrastructure
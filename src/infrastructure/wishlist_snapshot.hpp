@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../domain/wishlist_columns.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace bluray::infrastructure {
+
+/**
+ * Periodically refreshed columnar copy of the wishlist (Singleton pattern)
+ *
+ * Dashboard statistics read the columns instead of loading every
+ * WishlistItem. The snapshot is rebuilt with one narrow query when the
+ * database has changed since it was built, at most once per refresh
+ * interval, so a busy scrape does not rebuild it on every request.
+ */
+class WishlistSnapshot {
+public:
+  static WishlistSnapshot &instance();
+
+  // Prevent copying
+  WishlistSnapshot(const WishlistSnapshot &) = delete;
+  WishlistSnapshot &operator=(const WishlistSnapshot &) = delete;
+
+  /**
+   * Current columns; stay valid (and unchanged) while held
+   */
+  std::shared_ptr<const domain::WishlistColumns> columns();
+
+private:
+  WishlistSnapshot() = default;
+
+  std::shared_ptr<const domain::WishlistColumns> load();
+
+  std::mutex mutex_;
+  std::shared_ptr<const domain::WishlistColumns> columns_;
+  std::chrono::steady_clock::time_point built_at_;
+
+  // Database state the snapshot was built from
+  int64_t data_version_{0};
+  int64_t total_changes_{0};
+
+  static constexpr std::chrono::seconds REFRESH_INTERVAL{1};
+};
+
+} // namespace bluray::infrastructure
@@ -1,11 +1,19 @@
+#include "application/enrichment/tmdb_enrichment_service.hpp"
+#include "application/event_bus.hpp"
+#include "application/matching/duplicate_detector.hpp"
 #include "application/notifier/discord_notifier.hpp"
 #include "application/notifier/email_notifier.hpp"
 #include "application/scheduler.hpp"
+#include "infrastructure/change_feed.hpp"
 #include "infrastructure/config_manager.hpp"
 #include "infrastructure/database_manager.hpp"
 #include "infrastructure/logger.hpp"
+#include "infrastructure/release_calendar_index.hpp"
+#include "infrastructure/repositories/price_history_repository.hpp"
+#include "infrastructure/repositories/price_stats_repository.hpp"
 #include "infrastructure/repositories/release_calendar_repository.hpp"
 #include "presentation/web_frontend.hpp"
+#include <algorithm>
 #include <csignal>
 #include <cstring>
 #include <fmt/format.h> // Add fmt include
@@ -19,8 +27,7 @@ using namespace bluray;
 presentation::WebFrontend *g_web_frontend = nullptr;
 
 void signalHandler(int signum) {
-  infrastructure::Logger::instance().info(
-      fmt::format("Received signal {}, shutting down...", signum));
+  LOG_INFO("Received signal {}, shutting down...", signum);
 
   if (g_web_frontend) {
     g_web_frontend->stop();
@@ -29,15 +36,38 @@ void signalHandler(int signum) {
   std::exit(signum);
 }
 
+// Apply the log_level setting ("debug", "info", "warning" or "error")
+void applyLogLevel(const infrastructure::ConfigSnapshot &config) {
+  const std::string level = config.get("log_level", "info");
+
+  auto &logger = infrastructure::Logger::instance();
+  if (level == "debug") {
+    logger.setLevel(infrastructure::LogLevel::Debug);
+  } else if (level == "info") {
+    logger.setLevel(infrastructure::LogLevel::Info);
+  } else if (level == "warning") {
+    logger.setLevel(infrastructure::LogLevel::Warning);
+  } else if (level == "error") {
+    logger.setLevel(infrastructure::LogLevel::Error);
+  } else {
+    LOG_WARNING("Unknown log_level '{}', keeping current level", level);
+  }
+}
+
 void printUsage(const char *program_name) {
   std::cout << "Usage: " << program_name << " [OPTIONS]\n\n"
             << "Options:\n"
             << "  --run                Run web server (default mode)\n"
             << "  --scrape             Run wishlist scraper once and exit\n"
             << "  --scrape-calendar    Run release calendar scraper once and exit\n"
+            << "  --refresh-tmdb       Refresh TMDb metadata changed since last run and exit\n"
             << "  --port <port>        Specify web server port (default: 8080)\n"
             << "  --db <path>          Specify database path (default: "
                "./bluray-tracker.db)\n"
+            << "  --log-file <path>    Log file, rotated and gzipped when it "
+               "grows past 10 MB\n"
+            << "                       (default: ./bluray-tracker.log)\n"
+            << "  --log-format <fmt>   Log file format: json (default) or text\n"
             << "  --help               Show this help message\n"
             << std::endl;
 }
@@ -47,6 +77,8 @@ int main(int argc, char *argv[]) {
   std::string mode = "run";
   int port = 8080;
   std::string db_path = "./bluray-tracker.db";
+  std::string log_path = "./bluray-tracker.log";
+  infrastructure::LoggerOptions log_options;
 
   for (int i = 1; i < argc; ++i) {
     if (std::strcmp(argv[i], "--help") == 0) {
@@ -58,10 +90,25 @@ int main(int argc, char *argv[]) {
       mode = "scrape";
     } else if (std::strcmp(argv[i], "--scrape-calendar") == 0) {
       mode = "scrape-calendar";
+    } else if (std::strcmp(argv[i], "--refresh-tmdb") == 0) {
+      mode = "refresh-tmdb";
     } else if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
       port = std::stoi(argv[++i]);
     } else if (std::strcmp(argv[i], "--db") == 0 && i + 1 < argc) {
       db_path = argv[++i];
+    } else if (std::strcmp(argv[i], "--log-file") == 0 && i + 1 < argc) {
+      log_path = argv[++i];
+    } else if (std::strcmp(argv[i], "--log-format") == 0 && i + 1 < argc) {
+      const std::string format = argv[++i];
+      if (format == "json") {
+        log_options.file_format = infrastructure::LogFormat::Json;
+      } else if (format == "text") {
+        log_options.file_format = infrastructure::LogFormat::Text;
+      } else {
+        std::cerr << "Unknown log format: " << format << std::endl;
+        printUsage(argv[0]);
+        return 1;
+      }
     } else {
       std::cerr << "Unknown option: " << argv[i] << std::endl;
       printUsage(argv[0]);
@@ -72,19 +119,28 @@ int main(int argc, char *argv[]) {
   try {
     // Initialize infrastructure
     auto &logger = infrastructure::Logger::instance();
-    logger.initialize("./bluray-tracker.log");
+    logger.initialize(log_path, log_options);
     logger.setLevel(infrastructure::LogLevel::Info);
 
-    logger.info("=== Blu-ray Tracker Starting ===");
+    LOG_INFO("=== Blu-ray Tracker Starting ===");
 
     // Initialize database
     auto &db = infrastructure::DatabaseManager::instance();
     db.initialize(db_path);
 
+    // Databases from before price_stats get their statistics once
+    infrastructure::PriceStatsRepository().backfill();
+
     // Load configuration
     auto &config = infrastructure::ConfigManager::instance();
     config.load();
 
+    // Switching to the series backend starts it from the existing history
+    infrastructure::PriceHistoryRepository().importIntoSeries();
+
+    applyLogLevel(*config.snapshot());
+    config.subscribe({"log_level"}, applyLogLevel);
+
     // Override port from config if not specified via CLI
     if (argc == 1) { // No CLI args
       port = config.getInt("web_port", 8080);
@@ -92,7 +148,7 @@ int main(int argc, char *argv[]) {
 
     if (mode == "scrape") {
       // Scrape mode: run once and exit
-      logger.info("Running in scrape mode");
+      LOG_INFO("Running in scrape mode");
 
       auto scheduler = std::make_shared<application::Scheduler>();
 
@@ -107,26 +163,42 @@ int main(int argc, char *argv[]) {
 
       // Run scraping
       int processed = scheduler->runOnce();
-      logger.info(
-          fmt::format("Scraping completed: {} items processed", processed));
+      LOG_INFO("Scraping completed: {} items processed", processed);
 
       return 0;
 
     } else if (mode == "scrape-calendar") {
       // Release calendar scrape mode: run once and exit
-      logger.info("Running in release calendar scrape mode");
+      LOG_INFO("Running in release calendar scrape mode");
 
       auto scheduler = std::make_shared<application::Scheduler>();
 
       // Run calendar scraping
       int processed = scheduler->scrapeReleaseCalendar();
-      logger.info(fmt::format("Release calendar scraping completed: {} items processed", processed));
+      LOG_INFO("Release calendar scraping completed: {} items processed",
+               processed);
 
       return 0;
 
+    } else if (mode == "refresh-tmdb") {
+      // TMDb refresh mode: apply the changes feed once and exit
+      LOG_INFO("Running in TMDb refresh mode");
+
+      application::enrichment::TmdbEnrichmentService enrichment_service;
+      auto summary = enrichment_service.refreshChangedItems();
+
+      if (!summary.success) {
+        LOG_ERROR("TMDb refresh failed: {}", summary.error_message);
+        return 1;
+      }
+
+      LOG_INFO("TMDb refresh completed: {} items updated",
+               summary.refreshed_items);
+      return 0;
+
     } else {
       // Web server mode
-      logger.info(fmt::format("Running in web server mode on port {}", port));
+      LOG_INFO("Running in web server mode on port {}", port);
 
       // Setup signal handlers
       std::signal(SIGINT, signalHandler);
@@ -149,36 +221,63 @@ int main(int argc, char *argv[]) {
       std::thread calendar_init_thread([scheduler]() {
         infrastructure::repositories::SqliteReleaseCalendarRepository calendar_repo;
         int calendar_count = calendar_repo.count();
-        auto& logger = infrastructure::Logger::instance();
 
         if (calendar_count == 0) {
-          logger.info("Release calendar is empty, fetching initial data in background...");
+          LOG_INFO("Release calendar is empty, fetching initial data in background...");
           try {
             int processed = scheduler->scrapeReleaseCalendar();
-            logger.info(fmt::format(
-                "Initial calendar fetch completed: {} releases added", processed));
+            LOG_INFO("Initial calendar fetch completed: {} releases added",
+                     processed);
           } catch (const std::exception &e) {
-            logger.warning(fmt::format(
-                "Failed to fetch initial calendar data: {}. Will retry on next scheduled run.",
-                e.what()));
+            LOG_WARNING("Failed to fetch initial calendar data: {}. Will retry on next scheduled run.",
+                        e.what());
           }
         } else {
-          logger.info(fmt::format(
-              "Release calendar already populated with {} items", calendar_count));
+          LOG_INFO("Release calendar already populated with {} items",
+                   calendar_count);
         }
       });
       calendar_init_thread.detach();
 
+      // Single enrichment service shared by all request handlers, so that
+      // the TMDb rate limit and bulk progress are process-wide
+      auto enrichment_service =
+          std::make_shared<application::enrichment::TmdbEnrichmentService>();
+
       // Create and run web frontend
-      presentation::WebFrontend web_frontend(scheduler);
+      presentation::WebFrontend web_frontend(scheduler, enrichment_service);
       g_web_frontend = &web_frontend;
 
-      logger.info(
-          fmt::format("Web interface available at http://localhost:{}", port));
+      // Pick up what cron scrapers and manual database edits write
+      infrastructure::ChangeFeed change_feed(
+          [](const std::vector<domain::DataChange> &changes) {
+            const bool config_changed =
+                std::any_of(changes.begin(), changes.end(),
+                            [](const auto &c) { return c.table == "config"; });
+            if (config_changed) {
+              infrastructure::ConfigManager::instance().reload();
+            }
+            const bool calendar_changed = std::any_of(
+                changes.begin(), changes.end(),
+                [](const auto &c) { return c.table == "release_calendar"; });
+            if (calendar_changed) {
+              infrastructure::ReleaseCalendarIndex::instance().invalidate();
+            }
+            application::matching::DuplicateDetector::instance().apply(
+                changes);
+
+            application::EventBus::instance().publish(
+                std::make_shared<const domain::ExternalDataChangedEvent>(
+                    domain::ExternalDataChangedEvent{changes}));
+          });
+      change_feed.start();
+
+      LOG_INFO("Web interface available at http://localhost:{}", port);
       web_frontend.run(port);
     }
 
   } catch (const std::exception &e) {
+    LOG_ERROR("Fatal error: {}", e.what());
     std::cerr << "Fatal error: " << e.what() << std::endl;
     return 1;
   }
@@ -931,6 +931,11 @@ std::string HtmlRenderer::renderMainContent() {
                         <div class="stat-value" id="uhd4kCount">0</div>
                         <div class="stat-label">UHD 4K</div>
                     </div>
+                    <div class="stat-card" style="background: linear-gradient(135deg, #10b981 0%, #059669 100%);">
+                        <div class="stat-icon">🏷️</div>
+                        <div class="stat-value" id="dealCount">0</div>
+                        <div class="stat-label">Deals</div>
+                    </div>
                 </div>
 
                 <div class="card">
@@ -1104,6 +1109,11 @@ std::string HtmlRenderer::renderMainContent() {
                             <input type="number" class="form-input" id="scrapeDelay" min="1" max="60" required>
                             <small style="color: var(--text-muted);">Delay between scraping requests to avoid rate limiting</small>
                         </div>
+                        <div class="form-group">
+                            <label class="form-label">Scrape Concurrency</label>
+                            <input type="number" class="form-input" id="scrapeConcurrency" min="1" max="16" required>
+                            <small style="color: var(--text-muted);">Items scraped in parallel; also applies to a scrape that is already running</small>
+                        </div>
                         <div class="form-group">
                             <label class="form-label">Cache Directory</label>
                             <input type="text" class="form-input" id="cacheDir" required>
@@ -1530,6 +1540,8 @@ std::string HtmlRenderer::renderScripts() {
             connect();
         }
 
+        let itemChangeRefreshTimer = null;
+
         function handleWebSocketMessage(msg) {
             if (msg.type.startsWith('wishlist_')) {
                 if (currentPage === 'wishlist') loadWishlist(wishlistData.page);
@@ -1537,6 +1549,24 @@ std::string HtmlRenderer::renderScripts() {
                 if (msg.message) {
                     showToast(msg.message, 'info');
                 }
+            } else if (msg.type === 'item_changed' || msg.type === 'metadata_updated') {
+                // Scrape runs produce bursts of changes; refresh once per burst
+                clearTimeout(itemChangeRefreshTimer);
+                itemChangeRefreshTimer = setTimeout(() => {
+                    if (currentPage === 'wishlist') loadWishlist(wishlistData.page);
+                    loadDashboardStats();
+                }, 1000);
+            } else if (msg.type === 'data_changed') {
+                // Written by another process (e.g. a cron scrape)
+                const changes = msg.changes || {};
+                clearTimeout(itemChangeRefreshTimer);
+                itemChangeRefreshTimer = setTimeout(() => {
+                    if (changes.wishlist && currentPage === 'wishlist') loadWishlist(wishlistData.page);
+                    if (changes.collection && currentPage === 'collection') loadCollection(collectionData.page);
+                    if (changes.release_calendar && currentPage === 'dashboard') loadReleaseCalendar();
+                    if (changes.config && currentPage === 'settings') loadSettings();
+                    loadDashboardStats();
+                }, 250);
             }
         }
 
@@ -1550,6 +1580,7 @@ std::string HtmlRenderer::renderScripts() {
                 document.getElementById('collectionCount').textContent = data.collection_count;
                 document.getElementById('inStockCount').textContent = data.in_stock_count;
                 document.getElementById('uhd4kCount').textContent = data.uhd_4k_count;
+                document.getElementById('dealCount').textContent = data.deal_count;
                 
                 // Update Progress Bar
                 const progressContainer = document.getElementById('scrapeProgressContainer');
@@ -1769,6 +1800,7 @@ std::string HtmlRenderer::renderScripts() {
 
                 const newItem = await res.json();
                 showToast(`Added "${title}" to wishlist!`, 'success');
+                warnPossibleDuplicates(newItem);
 
                 // Reload wishlist if on that page
                 if (currentPage === 'wishlist') {
@@ -1815,6 +1847,7 @@ std::string HtmlRenderer::renderScripts() {
                 wishlistData = await res.json();
                 renderWishlistTable();
                 renderWishlistPagination();
+                loadWishlistSparklines();
             } catch (error) {
                 console.error('Failed to load wishlist:', error);
                 showToast('Failed to load wishlist', 'error');
@@ -1855,6 +1888,7 @@ std::string HtmlRenderer::renderScripts() {
                     </td>
                     <td>
                         <div class="stat-value" style="font-size: 1.2rem;">€${item.current_price.toFixed(2)}</div>
+                        <svg data-sparkline-id="${item.id}" width="100" height="24" style="display: block;"></svg>
                     </td>
                     <td>
                         <div style="font-size: 0.9rem;">
@@ -1889,6 +1923,47 @@ std::string HtmlRenderer::renderScripts() {
             `).join('');
         }
 
+        // Price trends of every row on the page in one request
+        async function loadWishlistSparklines() {
+            const ids = wishlistData.items.map(item => item.id);
+            if (ids.length === 0) return;
+            try {
+                const res = await fetch(`/api/history/sparklines?ids=${ids.join(',')}&days=90&points=32`);
+                const data = await res.json();
+                for (const [id, line] of Object.entries(data.items)) {
+                    const svg = document.querySelector(`svg[data-sparkline-id="${id}"]`);
+                    if (svg) drawSparkline(svg, line);
+                }
+            } catch (error) {
+                console.error('Failed to load sparklines:', error);
+            }
+        }
+
+        // Undo the server's delta encoding (first value, then differences)
+        function undelta(values) {
+            let sum = 0;
+            return values.map(value => (sum += value));
+        }
+
+        function drawSparkline(svg, line) {
+            const times = undelta(line.t);
+            const cents = undelta(line.c);
+            if (times.length < 2) return;
+
+            const width = svg.width.baseVal.value;
+            const height = svg.height.baseVal.value;
+            const timeSpan = (times[times.length - 1] - times[0]) || 1;
+            const minCents = Math.min(...cents);
+            const centsSpan = (Math.max(...cents) - minCents) || 1;
+            const points = times.map((t, i) => {
+                const x = 1 + (t - times[0]) / timeSpan * (width - 2);
+                const y = height - 1 - (cents[i] - minCents) / centsSpan * (height - 2);
+                return `${x.toFixed(1)},${y.toFixed(1)}`;
+            });
+            const falling = cents[cents.length - 1] < cents[0];
+            svg.innerHTML = `<polyline points="${points.join(' ')}" fill="none" stroke="${falling ? 'var(--success)' : 'var(--primary)'}" stroke-width="1.5"/>`;
+        }
+
         function renderWishlistPagination() {
             const container = document.getElementById('wishlistPagination');
             // Simplified pagination
@@ -2238,6 +2313,7 @@ std::string HtmlRenderer::renderScripts() {
                 
                 if (res.ok) {
                     showToast('Item added to wishlist', 'success');
+                    warnPossibleDuplicates(await res.json());
                     closeModal('addWishlistModal');
                     loadWishlist();
                 } else {
@@ -2377,6 +2453,7 @@ std::string HtmlRenderer::renderScripts() {
                 const data = await res.json();
 
                 document.getElementById('scrapeDelay').value = data.scrape_delay_seconds || 8;
+                document.getElementById('scrapeConcurrency').value = data.scrape_concurrency || 4;
                 document.getElementById('cacheDir').value = data.cache_directory || './cache';
 
                 // TMDb settings
@@ -2401,6 +2478,7 @@ std::string HtmlRenderer::renderScripts() {
 
             const data = {
                 scrape_delay_seconds: parseInt(document.getElementById('scrapeDelay').value),
+                scrape_concurrency: parseInt(document.getElementById('scrapeConcurrency').value),
                 cache_directory: document.getElementById('cacheDir').value
             };
 
@@ -2441,6 +2519,16 @@ std::string HtmlRenderer::renderScripts() {
             btn.textContent = next === 'dark' ? '🌙' : '☀️';
         }
 
+        // Added items come back with the items they probably duplicate
+        function warnPossibleDuplicates(item) {
+            const duplicates = item.possible_duplicates || [];
+            if (duplicates.length === 0) return;
+            const names = duplicates.slice(0, 3)
+                .map(d => `"${escapeHtml(d.title)}" (${d.type})`)
+                .join(', ');
+            showToast(`Possible duplicate of ${names}`, 'info');
+        }
+
         function showToast(message, type = 'info') {
             const container = document.getElementById('toastContainer');
             const toast = document.createElement('div');
@@ -2468,7 +2556,10 @@ std::string HtmlRenderer::renderScripts() {
              
              // Load Data
              try {
-                const res = await fetch(`/api/wishlist/${id}/history`);
+                // About one point per pixel; the server downsamples
+                const canvas = document.getElementById('priceHistoryChart');
+                const points = Math.min(1000, Math.max(100, canvas.clientWidth));
+                const res = await fetch(`/api/wishlist/${id}/history?days=180&points=${points}`);
                 const history = await res.json();
                 renderPriceChart(history, item.desired_max_price);
              } catch(e) {
@@ -1,20 +1,32 @@
 #include "web_frontend.hpp"
 #include "../application/scraper/scraper.hpp"
 #include "../application/enrichment/tmdb_enrichment_service.hpp"
+#include "../application/matching/duplicate_detector.hpp"
 #include "../infrastructure/config_manager.hpp"
 #include "../infrastructure/database_manager.hpp"
 #include "../infrastructure/input_validation.hpp"
 #include "../infrastructure/logger.hpp"
+#include "../infrastructure/release_calendar_index.hpp"
+#include "../infrastructure/repositories/alert_rule_repository.hpp"
+#include "../infrastructure/repositories/catalog_repository.hpp"
 #include "../infrastructure/repositories/collection_repository.hpp"
 #include "../infrastructure/repositories/price_history_repository.hpp"
+#include "../infrastructure/repositories/price_stats_repository.hpp"
+#include "../infrastructure/repositories/product_repository.hpp"
 #include "../infrastructure/repositories/release_calendar_repository.hpp"
+#include "../infrastructure/repositories/release_match_repository.hpp"
 #include "../infrastructure/repositories/tag_repository.hpp"
 #include "../infrastructure/repositories/wishlist_repository.hpp"
+#include "../infrastructure/wishlist_snapshot.hpp"
 #include "html_renderer.hpp"
+#include <algorithm>
 #include <filesystem>
 #include <fmt/format.h>
 #include <iomanip>
+#include <map>
+#include <optional>
 #include <sstream>
+#include <unordered_map>
 
 namespace bluray::presentation {
 
@@ -35,9 +47,8 @@ void updateMetadataFields(const crow::json::rvalue &body,
     if (validation::isValidImdbId(id)) {
       imdb_id = id;
     } else {
-      Logger::instance().warning(fmt::format(
-          "Ignoring invalid imdb_id value '{}' (must be tt followed by 7-8 digits)", 
-          validation::sanitizeForLog(id)));
+      LOG_WARNING("Ignoring invalid imdb_id value '{}' (must be tt followed by 7-8 digits)",
+                  validation::sanitizeForLog(id));
     }
   }
   
@@ -46,9 +57,8 @@ void updateMetadataFields(const crow::json::rvalue &body,
     if (validation::isValidTmdbRating(rating)) {
       tmdb_rating = rating;
     } else {
-      Logger::instance().warning(fmt::format(
-          "Ignoring invalid tmdb_rating value {} (must be between 0.0 and 10.0)", 
-          rating));
+      LOG_WARNING("Ignoring invalid tmdb_rating value {} (must be between 0.0 and 10.0)",
+                  rating);
     }
   }
   
@@ -57,19 +67,24 @@ void updateMetadataFields(const crow::json::rvalue &body,
     if (validation::isValidTrailerKey(key)) {
       trailer_key = key;
     } else {
-      Logger::instance().warning(fmt::format(
-          "Ignoring invalid trailer_key value '{}' (must be 11 alphanumeric characters with - or _)", 
-          validation::sanitizeForLog(key)));
+      LOG_WARNING("Ignoring invalid trailer_key value '{}' (must be 11 alphanumeric characters with - or _)",
+                  validation::sanitizeForLog(key));
     }
   }
 }
 
 // Helper function to update edition & bonus features fields
 void updateEditionFields(const crow::json::rvalue &body,
-                        std::string &edition_type, bool &has_slipcover,
+                        domain::Symbol &edition_type, bool &has_slipcover,
                         bool &has_digital_copy, std::string &bonus_features) {
   if (body.has("edition_type")) {
-    edition_type = body["edition_type"].s();
+    std::string type = body["edition_type"].s();
+    if (validation::isValidEditionType(type)) {
+      edition_type = type;
+    } else {
+      LOG_WARNING("Ignoring unknown edition_type '{}'",
+                  validation::sanitizeForLog(type));
+    }
   }
   if (body.has("has_slipcover")) {
     has_slipcover = body["has_slipcover"].b();
@@ -82,6 +97,39 @@ void updateEditionFields(const crow::json::rvalue &body,
   }
 }
 
+// Helper function to write a price: euros for display, exact cents for
+// clients that compare or sum prices
+void setMoneyJson(crow::json::wvalue &json, const std::string &key,
+                  domain::Money money) {
+  json[key] = money.euros();
+  json[key + "_cents"] = money.cents();
+}
+
+// Helper function to read a price given as "<key>_cents" or in euros
+domain::Money readMoney(const crow::json::rvalue &body,
+                        const std::string &key) {
+  const std::string cents_key = key + "_cents";
+  if (body.has(cents_key.c_str())) {
+    return domain::Money::fromCents(body[cents_key.c_str()].i());
+  }
+  if (body.has(key.c_str())) {
+    return domain::Money::fromEuros(body[key.c_str()].d());
+  }
+  return {};
+}
+
+// Helper function to write integers as the first value followed by the
+// differences between neighbours (small numbers for slowly moving series)
+crow::json::wvalue deltaEncodedJson(const std::vector<int64_t> &values) {
+  crow::json::wvalue json = crow::json::wvalue::list();
+  int64_t previous = 0;
+  for (size_t i = 0; i < values.size(); ++i) {
+    json[i] = values[i] - previous;
+    previous = values[i];
+  }
+  return json;
+}
+
 // Helper function to populate tag JSON array
 void populateTagJson(crow::json::wvalue &json, int item_id, 
                      const std::string &item_type) {
@@ -96,15 +144,187 @@ void populateTagJson(crow::json::wvalue &json, int item_id,
     json["tags"][i] = std::move(tag_json);
   }
 }
+
+using ReleaseMatchesById =
+    std::unordered_map<int, std::vector<domain::ReleaseMatch>>;
+
+// Helper function to look up one id in batch-loaded release matches
+const std::vector<domain::ReleaseMatch> &
+matchesFor(const ReleaseMatchesById &matches, int id) {
+  static const std::vector<domain::ReleaseMatch> kNone;
+  auto it = matches.find(id);
+  return it != matches.end() ? it->second : kNone;
+}
+
+// Helper function to load the matches of listed releases in one query
+ReleaseMatchesById
+loadReleaseMatches(const std::vector<domain::ReleaseCalendarItem> &items) {
+  std::vector<int> ids;
+  ids.reserve(items.size());
+  for (const auto &item : items) {
+    ids.push_back(item.id);
+  }
+  return ReleaseMatchRepository().findByReleases(ids);
+}
+
+// Helper function to load the upcoming releases of listed collection items
+// in one query
+ReleaseMatchesById
+loadUpcomingReleases(const std::vector<domain::CollectionItem> &items) {
+  std::vector<int> ids;
+  ids.reserve(items.size());
+  for (const auto &item : items) {
+    ids.push_back(item.id);
+  }
+  return ReleaseMatchRepository().findByItems("collection", ids);
+}
+
+// Helper function to list the upcoming releases matched to an item
+void populateUpcomingReleasesJson(
+    crow::json::wvalue &json,
+    const std::vector<domain::ReleaseMatch> &matches) {
+  json["upcoming_releases"] = crow::json::wvalue::list();
+  for (size_t i = 0; i < matches.size(); ++i) {
+    crow::json::wvalue release_json;
+    release_json["id"] = matches[i].release_id;
+    release_json["title"] = matches[i].release_title;
+    release_json["release_date"] = matches[i].release_date;
+    release_json["format"] = matches[i].format.str();
+    release_json["is_uhd_4k"] = matches[i].is_uhd_4k;
+    release_json["score"] = matches[i].score;
+    json["upcoming_releases"][i] = std::move(release_json);
+  }
+}
+
+// Helper function to list the wishlist and collection items matched to a
+// calendar release
+void populateReleaseMatchesJson(
+    crow::json::wvalue &json,
+    const std::vector<domain::ReleaseMatch> &matches) {
+  json["matches"] = crow::json::wvalue::list();
+  for (size_t i = 0; i < matches.size(); ++i) {
+    crow::json::wvalue match_json;
+    match_json["type"] = matches[i].item_type;
+    match_json["id"] = matches[i].item_id;
+    match_json["title"] = matches[i].item_title;
+    match_json["score"] = matches[i].score;
+    json["matches"][i] = std::move(match_json);
+  }
+}
+
+// Helper function to convert a retailer offer to JSON
+crow::json::wvalue productOfferToJson(const domain::ProductOffer &offer) {
+  crow::json::wvalue json;
+  json["wishlist_id"] = offer.wishlist_id;
+  json["url"] = offer.url;
+  json["source"] = offer.source.str();
+  setMoneyJson(json, "price", offer.price);
+  json["in_stock"] = offer.in_stock;
+  return json;
+}
+
+// Helper function to convert a product identity (with its offers, if
+// loaded) to JSON
+crow::json::wvalue productToJson(const domain::ProductIdentity &product) {
+  crow::json::wvalue json;
+  json["id"] = product.id;
+  json["ean"] = product.ean;
+  json["asin"] = product.asin;
+  json["title"] = product.title;
+  json["offer_count"] = product.offer_count;
+  if (product.best_offer) {
+    json["best_offer"] = productOfferToJson(*product.best_offer);
+  } else {
+    json["best_offer"] = nullptr;
+  }
+  if (!product.offers.empty()) {
+    json["offers"] = crow::json::wvalue::list();
+    for (size_t i = 0; i < product.offers.size(); ++i) {
+      json["offers"][i] = productOfferToJson(product.offers[i]);
+    }
+  }
+  return json;
+}
+
+// Helper function to convert a catalog entry to JSON
+crow::json::wvalue catalogEntryToJson(const domain::CatalogEntry &entry) {
+  crow::json::wvalue json;
+  json["type"] = entry.item_type;
+  json["id"] = entry.id;
+  json["title"] = entry.title;
+  json["is_uhd_4k"] = entry.is_uhd_4k;
+  json["tmdb_id"] = entry.tmdb_id;
+  json["ean"] = entry.ean;
+  return json;
+}
+
+// Helper function to index a newly added item for duplicate detection;
+// returns the items it probably duplicates
+crow::json::wvalue indexNewCatalogEntry(const std::string &item_type, int id) {
+  crow::json::wvalue json = crow::json::wvalue::list();
+  auto entry = CatalogRepository().find(item_type, id);
+  if (!entry) {
+    return json;
+  }
+
+  auto matches =
+      application::matching::DuplicateDetector::instance().add(*entry);
+  for (size_t i = 0; i < matches.size(); ++i) {
+    auto match_json = catalogEntryToJson(matches[i].entry);
+    match_json["score"] = matches[i].similarity;
+    match_json["same_tmdb_id"] = matches[i].same_tmdb_id;
+    match_json["same_ean"] = matches[i].same_ean;
+    json[i] = std::move(match_json);
+  }
+  return json;
+}
+
+// Helper function to re-index an edited item for duplicate detection
+void reindexCatalogEntry(const std::string &item_type, int id) {
+  if (auto entry = CatalogRepository().find(item_type, id)) {
+    application::matching::DuplicateDetector::instance().update(*entry);
+  }
+}
+
+// Helper function to apply alert rule fields from a request body
+void updateAlertRuleFields(const crow::json::rvalue &body,
+                           domain::AlertRule &rule) {
+  if (body.has("name")) {
+    rule.name = body["name"].s();
+  }
+  if (body.has("conditions")) {
+    rule.conditions = crow::json::wvalue(body["conditions"]).dump();
+  }
+  if (body.has("notify_via")) {
+    rule.notify_via.clear();
+    const auto &channels = body["notify_via"];
+    for (size_t i = 0; i < channels.size(); ++i) {
+      rule.notify_via.push_back(channels[i].s());
+    }
+  }
+  if (body.has("enabled")) {
+    rule.enabled = body["enabled"].b();
+  }
+}
 } // anonymous namespace
 
-WebFrontend::WebFrontend(std::shared_ptr<application::Scheduler> scheduler)
+WebFrontend::WebFrontend(
+    std::shared_ptr<application::Scheduler> scheduler,
+    std::shared_ptr<application::enrichment::TmdbEnrichmentService>
+        enrichment_service)
     : scheduler_(std::move(scheduler)),
+      enrichment_service_(std::move(enrichment_service)),
       renderer_(std::make_unique<HtmlRenderer>()) {
   setupRoutes();
+  subscribeToEvents();
 }
 
 WebFrontend::~WebFrontend() {
+  // Stop event deliveries first; handlers capture this
+  for (auto id : event_subscriptions_) {
+    application::EventBus::instance().unsubscribe(id);
+  }
+
   // Join all background threads before destruction
   std::lock_guard<std::mutex> lock(threads_mutex_);
   for (auto& thread : background_threads_) {
@@ -112,17 +332,17 @@ WebFrontend::~WebFrontend() {
       thread.join();
     }
   }
-  Logger::instance().debug("All background threads joined");
+  LOG_DEBUG("All background threads joined");
 }
 
 void WebFrontend::run(int port) {
-  Logger::instance().info(fmt::format("Starting web server on port {}", port));
+  LOG_INFO("Starting web server on port {}", port);
   app_.port(port).multithreaded().run();
 }
 
 void WebFrontend::stop() {
   app_.stop();
-  Logger::instance().info("Web server stopped");
+  LOG_INFO("Web server stopped");
 }
 
 void WebFrontend::cleanupFinishedThreads() {
@@ -146,13 +366,84 @@ void WebFrontend::broadcastUpdate(const std::string &message) {
   }
 }
 
+void WebFrontend::subscribeToEvents() {
+  auto &bus = application::EventBus::instance();
+
+  // Scrape changes, including those from scheduled runs
+  event_subscriptions_.push_back(bus.subscribe<domain::ChangeEvent>(
+      [this](const std::shared_ptr<const domain::ChangeEvent> &event) {
+        if (!event->item) {
+          return;
+        }
+        crow::json::wvalue ws_msg;
+        ws_msg["type"] = "item_changed";
+        ws_msg["item_id"] = event->item->id;
+        ws_msg["change"] = domain::toString(event->type);
+        ws_msg["description"] = event->describe();
+        setMoneyJson(ws_msg, "current_price", event->item->current_price);
+        ws_msg["in_stock"] = event->item->in_stock;
+        if (event->old_price) {
+          setMoneyJson(ws_msg, "old_price", *event->old_price);
+        }
+        broadcastUpdate(ws_msg.dump());
+      }));
+
+  // Metadata saved by bulk enrichment or the TMDb refresh
+  event_subscriptions_.push_back(bus.subscribe<domain::MetadataUpdatedEvent>(
+      [this](const std::shared_ptr<const domain::MetadataUpdatedEvent> &event) {
+        crow::json::wvalue ws_msg;
+        ws_msg["type"] = "metadata_updated";
+        ws_msg["item_type"] = event->item_type;
+        ws_msg["item_id"] = event->item_id;
+        ws_msg["tmdb_id"] = event->tmdb_id;
+        ws_msg["tmdb_rating"] = event->tmdb_rating;
+        broadcastUpdate(ws_msg.dump());
+      }));
+
+  // Calendar scrapes, whether triggered via API or at startup
+  event_subscriptions_.push_back(bus.subscribe<domain::CalendarUpdatedEvent>(
+      [this](const std::shared_ptr<const domain::CalendarUpdatedEvent> &event) {
+        crow::json::wvalue ws_msg;
+        ws_msg["type"] = "calendar_scrape_completed";
+        ws_msg["releases_found"] = event->releases_found;
+        ws_msg["added"] = event->added;
+        ws_msg["updated"] = event->updated;
+        broadcastUpdate(ws_msg.dump());
+      }));
+
+  // Writes by cron scrapers and other processes; clients reload the views
+  // showing the listed rows
+  event_subscriptions_.push_back(
+      bus.subscribe<domain::ExternalDataChangedEvent>(
+          [this](const std::shared_ptr<const domain::ExternalDataChangedEvent>
+                     &event) {
+            std::map<std::string, std::set<int64_t>> rows_by_table;
+            for (const auto &change : event->changes) {
+              rows_by_table[change.table].insert(change.row_id);
+            }
+
+            crow::json::wvalue ws_msg;
+            ws_msg["type"] = "data_changed";
+            for (const auto &[table, rows] : rows_by_table) {
+              ws_msg["changes"][table] = crow::json::wvalue::list();
+              size_t i = 0;
+              for (const auto row_id : rows) {
+                ws_msg["changes"][table][i++] = row_id;
+              }
+            }
+            broadcastUpdate(ws_msg.dump());
+          }));
+}
+
 void WebFrontend::setupRoutes() {
   setupWishlistRoutes();
   setupCollectionRoutes();
   setupReleaseCalendarRoutes();
   setupTagRoutes();
+  setupAlertRuleRoutes();
   setupActionRoutes();
   setupEnrichmentRoutes();
+  setupDuplicateRoutes();
   setupStaticRoutes();
   setupWebSocketRoute();
   setupSettingsRoutes();
@@ -167,21 +458,19 @@ void WebFrontend::setupWebSocketRoute() {
       .onopen([this](crow::websocket::connection &conn) {
         std::lock_guard<std::mutex> lock(ws_mutex_);
         ws_connections_.insert(&conn);
-        Logger::instance().debug(fmt::format(
-            "WebSocket client connected. Total: {}", ws_connections_.size()));
+        LOG_DEBUG("WebSocket client connected. Total: {}",
+                  ws_connections_.size());
       })
       .onclose([this](crow::websocket::connection &conn,
                       const std::string & /*reason*/) {
         std::lock_guard<std::mutex> lock(ws_mutex_);
         ws_connections_.erase(&conn);
-        Logger::instance().debug(
-            fmt::format("WebSocket client disconnected. Total: {}",
-                        ws_connections_.size()));
+        LOG_DEBUG("WebSocket client disconnected. Total: {}",
+                  ws_connections_.size());
       })
       .onmessage([](crow::websocket::connection & /*conn*/,
                     const std::string &data, bool /*is_binary*/) {
-        Logger::instance().debug(
-            fmt::format("WebSocket message received: {}", data));
+        LOG_DEBUG("WebSocket message received: {}", data);
       });
 }
 
@@ -232,8 +521,9 @@ void WebFrontend::setupWishlistRoutes() {
         response["has_next"] = result.has_next();
         response["has_previous"] = result.has_previous();
 
+        const auto data = loadWishlistPageData(result.items);
         for (size_t i = 0; i < result.items.size(); ++i) {
-          response["items"][i] = wishlistItemToJson(result.items[i]);
+          response["items"][i] = wishlistItemToJson(result.items[i], data);
         }
 
         return crow::response(200, response);
@@ -252,7 +542,7 @@ void WebFrontend::setupWishlistRoutes() {
         domain::WishlistItem item;
         item.url = body["url"].s();
         item.title = body.has("title") ? body["title"].s() : std::string("");
-        item.desired_max_price = body["desired_max_price"].d();
+        item.desired_max_price = readMoney(body, "desired_max_price");
         item.notify_on_price_drop = body.has("notify_on_price_drop")
                                         ? body["notify_on_price_drop"].b()
                                         : true;
@@ -271,8 +561,9 @@ void WebFrontend::setupWishlistRoutes() {
         }
 
         // Try to scrape metadata if available
+        std::optional<domain::Product> product;
         if (auto sc = application::scraper::ScraperFactory::create(item.url)) {
-          if (auto product = sc->scrape(item.url)) {
+          if ((product = sc->scrape(item.url))) {
             if (item.title.empty() && !product->title.empty()) {
               item.title = product->title;
             }
@@ -296,6 +587,20 @@ void WebFrontend::setupWishlistRoutes() {
           // Record initial price history
           infrastructure::PriceHistoryRepository history_repo;
           history_repo.addEntry(item.id, item.current_price, item.in_stock);
+          try {
+            infrastructure::PriceStatsRepository stats_repo;
+            stats_repo.record(item.id, item.current_price,
+                              std::chrono::system_clock::now());
+          } catch (const std::exception &e) {
+            // The item is stored; its statistics start at the next scrape
+            LOG_ERROR("Failed to record initial price stats: {}", e.what());
+          }
+
+          // Same disc at another retailer (by EAN/ASIN)
+          if (product) {
+            infrastructure::ProductRepository product_repo;
+            product_repo.link(item.id, *product);
+          }
 
           // Broadcast update via WebSocket
           auto json_item = wishlistItemToJson(item);
@@ -305,6 +610,8 @@ void WebFrontend::setupWishlistRoutes() {
           broadcastUpdate(ws_msg.dump());
 
           json_item = wishlistItemToJson(item);
+          json_item["possible_duplicates"] =
+              indexNewCatalogEntry("wishlist", item.id);
           return crow::response(201, json_item);
         }
 
@@ -348,8 +655,9 @@ void WebFrontend::setupWishlistRoutes() {
             item->title_locked = explicit_lock;
           }
         }
-        if (body.has("desired_max_price"))
-          item->desired_max_price = body["desired_max_price"].d();
+        if (body.has("desired_max_price") ||
+            body.has("desired_max_price_cents"))
+          item->desired_max_price = readMoney(body, "desired_max_price");
         if (body.has("notify_on_price_drop"))
           item->notify_on_price_drop = body["notify_on_price_drop"].b();
         if (body.has("notify_on_stock"))
@@ -364,6 +672,8 @@ void WebFrontend::setupWishlistRoutes() {
                           item->has_digital_copy, item->bonus_features);
 
         if (repo.update(*item)) {
+          reindexCatalogEntry("wishlist", item->id);
+
           // Broadcast update via WebSocket
           auto json_item = wishlistItemToJson(*item);
           crow::json::wvalue ws_msg;
@@ -383,6 +693,10 @@ void WebFrontend::setupWishlistRoutes() {
       .methods("DELETE"_method)([this](int id) {
         SqliteWishlistRepository repo;
         if (repo.remove(id)) {
+          PriceHistoryRepository().removeHistory(id);
+          application::matching::DuplicateDetector::instance().remove(
+              "wishlist", id);
+
           // Broadcast update via WebSocket
           crow::json::wvalue ws_msg;
           ws_msg["type"] = "wishlist_deleted";
@@ -394,30 +708,44 @@ void WebFrontend::setupWishlistRoutes() {
         return crow::response(404, "Item not found");
       });
   // Get price history for wishlist item
+  // ?days= (default 180) and ?points= (default 500, at most 1000): long
+  // histories are downsampled so the response size stays bounded
   CROW_ROUTE(app_, "/api/wishlist/<int>/history")
-      .methods("GET"_method)([](int id) {
+      .methods("GET"_method)([](const crow::request &req, int id) {
         SqliteWishlistRepository wishlist_repo;
         auto item = wishlist_repo.findById(id);
         if (!item) {
           return crow::response(404, "Item not found");
         }
 
-        infrastructure::PriceHistoryRepository repo;
+        constexpr int kMaxHistoryPoints = 1000;
         int days = 180; // Default to 6 months
+        int points = 500;
+        try {
+          if (req.url_params.get("days")) {
+            days = std::stoi(req.url_params.get("days"));
+          }
+          if (req.url_params.get("points")) {
+            points = std::stoi(req.url_params.get("points"));
+          }
+        } catch (const std::exception &) {
+          return crow::response(400, "days and points must be numbers");
+        }
+        if (days < 1 || days > 36500) {
+          return crow::response(400, "days must be between 1 and 36500");
+        }
+        points = std::clamp(points, 2, kMaxHistoryPoints);
 
-        // Allow days override via query param
-        // Note: Crow's url_params handling might need checking, assuming
-        // minimal here or default. Using default 180 days for now or
-        // hardcoded as per plan.
-
-        auto history = repo.getHistory(id, days);
+        infrastructure::PriceHistoryRepository repo;
+        auto history =
+            repo.getDownsampledHistory(id, days, static_cast<size_t>(points));
 
         crow::json::wvalue response;
         response = crow::json::wvalue::list();
 
         for (size_t i = 0; i < history.size(); ++i) {
           crow::json::wvalue entry;
-          entry["price"] = history[i].price;
+          setMoneyJson(entry, "price", history[i].price);
           entry["in_stock"] = history[i].in_stock;
           entry["date"] = history[i].recorded_at;
           response[i] = std::move(entry);
@@ -425,6 +753,74 @@ void WebFrontend::setupWishlistRoutes() {
 
         return crow::response(200, response);
       });
+
+  // Price trend of several items at once, e.g. the cards on one page:
+  // ?ids=1,2,3&days=90&points=32. Each item has "t" (epoch seconds) and "c"
+  // (cents), delta-encoded: the first value, then differences.
+  CROW_ROUTE(app_, "/api/history/sparklines")
+      .methods("GET"_method)([](const crow::request &req) {
+        constexpr size_t kMaxSparklineItems = 200;
+        constexpr int kMaxSparklinePoints = 100;
+
+        std::vector<int> ids;
+        int days = 90;
+        int points = 32;
+        try {
+          if (req.url_params.get("ids")) {
+            std::istringstream list(req.url_params.get("ids"));
+            std::string id;
+            while (std::getline(list, id, ',')) {
+              if (!id.empty()) {
+                ids.push_back(std::stoi(id));
+              }
+            }
+          }
+          if (req.url_params.get("days")) {
+            days = std::stoi(req.url_params.get("days"));
+          }
+          if (req.url_params.get("points")) {
+            points = std::stoi(req.url_params.get("points"));
+          }
+        } catch (const std::exception &) {
+          return crow::response(400, "ids, days and points must be numbers");
+        }
+        if (ids.empty() || ids.size() > kMaxSparklineItems) {
+          return crow::response(
+              400, fmt::format("ids must list 1 to {} items",
+                               kMaxSparklineItems));
+        }
+        if (days < 1 || days > 36500) {
+          return crow::response(400, "days must be between 1 and 36500");
+        }
+        points = std::clamp(points, 2, kMaxSparklinePoints);
+
+        infrastructure::PriceHistoryRepository repo;
+        const auto sparklines =
+            repo.getSparklines(ids, days, static_cast<size_t>(points));
+
+        crow::json::wvalue response;
+        response["days"] = days;
+        response["points"] = points;
+        response["items"] = crow::json::wvalue::object();
+        for (const auto &[id, sparkline] : sparklines) {
+          crow::json::wvalue line;
+          line["t"] = deltaEncodedJson(sparkline.times);
+          line["c"] = deltaEncodedJson(sparkline.cents);
+          response["items"][std::to_string(id)] = std::move(line);
+        }
+        return crow::response(200, response);
+      });
+
+  // Product identity with every retailer's offer, cheapest in stock first
+  CROW_ROUTE(app_, "/api/products/<int>")
+      .methods("GET"_method)([](int id) {
+        ProductRepository repo;
+        auto product = repo.findById(id, true);
+        if (!product) {
+          return crow::response(404, "Product not found");
+        }
+        return crow::response(200, productToJson(*product));
+      });
 }
 
 void WebFrontend::setupCollectionRoutes() {
@@ -463,13 +859,15 @@ void WebFrontend::setupCollectionRoutes() {
         response["page"] = result.page;
         response["page_size"] = result.page_size;
         response["total_count"] = result.total_count;
-        response["total_value"] = result.total_value;
+        setMoneyJson(response, "total_value", result.total_value);
         response["total_pages"] = result.total_pages();
         response["has_next"] = result.has_next();
         response["has_previous"] = result.has_previous();
 
+        const auto upcoming = loadUpcomingReleases(result.items);
         for (size_t i = 0; i < result.items.size(); ++i) {
-          response["items"][i] = collectionItemToJson(result.items[i]);
+          response["items"][i] = collectionItemToJson(
+              result.items[i], matchesFor(upcoming, result.items[i].id));
         }
 
         return crow::response(200, response);
@@ -488,7 +886,7 @@ void WebFrontend::setupCollectionRoutes() {
         domain::CollectionItem item;
         item.url = body["url"].s();
         item.title = body["title"].s();
-        item.purchase_price = body["purchase_price"].d();
+        item.purchase_price = readMoney(body, "purchase_price");
         item.is_uhd_4k = body.has("is_uhd_4k") ? body["is_uhd_4k"].b() : false;
         item.notes = body.has("notes") ? std::string(body["notes"].s())
                                        : std::string("");
@@ -532,6 +930,8 @@ void WebFrontend::setupCollectionRoutes() {
           broadcastUpdate(ws_msg.dump());
 
           json_item = collectionItemToJson(item);
+          json_item["possible_duplicates"] =
+              indexNewCatalogEntry("collection", item.id);
           return crow::response(201, json_item);
         }
 
@@ -556,8 +956,8 @@ void WebFrontend::setupCollectionRoutes() {
 
         if (x.has("title"))
           item.title = x["title"].s();
-        if (x.has("purchase_price"))
-          item.purchase_price = x["purchase_price"].d();
+        if (x.has("purchase_price") || x.has("purchase_price_cents"))
+          item.purchase_price = readMoney(x, "purchase_price");
         if (x.has("is_uhd_4k"))
           item.is_uhd_4k = x["is_uhd_4k"].b();
         if (x.has("notes"))
@@ -576,6 +976,7 @@ void WebFrontend::setupCollectionRoutes() {
                           item.has_digital_copy, item.bonus_features);
 
         if (repo.update(item)) {
+          reindexCatalogEntry("collection", item.id);
           return crow::response(200);
         }
 
@@ -587,6 +988,9 @@ void WebFrontend::setupCollectionRoutes() {
       .methods("DELETE"_method)([this](int id) {
         SqliteCollectionRepository repo;
         if (repo.remove(id)) {
+          application::matching::DuplicateDetector::instance().remove(
+              "collection", id);
+
           // Broadcast update via WebSocket
           crow::json::wvalue ws_msg;
           ws_msg["type"] = "collection_deleted";
@@ -632,8 +1036,10 @@ void WebFrontend::setupReleaseCalendarRoutes() {
         response["has_next"] = result.has_next();
         response["has_previous"] = result.has_previous();
 
+        const auto matches = loadReleaseMatches(result.items);
         for (size_t i = 0; i < result.items.size(); ++i) {
-          response["items"][i] = releaseCalendarItemToJson(result.items[i]);
+          response["items"][i] = releaseCalendarItemToJson(
+              result.items[i], matchesFor(matches, result.items[i].id));
         }
 
         return crow::response(200, response);
@@ -653,42 +1059,99 @@ void WebFrontend::setupReleaseCalendarRoutes() {
           return crow::response(400, "Missing start or end date");
         }
 
-        // Parse dates (simple implementation)
-        std::tm start_tm = {};
-        std::tm end_tm = {};
-        std::istringstream start_ss(start_date);
-        std::istringstream end_ss(end_date);
-
-        // Validate that date parsing succeeds
-        if (!(start_ss >> std::get_time(&start_tm, "%Y-%m-%d")) ||
-            !(end_ss >> std::get_time(&end_tm, "%Y-%m-%d"))) {
+        const auto first = ReleaseCalendarIndex::parseDay(start_date);
+        const auto last = ReleaseCalendarIndex::parseDay(end_date);
+        if (!first || !last) {
           return crow::response(
-              400, "Invalid start or end date format, expected YYYY-MM-DD");
+              400, "Invalid start or end date, expected YYYY-MM-DD");
         }
 
-        auto start_time_t = std::mktime(&start_tm);
-        auto end_time_t = std::mktime(&end_tm);
-
-        if (start_time_t == static_cast<std::time_t>(-1) ||
-            end_time_t == static_cast<std::time_t>(-1)) {
-          return crow::response(400, "Invalid start or end date value");
+        // Served from memory; the table is the fallback
+        auto items =
+            ReleaseCalendarIndex::instance().findByDayRange(*first, *last);
+        if (!items) {
+          items = repo.findByDateRange(
+              ReleaseCalendarIndex::startOfDay(*first),
+              ReleaseCalendarIndex::startOfDay(*last));
         }
 
-        auto start_tp = std::chrono::system_clock::from_time_t(start_time_t);
-        auto end_tp = std::chrono::system_clock::from_time_t(end_time_t);
-        auto items = repo.findByDateRange(start_tp, end_tp);
-
         crow::json::wvalue response;
         response["items"] = crow::json::wvalue::list();
-        response["count"] = items.size();
+        response["count"] = items->size();
 
-        for (size_t i = 0; i < items.size(); ++i) {
-          response["items"][i] = releaseCalendarItemToJson(items[i]);
+        const auto matches = loadReleaseMatches(*items);
+        for (size_t i = 0; i < items->size(); ++i) {
+          response["items"][i] = releaseCalendarItemToJson(
+              (*items)[i], matchesFor(matches, (*items)[i].id));
         }
 
         return crow::response(200, response);
       });
 
+  // Month view: releases of ?month=YYYY-MM grouped by day
+  CROW_ROUTE(app_, "/api/release-calendar/month")
+      .methods("GET"_method)([this](const crow::request &req) {
+        const std::string month =
+            req.url_params.get("month") ? req.url_params.get("month") : "";
+        if (month.size() != 7 ||
+            !ReleaseCalendarIndex::parseDay(month + "-01")) {
+          return crow::response(400, "Invalid month, expected YYYY-MM");
+        }
+        const int year = std::stoi(month.substr(0, 4));
+        const int month_number = std::stoi(month.substr(5, 2));
+
+        auto &index = ReleaseCalendarIndex::instance();
+        auto days = index.findByMonth(year, month_number);
+        if (!days) {
+          // Index unavailable: read the month from the table
+          SqliteReleaseCalendarRepository repo;
+          const auto first = ReleaseCalendarIndex::dayFromCivil(
+              year, month_number, 1);
+          const auto next_month =
+              month_number == 12
+                  ? ReleaseCalendarIndex::dayFromCivil(year + 1, 1, 1)
+                  : ReleaseCalendarIndex::dayFromCivil(year, month_number + 1,
+                                                       1);
+
+          days.emplace();
+          for (auto &item : repo.findByDateRange(
+                   ReleaseCalendarIndex::startOfDay(first),
+                   ReleaseCalendarIndex::startOfDay(next_month - 1))) {
+            (*days)[ReleaseCalendarIndex::dayOf(item.release_date)].push_back(
+                std::move(item));
+          }
+        }
+
+        std::vector<int> release_ids;
+        for (const auto &[day, items] : *days) {
+          for (const auto &item : items) {
+            release_ids.push_back(item.id);
+          }
+        }
+        const auto matches =
+            ReleaseMatchRepository().findByReleases(release_ids);
+
+        crow::json::wvalue response;
+        response["month"] = month;
+        response["days"] = crow::json::wvalue::list();
+        size_t count = 0;
+        size_t i = 0;
+        for (const auto &[day, items] : *days) {
+          crow::json::wvalue day_json;
+          day_json["date"] = ReleaseCalendarIndex::formatDay(day);
+          day_json["items"] = crow::json::wvalue::list();
+          for (size_t j = 0; j < items.size(); ++j) {
+            day_json["items"][j] = releaseCalendarItemToJson(
+                items[j], matchesFor(matches, items[j].id));
+          }
+          count += items.size();
+          response["days"][i++] = std::move(day_json);
+        }
+        response["count"] = count;
+
+        return crow::response(200, response);
+      });
+
   // Add release calendar item manually
   CROW_ROUTE(app_, "/api/release-calendar")
       .methods("POST"_method)([this](const crow::request &req) {
@@ -701,8 +1164,13 @@ void WebFrontend::setupReleaseCalendarRoutes() {
 
         domain::ReleaseCalendarItem item;
         item.title = body["title"].s();
-        item.format = body.has("format") ? std::string(body["format"].s())
-                                         : std::string("Blu-ray");
+        const std::string format = body.has("format")
+                                       ? std::string(body["format"].s())
+                                       : std::string("Blu-ray");
+        if (!validation::isValidReleaseFormat(format)) {
+          return crow::response(400, "Invalid format");
+        }
+        item.format = format;
         item.studio = body.has("studio") ? std::string(body["studio"].s())
                                          : std::string("");
         item.product_url = body.has("product_url")
@@ -712,7 +1180,7 @@ void WebFrontend::setupReleaseCalendarRoutes() {
                              ? std::string(body["image_url"].s())
                              : std::string("");
         item.is_uhd_4k = body.has("is_uhd_4k") ? body["is_uhd_4k"].b() : false;
-        item.price = body.has("price") ? body["price"].d() : 0.0;
+        item.price = readMoney(body, "price");
         item.notes = body.has("notes") ? std::string(body["notes"].s())
                                        : std::string("");
 
@@ -741,14 +1209,17 @@ void WebFrontend::setupReleaseCalendarRoutes() {
         if (id > 0) {
           item.id = id;
 
+          // Matched on the next calendar refresh
+          const std::vector<domain::ReleaseMatch> no_matches;
+
           // Broadcast update via WebSocket
-          auto json_item = releaseCalendarItemToJson(item);
+          auto json_item = releaseCalendarItemToJson(item, no_matches);
           crow::json::wvalue ws_msg;
           ws_msg["type"] = "calendar_added";
           ws_msg["item"] = std::move(json_item);
           broadcastUpdate(ws_msg.dump());
 
-          json_item = releaseCalendarItemToJson(item);
+          json_item = releaseCalendarItemToJson(item, no_matches);
           return crow::response(201, json_item);
         }
 
@@ -947,10 +1418,152 @@ void WebFrontend::setupTagRoutes() {
       .methods("DELETE"_method)(createTagAssignmentHandler("collection", false));
 }
 
+void WebFrontend::setupAlertRuleRoutes() {
+  // Get all alert rules with their evaluation statistics
+  CROW_ROUTE(app_, "/api/alert-rules")
+      .methods("GET"_method)([this]() {
+        SqliteAlertRuleRepository repo;
+        auto rules = repo.findAll();
+        const auto stats = scheduler_->getAlertRuleStats();
+
+        crow::json::wvalue response;
+        response["rules"] = crow::json::wvalue::list();
+        for (size_t i = 0; i < rules.size(); ++i) {
+          response["rules"][i] = alertRuleToJson(rules[i], stats);
+        }
+
+        return crow::response(200, response);
+      });
+
+  // Create an alert rule
+  CROW_ROUTE(app_, "/api/alert-rules")
+      .methods("POST"_method)([this](const crow::request &req) {
+        auto body = crow::json::load(req.body);
+        if (!body) {
+          return crow::response(400, "Invalid JSON");
+        }
+        if (!body.has("name") || !body.has("conditions")) {
+          return crow::response(400,
+                                "Missing required fields: name, conditions");
+        }
+
+        domain::AlertRule rule;
+        updateAlertRuleFields(body, rule);
+        if (rule.name.empty()) {
+          return crow::response(400, "Rule name must not be empty");
+        }
+
+        // Reject rules that would not compile at the next scrape run
+        try {
+          application::alerts::RuleEngine::compile(rule);
+        } catch (const application::alerts::RuleCompileError &e) {
+          return crow::response(400, e.what());
+        }
+
+        SqliteAlertRuleRepository repo;
+        const int id = repo.add(rule);
+        if (id <= 0) {
+          return crow::response(500, "Failed to add alert rule");
+        }
+        rule.id = id;
+
+        crow::json::wvalue ws_msg;
+        ws_msg["type"] = "alert_rule_added";
+        ws_msg["rule_id"] = id;
+        broadcastUpdate(ws_msg.dump());
+
+        return crow::response(201, alertRuleToJson(rule, {}));
+      });
+
+  // Update an alert rule
+  CROW_ROUTE(app_, "/api/alert-rules/<int>")
+      .methods("PUT"_method)([this](const crow::request &req, int id) {
+        auto body = crow::json::load(req.body);
+        if (!body) {
+          return crow::response(400, "Invalid JSON");
+        }
+
+        SqliteAlertRuleRepository repo;
+        auto rule = repo.findById(id);
+        if (!rule) {
+          return crow::response(404, "Alert rule not found");
+        }
+
+        updateAlertRuleFields(body, *rule);
+        if (rule->name.empty()) {
+          return crow::response(400, "Rule name must not be empty");
+        }
+
+        try {
+          application::alerts::RuleEngine::compile(*rule);
+        } catch (const application::alerts::RuleCompileError &e) {
+          return crow::response(400, e.what());
+        }
+
+        if (!repo.update(*rule)) {
+          return crow::response(500, "Failed to update alert rule");
+        }
+
+        crow::json::wvalue ws_msg;
+        ws_msg["type"] = "alert_rule_updated";
+        ws_msg["rule_id"] = id;
+        broadcastUpdate(ws_msg.dump());
+
+        return crow::response(200, alertRuleToJson(
+                                       *rule, scheduler_->getAlertRuleStats()));
+      });
+
+  // Delete an alert rule
+  CROW_ROUTE(app_, "/api/alert-rules/<int>")
+      .methods("DELETE"_method)([this](int id) {
+        SqliteAlertRuleRepository repo;
+        if (!repo.remove(id)) {
+          return crow::response(404, "Alert rule not found");
+        }
+
+        crow::json::wvalue ws_msg;
+        ws_msg["type"] = "alert_rule_deleted";
+        ws_msg["rule_id"] = id;
+        broadcastUpdate(ws_msg.dump());
+
+        return crow::response(200, "Alert rule deleted");
+      });
+
+  // Preview which wishlist items a rule matches right now
+  CROW_ROUTE(app_, "/api/alert-rules/preview")
+      .methods("POST"_method)([](const crow::request &req) {
+        auto body = crow::json::load(req.body);
+        if (!body || !body.has("conditions")) {
+          return crow::response(400, "Missing required field: conditions");
+        }
+
+        domain::AlertRule rule;
+        updateAlertRuleFields(body, rule);
+
+        SqliteWishlistRepository wishlist_repo;
+        std::vector<int> matching;
+        try {
+          matching = application::alerts::RuleEngine::preview(
+              rule, wishlist_repo.findAll());
+        } catch (const application::alerts::RuleCompileError &e) {
+          return crow::response(400, e.what());
+        }
+
+        crow::json::wvalue response;
+        response["matching_items"] = matching.size();
+        response["item_ids"] = crow::json::wvalue::list();
+        for (size_t i = 0; i < matching.size(); ++i) {
+          response["item_ids"][i] = matching[i];
+        }
+
+        return crow::response(200, response);
+      });
+}
+
 void WebFrontend::setupActionRoutes() {
   // Trigger scrape now
   CROW_ROUTE(app_, "/api/action/scrape").methods("POST"_method)([this]() {
-    Logger::instance().info("Manual scrape triggered via API");
+    LOG_INFO("Manual scrape triggered via API");
 
     try {
       int processed = scheduler_->runOnce();
@@ -976,7 +1589,7 @@ void WebFrontend::setupActionRoutes() {
 
   // Trigger release calendar scrape
   CROW_ROUTE(app_, "/api/scrape-calendar").methods("POST"_method)([this]() {
-    Logger::instance().info("Manual calendar scrape triggered via API");
+    LOG_INFO("Manual calendar scrape triggered via API");
 
     try {
       int releases_found = scheduler_->scrapeReleaseCalendar();
@@ -985,11 +1598,7 @@ void WebFrontend::setupActionRoutes() {
       response["success"] = true;
       response["releases_found"] = releases_found;
 
-      // Broadcast calendar scrape completion
-      crow::json::wvalue ws_msg;
-      ws_msg["type"] = "calendar_scrape_completed";
-      ws_msg["releases_found"] = releases_found;
-      broadcastUpdate(ws_msg.dump());
+      // Completion is broadcast from the CalendarUpdatedEvent subscription
 
       return crow::response(200, response);
     } catch (const std::exception &e) {
@@ -1000,28 +1609,26 @@ void WebFrontend::setupActionRoutes() {
     }
   });
 
-  // Get dashboard stats
   // Get dashboard stats
   CROW_ROUTE(app_, "/api/stats").methods("GET"_method)([this]() {
-    SqliteWishlistRepository wishlist_repo;
     SqliteCollectionRepository collection_repo;
 
     crow::json::wvalue response;
-    response["wishlist_count"] = wishlist_repo.count();
     response["collection_count"] = collection_repo.count();
 
-    // Count in-stock items
-    auto wishlist = wishlist_repo.findAll();
-    int in_stock_count = 0;
-    int uhd_4k_count = 0;
-    for (const auto &item : wishlist) {
-      if (item.in_stock)
-        in_stock_count++;
-      if (item.is_uhd_4k)
-        uhd_4k_count++;
-    }
-    response["in_stock_count"] = in_stock_count;
-    response["uhd_4k_count"] = uhd_4k_count;
+    // Wishlist figures come from the columnar snapshot
+    const auto wishlist = infrastructure::WishlistSnapshot::instance().columns();
+    auto deals = domain::columns::belowThreshold(*wishlist);
+    deals &= wishlist->in_stock;
+
+    response["wishlist_count"] = static_cast<int64_t>(wishlist->size());
+    response["in_stock_count"] =
+        static_cast<int64_t>(wishlist->in_stock.count());
+    response["uhd_4k_count"] = static_cast<int64_t>(wishlist->is_uhd_4k.count());
+    response["deal_count"] = static_cast<int64_t>(deals.count());
+    setMoneyJson(response, "wishlist_value",
+                 domain::Money::fromCents(
+                     domain::columns::sum(wishlist->current_price)));
 
     // Scrape Progress
     auto progress = scheduler_->getScrapeProgress();
@@ -1032,6 +1639,42 @@ void WebFrontend::setupActionRoutes() {
     progress_json["total"] = progress.total;
     response["scrape_progress"] = std::move(progress_json);
 
+    // Notification dispatch metrics
+    auto notifications = scheduler_->getNotificationMetrics();
+
+    crow::json::wvalue notifications_json;
+    notifications_json["queue_depth"] =
+        static_cast<int64_t>(notifications.queue_depth);
+    notifications_json["enqueued"] =
+        static_cast<int64_t>(notifications.enqueued);
+    notifications_json["dispatched"] =
+        static_cast<int64_t>(notifications.dispatched);
+    notifications_json["retries"] = static_cast<int64_t>(notifications.retries);
+    notifications_json["given_up"] =
+        static_cast<int64_t>(notifications.given_up);
+    notifications_json["batches"] = static_cast<int64_t>(notifications.batches);
+    notifications_json["notifier_errors"] =
+        static_cast<int64_t>(notifications.notifier_errors);
+    notifications_json["last_latency_ms"] =
+        static_cast<int64_t>(notifications.last_latency.count());
+    notifications_json["avg_latency_ms"] =
+        static_cast<int64_t>(notifications.avg_latency.count());
+    notifications_json["max_latency_ms"] =
+        static_cast<int64_t>(notifications.max_latency.count());
+    response["notifications"] = std::move(notifications_json);
+
+    // Internal event bus delivery
+    const auto events = application::EventBus::instance().getMetrics();
+    crow::json::wvalue events_json;
+    events_json["queue_depth"] = events.queue_depth;
+    events_json["max_queue_depth"] = events.max_queue_depth;
+    events_json["subscribers"] = events.subscribers;
+    events_json["published"] = events.published;
+    events_json["delivered"] = events.delivered;
+    events_json["dropped"] = events.dropped;
+    events_json["handler_errors"] = events.handler_errors;
+    response["events"] = std::move(events_json);
+
     return crow::response(200, response);
   });
 }
@@ -1052,10 +1695,7 @@ void WebFrontend::setupEnrichmentRoutes() {
 
         auto item = *item_opt;
 
-        // Create enrichment service
-        application::enrichment::TmdbEnrichmentService service;
-
-        if (!service.isEnabled()) {
+        if (!enrichment_service_->isEnabled()) {
           crow::json::wvalue error_response;
           error_response["success"] = false;
           error_response["error"] =
@@ -1064,7 +1704,7 @@ void WebFrontend::setupEnrichmentRoutes() {
         }
 
         // Enrich the item
-        auto result = service.enrichWishlistItem(item);
+        auto result = enrichment_service_->enrichWishlistItem(item);
 
         if (result.success) {
           // Save enriched item
@@ -1075,6 +1715,8 @@ void WebFrontend::setupEnrichmentRoutes() {
             return crow::response(500, error_response);
           }
 
+          reindexCatalogEntry("wishlist", item.id);
+
           // Broadcast update to WebSocket clients
           crow::json::wvalue ws_msg;
           ws_msg["type"] = "wishlist_updated";
@@ -1130,10 +1772,7 @@ void WebFrontend::setupEnrichmentRoutes() {
 
         auto item = *item_opt;
 
-        // Create enrichment service
-        application::enrichment::TmdbEnrichmentService service;
-
-        if (!service.isEnabled()) {
+        if (!enrichment_service_->isEnabled()) {
           crow::json::wvalue error_response;
           error_response["success"] = false;
           error_response["error"] =
@@ -1142,7 +1781,7 @@ void WebFrontend::setupEnrichmentRoutes() {
         }
 
         // Enrich the item
-        auto result = service.enrichCollectionItem(item);
+        auto result = enrichment_service_->enrichCollectionItem(item);
 
         if (result.success) {
           // Save enriched item
@@ -1153,6 +1792,8 @@ void WebFrontend::setupEnrichmentRoutes() {
             return crow::response(500, error_response);
           }
 
+          reindexCatalogEntry("collection", item.id);
+
           // Broadcast update to WebSocket clients
           crow::json::wvalue ws_msg;
           ws_msg["type"] = "collection_updated";
@@ -1224,8 +1865,6 @@ void WebFrontend::setupEnrichmentRoutes() {
           cleanupFinishedThreads(); // Clean up any completed threads
           
           background_threads_.emplace_back([this, item_type, item_ids]() {
-            application::enrichment::TmdbEnrichmentService service;
-
             auto progress_callback =
                 [this](const application::enrichment::BulkEnrichmentProgress
                            &progress) {
@@ -1244,12 +1883,15 @@ void WebFrontend::setupEnrichmentRoutes() {
 
             if (item_type == "wishlist") {
               final_progress =
-                  service.enrichMultipleWishlistItems(item_ids, progress_callback);
+                  enrichment_service_->enrichMultipleWishlistItems(item_ids, progress_callback);
             } else if (item_type == "collection") {
-              final_progress = service.enrichMultipleCollectionItems(
+              final_progress = enrichment_service_->enrichMultipleCollectionItems(
                   item_ids, progress_callback);
             }
 
+            // New TMDb ids link duplicates
+            application::matching::DuplicateDetector::instance().invalidate();
+
             // Broadcast completion
             crow::json::wvalue ws_msg;
             ws_msg["type"] = "enrichment_completed";
@@ -1268,9 +1910,8 @@ void WebFrontend::setupEnrichmentRoutes() {
       });
 
   // Get enrichment progress
-  CROW_ROUTE(app_, "/api/enrich/progress").methods("GET"_method)([]() {
-    application::enrichment::TmdbEnrichmentService service;
-    auto progress = service.getCurrentProgress();
+  CROW_ROUTE(app_, "/api/enrich/progress").methods("GET"_method)([this]() {
+    auto progress = enrichment_service_->getCurrentProgress();
 
     crow::json::wvalue response;
     response["total"] = progress.total;
@@ -1283,6 +1924,45 @@ void WebFrontend::setupEnrichmentRoutes() {
     return crow::response(200, response);
   });
 
+  // Refresh enriched items that changed on TMDb (async)
+  CROW_ROUTE(app_, "/api/enrich/refresh")
+      .methods("POST"_method)([this]() {
+        if (!enrichment_service_->isEnabled()) {
+          crow::json::wvalue error_response;
+          error_response["success"] = false;
+          error_response["error"] = "TMDb API key not configured";
+          return crow::response(400, error_response);
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(threads_mutex_);
+          cleanupFinishedThreads(); // Clean up any completed threads
+
+          background_threads_.emplace_back([this]() {
+            auto summary = enrichment_service_->refreshChangedItems();
+            application::matching::DuplicateDetector::instance().invalidate();
+
+            crow::json::wvalue ws_msg;
+            ws_msg["type"] = "tmdb_refresh_completed";
+            ws_msg["success"] = summary.success;
+            ws_msg["start_date"] = summary.start_date;
+            ws_msg["end_date"] = summary.end_date;
+            ws_msg["changed_movies"] = summary.changed_movies;
+            ws_msg["matched_movies"] = summary.matched_movies;
+            ws_msg["refreshed_items"] = summary.refreshed_items;
+            ws_msg["failed"] = summary.failed;
+            if (!summary.success) {
+              ws_msg["error"] = summary.error_message;
+            }
+            broadcastUpdate(ws_msg.dump());
+          });
+        }
+
+        crow::json::wvalue response;
+        response["started"] = true;
+        return crow::response(200, response);
+      });
+
   // Auto-enrich all unenriched items
   CROW_ROUTE(app_, "/api/enrich/auto")
       .methods("POST"_method)([this](const crow::request &req) {
@@ -1361,8 +2041,6 @@ void WebFrontend::setupEnrichmentRoutes() {
           cleanupFinishedThreads(); // Clean up any completed threads
           
           background_threads_.emplace_back([this, item_type, unenriched_ids]() {
-            application::enrichment::TmdbEnrichmentService service;
-
             auto progress_callback =
                 [this](const application::enrichment::BulkEnrichmentProgress
                            &progress) {
@@ -1379,13 +2057,16 @@ void WebFrontend::setupEnrichmentRoutes() {
             application::enrichment::BulkEnrichmentProgress final_progress;
 
             if (item_type == "wishlist") {
-              final_progress = service.enrichMultipleWishlistItems(unenriched_ids,
+              final_progress = enrichment_service_->enrichMultipleWishlistItems(unenriched_ids,
                                                                     progress_callback);
             } else if (item_type == "collection") {
-              final_progress = service.enrichMultipleCollectionItems(
+              final_progress = enrichment_service_->enrichMultipleCollectionItems(
                   unenriched_ids, progress_callback);
             }
 
+            // New TMDb ids link duplicates
+            application::matching::DuplicateDetector::instance().invalidate();
+
             // Broadcast completion
             crow::json::wvalue ws_msg;
             ws_msg["type"] = "enrichment_completed";
@@ -1403,6 +2084,63 @@ void WebFrontend::setupEnrichmentRoutes() {
       });
 }
 
+void WebFrontend::setupDuplicateRoutes() {
+  // Latest full-catalog duplicate report; until the first scan has
+  // finished, starts it and answers 202
+  CROW_ROUTE(app_, "/api/duplicates").methods("GET"_method)([this]() {
+    auto &detector = application::matching::DuplicateDetector::instance();
+    if (auto report = detector.lastReport()) {
+      return crow::response(200, duplicateReportToJson(*report));
+    }
+
+    startDuplicateScan();
+
+    crow::json::wvalue response;
+    response["scanning"] = true;
+    return crow::response(202, response);
+  });
+
+  // Rescan the whole catalog for duplicates (async, one scan at a time)
+  CROW_ROUTE(app_, "/api/duplicates/scan")
+      .methods("POST"_method)([this]() {
+        crow::json::wvalue response;
+        if (!startDuplicateScan()) {
+          response["started"] = false;
+          response["message"] = "A duplicate scan is already running";
+          return crow::response(409, response);
+        }
+
+        response["started"] = true;
+        return crow::response(200, response);
+      });
+}
+
+bool WebFrontend::startDuplicateScan() {
+  auto &detector = application::matching::DuplicateDetector::instance();
+  if (!detector.beginScan()) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(threads_mutex_);
+  cleanupFinishedThreads(); // Clean up any completed threads
+
+  background_threads_.emplace_back([this]() {
+    try {
+      auto report =
+          application::matching::DuplicateDetector::instance().scan();
+
+      crow::json::wvalue ws_msg;
+      ws_msg["type"] = "duplicates_scanned";
+      ws_msg["items"] = report.items;
+      ws_msg["group_count"] = report.groups.size();
+      broadcastUpdate(ws_msg.dump());
+    } catch (const std::exception &e) {
+      LOG_ERROR("Duplicate scan failed: {}", e.what());
+    }
+  });
+  return true;
+}
+
 void WebFrontend::setupSettingsRoutes() {
   // Get settings
   CROW_ROUTE(app_, "/api/settings").methods("GET"_method)([]() {
@@ -1410,6 +2148,7 @@ void WebFrontend::setupSettingsRoutes() {
 
     crow::json::wvalue response;
     response["scrape_delay_seconds"] = config.getInt("scrape_delay_seconds", 8);
+    response["scrape_concurrency"] = config.getInt("scrape_concurrency", 4);
     response["discord_webhook_url"] = config.get("discord_webhook_url", "");
     response["smtp_server"] = config.get("smtp_server", "");
     response["smtp_port"] = config.get("smtp_port", "587");
@@ -1430,55 +2169,74 @@ void WebFrontend::setupSettingsRoutes() {
 
   // Update settings
   CROW_ROUTE(app_, "/api/settings")
-      .methods("PUT"_method, "POST"_method)([](const crow::request &req) {
+      .methods("PUT"_method, "POST"_method)([this](const crow::request &req) {
         auto body = crow::json::load(req.body);
         if (!body) {
           return crow::response(400, "Invalid JSON");
         }
 
-        auto &config = ConfigManager::instance();
+        // Validate everything first, then store the whole update as one
+        // config snapshot so subscribers re-tune once
+        std::vector<std::pair<std::string, std::string>> updates;
 
         if (body.has("scrape_delay_seconds")) {
-          config.set("scrape_delay_seconds",
-                     std::to_string(body["scrape_delay_seconds"].i()));
+          updates.emplace_back("scrape_delay_seconds",
+                               std::to_string(body["scrape_delay_seconds"].i()));
+        }
+        if (body.has("scrape_concurrency")) {
+          int concurrency = body["scrape_concurrency"].i();
+          if (concurrency < 1 || concurrency > 16) {
+            return crow::response(400, "Invalid scrape concurrency");
+          }
+          updates.emplace_back("scrape_concurrency",
+                               std::to_string(concurrency));
         }
         if (body.has("discord_webhook_url")) {
-          config.set("discord_webhook_url",
-                     std::string(body["discord_webhook_url"].s()));
+          updates.emplace_back("discord_webhook_url",
+                               std::string(body["discord_webhook_url"].s()));
         }
         if (body.has("smtp_server")) {
-          config.set("smtp_server", std::string(body["smtp_server"].s()));
+          updates.emplace_back("smtp_server",
+                               std::string(body["smtp_server"].s()));
         }
         if (body.has("smtp_port")) {
           int smtp_port = body["smtp_port"].i();
           if (smtp_port < 1 || smtp_port > 65535) {
             return crow::response(400, "Invalid SMTP port");
           }
-          config.set("smtp_port", std::to_string(smtp_port));
+          updates.emplace_back("smtp_port", std::to_string(smtp_port));
         }
         if (body.has("smtp_user")) {
-          config.set("smtp_user", std::string(body["smtp_user"].s()));
+          updates.emplace_back("smtp_user", std::string(body["smtp_user"].s()));
         }
         if (body.has("smtp_pass")) {
-          config.set("smtp_pass", std::string(body["smtp_pass"].s()));
+          updates.emplace_back("smtp_pass", std::string(body["smtp_pass"].s()));
         }
         if (body.has("smtp_from")) {
-          config.set("smtp_from", std::string(body["smtp_from"].s()));
+          updates.emplace_back("smtp_from", std::string(body["smtp_from"].s()));
         }
         if (body.has("smtp_to")) {
-          config.set("smtp_to", std::string(body["smtp_to"].s()));
+          updates.emplace_back("smtp_to", std::string(body["smtp_to"].s()));
         }
 
         // TMDb settings
+        std::optional<std::string> tmdb_api_key;
         if (body.has("tmdb_api_key")) {
-          config.set("tmdb_api_key", std::string(body["tmdb_api_key"].s()));
+          tmdb_api_key = std::string(body["tmdb_api_key"].s());
+          updates.emplace_back("tmdb_api_key", *tmdb_api_key);
         }
         if (body.has("tmdb_auto_enrich")) {
-          config.set("tmdb_auto_enrich", body["tmdb_auto_enrich"].b() ? "1" : "0");
+          updates.emplace_back("tmdb_auto_enrich",
+                               body["tmdb_auto_enrich"].b() ? "1" : "0");
         }
         if (body.has("tmdb_enrich_on_add")) {
-          config.set("tmdb_enrich_on_add",
-                     body["tmdb_enrich_on_add"].b() ? "1" : "0");
+          updates.emplace_back("tmdb_enrich_on_add",
+                               body["tmdb_enrich_on_add"].b() ? "1" : "0");
+        }
+
+        ConfigManager::instance().set(updates);
+        if (tmdb_api_key) {
+          enrichment_service_->setApiKey(*tmdb_api_key);
         }
 
         return crow::response(200, "Settings updated");
@@ -1540,19 +2298,41 @@ std::string WebFrontend::timePointToString(
   return ss.str();
 }
 
+WebFrontend::WishlistPageData WebFrontend::loadWishlistPageData(
+    const std::vector<domain::WishlistItem> &items) {
+  std::vector<int> ids;
+  ids.reserve(items.size());
+  for (const auto &item : items) {
+    ids.push_back(item.id);
+  }
+
+  WishlistPageData data;
+  data.price_stats = infrastructure::PriceStatsRepository().find(ids);
+  data.products = ProductRepository().findByWishlistIds(ids);
+  data.upcoming_releases =
+      ReleaseMatchRepository().findByItems("wishlist", ids);
+  return data;
+}
+
 crow::json::wvalue
 WebFrontend::wishlistItemToJson(const domain::WishlistItem &item) {
+  return wishlistItemToJson(item, loadWishlistPageData({item}));
+}
+
+crow::json::wvalue
+WebFrontend::wishlistItemToJson(const domain::WishlistItem &item,
+                                const WishlistPageData &data) {
   crow::json::wvalue json;
   json["id"] = item.id;
   json["url"] = item.url;
   json["title"] = item.title;
-  json["current_price"] = item.current_price;
-  json["desired_max_price"] = item.desired_max_price;
+  setMoneyJson(json, "current_price", item.current_price);
+  setMoneyJson(json, "desired_max_price", item.desired_max_price);
   json["in_stock"] = item.in_stock;
   json["is_uhd_4k"] = item.is_uhd_4k;
   json["image_url"] = item.image_url;
   json["local_image_path"] = item.local_image_path;
-  json["source"] = item.source;
+  json["source"] = item.source.str();
   json["notify_on_price_drop"] = item.notify_on_price_drop;
   json["notify_on_stock"] = item.notify_on_stock;
   json["title_locked"] = item.title_locked;
@@ -1566,7 +2346,7 @@ WebFrontend::wishlistItemToJson(const domain::WishlistItem &item) {
   json["trailer_key"] = item.trailer_key;
 
   // Edition & bonus features
-  json["edition_type"] = item.edition_type;
+  json["edition_type"] = item.edition_type.str();
   json["has_slipcover"] = item.has_slipcover;
   json["has_digital_copy"] = item.has_digital_copy;
   json["bonus_features"] = item.bonus_features;
@@ -1574,20 +2354,73 @@ WebFrontend::wishlistItemToJson(const domain::WishlistItem &item) {
   // Get tags for this item
   populateTagJson(json, item.id, "wishlist");
 
+  // Calendar releases of the same film
+  populateUpcomingReleasesJson(
+      json, matchesFor(data.upcoming_releases, item.id));
+
+  // All-time and rolling lows, moving average
+  auto stats = data.price_stats.find(item.id);
+  populatePriceStatsJson(json, stats != data.price_stats.end()
+                                   ? &stats->second
+                                   : nullptr);
+
+  // Same disc at other retailers: cheapest in-stock offer
+  if (auto product = data.products.find(item.id);
+      product != data.products.end()) {
+    json["product"] = productToJson(product->second);
+  } else {
+    json["product"] = nullptr;
+  }
+
   return json;
 }
 
+void WebFrontend::populatePriceStatsJson(crow::json::wvalue &json,
+                                         const domain::PriceStats *stats) {
+  if (!stats) {
+    json["price_stats"] = nullptr;
+    return;
+  }
+
+  const auto now = std::chrono::system_clock::now();
+  crow::json::wvalue stats_json;
+  setMoneyJson(stats_json, "all_time_low", stats->all_time_low);
+  setMoneyJson(stats_json, "all_time_high", stats->all_time_high);
+  setMoneyJson(stats_json, "average", stats->average());
+  if (auto low = stats->windowLow(30, now)) {
+    setMoneyJson(stats_json, "low_30d", *low);
+  } else {
+    stats_json["low_30d"] = nullptr;
+  }
+  if (auto low = stats->windowLow(90, now)) {
+    setMoneyJson(stats_json, "low_90d", *low);
+  } else {
+    stats_json["low_90d"] = nullptr;
+  }
+  stats_json["last_change_at"] =
+      timePointToString(stats->last_change_at);
+  stats_json["samples"] = stats->samples;
+  json["price_stats"] = std::move(stats_json);
+}
+
 crow::json::wvalue
 WebFrontend::collectionItemToJson(const domain::CollectionItem &item) {
+  return collectionItemToJson(
+      item, ReleaseMatchRepository().findByItem("collection", item.id));
+}
+
+crow::json::wvalue WebFrontend::collectionItemToJson(
+    const domain::CollectionItem &item,
+    const std::vector<domain::ReleaseMatch> &upcoming_releases) {
   crow::json::wvalue json;
   json["id"] = item.id;
   json["url"] = item.url;
   json["title"] = item.title;
-  json["purchase_price"] = item.purchase_price;
+  setMoneyJson(json, "purchase_price", item.purchase_price);
   json["is_uhd_4k"] = item.is_uhd_4k;
   json["image_url"] = item.image_url;
   json["local_image_path"] = item.local_image_path;
-  json["source"] = item.source;
+  json["source"] = item.source.str();
   json["notes"] = item.notes;
   json["purchased_at"] = timePointToString(item.purchased_at);
   json["added_at"] = timePointToString(item.added_at);
@@ -1599,7 +2432,7 @@ WebFrontend::collectionItemToJson(const domain::CollectionItem &item) {
   json["trailer_key"] = item.trailer_key;
 
   // Edition & bonus features
-  json["edition_type"] = item.edition_type;
+  json["edition_type"] = item.edition_type.str();
   json["has_slipcover"] = item.has_slipcover;
   json["has_digital_copy"] = item.has_digital_copy;
   json["bonus_features"] = item.bonus_features;
@@ -1607,26 +2440,97 @@ WebFrontend::collectionItemToJson(const domain::CollectionItem &item) {
   // Get tags for this item
   populateTagJson(json, item.id, "collection");
 
+  // Calendar releases of the same film, e.g. a 4K upgrade
+  populateUpcomingReleasesJson(json, upcoming_releases);
+
+  return json;
+}
+
+crow::json::wvalue WebFrontend::alertRuleToJson(
+    const domain::AlertRule &rule,
+    const std::vector<application::alerts::RuleStats> &stats) {
+  crow::json::wvalue json;
+  json["id"] = rule.id;
+  json["name"] = rule.name;
+  json["conditions"] = crow::json::load(rule.conditions);
+  json["notify_via"] = crow::json::wvalue::list();
+  for (size_t i = 0; i < rule.notify_via.size(); ++i) {
+    json["notify_via"][i] = rule.notify_via[i];
+  }
+  json["enabled"] = rule.enabled;
+  json["created_at"] = timePointToString(rule.created_at);
+
+  // Statistics exist once a scrape run has evaluated the rule
+  auto it = std::find_if(stats.begin(), stats.end(), [&](const auto &entry) {
+    return entry.rule_id == rule.id;
+  });
+  if (it != stats.end()) {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    crow::json::wvalue stats_json;
+    stats_json["instructions"] = it->instructions;
+    stats_json["runs"] = it->runs;
+    stats_json["evaluations"] = it->evaluations;
+    stats_json["matches"] = it->matches;
+    stats_json["total_time_us"] = static_cast<int64_t>(
+        duration_cast<microseconds>(it->total_time).count());
+    stats_json["last_run_time_us"] = static_cast<int64_t>(
+        duration_cast<microseconds>(it->last_run_time).count());
+    stats_json["avg_time_per_item_ns"] =
+        it->evaluations > 0
+            ? static_cast<int64_t>(it->total_time.count() /
+                                   static_cast<int64_t>(it->evaluations))
+            : 0;
+    json["stats"] = std::move(stats_json);
+  }
+
+  return json;
+}
+
+crow::json::wvalue WebFrontend::duplicateReportToJson(
+    const application::matching::DuplicateReport &report) {
+  crow::json::wvalue json;
+  json["generated_at"] = timePointToString(report.generated_at);
+  json["items"] = report.items;
+  json["duration_ms"] = report.duration.count();
+  json["group_count"] = report.groups.size();
+  json["groups"] = crow::json::wvalue::list();
+  for (size_t i = 0; i < report.groups.size(); ++i) {
+    const auto &group = report.groups[i];
+    crow::json::wvalue group_json;
+    group_json["items"] = crow::json::wvalue::list();
+    for (size_t j = 0; j < group.entries.size(); ++j) {
+      group_json["items"][j] = catalogEntryToJson(group.entries[j]);
+    }
+    group_json["same_tmdb_id"] = group.same_tmdb_id;
+    group_json["same_ean"] = group.same_ean;
+    json["groups"][i] = std::move(group_json);
+  }
   return json;
 }
 
 crow::json::wvalue WebFrontend::releaseCalendarItemToJson(
-    const domain::ReleaseCalendarItem &item) {
+    const domain::ReleaseCalendarItem &item,
+    const std::vector<domain::ReleaseMatch> &matches) {
   crow::json::wvalue json;
   json["id"] = item.id;
   json["title"] = item.title;
   json["release_date"] = timePointToString(item.release_date);
-  json["format"] = item.format;
+  json["format"] = item.format.str();
   json["studio"] = item.studio;
   json["image_url"] = item.image_url;
   json["local_image_path"] = item.local_image_path;
   json["product_url"] = item.product_url;
   json["is_uhd_4k"] = item.is_uhd_4k;
   json["is_preorder"] = item.is_preorder;
-  json["price"] = item.price;
+  setMoneyJson(json, "price", item.price);
   json["notes"] = item.notes;
   json["created_at"] = timePointToString(item.created_at);
   json["last_updated"] = timePointToString(item.last_updated);
+
+  // Wishlist and collection items of the same film
+  populateReleaseMatchesJson(json, matches);
   return json;
 }
 
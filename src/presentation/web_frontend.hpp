@@ -1,6 +1,10 @@
 #pragma once
 
+#include "../application/enrichment/tmdb_enrichment_service.hpp"
+#include "../application/event_bus.hpp"
+#include "../application/matching/duplicate_detector.hpp"
 #include "../application/scheduler.hpp"
+#include "../domain/price_stats.hpp"
 
 #include "html_renderer.hpp"
 #include <crow.h>
@@ -8,6 +12,7 @@
 #include <mutex>
 #include <set>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace bluray::presentation {
@@ -17,7 +22,9 @@ namespace bluray::presentation {
  */
 class WebFrontend {
 public:
-  explicit WebFrontend(std::shared_ptr<application::Scheduler> scheduler);
+  WebFrontend(std::shared_ptr<application::Scheduler> scheduler,
+              std::shared_ptr<application::enrichment::TmdbEnrichmentService>
+                  enrichment_service);
 
   /**
    * Destructor - joins background threads
@@ -52,30 +59,89 @@ private:
   void setupCollectionRoutes();
   void setupReleaseCalendarRoutes();
   void setupTagRoutes();
+  void setupAlertRuleRoutes();
   void setupActionRoutes();
   void setupEnrichmentRoutes();
+  void setupDuplicateRoutes();
   void setupStaticRoutes();
   void setupWebSocketRoute();
   void setupSettingsRoutes();
 
+  /**
+   * Forward scrape, enrichment, calendar and external change events to
+   * WebSocket clients
+   */
+  void subscribeToEvents();
+
+  /**
+   * Run a full duplicate scan on a background thread, announced with a
+   * "duplicates_scanned" WebSocket message
+   * @return false if a scan is already running
+   */
+  bool startDuplicateScan();
+
   // HTML rendering
   std::string renderSPA();
 
+  /**
+   * Per-item data shown with a page of wishlist items, each part loaded in
+   * one query for the whole page (keyed by wishlist id; items without any
+   * are absent)
+   */
+  struct WishlistPageData {
+    std::unordered_map<int, domain::PriceStats> price_stats;
+    std::unordered_map<int, domain::ProductIdentity> products;
+    std::unordered_map<int, std::vector<domain::ReleaseMatch>>
+        upcoming_releases;
+  };
+
+  WishlistPageData
+  loadWishlistPageData(const std::vector<domain::WishlistItem> &items);
+
   // Helper methods
   crow::json::wvalue wishlistItemToJson(const domain::WishlistItem &item);
+  crow::json::wvalue wishlistItemToJson(const domain::WishlistItem &item,
+                                        const WishlistPageData &data);
   crow::json::wvalue collectionItemToJson(const domain::CollectionItem &item);
+  // `upcoming_releases`: the item's entries from ReleaseMatchRepository,
+  // loaded for the whole page
+  crow::json::wvalue collectionItemToJson(
+      const domain::CollectionItem &item,
+      const std::vector<domain::ReleaseMatch> &upcoming_releases);
+  // `matches`: the release's entries from ReleaseMatchRepository, loaded
+  // for the whole page
+  crow::json::wvalue
+  releaseCalendarItemToJson(const domain::ReleaseCalendarItem &item,
+                            const std::vector<domain::ReleaseMatch> &matches);
   crow::json::wvalue
-  releaseCalendarItemToJson(const domain::ReleaseCalendarItem &item);
+  alertRuleToJson(const domain::AlertRule &rule,
+                  const std::vector<application::alerts::RuleStats> &stats);
+  crow::json::wvalue
+  duplicateReportToJson(const application::matching::DuplicateReport &report);
   std::string
   timePointToString(const std::chrono::system_clock::time_point &tp);
 
+  /**
+   * Add an item's running price statistics as "price_stats" (null until a
+   * price has been recorded, i.e. `stats` is null)
+   */
+  void populatePriceStatsJson(crow::json::wvalue &json,
+                              const domain::PriceStats *stats);
+
   crow::SimpleApp app_;
   std::shared_ptr<application::Scheduler> scheduler_;
 
+  // Process-wide enrichment service (shared TMDb rate limit and progress)
+  std::shared_ptr<application::enrichment::TmdbEnrichmentService>
+      enrichment_service_;
+
   // WebSocket connections
   std::mutex ws_mutex_;
   std::set<crow::websocket::connection *> ws_connections_;
 
+  // Event bus subscriptions, removed before destruction
+  std::vector<application::EventBus::SubscriptionId> event_subscriptions_;
+
   // Background enrichment threads
   std::mutex threads_mutex_;
   std::vector<std::thread> background_threads_;